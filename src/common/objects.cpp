@@ -30,6 +30,15 @@ void Objects::add(ObjectBasePtr object)
     }
 }
 
+void Objects::insert(size_t index, ObjectBasePtr object)
+{
+    auto i = std::find(m_objects.begin(), m_objects.end(), object);
+    if (i == m_objects.end())
+    {
+        m_objects.insert(m_objects.begin() + static_cast<ObjectVector::difference_type>(std::min(index, m_objects.size())), object);
+    }
+}
+
 void Objects::remove(ObjectBase & object)
 {
     for (auto i = m_objects.begin(); i != m_objects.end(); i++)
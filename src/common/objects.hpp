@@ -37,6 +37,9 @@ public:
     //! Add an object.
     void add(ObjectBasePtr object);
 
+    //! Insert an object at the given index or add it if the index is out of range.
+    void insert(size_t index, ObjectBasePtr object);
+
     //! Remove an object.
     void remove(ObjectBase & object);
 
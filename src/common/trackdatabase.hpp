@@ -20,7 +20,6 @@
 
 class Objects;
 class Route;
-class MapBase;
 
 //! Common base class for track data shared by the editor and the game.
 class TrackDataBase
@@ -62,12 +61,6 @@ public:
     //! Set user track option.
     virtual void setUserTrack(bool isUserTrack);
 
-    //! Get map object.
-    virtual MapBase & map() = 0;
-
-    //! Get map object.
-    virtual const MapBase & map() const = 0;
-
     //! Get route object.
     virtual Route & route() = 0;
 
@@ -0,0 +1,190 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trackfilereader.hpp"
+#include "datakeywords.hpp"
+
+#include <QFile>
+#include <QXmlStreamReader>
+
+namespace {
+
+int toInt(const QXmlStreamAttributes & attributes, const char * key, int defaultValue = 0)
+{
+    const auto value = attributes.value(QLatin1String(key));
+    return value.isEmpty() ? defaultValue : value.toInt();
+}
+
+unsigned int toUInt(const QXmlStreamAttributes & attributes, const char * key, unsigned int defaultValue = 0)
+{
+    const auto value = attributes.value(QLatin1String(key));
+    return value.isEmpty() ? defaultValue : value.toUInt();
+}
+
+} // namespace
+
+TrackFileReader::TrackFileReader()
+{
+    m_tileTypes.push_back("clear");
+}
+
+bool TrackFileReader::read(QString path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    return read(file);
+}
+
+bool TrackFileReader::read(QIODevice & device)
+{
+    QXmlStreamReader reader(&device);
+    if (!readHeader(reader))
+    {
+        return false;
+    }
+
+    m_tiles.reserve(m_header.cols * m_header.rows);
+
+    while (reader.readNextStartElement())
+    {
+        const auto element = reader.name();
+        const auto attributes = reader.attributes();
+        if (element == QLatin1String(DataKeywords::Track::tile))
+        {
+            Tile tile;
+            tile.i = static_cast<uint16_t>(toUInt(attributes, DataKeywords::Tile::i));
+            tile.j = static_cast<uint16_t>(toUInt(attributes, DataKeywords::Tile::j));
+            tile.typeIndex = tileTypeIndex(attributes.value(QLatin1String(DataKeywords::Tile::type)));
+            tile.orientation = static_cast<int16_t>(toInt(attributes, DataKeywords::Tile::orientation));
+            tile.computerHint = static_cast<uint8_t>(toUInt(attributes, DataKeywords::Tile::computerHint));
+            tile.excludeFromMinimap = toUInt(attributes, DataKeywords::Tile::excludeFromMinimap);
+
+            // Tiles outside of the map would be ignored anyway
+            if (tile.i < m_header.cols && tile.j < m_header.rows)
+            {
+                m_tiles.push_back(tile);
+            }
+        }
+        else if (element == QLatin1String(DataKeywords::Track::object))
+        {
+            Object object;
+            object.category = attributes.value(QLatin1String(DataKeywords::Object::category)).toString();
+            object.role = attributes.value(QLatin1String(DataKeywords::Object::role)).toString();
+            object.x = toInt(attributes, DataKeywords::Object::x);
+            object.y = toInt(attributes, DataKeywords::Object::y);
+            object.orientation = toInt(attributes, DataKeywords::Object::orientation);
+            object.forceStationary = toUInt(attributes, DataKeywords::Object::forceStationary);
+            m_objects.push_back(object);
+        }
+        else if (element == QLatin1String(DataKeywords::Track::node))
+        {
+            Node node;
+            node.index = toInt(attributes, DataKeywords::Node::index);
+            node.x = toInt(attributes, DataKeywords::Node::x);
+            node.y = toInt(attributes, DataKeywords::Node::y);
+            node.width = toInt(attributes, DataKeywords::Node::width);
+            node.height = toInt(attributes, DataKeywords::Node::height);
+            m_nodes.push_back(node);
+        }
+
+        reader.skipCurrentElement();
+    }
+
+    return !reader.hasError();
+}
+
+bool TrackFileReader::readHeader(QIODevice & device)
+{
+    QXmlStreamReader reader(&device);
+    return readHeader(reader);
+}
+
+bool TrackFileReader::readHeader(QXmlStreamReader & reader)
+{
+    m_header = {};
+    m_tiles.clear();
+    m_objects.clear();
+    m_nodes.clear();
+
+    if (!reader.readNextStartElement() || reader.name() != QLatin1String(DataKeywords::Header::track))
+    {
+        return false;
+    }
+
+    const auto header = reader.attributes();
+    m_header.cols = toUInt(header, DataKeywords::Header::cols);
+    m_header.rows = toUInt(header, DataKeywords::Header::rows);
+    if (!m_header.cols || !m_header.rows)
+    {
+        return false;
+    }
+
+    const auto name = header.value(QLatin1String(DataKeywords::Header::name));
+    m_header.name = name.isEmpty() ? QString("undefined") : name.toString();
+    m_header.isUserTrack = toUInt(header, DataKeywords::Header::user);
+    m_header.index = toUInt(header, DataKeywords::Header::index, m_header.index);
+
+    return true;
+}
+
+uint16_t TrackFileReader::tileTypeIndex(QStringView type)
+{
+    // Missing type means a cleared tile
+    if (type.isEmpty())
+    {
+        return 0;
+    }
+
+    // There are only a dozen tile types, so a linear search beats hashing
+    for (size_t index = 0; index < m_tileTypes.size(); index++)
+    {
+        if (m_tileTypes[index] == type)
+        {
+            return static_cast<uint16_t>(index);
+        }
+    }
+
+    m_tileTypes.push_back(type.toString());
+    return static_cast<uint16_t>(m_tileTypes.size() - 1);
+}
+
+const TrackFileReader::Header & TrackFileReader::header() const
+{
+    return m_header;
+}
+
+const std::vector<TrackFileReader::Tile> & TrackFileReader::tiles() const
+{
+    return m_tiles;
+}
+
+const std::vector<QString> & TrackFileReader::tileTypes() const
+{
+    return m_tileTypes;
+}
+
+const std::vector<TrackFileReader::Object> & TrackFileReader::objects() const
+{
+    return m_objects;
+}
+
+const std::vector<TrackFileReader::Node> & TrackFileReader::nodes() const
+{
+    return m_nodes;
+}
@@ -0,0 +1,140 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TRACKFILEREADER_HPP
+#define TRACKFILEREADER_HPP
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+class QIODevice;
+class QXmlStreamReader;
+
+/*! Streaming reader for the track files shared by the game and the editor.
+ *  The tiles are read into a compact array and the tile types are interned,
+ *  so a reader that is reused for several tracks doesn't allocate per tile.
+ *  The coordinates are stored as written by the editor: mirroring them for the
+ *  game is up to the caller. */
+class TrackFileReader
+{
+public:
+    struct Header
+    {
+        QString name;
+
+        bool isUserTrack = false;
+
+        unsigned int cols = 0;
+
+        unsigned int rows = 0;
+
+        //! Tracks without an index are sorted last.
+        unsigned int index = 999;
+    };
+
+    struct Tile
+    {
+        uint16_t i = 0;
+
+        uint16_t j = 0;
+
+        //! Index to tileTypes().
+        uint16_t typeIndex = 0;
+
+        int16_t orientation = 0;
+
+        uint8_t computerHint = 0;
+
+        bool excludeFromMinimap = false;
+    };
+
+    struct Object
+    {
+        QString category;
+
+        QString role;
+
+        int x = 0;
+
+        int y = 0;
+
+        int orientation = 0;
+
+        bool forceStationary = false;
+    };
+
+    struct Node
+    {
+        int index = 0;
+
+        int x = 0;
+
+        int y = 0;
+
+        int width = 0;
+
+        int height = 0;
+    };
+
+    //! Constructor.
+    TrackFileReader();
+
+    TrackFileReader(const TrackFileReader & other) = delete;
+
+    TrackFileReader & operator=(const TrackFileReader & other) = delete;
+
+    /*! Read the given track file.
+     *  \return false if the file cannot be opened, is not a valid track file or has no tiles. */
+    bool read(QString path);
+
+    //! Read a track from the given open device.
+    bool read(QIODevice & device);
+
+    /*! Read only the header of a track from the given open device. Tiles, objects and nodes
+     *  are cleared. Used to list the tracks without parsing them completely. */
+    bool readHeader(QIODevice & device);
+
+    const Header & header() const;
+
+    //! Tiles in file order.
+    const std::vector<Tile> & tiles() const;
+
+    //! Interned tile type names referred by Tile::typeIndex. The first one is "clear" and they are kept over reads.
+    const std::vector<QString> & tileTypes() const;
+
+    const std::vector<Object> & objects() const;
+
+    //! Target nodes in file order.
+    const std::vector<Node> & nodes() const;
+
+private:
+    bool readHeader(QXmlStreamReader & reader);
+
+    uint16_t tileTypeIndex(QStringView type);
+
+    Header m_header;
+
+    std::vector<Tile> m_tiles;
+
+    std::vector<QString> m_tileTypes;
+
+    std::vector<Object> m_objects;
+
+    std::vector<Node> m_nodes;
+};
+
+#endif // TRACKFILEREADER_HPP
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2018 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../simple_logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::Benchmark {
+
+//! \return messages per second when the given number of threads log the given number of messages each.
+double run(int threadCount, int messageCount, L::Level level)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([=] {
+            for (int i = 0; i < messageCount; i++) {
+                switch (level) {
+                case L::Level::Debug:
+                    L("Benchmark").debug() << "Message " << i << " of thread " << t << ", value " << i * 0.5;
+                    break;
+                default:
+                    L("Benchmark").info() << "Message " << i << " of thread " << t << ", value " << i * 0.5;
+                    break;
+                }
+            }
+        });
+    }
+
+    for (auto && thread : threads) {
+        thread.join();
+    }
+
+    // Include writing the pending messages
+    L::flush();
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threadCount * messageCount / elapsed.count();
+}
+
+void printResult(const std::string & name, double messagesPerSecond)
+{
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(0) << std::setw(12) << messagesPerSecond << " msg/s" << std::endl;
+}
+
+void runAll(int messageCount)
+{
+    const int threadCount = static_cast<int>(std::max(2u, std::thread::hardware_concurrency() / 2));
+
+    for (bool async : { false, true }) {
+        L::enableAsyncMode(async);
+        const std::string mode = async ? "Async" : "Sync";
+        printResult(mode + ", 1 thread", run(1, messageCount, L::Level::Info));
+        printResult(mode + ", " + std::to_string(threadCount) + " threads", run(threadCount, messageCount / threadCount, L::Level::Info));
+        printResult(mode + ", disabled level", run(1, messageCount, L::Level::Debug));
+        L::enableAsyncMode(false);
+    }
+}
+
+} // namespace juzzlin::Benchmark
+
+int main(int argc, char ** argv)
+{
+    using juzzlin::L;
+
+    const std::string logFileName = "benchmark.log";
+    L::initialize(logFileName);
+    L::enableEchoMode(false);
+    L::setLoggingLevel(L::Level::Info);
+    L::setTimestampMode(L::TimestampMode::DateTime);
+
+    const int messageCount = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 200000;
+    std::cout << "Messages: " << messageCount << std::endl;
+    juzzlin::Benchmark::runAll(messageCount);
+
+    std::remove(logFileName.c_str());
+
+    return EXIT_SUCCESS;
+}
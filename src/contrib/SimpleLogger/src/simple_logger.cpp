@@ -24,15 +24,22 @@
 
 #include "simple_logger.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <map>
+#include <iterator>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace juzzlin {
 
@@ -59,6 +66,10 @@ public:
 
     static void enableEchoMode(bool enable);
 
+    static void enableAsyncMode(bool enable);
+
+    static void flushAsync();
+
     static void setLevelSymbol(SimpleLogger::Level level, std::string symbol);
 
     static void setLoggingLevel(SimpleLogger::Level level);
@@ -78,21 +89,45 @@ public:
     std::ostringstream & prepareStreamForLoggingLevel(SimpleLogger::Level level);
 
 private:
-    std::string currentDateTime(std::chrono::time_point<std::chrono::system_clock> now, const std::string & dateTimeFormat) const;
+    using Clock = std::chrono::system_clock;
+
+    struct Record
+    {
+        SimpleLogger::Level level;
+
+        Clock::time_point time;
+
+        std::string tag;
+
+        std::string message;
+
+        // Orders the records of different threads in the async mode
+        uint64_t sequence = 0;
+    };
+
+    class AsyncWriter;
+
+    static AsyncWriter & asyncWriter();
+
+    static std::string currentDateTime(Clock::time_point now, const std::string & dateTimeFormat);
 
-    void flushFileIfOpen();
+    static std::string timestamp(Clock::time_point now);
 
-    void flushEchoIfEnabled();
+    //! Write the record to the file and the echo stream. m_writeMutex must be locked.
+    static void write(const Record & record);
 
-    void prefixWithLevelAndTag(SimpleLogger::Level level);
+    //! Flush the file and the echo streams of the levels in the mask. m_writeMutex must be locked.
+    static void flushStreams(uint32_t levelMask);
 
-    void prefixWithTimestamp();
+    static std::ostringstream & disabledStream();
 
-    bool shouldFlush() const;
+    static size_t index(SimpleLogger::Level level);
 
     static bool m_echoMode;
 
-    static SimpleLogger::Level m_level;
+    static std::atomic<bool> m_asyncMode;
+
+    static std::atomic<SimpleLogger::Level> m_level;
 
     static SimpleLogger::TimestampMode m_timestampMode;
 
@@ -102,26 +137,197 @@ private:
 
     static std::ofstream m_fileStream;
 
-    using SymbolMap = std::map<SimpleLogger::Level, std::string>;
-    static SymbolMap m_symbols;
+    // Indexed by the level
+    using SymbolArray = std::array<std::string, 7>;
+    static SymbolArray m_symbols;
+
+    // Indexed by the level
+    using StreamArray = std::array<std::ostream *, 7>;
+    static StreamArray m_streams;
+
+    // Serializes the writing only, messages are composed without locking
+    static std::mutex m_writeMutex;
 
-    using StreamMap = std::map<SimpleLogger::Level, std::ostream *>;
-    static StreamMap m_streams;
+    // Latest date time timestamp, which changes only once per second
+    static std::time_t m_cachedTime;
 
-    static std::recursive_mutex m_mutex;
+    static std::string m_cachedFormat;
+
+    static std::string m_cachedDateTime;
 
     SimpleLogger::Level m_activeLevel = SimpleLogger::Level::Info;
 
-    std::lock_guard<std::recursive_mutex> m_lock;
+    Clock::time_point m_time;
 
     std::string m_tag;
 
-    std::ostringstream m_message;
+    // Constructed only if the level is enabled
+    std::optional<std::ostringstream> m_message;
 };
 
+/*! Collects the records into per-thread buffers and writes them in a background thread,
+ *  so that logging threads only lock their own, uncontended buffer. */
+class SimpleLogger::Impl::AsyncWriter
+{
+public:
+    AsyncWriter() = default;
+
+    ~AsyncWriter();
+
+    void start();
+
+    //! Stop the thread and write the pending records.
+    void stop();
+
+    void push(Record && record);
+
+    //! Write the pending records in the calling thread.
+    void flush();
+
+private:
+    struct ThreadBuffer
+    {
+        std::mutex mutex;
+
+        std::vector<Record> records;
+    };
+
+    ThreadBuffer & threadBuffer();
+
+    void run();
+
+    // Wake up the thread early if a buffer grows this large
+    static const size_t WAKE_UP_SIZE = 1024;
+
+    std::mutex m_buffersMutex;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+    std::atomic<uint64_t> m_sequence { 0 };
+
+    // Guarded by m_writeMutex
+    std::vector<Record> m_batch;
+
+    std::mutex m_threadMutex;
+
+    std::condition_variable m_condition;
+
+    bool m_running = false;
+
+    std::thread m_thread;
+};
+
+SimpleLogger::Impl::AsyncWriter::~AsyncWriter()
+{
+    stop();
+    flush();
+}
+
+void SimpleLogger::Impl::AsyncWriter::start()
+{
+    std::lock_guard<std::mutex> lock(m_threadMutex);
+    if (!m_running) {
+        m_running = true;
+        m_thread = std::thread(&AsyncWriter::run, this);
+    }
+}
+
+void SimpleLogger::Impl::AsyncWriter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_threadMutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+
+    m_condition.notify_one();
+    m_thread.join();
+    flush();
+}
+
+SimpleLogger::Impl::AsyncWriter::ThreadBuffer & SimpleLogger::Impl::AsyncWriter::threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        m_buffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+void SimpleLogger::Impl::AsyncWriter::push(Record && record)
+{
+    record.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+
+    auto && buffer = threadBuffer();
+    size_t size = 0;
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.records.push_back(std::move(record));
+        size = buffer.records.size();
+    }
+
+    if (size == WAKE_UP_SIZE) {
+        m_condition.notify_one();
+    }
+}
+
+void SimpleLogger::Impl::AsyncWriter::flush()
+{
+    std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        for (auto iter = m_buffers.begin(); iter != m_buffers.end();) {
+            auto && buffer = *iter;
+
+            // The thread has finished if this is the only reference, so nothing can be pushed after draining
+            const bool finished = buffer.use_count() == 1;
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                m_batch.insert(m_batch.end(), std::make_move_iterator(buffer->records.begin()), std::make_move_iterator(buffer->records.end()));
+                buffer->records.clear(); // Keeps the capacity
+            }
+
+            iter = finished ? m_buffers.erase(iter) : iter + 1;
+        }
+    }
+
+    if (m_batch.empty()) {
+        return;
+    }
+
+    std::sort(m_batch.begin(), m_batch.end(), [](auto && a, auto && b) { return a.sequence < b.sequence; });
+    uint32_t levelMask = 0;
+    for (auto && record : m_batch) {
+        write(record);
+        levelMask |= 1u << index(record.level);
+    }
+
+    flushStreams(levelMask);
+    m_batch.clear();
+}
+
+void SimpleLogger::Impl::AsyncWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_threadMutex);
+    while (m_running) {
+        m_condition.wait_for(lock, std::chrono::milliseconds(50));
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
 bool SimpleLogger::Impl::m_echoMode = true;
 
-SimpleLogger::Level SimpleLogger::Impl::m_level = SimpleLogger::Level::Info;
+std::atomic<bool> SimpleLogger::Impl::m_asyncMode { false };
+
+std::atomic<SimpleLogger::Level> SimpleLogger::Impl::m_level { SimpleLogger::Level::Info };
 
 SimpleLogger::TimestampMode SimpleLogger::Impl::m_timestampMode = SimpleLogger::TimestampMode::DateTime;
 
@@ -132,35 +338,39 @@ std::string SimpleLogger::Impl::m_customTimestampFormat;
 std::ofstream SimpleLogger::Impl::m_fileStream;
 
 // Default level symbols
-SimpleLogger::Impl::SymbolMap SimpleLogger::Impl::m_symbols = {
-    { SimpleLogger::Level::Trace, "T:" },
-    { SimpleLogger::Level::Debug, "D:" },
-    { SimpleLogger::Level::Info, "I:" },
-    { SimpleLogger::Level::Warning, "W:" },
-    { SimpleLogger::Level::Error, "E:" },
-    { SimpleLogger::Level::Fatal, "F:" }
+SimpleLogger::Impl::SymbolArray SimpleLogger::Impl::m_symbols = {
+    "T:", // Trace
+    "D:", // Debug
+    "I:", // Info
+    "W:", // Warning
+    "E:", // Error
+    "F:", // Fatal
+    "" // None
 };
 
 // Default streams
-SimpleLogger::Impl::StreamMap SimpleLogger::Impl::m_streams = {
-    { SimpleLogger::Level::Trace, &std::cout },
-    { SimpleLogger::Level::Debug, &std::cout },
-    { SimpleLogger::Level::Info, &std::cout },
-    { SimpleLogger::Level::Warning, &std::cerr },
-    { SimpleLogger::Level::Error, &std::cerr },
-    { SimpleLogger::Level::Fatal, &std::cerr }
+SimpleLogger::Impl::StreamArray SimpleLogger::Impl::m_streams = {
+    &std::cout, // Trace
+    &std::cout, // Debug
+    &std::cout, // Info
+    &std::cerr, // Warning
+    &std::cerr, // Error
+    &std::cerr, // Fatal
+    nullptr // None
 };
 
-std::recursive_mutex SimpleLogger::Impl::m_mutex;
+std::mutex SimpleLogger::Impl::m_writeMutex;
 
-SimpleLogger::Impl::Impl()
-  : m_lock(m_mutex)
-{
-}
+std::time_t SimpleLogger::Impl::m_cachedTime = 0;
+
+std::string SimpleLogger::Impl::m_cachedFormat;
+
+std::string SimpleLogger::Impl::m_cachedDateTime;
+
+SimpleLogger::Impl::Impl() = default;
 
 SimpleLogger::Impl::Impl(const std::string & tag)
-  : m_lock(m_mutex)
-  , m_tag(tag)
+  : m_tag(tag)
 {
 }
 
@@ -169,22 +379,68 @@ SimpleLogger::Impl::~Impl()
     flush();
 }
 
+SimpleLogger::Impl::AsyncWriter & SimpleLogger::Impl::asyncWriter()
+{
+    // Destroyed before the streams, so the pending records are written on exit
+    static AsyncWriter asyncWriter;
+    return asyncWriter;
+}
+
+size_t SimpleLogger::Impl::index(SimpleLogger::Level level)
+{
+    return static_cast<size_t>(level);
+}
+
 void SimpleLogger::Impl::enableEchoMode(bool enable)
 {
     m_echoMode = enable;
 }
 
+void SimpleLogger::Impl::enableAsyncMode(bool enable)
+{
+    if (enable) {
+        asyncWriter().start();
+        m_asyncMode = true;
+    } else if (m_asyncMode) {
+        m_asyncMode = false;
+        asyncWriter().stop();
+    }
+}
+
+void SimpleLogger::Impl::flushAsync()
+{
+    if (m_asyncMode) {
+        asyncWriter().flush();
+    }
+}
+
+std::ostringstream & SimpleLogger::Impl::disabledStream()
+{
+    // All insertions to a failed stream are no-ops, so nothing gets formatted
+    thread_local std::ostringstream stream;
+    stream.setstate(std::ios::badbit);
+    return stream;
+}
+
 std::ostringstream & SimpleLogger::Impl::prepareStreamForLoggingLevel(SimpleLogger::Level level)
 {
     m_activeLevel = level;
-    prefixWithTimestamp();
-    prefixWithLevelAndTag(level);
-    return m_message;
+    if (level < m_level) {
+        return disabledStream();
+    }
+
+    // The timestamp and the prefixes are formatted when writing
+    if (!m_message) {
+        m_time = Clock::now();
+        m_message.emplace();
+    }
+
+    return *m_message;
 }
 
 void SimpleLogger::Impl::setLevelSymbol(Level level, std::string symbol)
 {
-    m_symbols[level] = symbol;
+    m_symbols[index(level)] = symbol;
 }
 
 void SimpleLogger::Impl::setLoggingLevel(SimpleLogger::Level level)
@@ -207,26 +463,25 @@ void SimpleLogger::Impl::setTimestampSeparator(std::string separator)
     m_timestampSeparator = separator;
 }
 
-std::string SimpleLogger::Impl::currentDateTime(std::chrono::time_point<std::chrono::system_clock> now, const std::string & dateTimeFormat) const
+std::string SimpleLogger::Impl::currentDateTime(Clock::time_point now, const std::string & dateTimeFormat)
 {
-    std::ostringstream oss;
-    const auto rawTime = std::chrono::system_clock::to_time_t(now);
-    oss << std::put_time(std::localtime(&rawTime), dateTimeFormat.c_str());
-
-    return oss.str();
-}
+    const auto rawTime = Clock::to_time_t(now);
+    if (rawTime != m_cachedTime || dateTimeFormat != m_cachedFormat) {
+        std::ostringstream oss;
+        oss << std::put_time(std::localtime(&rawTime), dateTimeFormat.c_str());
+        m_cachedTime = rawTime;
+        m_cachedFormat = dateTimeFormat;
+        m_cachedDateTime = oss.str();
+    }
 
-void SimpleLogger::Impl::prefixWithLevelAndTag(SimpleLogger::Level level)
-{
-    m_message << m_symbols[level] << (!m_tag.empty() ? " " + m_tag + ":" : "") << " ";
+    return m_cachedDateTime;
 }
 
-static std::string isoDateTimeMilliseconds()
+static std::string isoDateTimeMilliseconds(std::chrono::system_clock::time_point now)
 {
     using std::chrono::duration_cast;
     using std::chrono::system_clock;
 
-    const auto now = system_clock::now();
     const auto nowMs = duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000; // Milliseconds part
     const auto timeTNow = system_clock::to_time_t(now); // Convert to time_t for strftime
 
@@ -241,75 +496,95 @@ static std::string isoDateTimeMilliseconds()
     return oss.str();
 }
 
-void SimpleLogger::Impl::prefixWithTimestamp()
+std::string SimpleLogger::Impl::timestamp(Clock::time_point now)
 {
-    std::string timestamp;
-
     using std::chrono::duration_cast;
-    using std::chrono::system_clock;
 
     switch (m_timestampMode) {
     case SimpleLogger::TimestampMode::None:
         break;
-    case SimpleLogger::TimestampMode::DateTime: {
-        timestamp = currentDateTime(system_clock::now(), "%a %b %e %H:%M:%S %Y");
-    } break;
-    case SimpleLogger::TimestampMode::ISODateTime: {
-        timestamp = currentDateTime(system_clock::now(), "%Y-%m-%dT%H:%M:%S");
-    } break;
-    case SimpleLogger::TimestampMode::ISODateTimeMilliseconds: {
-        timestamp = isoDateTimeMilliseconds();
-    } break;
+    case SimpleLogger::TimestampMode::DateTime:
+        return currentDateTime(now, "%a %b %e %H:%M:%S %Y");
+    case SimpleLogger::TimestampMode::ISODateTime:
+        return currentDateTime(now, "%Y-%m-%dT%H:%M:%S");
+    case SimpleLogger::TimestampMode::ISODateTimeMilliseconds:
+        return isoDateTimeMilliseconds(now);
     case SimpleLogger::TimestampMode::EpochSeconds:
-        timestamp = std::to_string(duration_cast<std::chrono::seconds>(system_clock::now().time_since_epoch()).count());
-        break;
+        return std::to_string(duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
     case SimpleLogger::TimestampMode::EpochMilliseconds:
-        using std::chrono::duration_cast;
-        timestamp = std::to_string(duration_cast<std::chrono::milliseconds>(system_clock::now().time_since_epoch()).count());
-        break;
+        return std::to_string(duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
     case SimpleLogger::TimestampMode::EpochMicroseconds:
-        using std::chrono::duration_cast;
-        timestamp = std::to_string(duration_cast<std::chrono::microseconds>(system_clock::now().time_since_epoch()).count());
-        break;
+        return std::to_string(duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count());
     case SimpleLogger::TimestampMode::Custom:
-        timestamp = currentDateTime(system_clock::now(), m_customTimestampFormat);
-        break;
+        return currentDateTime(now, m_customTimestampFormat);
     }
 
-    if (!timestamp.empty()) {
-        m_message << timestamp << m_timestampSeparator;
-    }
+    return {};
 }
 
-bool SimpleLogger::Impl::shouldFlush() const
+void SimpleLogger::Impl::write(const Record & record)
 {
-    return m_activeLevel >= m_level && !m_message.str().empty();
+    std::string line = timestamp(record.time);
+    if (!line.empty()) {
+        line += m_timestampSeparator;
+    }
+
+    line += m_symbols[index(record.level)];
+    if (!record.tag.empty()) {
+        line += " " + record.tag + ":";
+    }
+
+    line += " ";
+    line += record.message;
+    line += '\n';
+
+    if (m_fileStream.is_open()) {
+        m_fileStream << line;
+    }
+
+    if (m_echoMode) {
+        if (auto && stream = m_streams[index(record.level)]; stream) {
+            *stream << line;
+        }
+    }
 }
 
-void SimpleLogger::Impl::flushFileIfOpen()
+void SimpleLogger::Impl::flushStreams(uint32_t levelMask)
 {
     if (m_fileStream.is_open()) {
-        m_fileStream << m_message.str() << std::endl;
         m_fileStream.flush();
     }
-}
 
-void SimpleLogger::Impl::flushEchoIfEnabled()
-{
+    // Only the streams that were written to are guaranteed to be alive
     if (m_echoMode) {
-        if (auto && stream = m_streams[m_activeLevel]; stream) {
-            *stream << m_message.str() << std::endl;
-            stream->flush();
+        for (size_t i = 0; i < m_streams.size(); i++) {
+            if (m_streams[i] && levelMask & (1u << i)) {
+                m_streams[i]->flush();
+            }
         }
     }
 }
 
 void SimpleLogger::Impl::flush()
 {
-    if (shouldFlush()) {
-        flushFileIfOpen();
-        flushEchoIfEnabled();
+    if (!m_message || m_activeLevel < m_level) {
+        return;
+    }
+
+    Record record { m_activeLevel, m_time, std::move(m_tag), m_message->str() };
+    if (m_asyncMode) {
+        if (record.level != SimpleLogger::Level::Fatal) {
+            asyncWriter().push(std::move(record));
+            return;
+        }
+
+        // Write the pending records first, so that nothing is lost if the process is about to abort
+        asyncWriter().flush();
     }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    write(record);
+    flushStreams(1u << index(record.level));
 }
 
 void SimpleLogger::Impl::initialize(std::string filename, bool append)
@@ -354,7 +629,7 @@ std::ostringstream & SimpleLogger::Impl::fatalStream()
 
 void SimpleLogger::Impl::setStream(Level level, std::ostream & stream)
 {
-    m_streams[level] = &stream;
+    m_streams[index(level)] = &stream;
 }
 
 SimpleLogger::SimpleLogger()
@@ -377,6 +652,16 @@ void SimpleLogger::enableEchoMode(bool enable)
     Impl::enableEchoMode(enable);
 }
 
+void SimpleLogger::enableAsyncMode(bool enable)
+{
+    Impl::enableAsyncMode(enable);
+}
+
+void SimpleLogger::flush()
+{
+    Impl::flushAsync();
+}
+
 void SimpleLogger::setLoggingLevel(Level level)
 {
     Impl::setLoggingLevel(level);
@@ -440,7 +725,7 @@ std::ostringstream & SimpleLogger::fatal()
 
 std::string SimpleLogger::version()
 {
-    return "2.0.0";
+    return "2.1.0";
 }
 
 SimpleLogger::~SimpleLogger() = default;
@@ -88,6 +88,15 @@ public:
     //! \param enable Echo everything if true. Default is false.
     static void enableEchoMode(bool enable);
 
+    //! Enable/disable asynchronous mode. The messages are queued into per-thread buffers and
+    //! a background thread formats and writes them. Fatal messages are still written immediately.
+    //! Configure the logger before enabling. Disabling writes the pending messages.
+    //! \param enable Write asynchronously if true. Default is false.
+    static void enableAsyncMode(bool enable);
+
+    //! Write the pending messages of the asynchronous mode now.
+    static void flush();
+
     //! Set the logging level.
     //! \param level The minimum level. Default is Info.
     static void setLoggingLevel(Level level);
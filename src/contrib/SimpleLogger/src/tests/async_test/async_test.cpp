@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2020 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::AsyncTest {
+
+std::vector<std::string> lines(const std::stringstream & stream)
+{
+    std::vector<std::string> result;
+    std::istringstream input(stream.str());
+    std::string line;
+    while (std::getline(input, line)) {
+        result.push_back(line);
+    }
+
+    return result;
+}
+
+void testAsync_flush_shouldWriteAllMessagesInOrder()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Info, ss);
+    L::enableAsyncMode(true);
+
+    for (int i = 0; i < 1000; i++) {
+        L().info() << "Message " << i;
+    }
+
+    L::flush();
+
+    const auto result = lines(ss);
+    assert(result.size() == 1000);
+    for (int i = 0; i < 1000; i++) {
+        assert(result[i].find("I: Message " + std::to_string(i)) != std::string::npos);
+    }
+
+    L::enableAsyncMode(false);
+}
+
+void testAsync_multipleThreads_shouldKeepOrderOfEachThread()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Info, ss);
+    L::enableAsyncMode(true);
+
+    const int threadCount = 4;
+    const int messageCount = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([=] {
+            for (int i = 0; i < messageCount; i++) {
+                L("T" + std::to_string(t)).info() << i;
+            }
+        });
+    }
+
+    for (auto && thread : threads) {
+        thread.join();
+    }
+
+    L::enableAsyncMode(false);
+
+    std::vector<int> next(threadCount, 0);
+    for (auto && line : lines(ss)) {
+        const auto tag = line.find(" T");
+        assert(tag != std::string::npos);
+        const int t = std::stoi(line.substr(tag + 2));
+        const int i = std::stoi(line.substr(line.find(": ", tag) + 2));
+        assert(i == next[t]);
+        next[t]++;
+    }
+
+    for (auto && count : next) {
+        assert(count == messageCount);
+    }
+}
+
+void testAsync_fatal_shouldBeWrittenImmediatelyAfterPendingMessages()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Info, ss);
+    L::setStream(L::Level::Fatal, ss);
+    L::enableAsyncMode(true);
+
+    L().info() << "Pending";
+    L().fatal() << "Fatal";
+
+    const auto result = lines(ss);
+    assert(result.size() == 2);
+    assert(result[0].find("Pending") != std::string::npos);
+    assert(result[1].find("Fatal") != std::string::npos);
+
+    L::enableAsyncMode(false);
+}
+
+void testAsync_disable_shouldWritePendingMessages()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Warning, ss);
+    L::enableAsyncMode(true);
+
+    L().warning() << "Pending";
+    L::enableAsyncMode(false);
+
+    assert(ss.str().find("Pending") != std::string::npos);
+}
+
+void testDisabledLevel_shouldNotFormatMessage()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Debug, ss);
+
+    // Nothing is inserted to the stream of a disabled level
+    std::ostringstream & stream = L().debug();
+    stream << "Not formatted " << 42;
+    assert(stream.str().empty());
+
+    L::enableAsyncMode(true);
+    L().debug() << "Not formatted";
+    L::enableAsyncMode(false);
+    assert(ss.str().empty());
+}
+
+void runTests()
+{
+    L::setLoggingLevel(L::Level::Info);
+    L::setTimestampMode(L::TimestampMode::EpochMicroseconds);
+
+    testAsync_flush_shouldWriteAllMessagesInOrder();
+
+    testAsync_multipleThreads_shouldKeepOrderOfEachThread();
+
+    testAsync_fatal_shouldBeWrittenImmediatelyAfterPendingMessages();
+
+    testAsync_disable_shouldWritePendingMessages();
+
+    testDisabledLevel_shouldNotFormatMessage();
+}
+
+} // namespace juzzlin::AsyncTest
+
+int main()
+{
+    juzzlin::AsyncTest::runTests();
+
+    return EXIT_SUCCESS;
+}
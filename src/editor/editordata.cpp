@@ -49,6 +49,8 @@ bool EditorData::loadTrackData(QString fileName)
 {
     m_undoStack.clear();
 
+    m_pendingUndoPoint.reset();
+
     clearScene();
 
     m_trackData = m_trackIO.open(fileName);
@@ -66,15 +68,13 @@ void EditorData::undo()
     {
         m_dadStore.clear();
 
+        m_pendingUndoPoint.reset();
+
         m_selectedObject = nullptr;
 
         m_selectedTargetNode = nullptr;
 
-        saveRedoPoint();
-
-        clearScene();
-
-        m_trackData = m_undoStack.undo();
+        m_undoStack.undo(*this, *m_trackData);
     }
 }
 
@@ -89,15 +89,13 @@ void EditorData::redo()
     {
         m_dadStore.clear();
 
+        m_pendingUndoPoint.reset();
+
         m_selectedObject = nullptr;
 
         m_selectedTargetNode = nullptr;
 
-        saveUndoPoint();
-
-        clearScene();
-
-        m_trackData = m_undoStack.redo();
+        m_undoStack.redo(*this, *m_trackData);
     }
 }
 
@@ -107,18 +105,34 @@ bool EditorData::saveTrackData()
     return m_trackIO.save(m_trackData, m_trackData->fileName());
 }
 
-void EditorData::saveUndoPoint()
+void EditorData::saveUndoPoint(UndoCommandPtr command, bool coalesce)
 {
     assert(m_trackData);
-    m_undoStack.pushUndoPoint(m_trackData);
+    m_undoStack.pushUndoPoint(std::move(command), coalesce);
 
     m_mediator.enableUndo(m_undoStack.isUndoable());
+    m_mediator.enableRedo(m_undoStack.isRedoable());
 }
 
-void EditorData::saveRedoPoint()
+void EditorData::beginUndoPoint(UndoCommandPtr command)
+{
+    m_pendingUndoPoint = std::move(command);
+}
+
+void EditorData::endUndoPoint()
+{
+    if (m_pendingUndoPoint && !m_pendingUndoPoint->isRedundant(*m_trackData))
+    {
+        saveUndoPoint(std::move(m_pendingUndoPoint));
+    }
+
+    m_pendingUndoPoint.reset();
+}
+
+void EditorData::execute(UndoCommandPtr command)
 {
     assert(m_trackData);
-    m_undoStack.pushRedoPoint(m_trackData);
+    saveUndoPoint(command->apply(*this, *m_trackData));
 }
 
 bool EditorData::saveTrackDataAs(QString fileName)
@@ -134,6 +148,10 @@ bool EditorData::saveTrackDataAs(QString fileName)
 
 void EditorData::setTrackData(TrackDataPtr trackData)
 {
+    m_undoStack.clear();
+
+    m_pendingUndoPoint.reset();
+
     clearScene();
 
     m_trackData = trackData;
@@ -225,6 +243,7 @@ void EditorData::removeRouteFromScene()
         m_mediator.removeItem(node->routeLine());
 
         delete node->routeLine();
+        node->setRouteLine(nullptr);
     }
 
     m_mediator.updateView();
@@ -296,6 +315,54 @@ void EditorData::addObjectsToScene()
     }
 }
 
+void EditorData::addTileToScene(TrackTileBasePtr trackTile)
+{
+    auto tile = dynamic_pointer_cast<TrackTile>(trackTile);
+    assert(tile);
+
+    tile->setPixmap(MainWindow::instance()->objectModelLoader().getPixmapByRole(tile->tileType()));
+
+    m_mediator.addItem(tile.get()); // The scene wants a raw pointer
+
+    tile->setAdded(true);
+}
+
+void EditorData::updateTileInScene(TrackTileBasePtr trackTile)
+{
+    auto tile = dynamic_pointer_cast<TrackTile>(trackTile);
+    assert(tile);
+
+    tile->setPixmap(MainWindow::instance()->objectModelLoader().getPixmapByRole(tile->tileType()));
+}
+
+void EditorData::addObjectToScene(ObjectBasePtr objectBase)
+{
+    auto object = dynamic_pointer_cast<Object>(objectBase);
+    assert(object);
+
+    m_mediator.addItem(object.get()); // The scene wants a raw pointer
+
+    object->setZValue(10);
+}
+
+void EditorData::removeObjectFromScene(ObjectBasePtr objectBase)
+{
+    auto object = dynamic_pointer_cast<Object>(objectBase);
+    assert(object);
+
+    m_mediator.removeItem(object.get()); // The scene wants a raw pointer
+
+    if (m_selectedObject == object.get())
+    {
+        m_selectedObject = nullptr;
+    }
+}
+
+void EditorData::updateSceneRect()
+{
+    m_mediator.updateSceneRect();
+}
+
 void EditorData::removeTileFromScene(TrackTileBasePtr trackTile)
 {
     TrackTile::setActiveTile(nullptr);
@@ -38,7 +38,7 @@ class QGraphicsLineItem;
 
 //! Editor data includes data and functionality related to the current
 //! race track and editing session.
-class EditorData
+class EditorData : public UndoScene
 {
 public:
     //! Constructor.
@@ -51,12 +51,12 @@ public:
 
     bool isUndoable() const;
 
-    //! Load track from undo point.
+    //! Undo the latest change.
     void undo();
 
     bool isRedoable() const;
 
-    //! Load track from redo point.
+    //! Redo the latest undone change.
     void redo();
 
     //! Save track data.
@@ -65,11 +65,19 @@ public:
     //! Sava track data to the given file.
     bool saveTrackDataAs(QString fileName);
 
-    //! Save undo point.
-    void saveUndoPoint();
+    /*! Save undo point that restores the state captured by the given command.
+     *  Set coalesce to merge consecutive changes of the same item into one undo point. */
+    void saveUndoPoint(UndoCommandPtr command, bool coalesce = false);
 
-    //! Save redo point.
-    void saveRedoPoint();
+    /*! Begin an undo point for a drag'n'drop. The command is saved by endUndoPoint()
+     *  only if the dragged item was actually changed. */
+    void beginUndoPoint(UndoCommandPtr command);
+
+    //! End the undo point begun by beginUndoPoint().
+    void endUndoPoint();
+
+    //! Apply the given command and save its inverse as an undo point.
+    void execute(UndoCommandPtr command);
 
     //! Set track data as the given data.
     void setTrackData(TrackDataPtr newTrackData);
@@ -82,16 +90,30 @@ public:
     void beginSetRoute();
 
     //! Adds current target node objects to the scene.
-    void addExistingRouteToScene();
+    void addExistingRouteToScene() override;
 
     //! Push a new target node.
     void pushNewTargetNodeToRoute(QPointF pos);
 
     //! Removes target node and line objects from the scene.
-    void removeRouteFromScene();
+    void removeRouteFromScene() override;
+
+    //! Adds given tile to the scene.
+    void addTileToScene(TrackTileBasePtr trackTile) override;
 
     //! Removes given tile from the scene.
-    void removeTileFromScene(TrackTileBasePtr trackTile);
+    void removeTileFromScene(TrackTileBasePtr trackTile) override;
+
+    //! Updates the pixmap of given tile.
+    void updateTileInScene(TrackTileBasePtr trackTile) override;
+
+    //! Adds given object to the scene.
+    void addObjectToScene(ObjectBasePtr object) override;
+
+    //! Removes given object from the scene.
+    void removeObjectFromScene(ObjectBasePtr object) override;
+
+    void updateSceneRect() override;
 
     //! Returns current track data object. Returns NULL if not set.
     TrackDataPtr trackData();
@@ -151,6 +173,8 @@ private:
 
     UndoStack m_undoStack;
 
+    UndoCommandPtr m_pendingUndoPoint;
+
     Object * m_selectedObject = nullptr;
 
     TargetNode * m_selectedTargetNode = nullptr;
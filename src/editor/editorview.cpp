@@ -99,7 +99,7 @@ void EditorView::createTileContextMenuActions()
         if (TrackTile * tile =
               dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
         {
-            m_mediator.saveUndoPoint();
+            m_mediator.saveUndoPoint({ tile });
             tile->rotate90CW();
         }
     });
@@ -111,28 +111,25 @@ void EditorView::createTileContextMenuActions()
         if (auto tile =
               dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
         {
-            m_mediator.saveUndoPoint();
+            m_mediator.saveUndoPoint({ tile });
             tile->rotate90CCW();
         }
     });
 
     m_clearComputerHint = new QAction(QWidget::tr("Clear computer hint"), &m_tileContextMenu);
     QObject::connect(m_clearComputerHint, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         setComputerHint(TrackTileBase::ComputerHint::None);
     });
 
     m_setComputerHintBrakeHard = new QAction(
       QWidget::tr("Set computer hint 'brake hard'.."), &m_tileContextMenu);
     QObject::connect(m_setComputerHintBrakeHard, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         setComputerHint(TrackTileBase::ComputerHint::BrakeHard);
     });
 
     m_setComputerHintBrake = new QAction(
       QWidget::tr("Set computer hint 'brake'.."), &m_tileContextMenu);
     QObject::connect(m_setComputerHintBrake, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         setComputerHint(TrackTileBase::ComputerHint::Brake);
     });
 
@@ -140,9 +137,10 @@ void EditorView::createTileContextMenuActions()
       QWidget::tr("Exclude from minimap"), &m_tileContextMenu);
     m_excludeFromMinimap->setCheckable(true);
     QObject::connect(m_excludeFromMinimap, &QAction::changed, [this]() {
-        if (auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(this->m_clickedPos), QTransform())))
+        auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(this->m_clickedPos), QTransform()));
+        if (tile && tile->excludeFromMinimap() != this->m_excludeFromMinimap->isChecked())
         {
-            m_mediator.saveUndoPoint();
+            m_mediator.saveUndoPoint({ tile });
             tile->setExcludeFromMinimap(this->m_excludeFromMinimap->isChecked());
         }
     });
@@ -150,54 +148,42 @@ void EditorView::createTileContextMenuActions()
     auto insertRowBefore = new QAction(
       QWidget::tr("Insert row before.."), &m_tileContextMenu);
     QObject::connect(insertRowBefore, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.insertRowBefore();
-        updateSceneRect();
         update();
     });
 
     auto insertRowAfter = new QAction(
       QWidget::tr("Insert row after.."), &m_tileContextMenu);
     QObject::connect(insertRowAfter, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.insertRowAfter();
-        updateSceneRect();
         update();
     });
 
     m_deleteRow = new QAction(
       QWidget::tr("Delete row.."), &m_tileContextMenu);
     QObject::connect(m_deleteRow, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.deleteRow();
-        updateSceneRect();
         update();
     });
 
     auto insertColBefore = new QAction(
       QWidget::tr("Insert column before.."), &m_tileContextMenu);
     QObject::connect(insertColBefore, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.insertColumnBefore();
-        updateSceneRect();
         update();
     });
 
     auto insertColAfter = new QAction(
       QWidget::tr("Insert column after.."), &m_tileContextMenu);
     QObject::connect(insertColAfter, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.insertColumnAfter();
-        updateSceneRect();
         update();
     });
 
     m_deleteCol = new QAction(
       QWidget::tr("Delete column.."), &m_tileContextMenu);
     QObject::connect(m_deleteCol, &QAction::triggered, [this]() {
-        m_mediator.saveUndoPoint();
         m_mediator.deleteColumn();
-        updateSceneRect();
         update();
     });
 
@@ -230,7 +216,7 @@ void EditorView::createObjectContextMenuActions()
         {
             if (auto object = m_mediator.selectedObject())
             {
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*object);
 
                 object->setRotation(static_cast<int>(dialog.angle() + object->rotation()) % 360);
             }
@@ -241,9 +227,10 @@ void EditorView::createObjectContextMenuActions()
     m_forceStationaryAction = new QAction(dummy2, &m_tileContextMenu);
     m_forceStationaryAction->setCheckable(true);
     QObject::connect(m_forceStationaryAction, &QAction::changed, [this]() {
-        if (auto object = m_mediator.selectedObject())
+        auto object = m_mediator.selectedObject();
+        if (object && object->forceStationary() != m_forceStationaryAction->isChecked())
         {
-            m_mediator.saveUndoPoint();
+            m_mediator.saveUndoPoint(*object);
             object->setForceStationary(m_forceStationaryAction->isChecked());
         }
     });
@@ -264,7 +251,7 @@ void EditorView::createTargetNodeContextMenuActions()
             TargetNodeSizeDlg dialog(tnode->size());
             if (dialog.exec() == QDialog::Accepted)
             {
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*tnode);
 
                 tnode->setSize(dialog.targetNodeSize());
             }
@@ -318,8 +305,6 @@ void EditorView::mousePressEvent(QMouseEvent * event)
 
 void EditorView::eraseObjectAtCurrentClickedPos()
 {
-    m_mediator.saveUndoPoint();
-
     // Fetch all items at the location
     QList<QGraphicsItem *> items = scene()->items(
       m_clickedScenePos, Qt::IntersectsItemShape, Qt::DescendingOrder);
@@ -330,6 +315,7 @@ void EditorView::eraseObjectAtCurrentClickedPos()
     {
         if (auto object = dynamic_cast<Object *>(item))
         {
+            m_mediator.saveUndoPoint(*object);
             m_mediator.removeObject(*object);
             m_mediator.setSelectedObject(nullptr);
             break;
@@ -421,7 +407,7 @@ void EditorView::handleLeftButtonClickOnObject(Object & object)
     // User is initiating a drag'n'drop
     if (m_mediator.mode() == EditorMode::None)
     {
-        m_mediator.saveUndoPoint();
+        m_mediator.beginUndoPoint(object);
 
         object.setZValue(object.zValue() + 1);
         m_mediator.dadStore().setDragAndDropObject(&object);
@@ -437,7 +423,7 @@ void EditorView::handleLeftButtonClickOnTargetNode(TargetNode & tnode)
     // User is initiating a drag'n'drop
     if (m_mediator.mode() == EditorMode::None)
     {
-        m_mediator.saveUndoPoint();
+        m_mediator.beginUndoPoint(tnode);
 
         tnode.setZValue(tnode.zValue() + 1);
         m_mediator.dadStore().setDragAndDropTargetNode(&tnode);
@@ -568,19 +554,19 @@ void EditorView::keyPressEvent(QKeyEvent * event)
             switch (event->key())
             {
             case Qt::Key_Left:
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*object, true);
                 object->setLocation(QPointF(object->location().x() - 1, object->location().y()));
                 break;
             case Qt::Key_Right:
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*object, true);
                 object->setLocation(QPointF(object->location().x() + 1, object->location().y()));
                 break;
             case Qt::Key_Up:
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*object, true);
                 object->setLocation(QPointF(object->location().x(), object->location().y() - 1));
                 break;
             case Qt::Key_Down:
-                m_mediator.saveUndoPoint();
+                m_mediator.saveUndoPoint(*object, true);
                 object->setLocation(QPointF(object->location().x(), object->location().y() + 1));
                 break;
             default:
@@ -609,7 +595,11 @@ void EditorView::handleTileDragRelease(QMouseEvent * event)
         }
 
         // Swap tiles
-        sourceTile->swap(*destTile);
+        if (destTile != sourceTile)
+        {
+            m_mediator.saveUndoPoint({ sourceTile, destTile });
+            sourceTile->swap(*destTile);
+        }
 
         // Restore position
         sourceTile->setPos(m_mediator.dadStore().dragAndDropSourcePos());
@@ -634,6 +624,8 @@ void EditorView::handleObjectDragRelease(QMouseEvent * event)
         object->setLocation(mapToScene(event->pos()));
         object->setZValue(object->zValue() - 1);
 
+        m_mediator.endUndoPoint();
+
         update();
 
         m_mediator.dadStore().clear();
@@ -652,6 +644,8 @@ void EditorView::handleTargetNodeDragRelease(QMouseEvent * event)
         tnode->setLocation(mapToScene(event->pos()));
         tnode->setZValue(tnode->zValue() - 1);
 
+        m_mediator.endUndoPoint();
+
         update();
 
         m_mediator.dadStore().clear();
@@ -665,14 +659,14 @@ void EditorView::setComputerHint(TrackTileBase::ComputerHint hint)
 {
     if (auto tile = dynamic_cast<TrackTile *>(scene()->itemAt(mapToScene(m_clickedPos), QTransform())))
     {
-        m_mediator.saveUndoPoint();
+        m_mediator.saveUndoPoint({ tile });
         tile->setComputerHint(hint);
     }
 }
 
 void EditorView::changeTileType(TrackTile & tile, QAction * action)
 {
-    m_mediator.saveUndoPoint();
+    m_mediator.saveUndoPoint({ &tile });
     setTileType(tile, action);
 }
 
@@ -598,6 +598,11 @@ void MainWindow::enableUndo(bool enable)
     m_undoAction->setEnabled(enable);
 }
 
+void MainWindow::enableRedo(bool enable)
+{
+    m_redoAction->setEnabled(enable);
+}
+
 void MainWindow::endSetRoute()
 {
     m_mediator->endSetRoute();
@@ -700,8 +705,6 @@ void MainWindow::setupTrackAfterUndoOrRedo()
 
     setActionStatesOnNewTrack();
 
-    m_mediator->setupTrackAfterUndoOrRedo();
-
     m_clearRouteAction->setEnabled(m_mediator->routeHasNodes());
 }
 
@@ -75,6 +75,8 @@ public slots:
 
     void enableUndo(bool enable);
 
+    void enableRedo(bool enable);
+
     //! End marking the route.
     void endSetRoute();
 
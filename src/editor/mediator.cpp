@@ -26,6 +26,7 @@
 #include "trackdata.hpp"
 #include "trackpropertiesdialog.hpp"
 #include "tracktile.hpp"
+#include "undocommand.hpp"
 
 #include <cassert>
 
@@ -48,8 +49,6 @@ void Mediator::addCurrentToolBarObjectToScene(QPointF clickedScenePos)
 {
     if (const auto action = MainWindow::instance()->currentToolBarAction())
     {
-        saveUndoPoint();
-
         const auto object = std::make_shared<Object>(ObjectFactory::createObject(action->data().toString()));
         object->setLocation(clickedScenePos);
 
@@ -58,6 +57,9 @@ void Mediator::addCurrentToolBarObjectToScene(QPointF clickedScenePos)
             object->setRotation(std::rand() % 360);
         }
 
+        // Not yet in the track, so undo removes the object
+        m_editorData->saveUndoPoint(std::make_unique<ObjectCommand>(object, m_editorData->trackData()->objects()));
+
         addObject(object);
         setSelectedObject(object.get());
     }
@@ -85,10 +87,9 @@ bool Mediator::beginSetRoute()
 
     assert(m_editorData);
 
-    m_editorData->saveUndoPoint();
-
     if (m_editorData->canRouteBeSet())
     {
+        m_editorData->saveUndoPoint(std::make_unique<RouteCommand>(m_editorData->trackData()->route()));
         m_editorData->beginSetRoute();
 
         return true;
@@ -119,27 +120,25 @@ DragAndDropStore & Mediator::dadStore()
 
 void Mediator::deleteColumn()
 {
-    auto deleted = m_editorData->trackData()->deleteColumn(m_editorData->activeColumn());
-    for (auto && tile : deleted)
-    {
-        m_editorData->removeTileFromScene(tile);
-    }
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Column, RowColumnCommand::Action::Delete, m_editorData->activeColumn()));
 }
 
 void Mediator::deleteRow()
 {
-    auto deleted = m_editorData->trackData()->deleteRow(m_editorData->activeRow());
-    for (auto && tile : deleted)
-    {
-        m_editorData->removeTileFromScene(tile);
-    }
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Row, RowColumnCommand::Action::Delete, m_editorData->activeRow()));
 }
 
 void Mediator::floodFill(TrackTile & tile, QAction * action, const QString & typeToFill)
 {
-    saveUndoPoint();
+    auto && map = m_editorData->trackData()->map();
+
+    // The filled area is not known beforehand, so capture all tiles and keep only the changed ones
+    auto command = std::make_unique<TileCommand>(map);
 
-    FloodFill::floodFill(tile, action, typeToFill, m_editorData->trackData()->map());
+    FloodFill::floodFill(tile, action, typeToFill, map);
+
+    command->removeUnchanged(map);
+    m_editorData->saveUndoPoint(std::move(command));
 }
 
 void Mediator::endSetRoute()
@@ -152,6 +151,11 @@ void Mediator::enableUndo(bool enable)
     m_mainWindow.enableUndo(enable);
 }
 
+void Mediator::enableRedo(bool enable)
+{
+    m_mainWindow.enableRedo(enable);
+}
+
 int Mediator::fitScale()
 {
     m_editorView->centerOn(m_editorView->sceneRect().center());
@@ -185,26 +189,22 @@ std::tuple<bool, QString, int, int> Mediator::initializeNewTrack()
 
 void Mediator::insertColumnAfter()
 {
-    m_editorData->trackData()->insertColumn(m_editorData->activeColumn(), MapBase::InsertDirection::After);
-    m_editorData->addTilesToScene();
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Column, RowColumnCommand::Action::Insert, m_editorData->activeColumn() + 1));
 }
 
 void Mediator::insertColumnBefore()
 {
-    m_editorData->trackData()->insertColumn(m_editorData->activeColumn(), MapBase::InsertDirection::Before);
-    m_editorData->addTilesToScene();
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Column, RowColumnCommand::Action::Insert, m_editorData->activeColumn()));
 }
 
 void Mediator::insertRowAfter()
 {
-    m_editorData->trackData()->insertRow(m_editorData->activeRow(), MapBase::InsertDirection::After);
-    m_editorData->addTilesToScene();
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Row, RowColumnCommand::Action::Insert, m_editorData->activeRow() + 1));
 }
 
 void Mediator::insertRowBefore()
 {
-    m_editorData->trackData()->insertRow(m_editorData->activeRow(), MapBase::InsertDirection::Before);
-    m_editorData->addTilesToScene();
+    m_editorData->execute(std::make_unique<RowColumnCommand>(RowColumnCommand::Line::Row, RowColumnCommand::Action::Insert, m_editorData->activeRow()));
 }
 
 void Mediator::initScene()
@@ -229,7 +229,7 @@ void Mediator::clearRoute()
 {
     assert(m_editorData);
 
-    m_editorData->saveUndoPoint();
+    m_editorData->saveUndoPoint(std::make_unique<RouteCommand>(m_editorData->trackData()->route()));
     m_editorData->clearRoute();
 }
 
@@ -309,6 +309,7 @@ void Mediator::mouseWheelZoom(int delta)
 
 void Mediator::pushNewTargetNodeToRoute(QPointF pos)
 {
+    m_editorData->saveUndoPoint(std::make_unique<RouteCommand>(m_editorData->trackData()->route()));
     m_editorData->pushNewTargetNodeToRoute(pos);
 }
 
@@ -333,9 +334,34 @@ bool Mediator::routeHasNodes() const
     return m_editorData->trackData()->route().numNodes();
 }
 
-void Mediator::saveUndoPoint()
+void Mediator::saveUndoPoint(const std::vector<TrackTile *> & tiles)
+{
+    m_editorData->saveUndoPoint(std::make_unique<TileCommand>(tiles));
+}
+
+void Mediator::saveUndoPoint(Object & object, bool coalesce)
+{
+    m_editorData->saveUndoPoint(std::make_unique<ObjectCommand>(object, m_editorData->trackData()->objects()), coalesce);
+}
+
+void Mediator::saveUndoPoint(TargetNode & tnode)
+{
+    m_editorData->saveUndoPoint(std::make_unique<TargetNodeCommand>(tnode, m_editorData->trackData()->route()));
+}
+
+void Mediator::beginUndoPoint(Object & object)
+{
+    m_editorData->beginUndoPoint(std::make_unique<ObjectCommand>(object, m_editorData->trackData()->objects()));
+}
+
+void Mediator::beginUndoPoint(TargetNode & tnode)
 {
-    m_editorData->saveUndoPoint();
+    m_editorData->beginUndoPoint(std::make_unique<TargetNodeCommand>(tnode, m_editorData->trackData()->route()));
+}
+
+void Mediator::endUndoPoint()
+{
+    m_editorData->endUndoPoint();
 }
 
 bool Mediator::saveTrackData()
@@ -419,19 +445,6 @@ void Mediator::showStatusBarMessage(QString message)
     m_mainWindow.statusBar()->showMessage(message);
 }
 
-void Mediator::setupTrackAfterUndoOrRedo()
-{
-    delete m_editorScene;
-    m_editorScene = new QGraphicsScene;
-
-    m_editorView->setScene(m_editorScene);
-    m_editorView->updateSceneRect();
-
-    m_editorData->addTilesToScene();
-    m_editorData->addObjectsToScene();
-    m_editorData->addExistingRouteToScene();
-}
-
 void Mediator::undo()
 {
     m_editorData->undo();
@@ -461,6 +474,11 @@ void Mediator::updateCoordinates(QPointF mappedPos)
     }
 }
 
+void Mediator::updateSceneRect()
+{
+    m_editorView->updateSceneRect();
+}
+
 void Mediator::updateView()
 {
     m_editorView->update();
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <tuple>
+#include <vector>
 
 class DragAndDropStore;
 class EditorData;
@@ -78,6 +79,8 @@ public:
 
     void enableUndo(bool enable);
 
+    void enableRedo(bool enable);
+
     void floodFill(TrackTile & tile, QAction * action, const QString & typeToFill);
 
     int fitScale();
@@ -114,7 +117,17 @@ public:
 
     int rows();
 
-    void saveUndoPoint();
+    void saveUndoPoint(const std::vector<TrackTile *> & tiles);
+
+    void saveUndoPoint(Object & object, bool coalesce = false);
+
+    void saveUndoPoint(TargetNode & tnode);
+
+    void beginUndoPoint(Object & object);
+
+    void beginUndoPoint(TargetNode & tnode);
+
+    void endUndoPoint();
 
     bool saveTrackData();
 
@@ -135,12 +148,12 @@ public:
 
     void showStatusBarMessage(QString message);
 
-    void setupTrackAfterUndoOrRedo();
-
     void undo();
 
     void updateCoordinates(QPointF mappedPos);
 
+    void updateSceneRect();
+
     void updateView();
 
 private:
@@ -48,8 +48,11 @@ TargetNode::TargetNode(const TargetNode & other)
 void TargetNode::setRouteLine(QGraphicsLineItem * routeLine)
 {
     m_routeLine = routeLine;
-    m_routeLine->setPen(
-      QPen(QBrush(ROUTE_LINE_COLOR), LINE_WIDTH, Qt::DashDotDotLine, Qt::RoundCap));
+    if (m_routeLine)
+    {
+        m_routeLine->setPen(
+          QPen(QBrush(ROUTE_LINE_COLOR), LINE_WIDTH, Qt::DashDotDotLine, Qt::RoundCap));
+    }
 }
 
 QGraphicsLineItem * TargetNode::routeLine() const
@@ -33,66 +33,56 @@
 #include "../common/datakeywords.hpp"
 #include "../common/objectbase.hpp"
 #include "../common/targetnodebase.hpp"
+#include "../common/trackfilereader.hpp"
 
 #include <cassert>
 #include <memory>
 
 namespace {
 
-void readTile(TrackData & newData, const QDomElement & element)
+void readTile(TrackData & newData, const TrackFileReader & reader, const TrackFileReader::Tile & tileData)
 {
     // Init a new tile. QGraphicsScene will take
     // the ownership eventually.
-    const auto tile = std::dynamic_pointer_cast<TrackTile>(newData.map().getTile(
-      element.attribute(DataKeywords::Tile::i, "0").toUInt(),
-      element.attribute(DataKeywords::Tile::j, "0").toUInt()));
+    const auto tile = std::dynamic_pointer_cast<TrackTile>(newData.map().getTile(tileData.i, tileData.j));
     assert(tile);
 
-    tile->setRotation(element.attribute(DataKeywords::Tile::orientation, "0").toInt());
+    tile->setRotation(tileData.orientation);
 
-    tile->setTileType(element.attribute(DataKeywords::Tile::type, "clear"));
+    tile->setTileType(reader.tileTypes().at(tileData.typeIndex));
 
-    tile->setComputerHint(
-      static_cast<TrackTileBase::ComputerHint>(element.attribute(DataKeywords::Tile::computerHint, "0").toInt()));
+    tile->setComputerHint(static_cast<TrackTileBase::ComputerHint>(tileData.computerHint));
 
-    tile->setExcludeFromMinimap(element.attribute(DataKeywords::Tile::excludeFromMinimap, "0").toUInt());
+    tile->setExcludeFromMinimap(tileData.excludeFromMinimap);
 }
 
-void readObject(TrackData & newData, const QDomElement & element)
+void readObject(TrackData & newData, const TrackFileReader::Object & objectData)
 {
     // Create a new object. QGraphicsScene will take
     // the ownership eventually.
-    auto object = std::make_shared<Object>(ObjectFactory::createObject(element.attribute(DataKeywords::Object::role, "clear")));
+    auto object = std::make_shared<Object>(ObjectFactory::createObject(objectData.role.isEmpty() ? QString("clear") : objectData.role));
 
-    object->setLocation(QPointF(
-      element.attribute(DataKeywords::Object::x, "0").toInt(),
-      element.attribute(DataKeywords::Object::y, "0").toInt()));
+    object->setLocation(QPointF(objectData.x, objectData.y));
 
-    object->setRotation(element.attribute(DataKeywords::Object::orientation, "0").toInt());
+    object->setRotation(objectData.orientation);
 
-    object->setForceStationary(element.attribute(DataKeywords::Object::forceStationary, "0").toUInt());
+    object->setForceStationary(objectData.forceStationary);
 
     newData.objects().add(object);
 }
 
-void readTargetNode(std::vector<TargetNodeBasePtr> & route, const QDomElement & element)
+void readTargetNode(std::vector<TargetNodeBasePtr> & route, const TrackFileReader::Node & nodeData)
 {
     // Create a new object. QGraphicsScene will take
     // the ownership eventually.
     const auto targetNode = std::make_shared<TargetNode>();
-    targetNode->setIndex(element.attribute(DataKeywords::Node::index, "0").toInt());
+    targetNode->setIndex(nodeData.index);
 
-    const int x = element.attribute(DataKeywords::Node::x, "0").toInt();
-    const int y = element.attribute(DataKeywords::Node::y, "0").toInt();
+    targetNode->setLocation(QPointF(nodeData.x, nodeData.y));
 
-    targetNode->setLocation(QPointF(x, y));
-
-    const int w = element.attribute(DataKeywords::Node::width, "0").toInt();
-    const int h = element.attribute(DataKeywords::Node::height, "0").toInt();
-
-    if (w > 0 && h > 0)
+    if (nodeData.width > 0 && nodeData.height > 0)
     {
-        targetNode->setSize(QSizeF(w, h));
+        targetNode->setSize(QSizeF(nodeData.width, nodeData.height));
     }
 
     route.push_back(targetNode);
@@ -205,67 +195,36 @@ bool TrackIO::save(TrackDataPtr trackData, QString path)
 
 TrackDataPtr TrackIO::open(QString path)
 {
-    QDomDocument doc;
-
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly))
+    TrackFileReader reader;
+    if (!reader.read(path))
     {
         return nullptr;
     }
 
-    if (!doc.setContent(&file))
+    const auto & header = reader.header();
+    const auto newData = std::make_shared<TrackData>(header.name, header.isUserTrack, header.cols, header.rows);
+    newData->setFileName(path);
+    newData->setIndex(header.index);
+
+    for (auto && tile : reader.tiles())
     {
-        file.close();
-        return nullptr;
+        readTile(*newData, reader, tile);
     }
 
-    file.close();
-
-    auto && root = doc.documentElement();
-    const size_t cols = root.attribute(DataKeywords::Header::cols, "0").toUInt();
-    const size_t rows = root.attribute(DataKeywords::Header::rows, "0").toUInt();
-
-    TrackDataPtr newData;
-    if (cols && rows)
+    for (auto && object : reader.objects())
     {
-        const auto name = root.attribute(DataKeywords::Header::name, "undefined");
-        const bool isUserTrack = root.attribute(DataKeywords::Header::user, "0").toInt();
-        newData = std::make_shared<TrackData>(name, isUserTrack, cols, rows);
-        newData->setFileName(path);
-        newData->setIndex(root.attribute(DataKeywords::Header::index, "0").toUInt());
-
-        // Temporary route vector.
-        std::vector<TargetNodeBasePtr> route;
-
-        auto && node = root.firstChild();
-        while (!node.isNull())
-        {
-            auto element = node.toElement();
-            if (!element.isNull())
-            {
-                // Read a tile element
-                if (element.nodeName() == DataKeywords::Track::tile)
-                {
-                    readTile(*newData, element);
-                }
-                // Read an object element
-                else if (element.nodeName() == DataKeywords::Track::object)
-                {
-                    readObject(*newData, element);
-                }
-                // Read a target node element
-                else if (element.nodeName() == DataKeywords::Track::node)
-                {
-                    readTargetNode(route, element);
-                }
-            }
-
-            node = node.nextSibling();
-        }
+        readObject(*newData, object);
+    }
 
-        // Sort and build route from the temporary vector.
-        newData->route().buildFromVector(route);
+    // Temporary route vector.
+    std::vector<TargetNodeBasePtr> route;
+    for (auto && node : reader.nodes())
+    {
+        readTargetNode(route, node);
     }
 
+    // Sort and build route from the temporary vector.
+    newData->route().buildFromVector(route);
+
     return newData;
 }
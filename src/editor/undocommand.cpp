@@ -0,0 +1,374 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "undocommand.hpp"
+
+#include "object.hpp"
+#include "targetnode.hpp"
+#include "trackdata.hpp"
+#include "tracktile.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+template<typename Ptr, typename Container, typename Item>
+Ptr findItem(const Container & container, const Item & item)
+{
+    const auto iter = std::find_if(container.cbegin(), container.cend(), [&item](const Ptr & candidate) {
+        return candidate.get() == &item;
+    });
+
+    assert(iter != container.cend());
+    return *iter;
+}
+} // namespace
+
+UndoScene::~UndoScene() = default;
+
+UndoCommand::UndoCommand() = default;
+
+UndoCommand::~UndoCommand() = default;
+
+bool UndoCommand::isRedundant(const TrackData &) const
+{
+    return false;
+}
+
+bool UndoCommand::coalesces(const UndoCommand &) const
+{
+    return false;
+}
+
+TileCommand::State::State(const TrackTile & tile)
+  : matrixLocation(tile.matrixLocation())
+  , tileType(tile.tileType())
+  , rotation(tile.rotation())
+  , computerHint(tile.computerHint())
+  , excludeFromMinimap(tile.excludeFromMinimap())
+{
+}
+
+bool TileCommand::State::operator==(const State & other) const
+{
+    return matrixLocation == other.matrixLocation && tileType == other.tileType && qFuzzyCompare(rotation + 1, other.rotation + 1) && computerHint == other.computerHint && excludeFromMinimap == other.excludeFromMinimap;
+}
+
+TileCommand::TileCommand(const std::vector<TrackTile *> & tiles)
+{
+    m_states.reserve(tiles.size());
+    for (auto && tile : tiles)
+    {
+        m_states.emplace_back(*tile);
+    }
+}
+
+TileCommand::TileCommand(const MapBase & map)
+{
+    m_states.reserve(map.cols() * map.rows());
+    for (size_t j = 0; j < map.rows(); j++)
+    {
+        for (size_t i = 0; i < map.cols(); i++)
+        {
+            const auto tile = std::dynamic_pointer_cast<TrackTile>(map.getTile(i, j));
+            assert(tile);
+            m_states.emplace_back(*tile);
+        }
+    }
+}
+
+void TileCommand::removeUnchanged(const MapBase & map)
+{
+    m_states.erase(std::remove_if(m_states.begin(), m_states.end(), [&map](const State & state) {
+                       const auto tile = std::dynamic_pointer_cast<TrackTile>(map.getTile(state.matrixLocation.x(), state.matrixLocation.y()));
+                       assert(tile);
+                       return state == State(*tile);
+                   }),
+                   m_states.end());
+    m_states.shrink_to_fit();
+}
+
+UndoCommandPtr TileCommand::apply(UndoScene & scene, TrackData & trackData)
+{
+    std::unique_ptr<TileCommand> inverse(new TileCommand);
+    inverse->m_states.reserve(m_states.size());
+
+    for (auto && state : m_states)
+    {
+        const auto tile = std::dynamic_pointer_cast<TrackTile>(trackData.map().getTile(state.matrixLocation.x(), state.matrixLocation.y()));
+        assert(tile);
+
+        inverse->m_states.emplace_back(*tile);
+
+        const bool typeChanged = tile->tileType() != state.tileType;
+        tile->setTileType(state.tileType);
+        tile->setRotation(state.rotation);
+        tile->setComputerHint(state.computerHint);
+        tile->setExcludeFromMinimap(state.excludeFromMinimap);
+
+        if (typeChanged)
+        {
+            scene.updateTileInScene(tile);
+        }
+    }
+
+    return inverse;
+}
+
+bool TileCommand::isRedundant(const TrackData & trackData) const
+{
+    return std::all_of(m_states.cbegin(), m_states.cend(), [&trackData](const State & state) {
+        const auto tile = std::dynamic_pointer_cast<TrackTile>(trackData.map().getTile(state.matrixLocation.x(), state.matrixLocation.y()));
+        assert(tile);
+        return state == State(*tile);
+    });
+}
+
+size_t TileCommand::byteSize() const
+{
+    return sizeof(*this) + m_states.capacity() * sizeof(State);
+}
+
+ObjectCommand::ObjectCommand(ObjectBasePtr object, const Objects & objects)
+  : m_object(object)
+  , m_location(object->location())
+  , m_rotation(std::dynamic_pointer_cast<Object>(object)->rotation())
+  , m_forceStationary(object->forceStationary())
+  , m_present(false)
+  , m_index(objects.count())
+{
+    const auto iter = std::find(objects.cbegin(), objects.cend(), object);
+    if (iter != objects.cend())
+    {
+        m_present = true;
+        m_index = static_cast<size_t>(iter - objects.cbegin());
+    }
+}
+
+ObjectCommand::ObjectCommand(const ObjectBase & object, const Objects & objects)
+  : ObjectCommand(findItem<ObjectBasePtr>(objects, object), objects)
+{
+}
+
+UndoCommandPtr ObjectCommand::apply(UndoScene & scene, TrackData & trackData)
+{
+    auto inverse = std::make_unique<ObjectCommand>(m_object, trackData.objects());
+
+    if (inverse->m_present && !m_present)
+    {
+        scene.removeObjectFromScene(m_object);
+        trackData.objects().remove(*m_object);
+    }
+    else if (!inverse->m_present && m_present)
+    {
+        trackData.objects().insert(m_index, m_object);
+        scene.addObjectToScene(m_object);
+    }
+
+    const auto object = std::dynamic_pointer_cast<Object>(m_object);
+    assert(object);
+
+    object->setLocation(m_location);
+    object->setRotation(m_rotation);
+    object->setForceStationary(m_forceStationary);
+
+    return inverse;
+}
+
+bool ObjectCommand::isRedundant(const TrackData & trackData) const
+{
+    const ObjectCommand current(m_object, trackData.objects());
+    return current.m_location == m_location && qFuzzyCompare(current.m_rotation + 1, m_rotation + 1) && current.m_forceStationary == m_forceStationary && current.m_present == m_present;
+}
+
+bool ObjectCommand::coalesces(const UndoCommand & newer) const
+{
+    const auto other = dynamic_cast<const ObjectCommand *>(&newer);
+    return other && other->m_object == m_object && other->m_present == m_present;
+}
+
+size_t ObjectCommand::byteSize() const
+{
+    return sizeof(*this);
+}
+
+TargetNodeCommand::TargetNodeCommand(TargetNodeBasePtr tnode)
+  : m_tnode(tnode)
+  , m_location(tnode->location())
+  , m_size(tnode->size())
+{
+}
+
+TargetNodeCommand::TargetNodeCommand(const TargetNodeBase & tnode, const Route & route)
+  : TargetNodeCommand(findItem<TargetNodeBasePtr>(route, tnode))
+{
+}
+
+UndoCommandPtr TargetNodeCommand::apply(UndoScene &, TrackData &)
+{
+    auto inverse = std::make_unique<TargetNodeCommand>(m_tnode);
+
+    // The editor's target node updates its route lines
+    m_tnode->setLocation(m_location);
+    m_tnode->setSize(m_size);
+
+    return inverse;
+}
+
+bool TargetNodeCommand::isRedundant(const TrackData &) const
+{
+    return m_tnode->location() == m_location && m_tnode->size() == m_size;
+}
+
+size_t TargetNodeCommand::byteSize() const
+{
+    return sizeof(*this);
+}
+
+RouteCommand::RouteCommand(const Route & route)
+{
+    m_states.reserve(route.numNodes());
+    for (auto iter = route.cbegin(); iter != route.cend(); iter++)
+    {
+        m_states.push_back({ *iter, (*iter)->location(), (*iter)->size() });
+    }
+}
+
+UndoCommandPtr RouteCommand::apply(UndoScene & scene, TrackData & trackData)
+{
+    auto inverse = std::make_unique<RouteCommand>(trackData.route());
+
+    scene.removeRouteFromScene();
+
+    trackData.route().clear();
+    for (auto && state : m_states)
+    {
+        // Links and route lines are re-created when the route is added to the scene
+        state.tnode->setPrev(nullptr);
+        state.tnode->setNext(nullptr);
+        state.tnode->setLocation(state.location);
+        state.tnode->setSize(state.size);
+
+        trackData.route().push(state.tnode);
+    }
+
+    scene.addExistingRouteToScene();
+
+    return inverse;
+}
+
+size_t RouteCommand::byteSize() const
+{
+    return sizeof(*this) + m_states.capacity() * sizeof(State);
+}
+
+RowColumnCommand::RowColumnCommand(Line line, Action action, size_t index)
+  : m_line(line)
+  , m_action(action)
+  , m_index(index)
+{
+}
+
+UndoCommandPtr RowColumnCommand::apply(UndoScene & scene, TrackData & trackData)
+{
+    return m_action == Action::Insert ? insert(scene, trackData) : remove(scene, trackData);
+}
+
+UndoCommandPtr RowColumnCommand::insert(UndoScene & scene, TrackData & trackData)
+{
+    if (m_line == Line::Row)
+    {
+        trackData.insertRow(m_index, MapBase::InsertDirection::Before);
+    }
+    else
+    {
+        trackData.insertColumn(m_index, MapBase::InsertDirection::Before);
+    }
+
+    // Put back the tiles of a deleted line instead of the new empty ones
+    auto && map = trackData.map();
+    const size_t count = m_line == Line::Row ? map.cols() : map.rows();
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t x = m_line == Line::Row ? i : m_index;
+        const size_t y = m_line == Line::Row ? m_index : i;
+        if (i < m_tiles.size())
+        {
+            map.setTile(x, y, m_tiles.at(i));
+        }
+
+        scene.addTileToScene(map.getTile(x, y));
+    }
+
+    for (auto && [object, location] : m_objects)
+    {
+        object->setLocation(location);
+    }
+
+    for (auto && [tnode, location] : m_tnodes)
+    {
+        tnode->setLocation(location);
+    }
+
+    scene.updateSceneRect();
+
+    return std::make_unique<RowColumnCommand>(m_line, Action::Delete, m_index);
+}
+
+UndoCommandPtr RowColumnCommand::remove(UndoScene & scene, TrackData & trackData)
+{
+    auto inverse = std::make_unique<RowColumnCommand>(m_line, Action::Insert, m_index);
+
+    for (auto && object : trackData.objects())
+    {
+        if (isOnLine(object->location()))
+        {
+            inverse->m_objects.emplace_back(object, object->location());
+        }
+    }
+
+    for (auto && tnode : trackData.route())
+    {
+        if (isOnLine(tnode->location()))
+        {
+            inverse->m_tnodes.emplace_back(tnode, tnode->location());
+        }
+    }
+
+    inverse->m_tiles = m_line == Line::Row ? trackData.deleteRow(m_index) : trackData.deleteColumn(m_index);
+    for (auto && tile : inverse->m_tiles)
+    {
+        scene.removeTileFromScene(tile);
+    }
+
+    scene.updateSceneRect();
+
+    return inverse;
+}
+
+bool RowColumnCommand::isOnLine(QPointF location) const
+{
+    // Deletion moves everything beyond the line start back by one line, but the insertion
+    // that undoes it moves back only what lies beyond the line start after that.
+    // Locations on the deleted line are therefore saved and restored explicitly.
+    const double coordinate = m_line == Line::Row ? location.y() : location.x();
+    const double size = m_line == Line::Row ? TrackTile::height() : TrackTile::width();
+    return coordinate > size * m_index && coordinate <= size * (m_index + 1);
+}
+
+size_t RowColumnCommand::byteSize() const
+{
+    return sizeof(*this) + m_tiles.capacity() * sizeof(TrackTileBasePtr) + m_tiles.size() * sizeof(TrackTile) + m_objects.capacity() * sizeof(decltype(m_objects)::value_type) + m_tnodes.capacity() * sizeof(decltype(m_tnodes)::value_type);
+}
@@ -0,0 +1,266 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef UNDOCOMMAND_HPP
+#define UNDOCOMMAND_HPP
+
+#include <QPoint>
+#include <QPointF>
+#include <QSizeF>
+#include <QString>
+
+#include "../common/objectbase.hpp"
+#include "../common/targetnodebase.hpp"
+#include "../common/tracktilebase.hpp"
+
+#include <memory>
+#include <vector>
+
+class MapBase;
+class Objects;
+class Route;
+class TrackData;
+class TrackTile;
+
+//! Scene operations through which undo commands keep the editor scene
+//! in sync with the track data. Only the items touched by a command are updated.
+class UndoScene
+{
+public:
+    virtual ~UndoScene();
+
+    //! Add a tile created or restored by a row or column insertion to the scene.
+    virtual void addTileToScene(TrackTileBasePtr tile) = 0;
+
+    //! Remove a tile of a deleted row or column from the scene.
+    virtual void removeTileFromScene(TrackTileBasePtr tile) = 0;
+
+    //! Update the pixmap of a tile after its type has changed.
+    virtual void updateTileInScene(TrackTileBasePtr tile) = 0;
+
+    virtual void addObjectToScene(ObjectBasePtr object) = 0;
+
+    virtual void removeObjectFromScene(ObjectBasePtr object) = 0;
+
+    //! Add current target node objects to the scene.
+    virtual void addExistingRouteToScene() = 0;
+
+    //! Remove target node and line objects from the scene.
+    virtual void removeRouteFromScene() = 0;
+
+    //! Called after the map has been resized.
+    virtual void updateSceneRect() = 0;
+};
+
+class UndoCommand;
+using UndoCommandPtr = std::unique_ptr<UndoCommand>;
+
+/*! Base class for the entries of the undo history.
+ *
+ *  A command holds only the state of the items it affects. Applying it
+ *  restores that state and returns the inverse command that restores the
+ *  state before the application, so the same command types move between
+ *  the undo and redo histories. */
+class UndoCommand
+{
+public:
+    UndoCommand();
+
+    UndoCommand(const UndoCommand & other) = delete;
+
+    UndoCommand & operator=(const UndoCommand & other) = delete;
+
+    virtual ~UndoCommand();
+
+    //! Apply the command and return its inverse.
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) = 0;
+
+    //! \return true if applying the command would not change the track data.
+    virtual bool isRedundant(const TrackData & trackData) const;
+
+    /*! \return true if the given newer command restores an item this command
+     *  already restores to an earlier state, so that it can be dropped. */
+    virtual bool coalesces(const UndoCommand & newer) const;
+
+    //! \return Approximate memory held by the command in bytes.
+    virtual size_t byteSize() const = 0;
+};
+
+//! Restores the type, rotation and hints of a set of tiles.
+class TileCommand : public UndoCommand
+{
+public:
+    //! Capture the given tiles.
+    explicit TileCommand(const std::vector<TrackTile *> & tiles);
+
+    //! Capture all tiles of the given map.
+    explicit TileCommand(const MapBase & map);
+
+    //! Forget the tiles that are still in the captured state, e.g. after a flood fill.
+    void removeUnchanged(const MapBase & map);
+
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) override;
+
+    virtual bool isRedundant(const TrackData & trackData) const override;
+
+    virtual size_t byteSize() const override;
+
+private:
+    struct State
+    {
+        explicit State(const TrackTile & tile);
+
+        bool operator==(const State & other) const;
+
+        QPoint matrixLocation;
+
+        QString tileType;
+
+        qreal rotation;
+
+        TrackTileBase::ComputerHint computerHint;
+
+        bool excludeFromMinimap;
+    };
+
+    TileCommand() = default;
+
+    std::vector<State> m_states;
+};
+
+//! Restores the location, rotation and presence of an object.
+class ObjectCommand : public UndoCommand
+{
+public:
+    //! Capture the given object. An object not in objects gets removed when the command is applied.
+    ObjectCommand(ObjectBasePtr object, const Objects & objects);
+
+    //! Capture an object that is in objects.
+    ObjectCommand(const ObjectBase & object, const Objects & objects);
+
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) override;
+
+    virtual bool isRedundant(const TrackData & trackData) const override;
+
+    virtual bool coalesces(const UndoCommand & newer) const override;
+
+    virtual size_t byteSize() const override;
+
+private:
+    ObjectBasePtr m_object;
+
+    QPointF m_location;
+
+    qreal m_rotation;
+
+    bool m_forceStationary;
+
+    bool m_present;
+
+    size_t m_index;
+};
+
+//! Restores the location and size of a single target node, e.g. after a drag.
+class TargetNodeCommand : public UndoCommand
+{
+public:
+    explicit TargetNodeCommand(TargetNodeBasePtr tnode);
+
+    //! Capture a target node that is in the route.
+    TargetNodeCommand(const TargetNodeBase & tnode, const Route & route);
+
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) override;
+
+    virtual bool isRedundant(const TrackData & trackData) const override;
+
+    virtual size_t byteSize() const override;
+
+private:
+    TargetNodeBasePtr m_tnode;
+
+    QPointF m_location;
+
+    QSizeF m_size;
+};
+
+//! Restores the node list of the route. Used when nodes are pushed or the route is cleared.
+class RouteCommand : public UndoCommand
+{
+public:
+    explicit RouteCommand(const Route & route);
+
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) override;
+
+    virtual size_t byteSize() const override;
+
+private:
+    struct State
+    {
+        TargetNodeBasePtr tnode;
+
+        QPointF location;
+
+        QSizeF size;
+    };
+
+    std::vector<State> m_states;
+};
+
+/*! Inserts or deletes a tile row or column. Deletion keeps the deleted tiles
+ *  and the locations of the objects and target nodes on them, so that the
+ *  inverse insertion restores the map exactly. */
+class RowColumnCommand : public UndoCommand
+{
+public:
+    enum class Line
+    {
+        Row,
+        Column
+    };
+
+    enum class Action
+    {
+        Insert,
+        Delete
+    };
+
+    //! \param index Index of the inserted line after an insertion or of the line to delete.
+    RowColumnCommand(Line line, Action action, size_t index);
+
+    virtual UndoCommandPtr apply(UndoScene & scene, TrackData & trackData) override;
+
+    virtual size_t byteSize() const override;
+
+private:
+    UndoCommandPtr insert(UndoScene & scene, TrackData & trackData);
+
+    UndoCommandPtr remove(UndoScene & scene, TrackData & trackData);
+
+    bool isOnLine(QPointF location) const;
+
+    Line m_line;
+
+    Action m_action;
+
+    size_t m_index;
+
+    std::vector<TrackTileBasePtr> m_tiles;
+
+    std::vector<std::pair<ObjectBasePtr, QPointF>> m_objects;
+
+    std::vector<std::pair<TargetNodeBasePtr, QPointF>> m_tnodes;
+};
+
+#endif // UNDOCOMMAND_HPP
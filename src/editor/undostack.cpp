@@ -20,32 +20,36 @@ UndoStack::UndoStack(unsigned int maxHistorySize)
 {
 }
 
-void UndoStack::pushUndoPoint(TrackDataPtr trackData)
+void UndoStack::push(CommandList & stack, UndoCommandPtr command)
 {
-    auto copyData = new TrackData(*trackData.get());
-    m_undoStack.push_back(TrackDataPtr(copyData));
+    stack.push_back(std::move(command));
 
-    if (m_undoStack.size() > m_maxHistorySize)
+    if (stack.size() > m_maxHistorySize)
     {
-        m_undoStack.pop_front();
+        stack.pop_front();
     }
 }
 
-void UndoStack::pushRedoPoint(TrackDataPtr trackData)
+void UndoStack::pushUndoPoint(UndoCommandPtr command, bool coalesce)
 {
-    auto copyData = new TrackData(*trackData.get());
-    m_redoStack.push_back(TrackDataPtr(copyData));
+    m_redoStack.clear();
 
-    if (m_redoStack.size() > m_maxHistorySize)
+    if (coalesce && m_coalescing && m_undoStack.back()->coalesces(*command))
     {
-        m_redoStack.pop_front();
+        return;
     }
+
+    push(m_undoStack, std::move(command));
+
+    m_coalescing = coalesce;
 }
 
 void UndoStack::clear()
 {
     m_undoStack.clear();
     m_redoStack.clear();
+
+    m_coalescing = false;
 }
 
 bool UndoStack::isUndoable() const
@@ -53,16 +57,16 @@ bool UndoStack::isUndoable() const
     return m_undoStack.size() > 0;
 }
 
-TrackDataPtr UndoStack::undo()
+void UndoStack::undo(UndoScene & scene, TrackData & trackData)
 {
     if (isUndoable())
     {
-        auto head = m_undoStack.back();
+        auto head = std::move(m_undoStack.back());
         m_undoStack.pop_back();
-        return head;
-    }
+        push(m_redoStack, head->apply(scene, trackData));
 
-    return TrackDataPtr();
+        m_coalescing = false;
+    }
 }
 
 bool UndoStack::isRedoable() const
@@ -70,14 +74,31 @@ bool UndoStack::isRedoable() const
     return m_redoStack.size() > 0;
 }
 
-TrackDataPtr UndoStack::redo()
+void UndoStack::redo(UndoScene & scene, TrackData & trackData)
 {
     if (isRedoable())
     {
-        auto head = m_redoStack.back();
+        auto head = std::move(m_redoStack.back());
         m_redoStack.pop_back();
-        return head;
+        push(m_undoStack, head->apply(scene, trackData));
+
+        m_coalescing = false;
+    }
+}
+
+size_t UndoStack::byteSize() const
+{
+    size_t size = 0;
+
+    for (auto && command : m_undoStack)
+    {
+        size += command->byteSize();
+    }
+
+    for (auto && command : m_redoStack)
+    {
+        size += command->byteSize();
     }
 
-    return TrackDataPtr();
+    return size;
 }
@@ -16,37 +16,49 @@
 #ifndef UNDOSTACK_HPP
 #define UNDOSTACK_HPP
 
-#include "trackdata.hpp"
+#include "undocommand.hpp"
 
 #include <list>
 
+/*! Undo and redo histories of commands. Each command holds only
+ *  the state of the items it affects instead of a copy of the whole track. */
 class UndoStack
 {
 public:
     UndoStack(unsigned int maxHistorySize = 100);
 
-    void pushUndoPoint(TrackDataPtr trackData);
-
-    void pushRedoPoint(TrackDataPtr trackData);
+    /*! Push an undo point and clear the redo history.
+     *  \param coalesce If set and the previous point was also pushed with coalesce set and restores
+     *         the same item, the new point is dropped so that e.g. consecutive nudges undo at once. */
+    void pushUndoPoint(UndoCommandPtr command, bool coalesce = false);
 
     void clear();
 
     bool isUndoable() const;
 
-    TrackDataPtr undo();
+    //! Apply the latest undo point and push its inverse to the redo history.
+    void undo(UndoScene & scene, TrackData & trackData);
 
     bool isRedoable() const;
 
-    TrackDataPtr redo();
+    //! Apply the latest redo point and push its inverse to the undo history.
+    void redo(UndoScene & scene, TrackData & trackData);
+
+    //! \return Approximate memory held by both histories in bytes.
+    size_t byteSize() const;
 
 private:
-    using TrackDataVector = std::list<TrackDataPtr>;
+    using CommandList = std::list<UndoCommandPtr>;
 
-    TrackDataVector m_undoStack;
+    void push(CommandList & stack, UndoCommandPtr command);
 
-    TrackDataVector m_redoStack;
+    CommandList m_undoStack;
+
+    CommandList m_redoStack;
 
     unsigned int m_maxHistorySize;
+
+    bool m_coalescing = false;
 };
 
 #endif // UNDOSTACK_HPP
@@ -0,0 +1,579 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "undostacktest.hpp"
+
+#include "../../object.hpp"
+#include "../../targetnode.hpp"
+#include "../../trackdata.hpp"
+#include "../../tracktile.hpp"
+#include "../../undostack.hpp"
+
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+class FakeScene : public UndoScene
+{
+public:
+    void addTileToScene(TrackTileBasePtr) override
+    {
+        m_tilesAdded++;
+    }
+
+    void removeTileFromScene(TrackTileBasePtr) override
+    {
+        m_tilesRemoved++;
+    }
+
+    void updateTileInScene(TrackTileBasePtr) override
+    {
+        m_tilesUpdated++;
+    }
+
+    void addObjectToScene(ObjectBasePtr) override
+    {
+        m_objectsAdded++;
+    }
+
+    void removeObjectFromScene(ObjectBasePtr) override
+    {
+        m_objectsRemoved++;
+    }
+
+    void addExistingRouteToScene() override
+    {
+        m_routesAdded++;
+    }
+
+    void removeRouteFromScene() override
+    {
+        m_routesRemoved++;
+    }
+
+    void updateSceneRect() override
+    {
+        m_sceneRectUpdates++;
+    }
+
+    int changes() const
+    {
+        return m_tilesAdded + m_tilesRemoved + m_tilesUpdated + m_objectsAdded + m_objectsRemoved + m_routesAdded + m_routesRemoved;
+    }
+
+    int m_tilesAdded = 0;
+    int m_tilesRemoved = 0;
+    int m_tilesUpdated = 0;
+    int m_objectsAdded = 0;
+    int m_objectsRemoved = 0;
+    int m_routesAdded = 0;
+    int m_routesRemoved = 0;
+    int m_sceneRectUpdates = 0;
+};
+
+const QStringList TILE_TYPES = { "straight", "corner90", "grass", "sand", "clear" };
+
+std::shared_ptr<TrackTile> tileAt(const TrackData & trackData, size_t x, size_t y)
+{
+    return std::dynamic_pointer_cast<TrackTile>(trackData.map().getTile(x, y));
+}
+
+void fillTiles(TrackData & trackData)
+{
+    for (size_t j = 0; j < trackData.map().rows(); j++)
+    {
+        for (size_t i = 0; i < trackData.map().cols(); i++)
+        {
+            const auto tile = tileAt(trackData, i, j);
+            tile->setTileType(TILE_TYPES.at(static_cast<int>((i + j * 3) % TILE_TYPES.size())));
+            tile->setRotation(static_cast<qreal>(90 * ((i + j) % 4)));
+            tile->setComputerHint(static_cast<TrackTileBase::ComputerHint>((i * j) % 3));
+            tile->setExcludeFromMinimap(i == j);
+        }
+    }
+}
+
+std::shared_ptr<Object> addObject(TrackData & trackData, QString role, QPointF location)
+{
+    const auto object = std::make_shared<Object>("tree", role, QSizeF(32, 32), QPixmap());
+    object->setLocation(location);
+    object->setRotation(45);
+    trackData.objects().add(object);
+    return object;
+}
+
+std::shared_ptr<TargetNode> addTargetNode(TrackData & trackData, QPointF location)
+{
+    const auto tnode = std::make_shared<TargetNode>();
+    tnode->setLocation(location);
+    tnode->setSize(QSizeF(TrackTile::width(), TrackTile::height()));
+    trackData.route().push(tnode);
+    return tnode;
+}
+
+//! Place objects and target nodes inside, on the borders of and around the given line.
+void populateAround(TrackData & trackData, bool row, size_t index)
+{
+    const double size = row ? TrackTile::height() : TrackTile::width();
+    const std::vector<double> offsets = { size / 2, size * index, size * index + 1, size * index + size / 2, size * (index + 1), size * (index + 1) + 1, size * (index + 2) };
+
+    int n = 0;
+    for (auto && offset : offsets)
+    {
+        const QPointF location = row ? QPointF(size * 1.5, offset) : QPointF(offset, size * 1.5);
+        addObject(trackData, QString("object%1").arg(n++), location);
+        addTargetNode(trackData, location);
+    }
+}
+
+//! Serialize everything the editor saves so that track states can be compared.
+QString dump(const TrackData & trackData)
+{
+    QString result;
+    QTextStream stream(&result);
+
+    stream << trackData.map().cols() << "x" << trackData.map().rows() << "\n";
+    for (size_t j = 0; j < trackData.map().rows(); j++)
+    {
+        for (size_t i = 0; i < trackData.map().cols(); i++)
+        {
+            const auto tile = tileAt(trackData, i, j);
+            stream << tile->tileType() << " " << tile->rotation() << " " << static_cast<int>(tile->computerHint()) << " "
+                   << tile->excludeFromMinimap() << " " << tile->matrixLocation().x() << "," << tile->matrixLocation().y() << " "
+                   << tile->location().x() << "," << tile->location().y() << " " << tile->pos().x() << "," << tile->pos().y() << "\n";
+        }
+    }
+
+    for (auto iter = trackData.objects().cbegin(); iter != trackData.objects().cend(); iter++)
+    {
+        const auto object = std::dynamic_pointer_cast<Object>(*iter);
+        stream << object->role() << " " << object->location().x() << "," << object->location().y() << " "
+               << object->rotation() << " " << object->forceStationary() << "\n";
+    }
+
+    for (auto iter = trackData.route().cbegin(); iter != trackData.route().cend(); iter++)
+    {
+        stream << (*iter)->index() << " " << (*iter)->location().x() << "," << (*iter)->location().y() << " "
+               << (*iter)->size().width() << "x" << (*iter)->size().height() << "\n";
+    }
+
+    return result;
+}
+
+} // namespace
+
+UndoStackTest::UndoStackTest()
+{
+}
+
+void UndoStackTest::testTileRoundTrip()
+{
+    TrackData trackData("test", false, 8, 6);
+    fillTiles(trackData);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto before = dump(trackData);
+
+    const auto tile = tileAt(trackData, 2, 3);
+    undoStack.pushUndoPoint(std::make_unique<TileCommand>(std::vector<TrackTile *> { tile.get() }));
+    tile->setTileType("finish");
+    tile->setRotation(270);
+    tile->setComputerHint(TrackTileBase::ComputerHint::BrakeHard);
+    tile->setExcludeFromMinimap(true);
+
+    const auto after = dump(trackData);
+    QVERIFY(after != before);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    // Only the changed tile is touched
+    QCOMPARE(scene.m_tilesUpdated, 1);
+    QCOMPARE(scene.changes(), 1);
+
+    QVERIFY(!undoStack.isUndoable());
+    QVERIFY(undoStack.isRedoable());
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), after);
+    QCOMPARE(scene.changes(), 2);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+}
+
+void UndoStackTest::testFloodFillKeepsOnlyChangedTiles()
+{
+    TrackData trackData("test", false, 10, 10);
+    fillTiles(trackData);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto before = dump(trackData);
+
+    auto command = std::make_unique<TileCommand>(trackData.map());
+    const size_t fullSize = command->byteSize();
+
+    tileAt(trackData, 1, 1)->setTileType("finish");
+    tileAt(trackData, 1, 2)->setTileType("finish");
+    tileAt(trackData, 2, 2)->setTileType("finish");
+
+    command->removeUnchanged(trackData.map());
+    QVERIFY(command->byteSize() * 10 < fullSize);
+
+    undoStack.pushUndoPoint(std::move(command));
+    undoStack.undo(scene, trackData);
+
+    QCOMPARE(dump(trackData), before);
+    QCOMPARE(scene.m_tilesUpdated, 3);
+}
+
+void UndoStackTest::testObjectAddAndRemove()
+{
+    TrackData trackData("test", false, 4, 4);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    addObject(trackData, "a", QPointF(10, 10));
+    const auto b = addObject(trackData, "b", QPointF(20, 20));
+    addObject(trackData, "c", QPointF(30, 30));
+
+    const auto before = dump(trackData);
+
+    // Add: the undo point is saved before the object is in the track
+    const auto d = std::make_shared<Object>("tree", "d", QSizeF(32, 32), QPixmap());
+    d->setLocation(QPointF(40, 40));
+    undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(d, trackData.objects()));
+    trackData.objects().add(d);
+
+    const auto afterAdd = dump(trackData);
+
+    // Remove from the middle
+    undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(*b, trackData.objects()));
+    trackData.objects().remove(*b);
+
+    const auto afterRemove = dump(trackData);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), afterAdd);
+    QCOMPARE(scene.m_objectsAdded, 1);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+    QCOMPARE(scene.m_objectsRemoved, 1);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterAdd);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterRemove);
+
+    QCOMPARE(scene.m_tilesUpdated + scene.m_routesAdded, 0);
+}
+
+void UndoStackTest::testObjectMoveCoalescing()
+{
+    TrackData trackData("test", false, 4, 4);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto a = addObject(trackData, "a", QPointF(100, 100));
+    const auto b = addObject(trackData, "b", QPointF(200, 200));
+
+    // Consecutive nudges of the same object form one undo point
+    for (int i = 0; i < 10; i++)
+    {
+        undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(*a, trackData.objects()), true);
+        a->setLocation(a->location() + QPointF(1, 0));
+    }
+
+    undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(*b, trackData.objects()), true);
+    b->setLocation(b->location() + QPointF(0, 1));
+
+    undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(*a, trackData.objects()), true);
+    a->setLocation(a->location() + QPointF(1, 0));
+
+    // Not coalesced with the previous nudge
+    undoStack.pushUndoPoint(std::make_unique<ObjectCommand>(*a, trackData.objects()));
+    a->setRotation(90);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(a->rotation(), 45.0);
+    QCOMPARE(a->location(), QPointF(111, 100));
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(a->location(), QPointF(110, 100));
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(b->location(), QPointF(200, 200));
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(a->location(), QPointF(100, 100));
+
+    QVERIFY(!undoStack.isUndoable());
+    QCOMPARE(scene.changes(), 0);
+}
+
+void UndoStackTest::testRedundantDrag()
+{
+    TrackData trackData("test", false, 4, 4);
+    fillTiles(trackData);
+
+    const auto object = addObject(trackData, "a", QPointF(100, 100));
+    const auto tnode = addTargetNode(trackData, QPointF(50, 50));
+    const auto tile = tileAt(trackData, 1, 1);
+
+    const ObjectCommand objectCommand(*object, trackData.objects());
+    const TargetNodeCommand tnodeCommand(*tnode, trackData.route());
+    const TileCommand tileCommand(std::vector<TrackTile *> { tile.get() });
+
+    // A click without a move doesn't need an undo point
+    QVERIFY(objectCommand.isRedundant(trackData));
+    QVERIFY(tnodeCommand.isRedundant(trackData));
+    QVERIFY(tileCommand.isRedundant(trackData));
+
+    object->setLocation(QPointF(101, 100));
+    tnode->setLocation(QPointF(51, 50));
+    tile->setRotation(tile->rotation() + 90);
+
+    QVERIFY(!objectCommand.isRedundant(trackData));
+    QVERIFY(!tnodeCommand.isRedundant(trackData));
+    QVERIFY(!tileCommand.isRedundant(trackData));
+}
+
+void UndoStackTest::testTargetNodeAndRoute()
+{
+    TrackData trackData("test", false, 4, 4);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    addTargetNode(trackData, QPointF(10, 10));
+    const auto tnode = addTargetNode(trackData, QPointF(20, 20));
+    addTargetNode(trackData, QPointF(30, 30));
+
+    const auto before = dump(trackData);
+
+    // Node drag
+    undoStack.pushUndoPoint(std::make_unique<TargetNodeCommand>(*tnode, trackData.route()));
+    tnode->setLocation(QPointF(25, 25));
+    tnode->setSize(QSizeF(10, 10));
+
+    const auto afterMove = dump(trackData);
+
+    // Clear the route and push a new node
+    undoStack.pushUndoPoint(std::make_unique<RouteCommand>(trackData.route()));
+    trackData.route().clear();
+    addTargetNode(trackData, QPointF(40, 40));
+
+    const auto afterPush = dump(trackData);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), afterMove);
+    QCOMPARE(scene.m_routesRemoved, 1);
+    QCOMPARE(scene.m_routesAdded, 1);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    // Moving a node only updates its route lines
+    QCOMPARE(scene.m_routesAdded, 1);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterMove);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterPush);
+}
+
+void UndoStackTest::testRowRoundTrip()
+{
+    const size_t cols = 6;
+    TrackData trackData("test", false, cols, 5);
+    fillTiles(trackData);
+    populateAround(trackData, true, 2);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto before = dump(trackData);
+    const auto deletedTile = tileAt(trackData, 3, 2);
+
+    undoStack.pushUndoPoint(RowColumnCommand(RowColumnCommand::Line::Row, RowColumnCommand::Action::Delete, 2).apply(scene, trackData));
+    QCOMPARE(trackData.map().rows(), size_t(4));
+    QCOMPARE(scene.m_tilesRemoved, static_cast<int>(cols));
+
+    const auto afterDelete = dump(trackData);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+    QCOMPARE(scene.m_tilesAdded, static_cast<int>(cols));
+    QCOMPARE(scene.m_sceneRectUpdates, 2);
+
+    // The deleted tiles themselves are restored
+    QCOMPARE(tileAt(trackData, 3, 2), deletedTile);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterDelete);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    // Insertion after the last row and before the first row
+    for (size_t index : { trackData.map().rows(), size_t(0), size_t(3) })
+    {
+        undoStack.pushUndoPoint(RowColumnCommand(RowColumnCommand::Line::Row, RowColumnCommand::Action::Insert, index).apply(scene, trackData));
+        QCOMPARE(trackData.map().rows(), size_t(6));
+        QCOMPARE(tileAt(trackData, 0, index)->tileType(), QString("clear"));
+
+        const auto afterInsert = dump(trackData);
+
+        undoStack.undo(scene, trackData);
+        QCOMPARE(dump(trackData), before);
+
+        undoStack.redo(scene, trackData);
+        QCOMPARE(dump(trackData), afterInsert);
+
+        undoStack.undo(scene, trackData);
+    }
+}
+
+void UndoStackTest::testColumnRoundTrip()
+{
+    const size_t rows = 5;
+    TrackData trackData("test", false, 6, rows);
+    fillTiles(trackData);
+    populateAround(trackData, false, 3);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto before = dump(trackData);
+
+    undoStack.pushUndoPoint(RowColumnCommand(RowColumnCommand::Line::Column, RowColumnCommand::Action::Delete, 3).apply(scene, trackData));
+    QCOMPARE(trackData.map().cols(), size_t(5));
+    QCOMPARE(scene.m_tilesRemoved, static_cast<int>(rows));
+
+    const auto afterDelete = dump(trackData);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    undoStack.redo(scene, trackData);
+    QCOMPARE(dump(trackData), afterDelete);
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    undoStack.pushUndoPoint(RowColumnCommand(RowColumnCommand::Line::Column, RowColumnCommand::Action::Insert, 1).apply(scene, trackData));
+    QCOMPARE(trackData.map().cols(), size_t(7));
+
+    undoStack.undo(scene, trackData);
+    QCOMPARE(dump(trackData), before);
+
+    // Only the tiles of the inserted and deleted columns were touched
+    QCOMPARE(scene.m_tilesAdded + scene.m_tilesRemoved, static_cast<int>(rows) * 6);
+    QCOMPARE(scene.m_tilesUpdated, 0);
+}
+
+void UndoStackTest::testRedoClearedByNewUndoPoint()
+{
+    TrackData trackData("test", false, 4, 4);
+    fillTiles(trackData);
+
+    FakeScene scene;
+    UndoStack undoStack;
+
+    const auto tile = tileAt(trackData, 0, 0);
+    undoStack.pushUndoPoint(std::make_unique<TileCommand>(std::vector<TrackTile *> { tile.get() }));
+    tile->setTileType("finish");
+
+    undoStack.undo(scene, trackData);
+    QVERIFY(undoStack.isRedoable());
+
+    undoStack.pushUndoPoint(std::make_unique<TileCommand>(std::vector<TrackTile *> { tile.get() }));
+    QVERIFY(!undoStack.isRedoable());
+
+    undoStack.clear();
+    QVERIFY(!undoStack.isUndoable());
+    QCOMPARE(undoStack.byteSize(), size_t(0));
+}
+
+void UndoStackTest::testHistoryLimit()
+{
+    TrackData trackData("test", false, 4, 4);
+    fillTiles(trackData);
+
+    FakeScene scene;
+    UndoStack undoStack(5);
+
+    const auto tile = tileAt(trackData, 0, 0);
+    for (int i = 0; i < 8; i++)
+    {
+        undoStack.pushUndoPoint(std::make_unique<TileCommand>(std::vector<TrackTile *> { tile.get() }));
+        tile->setRotation(i * 10);
+    }
+
+    int undoCount = 0;
+    while (undoStack.isUndoable())
+    {
+        undoStack.undo(scene, trackData);
+        undoCount++;
+    }
+
+    QCOMPARE(undoCount, 5);
+    QCOMPARE(tile->rotation(), 20.0);
+}
+
+void UndoStackTest::testMemoryPerUndoStep()
+{
+    const size_t cols = 100;
+    const size_t rows = 100;
+    TrackData trackData("test", false, cols, rows);
+    fillTiles(trackData);
+
+    UndoStack undoStack;
+
+    const size_t steps = 100;
+    for (size_t i = 0; i < steps; i++)
+    {
+        const auto tile = tileAt(trackData, i, i);
+        undoStack.pushUndoPoint(std::make_unique<TileCommand>(std::vector<TrackTile *> { tile.get() }));
+        tile->setTileType("finish");
+    }
+
+    // A snapshot would hold a copy of every tile per step
+    const size_t tileStep = undoStack.byteSize() / steps;
+    QVERIFY(tileStep <= 128);
+    QVERIFY(tileStep * 1000 < cols * rows * sizeof(TrackTile));
+
+    const auto object = addObject(trackData, "a", QPointF(100, 100));
+    QVERIFY(ObjectCommand(*object, trackData.objects()).byteSize() <= 128);
+
+    // Deleting a row holds just the deleted tiles
+    FakeScene scene;
+    const auto deletion = RowColumnCommand(RowColumnCommand::Line::Row, RowColumnCommand::Action::Delete, 50).apply(scene, trackData);
+    QVERIFY(deletion->byteSize() <= cols * (sizeof(TrackTile) + sizeof(TrackTileBasePtr)) + 256);
+}
+
+QTEST_MAIN(UndoStackTest)
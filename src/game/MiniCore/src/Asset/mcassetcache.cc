@@ -0,0 +1,173 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "mcassetcache.hh"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+
+#include <cstring>
+
+namespace {
+struct Header
+{
+    char magic[4];
+
+    uint32_t version;
+
+    uint32_t type;
+
+    uint32_t reserved;
+
+    uint64_t key;
+
+    uint64_t payloadSize;
+};
+
+static_assert(sizeof(Header) == 32, "Cache header must not have padding");
+
+const char MAGIC[4] = { 'M', 'C', 'A', 'C' };
+} // namespace
+
+MCAssetCache::Entry::Entry(std::unique_ptr<QFile> file, const unsigned char * data, size_t size)
+  : m_file(std::move(file))
+  , m_data(data)
+  , m_size(size)
+{
+}
+
+MCAssetCache::Entry::~Entry() = default;
+
+const unsigned char * MCAssetCache::Entry::data() const
+{
+    return m_data;
+}
+
+size_t MCAssetCache::Entry::size() const
+{
+    return m_size;
+}
+
+MCAssetCache::MCAssetCache(const std::string & path)
+  : m_path(path)
+{
+}
+
+const std::string & MCAssetCache::path() const
+{
+    return m_path;
+}
+
+std::string MCAssetCache::filePath(Type type, uint64_t key) const
+{
+    QString prefix;
+    switch (type)
+    {
+    case Type::Texture:
+        prefix = "texture-";
+        break;
+    case Type::Mesh:
+        prefix = "mesh-";
+        break;
+    case Type::Data:
+        prefix = "data-";
+        break;
+    }
+
+    const QString name = prefix + QString::number(key, 16).rightJustified(16, '0') + ".bin";
+    return (QString(m_path.c_str()) + QDir::separator() + name).toStdString();
+}
+
+std::unique_ptr<MCAssetCache::Entry> MCAssetCache::load(Type type, uint64_t key) const
+{
+    auto file = std::make_unique<QFile>(filePath(type, key).c_str());
+    if (!file->open(QIODevice::ReadOnly) || file->size() < static_cast<qint64>(sizeof(Header)))
+    {
+        return nullptr;
+    }
+
+    const auto data = file->map(0, file->size());
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) || header.version != MCAssetCache::VERSION || //
+        header.type != static_cast<uint32_t>(type) || header.key != key || //
+        header.payloadSize != static_cast<uint64_t>(file->size()) - sizeof(Header))
+    {
+        // Written by another version, will be overwritten
+        return nullptr;
+    }
+
+    return std::unique_ptr<Entry>(new Entry(std::move(file), data + sizeof(Header), static_cast<size_t>(header.payloadSize)));
+}
+
+bool MCAssetCache::store(Type type, uint64_t key, std::initializer_list<Chunk> chunks) const
+{
+    if (!QDir().mkpath(m_path.c_str()))
+    {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = MCAssetCache::VERSION;
+    header.type = static_cast<uint32_t>(type);
+    header.reserved = 0;
+    header.key = key;
+    header.payloadSize = 0;
+    for (auto && chunk : chunks)
+    {
+        header.payloadSize += chunk.second;
+    }
+
+    QSaveFile file(filePath(type, key).c_str());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    bool ok = file.write(reinterpret_cast<const char *>(&header), sizeof(Header)) == sizeof(Header);
+    for (auto && chunk : chunks)
+    {
+        ok = ok && file.write(static_cast<const char *>(chunk.first), static_cast<qint64>(chunk.second)) == static_cast<qint64>(chunk.second);
+    }
+
+    // Without commit() the file is discarded
+    return ok && file.commit();
+}
+
+uint64_t MCAssetCache::hash(const void * data, size_t size, uint64_t seed)
+{
+    const auto bytes = static_cast<const unsigned char *>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
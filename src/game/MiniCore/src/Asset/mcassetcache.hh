@@ -0,0 +1,107 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#ifndef MCASSETCACHE_HH
+#define MCASSETCACHE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "mcmacros.hh"
+
+class QFile;
+
+/*! Versioned on-disk cache of processed assets, e.g. texture data ready for upload.
+ *  Each entry is a file named by its type and 64-bit key. The file starts with a header
+ *  including the cache version and the key, so entries written by other versions are
+ *  treated as misses. The payload is memory-mapped on load. */
+class MCAssetCache
+{
+public:
+    enum class Type : uint32_t
+    {
+        Texture = 1,
+        Mesh = 2,
+        //! Payloads defined by the application.
+        Data = 3
+    };
+
+    //! Increase when the format of any cached payload changes.
+    static const uint32_t VERSION = 1;
+
+    //! A memory-mapped payload of an entry. The data stays valid as long as the object lives.
+    class Entry
+    {
+    public:
+        ~Entry();
+
+        const unsigned char * data() const;
+
+        size_t size() const;
+
+    private:
+        friend class MCAssetCache;
+
+        Entry(std::unique_ptr<QFile> file, const unsigned char * data, size_t size);
+
+        std::unique_ptr<QFile> m_file;
+
+        const unsigned char * m_data;
+
+        size_t m_size;
+
+        DISABLE_COPY(Entry);
+        DISABLE_ASSI(Entry);
+    };
+
+    using Chunk = std::pair<const void *, size_t>;
+
+    //! Constructor. The directory is created when the first entry is stored.
+    explicit MCAssetCache(const std::string & path);
+
+    const std::string & path() const;
+
+    //! \return the mapped entry or nullptr if not found or stale.
+    std::unique_ptr<Entry> load(Type type, uint64_t key) const;
+
+    /*! Store an entry. The payload is the concatenation of the given chunks.
+     *  The file is written atomically, so a crash never leaves a partial entry behind.
+     *  \return true on success. */
+    bool store(Type type, uint64_t key, std::initializer_list<Chunk> chunks) const;
+
+    //! 64-bit FNV-1a hash. Pass the previous result as the seed to combine hashes.
+    static uint64_t hash(const void * data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+private:
+    std::string filePath(Type type, uint64_t key) const;
+
+    std::string m_path;
+
+    DISABLE_COPY(MCAssetCache);
+    DISABLE_ASSI(MCAssetCache);
+};
+
+using MCAssetCachePtr = std::shared_ptr<MCAssetCache>;
+
+#endif // MCASSETCACHE_HH
@@ -18,9 +18,12 @@
 //
 
 #include "mcassetmanager.hh"
+#include "mcassetcache.hh"
 #include "mclogger.hh"
+#include "mcthreadpool.hh"
 
 #include <cassert>
+#include <thread>
 
 MCAssetManager * MCAssetManager::m_instance = nullptr;
 
@@ -65,11 +68,48 @@ MCMeshManager & MCAssetManager::meshManager()
     return *instance().m_meshManager;
 }
 
+void MCAssetManager::setCachePath(const std::string & cachePath)
+{
+    const auto cache = !cachePath.empty() ? std::make_shared<MCAssetCache>(cachePath) : nullptr;
+    m_surfaceManager->setCache(cache);
+    m_meshManager->setCache(cache);
+}
+
+void MCAssetManager::setProgressCallback(ProgressCallback callback)
+{
+    if (callback)
+    {
+        m_surfaceManager->setProgressCallback([callback](size_t loaded, size_t total) {
+            callback("surfaces", loaded, total);
+        });
+
+        m_meshManager->setProgressCallback([callback](size_t loaded, size_t total) {
+            callback("meshes", loaded, total);
+        });
+    }
+    else
+    {
+        m_surfaceManager->setProgressCallback(nullptr);
+        m_meshManager->setProgressCallback(nullptr);
+    }
+}
+
 void MCAssetManager::load()
 {
+    // The calling thread runs decoding tasks too, in addition to creating the GL objects
+    const unsigned int cores = std::thread::hardware_concurrency();
+    m_threadPool = std::make_unique<MCThreadPool>(cores > 1 ? cores - 1 : 0);
+    m_surfaceManager->setThreadPool(m_threadPool.get());
+    m_meshManager->setThreadPool(m_threadPool.get());
+
     loadSurfaces();
     loadFonts();
     loadMeshes();
+
+    // Stop the threads as the pool is not needed after loading
+    m_surfaceManager->setThreadPool(nullptr);
+    m_meshManager->setThreadPool(nullptr);
+    m_threadPool.reset();
 }
 
 void MCAssetManager::loadSurfaces()
@@ -20,17 +20,26 @@
 #ifndef MCASSETMANAGER_HH
 #define MCASSETMANAGER_HH
 
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "mcmeshmanager.hh"
 #include "mcsurfacemanager.hh"
 #include "mctexturefontmanager.hh"
 
+class MCThreadPool;
+
 /*! Singleton class that handles loading of assets and instantiates
- *  all sub-managers (MCSurfaceManager, MCTextureFontManager, MCMeshManager) */
+ *  all sub-managers (MCSurfaceManager, MCTextureFontManager, MCMeshManager).
+ *  The images and models are decoded by a thread pool during load(). */
 class MCAssetManager
 {
 public:
+    /*! Called in the loading thread with the asset type ("surfaces" or "meshes"),
+     *  the number of assets of the type loaded so far and the total number of them. */
+    using ProgressCallback = std::function<void(const std::string & type, size_t loaded, size_t total)>;
+
     //! Constructor.
     explicit MCAssetManager(
       const std::string & baseDataPath = "",
@@ -47,7 +56,14 @@ public:
 
     static MCMeshManager & meshManager();
 
-    //! Loads all assets.
+    /*! Cache the processed surfaces and meshes in the given directory.
+     *  An empty path disables the cache. Call before load(). */
+    void setCachePath(const std::string & cachePath);
+
+    //! Set the callback for reporting the progress of load().
+    void setProgressCallback(ProgressCallback callback);
+
+    //! Loads all assets. Must be called in the thread owning the GL context.
     void load();
 
     //! Destructor.
@@ -68,6 +84,8 @@ private:
 
     MCMeshManager * m_meshManager;
 
+    std::unique_ptr<MCThreadPool> m_threadPool;
+
     std::string m_baseDataPath;
 
     std::string m_surfaceConfigPath;
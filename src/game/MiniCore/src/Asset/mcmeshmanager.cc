@@ -24,17 +24,98 @@
 #include "mcmeshconfigloader.hh"
 #include "mcmeshloader.hh"
 #include "mcsurface.hh"
+#include "mcthreadpool.hh"
 
+#include <QByteArray>
 #include <QDir>
+#include <QFile>
 #include <QString>
+#include <QTextStream>
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <vector>
 
 MCMeshManager::MCMeshManager()
+  : m_threadPool(nullptr)
 {
 }
 
+//! Serialize the faces as the face count followed by the vertex count and the vertices of each face.
+static std::vector<unsigned char> serializeFaces(const MCMesh::FaceVector & faces)
+{
+    using Vertex = MCMesh::Face::Vertex;
+
+    size_t size = sizeof(uint32_t);
+    for (auto && face : faces)
+    {
+        size += sizeof(uint32_t) + face.vertices.size() * sizeof(Vertex);
+    }
+
+    std::vector<unsigned char> buffer(size);
+    auto dst = buffer.data();
+    const auto write = [&dst](const void * src, size_t size) {
+        std::memcpy(dst, src, size);
+        dst += size;
+    };
+
+    const uint32_t faceCount = static_cast<uint32_t>(faces.size());
+    write(&faceCount, sizeof(faceCount));
+    for (auto && face : faces)
+    {
+        const uint32_t vertexCount = static_cast<uint32_t>(face.vertices.size());
+        write(&vertexCount, sizeof(vertexCount));
+        write(face.vertices.data(), vertexCount * sizeof(Vertex));
+    }
+
+    return buffer;
+}
+
+//! \return false if the data doesn't contain faces written by serializeFaces().
+static bool deserializeFaces(const unsigned char * data, size_t size, MCMesh::FaceVector & faces)
+{
+    using Vertex = MCMesh::Face::Vertex;
+
+    const auto end = data + size;
+    const auto readCount = [&data, end](uint32_t & count) {
+        if (static_cast<size_t>(end - data) < sizeof(count))
+        {
+            return false;
+        }
+
+        std::memcpy(&count, data, sizeof(count));
+        data += sizeof(count);
+        return true;
+    };
+
+    uint32_t faceCount = 0;
+    if (!readCount(faceCount))
+    {
+        return false;
+    }
+
+    faces.clear();
+    faces.reserve(faceCount);
+    for (uint32_t i = 0; i < faceCount; i++)
+    {
+        uint32_t vertexCount = 0;
+        if (!readCount(vertexCount) || static_cast<size_t>(end - data) / sizeof(Vertex) < vertexCount)
+        {
+            return false;
+        }
+
+        MCMesh::Face face;
+        face.vertices.resize(vertexCount);
+        std::memcpy(face.vertices.data(), data, vertexCount * sizeof(Vertex));
+        data += vertexCount * sizeof(Vertex);
+        faces.push_back(std::move(face));
+    }
+
+    return data == end;
+}
+
 MCMeshPtr MCMeshManager::createMesh(const MCMeshMetaData & data, const MCMesh::FaceVector & faces)
 {
     // Create material
@@ -64,29 +145,90 @@ MCMeshPtr MCMeshManager::createMesh(const MCMeshMetaData & data, const MCMesh::F
     return mesh;
 }
 
+MCMesh::FaceVector MCMeshManager::loadFaces(const QString & modelPath) const
+{
+    QFile modelFile(modelPath);
+    if (!modelFile.open(QIODevice::ReadOnly))
+    {
+        throw std::runtime_error("Loading mesh '" + modelPath.toStdString() + "' failed!");
+    }
+
+    const QByteArray modelData = modelFile.readAll();
+    const uint64_t key = m_cache ? MCAssetCache::hash(modelData.constData(), static_cast<size_t>(modelData.size())) : 0;
+    if (m_cache)
+    {
+        MCMesh::FaceVector faces;
+        if (const auto entry = m_cache->load(MCAssetCache::Type::Mesh, key); entry && deserializeFaces(entry->data(), entry->size(), faces))
+        {
+            return faces;
+        }
+    }
+
+    MCMeshLoader modelLoader;
+    QTextStream in { modelData };
+    in.setEncoding(QStringConverter::Utf8);
+    modelLoader.readStream(in);
+
+    if (m_cache)
+    {
+        const auto buffer = serializeFaces(modelLoader.faces());
+        m_cache->store(MCAssetCache::Type::Mesh, key, { { buffer.data(), buffer.size() } });
+    }
+
+    return modelLoader.faces();
+}
+
 void MCMeshManager::load(const std::string & configFilePath, const std::string & baseDataPath)
 {
     MCMeshConfigLoader configLoader;
-    MCMeshLoader modelLoader;
 
     if (configLoader.load(configFilePath))
     {
-        for (size_t i = 0; i < configLoader.meshCount(); i++)
-        {
-            auto && metaData = configLoader.mesh(i);
+        const size_t meshCount = configLoader.meshCount();
+        std::vector<MCMesh::FaceVector> faces(meshCount);
+        std::vector<std::exception_ptr> errors(meshCount);
+        const auto parse = [&](size_t i) {
+            try
+            {
+                QString modelPath =
+                  QString(baseDataPath.c_str()) + QDir::separator().toLatin1() + configLoader.mesh(i)->modelPath.c_str();
+                modelPath.replace("./", "");
+                modelPath.replace("//", "/");
+
+                faces[i] = loadFaces(modelPath);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        };
 
-            QString modelPath =
-              QString(baseDataPath.c_str()) + QDir::separator().toLatin1() + metaData->modelPath.c_str();
-            modelPath.replace("./", "");
-            modelPath.replace("//", "/");
+        // The models are parsed in parallel, but the meshes are created in this thread,
+        // because it owns the GL context
+        if (m_threadPool)
+        {
+            m_threadPool->run(meshCount, parse);
+        }
+        else
+        {
+            for (size_t i = 0; i < meshCount; i++)
+            {
+                parse(i);
+            }
+        }
 
-            if (modelLoader.load(modelPath))
+        for (size_t i = 0; i < meshCount; i++)
+        {
+            if (errors[i])
             {
-                createMesh(*metaData, modelLoader.faces());
+                std::rethrow_exception(errors[i]);
             }
-            else
+
+            createMesh(*configLoader.mesh(i), faces[i]);
+
+            if (m_progressCallback)
             {
-                throw std::runtime_error("Loading mesh '" + modelPath.toStdString() + "' failed!");
+                m_progressCallback(i + 1, meshCount);
             }
         }
     }
@@ -96,6 +238,21 @@ void MCMeshManager::load(const std::string & configFilePath, const std::string &
     }
 }
 
+void MCMeshManager::setCache(MCAssetCachePtr cache)
+{
+    m_cache = cache;
+}
+
+void MCMeshManager::setThreadPool(MCThreadPool * threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+void MCMeshManager::setProgressCallback(ProgressCallback callback)
+{
+    m_progressCallback = callback;
+}
+
 MCMeshPtr MCMeshManager::mesh(const std::string & handle) const
 {
     // Try to find existing mesh for the handle
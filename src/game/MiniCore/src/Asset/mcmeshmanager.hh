@@ -20,14 +20,19 @@
 #ifndef MCMESHMANAGER_HH
 #define MCMESHMANAGER_HH
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 
+#include "mcassetcache.hh"
 #include "mcmacros.hh"
 #include "mcmesh.hh"
 #include "mcmeshmetadata.hh"
 
+class MCThreadPool;
+class QString;
+
 /*! Mesh manager base class. Can be used via MCAssetManager.
  *
  * It loads model data (only .obj supported) listed in a special mapping
@@ -53,10 +58,16 @@
  *   </mesh>
  *   <mesh handle="bridge" model="bridge.obj" texture1="asphalt"/>
  * </meshes>
+ *
+ * If a cache is set, the parsed faces are stored in it keyed by the contents of the model file.
+ * If a thread pool is set, the models are parsed in parallel.
  */
 class MCMeshManager
 {
 public:
+    //! Called with the number of meshes loaded so far and the total number of meshes.
+    using ProgressCallback = std::function<void(size_t loaded, size_t total)>;
+
     //! Constructor.
     MCMeshManager();
 
@@ -82,10 +93,28 @@ public:
     //! Create a mesh from given meta data and face vector.
     MCMeshPtr createMesh(const MCMeshMetaData & data, const MCMesh::FaceVector & faces);
 
+    //! Set the cache used by load() for the parsed models. Can be nullptr.
+    void setCache(MCAssetCachePtr cache);
+
+    //! Set the thread pool used by load() for parsing the models. Can be nullptr.
+    void setThreadPool(MCThreadPool * threadPool);
+
+    //! Set the callback called by load() in the calling thread after each mesh.
+    void setProgressCallback(ProgressCallback callback);
+
 private:
+    //! Parse the given model file or get the faces from the cache. Can be called in any thread.
+    MCMesh::FaceVector loadFaces(const QString & modelPath) const;
+
     typedef std::unordered_map<std::string, MCMeshPtr> MeshHash;
     MeshHash m_meshMap;
 
+    MCAssetCachePtr m_cache;
+
+    MCThreadPool * m_threadPool;
+
+    ProgressCallback m_progressCallback;
+
     DISABLE_COPY(MCMeshManager);
     DISABLE_ASSI(MCMeshManager);
     DISABLE_MOVE(MCMeshManager);
@@ -0,0 +1,412 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "mcpixelkernels.hh"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MC_PIXEL_KERNELS_SSE2
+#include <emmintrin.h>
+// Allow the SSE2 kernels also when the compiler doesn't assume SSE2 (32-bit x86)
+#if defined(__GNUC__) && !defined(__SSE2__)
+#define MC_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define MC_TARGET_SSE2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MC_PIXEL_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+//! The texture options as per-channel ranges that the kernels can test directly.
+struct TextureParams
+{
+    //! Alpha limit in 0..256.
+    uint32_t alphaLimit;
+
+    bool colorKeySet;
+
+    //! Inclusive ranges of matching values as 0xAARRGGBB. Alpha always matches.
+    uint32_t keyLow;
+
+    uint32_t keyHigh;
+};
+
+TextureParams textureParams(const MCPixelKernels::TextureOptions & options)
+{
+    TextureParams params;
+    params.alphaLimit = std::min(options.alphaClamp, 256u);
+    params.colorKeySet = options.colorKeySet;
+    params.keyLow = 0;
+    params.keyHigh = 0xff000000;
+
+    const auto addRange = [&params](unsigned int key, int shift) {
+        // Keys above 257 never match, an empty range (1..0) is used for them
+        const int low = key > 257 ? 1 : std::max(static_cast<int>(key) - 2, 0);
+        const int high = key > 257 ? 0 : std::min(static_cast<int>(key) + 2, 255);
+        params.keyLow |= static_cast<uint32_t>(low) << shift;
+        params.keyHigh |= static_cast<uint32_t>(high) << shift;
+    };
+
+    addRange(options.colorKeyR, 16);
+    addRange(options.colorKeyG, 8);
+    addRange(options.colorKeyB, 0);
+
+    return params;
+}
+
+inline bool inRange(uint32_t pixel, uint32_t low, uint32_t high, int shift)
+{
+    const uint32_t value = (pixel >> shift) & 0xff;
+    return value >= ((low >> shift) & 0xff) && value <= ((high >> shift) & 0xff);
+}
+
+inline uint32_t texturePixel(uint32_t pixel, const TextureParams & params)
+{
+    if ((pixel >> 24) < params.alphaLimit)
+    {
+        pixel = 0;
+    }
+
+    if (params.colorKeySet)
+    {
+        if (inRange(pixel, params.keyLow, params.keyHigh, 16) && inRange(pixel, params.keyLow, params.keyHigh, 8) && inRange(pixel, params.keyLow, params.keyHigh, 0))
+        {
+            pixel = 0;
+        }
+        else
+        {
+            pixel |= 0xff000000;
+        }
+    }
+
+    return pixel;
+}
+
+inline void storeRGBA(uint32_t pixel, unsigned char * dst)
+{
+    // Byte-wise, so the result doesn't depend on the byte order
+    dst[0] = static_cast<unsigned char>(pixel >> 16);
+    dst[1] = static_cast<unsigned char>(pixel >> 8);
+    dst[2] = static_cast<unsigned char>(pixel);
+    dst[3] = static_cast<unsigned char>(pixel >> 24);
+}
+
+inline uint32_t histogramIndex(uint32_t pixel)
+{
+    return ((pixel >> 9) & 0x7c00) | ((pixel >> 6) & 0x03e0) | ((pixel >> 3) & 0x001f);
+}
+
+void textureRowScalar(const uint32_t * src, unsigned char * dst, size_t count, const TextureParams & params)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        storeRGBA(texturePixel(src[i], params), dst + i * 4);
+    }
+}
+
+void addToHistogramScalar(const uint32_t * src, size_t count, uint32_t * histogram)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((src[i] >> 24) > 128)
+        {
+            histogram[histogramIndex(src[i])]++;
+        }
+    }
+}
+
+#ifdef MC_PIXEL_KERNELS_SSE2
+MC_TARGET_SSE2 void textureRowSSE2(const uint32_t * src, unsigned char * dst, size_t count, const TextureParams & params)
+{
+    const __m128i alphaLimit = _mm_set1_epi32(static_cast<int>(params.alphaLimit));
+    const __m128i keyLow = _mm_set1_epi32(static_cast<int>(params.keyLow));
+    const __m128i keyHigh = _mm_set1_epi32(static_cast<int>(params.keyHigh));
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i greenAlphaMask = _mm_set1_epi32(static_cast<int>(0xff00ff00));
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    const __m128i allSet = _mm_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+
+        // Alpha clamp
+        const __m128i clear = _mm_cmplt_epi32(_mm_srli_epi32(pixels, 24), alphaLimit);
+        pixels = _mm_andnot_si128(clear, pixels);
+
+        // Color key: all bytes within the ranges
+        if (params.colorKeySet)
+        {
+            const __m128i aboveLow = _mm_cmpeq_epi8(_mm_max_epu8(pixels, keyLow), pixels);
+            const __m128i belowHigh = _mm_cmpeq_epi8(_mm_min_epu8(pixels, keyHigh), pixels);
+            const __m128i match = _mm_cmpeq_epi32(_mm_and_si128(aboveLow, belowHigh), allSet);
+            pixels = _mm_andnot_si128(match, _mm_or_si128(pixels, alphaMask));
+        }
+
+        // ARGB => RGBA in memory by swapping red and blue
+        const __m128i red = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+        const __m128i blue = _mm_slli_epi32(_mm_and_si128(pixels, byteMask), 16);
+        pixels = _mm_or_si128(_mm_and_si128(pixels, greenAlphaMask), _mm_or_si128(red, blue));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), pixels);
+    }
+
+    textureRowScalar(src + i, dst + i * 4, count - i, params);
+}
+
+MC_TARGET_SSE2 void addToHistogramSSE2(const uint32_t * src, size_t count, uint32_t * histogram)
+{
+    const __m128i redMask = _mm_set1_epi32(0x7c00);
+    const __m128i greenMask = _mm_set1_epi32(0x03e0);
+    const __m128i blueMask = _mm_set1_epi32(0x001f);
+    const __m128i alphaLimit = _mm_set1_epi32(128);
+
+    alignas(16) uint32_t indices[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const int opaque = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(_mm_srli_epi32(pixels, 24), alphaLimit)));
+        if (!opaque)
+        {
+            continue;
+        }
+
+        const __m128i index = _mm_or_si128(
+          _mm_and_si128(_mm_srli_epi32(pixels, 9), redMask),
+          _mm_or_si128(_mm_and_si128(_mm_srli_epi32(pixels, 6), greenMask), _mm_and_si128(_mm_srli_epi32(pixels, 3), blueMask)));
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), index);
+
+        for (int j = 0; j < 4; j++)
+        {
+            if (opaque & (1 << j))
+            {
+                histogram[indices[j]]++;
+            }
+        }
+    }
+
+    addToHistogramScalar(src + i, count - i, histogram);
+}
+#endif
+
+#ifdef MC_PIXEL_KERNELS_NEON
+inline uint8x16_t inRangeNEON(uint8x16_t value, uint32_t low, uint32_t high, int shift)
+{
+    return vandq_u8(vcgeq_u8(value, vdupq_n_u8(static_cast<uint8_t>(low >> shift))), vcleq_u8(value, vdupq_n_u8(static_cast<uint8_t>(high >> shift))));
+}
+
+void textureRowNEON(const uint32_t * src, unsigned char * dst, size_t count, const TextureParams & params)
+{
+    // The alpha limit of 256 clears everything
+    const uint8x16_t alphaLimit = vdupq_n_u8(static_cast<uint8_t>(std::min(params.alphaLimit, 255u)));
+    const uint8x16_t clearAll = vdupq_n_u8(params.alphaLimit > 255 ? 0xff : 0);
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // Deinterleave into B, G, R and A planes
+        uint8x16x4_t pixels = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+
+        const uint8x16_t clear = vorrq_u8(vcltq_u8(pixels.val[3], alphaLimit), clearAll);
+        for (int c = 0; c < 4; c++)
+        {
+            pixels.val[c] = vbicq_u8(pixels.val[c], clear);
+        }
+
+        if (params.colorKeySet)
+        {
+            const uint8x16_t match = vandq_u8(
+              inRangeNEON(pixels.val[2], params.keyLow, params.keyHigh, 16),
+              vandq_u8(inRangeNEON(pixels.val[1], params.keyLow, params.keyHigh, 8), inRangeNEON(pixels.val[0], params.keyLow, params.keyHigh, 0)));
+            pixels.val[3] = vdupq_n_u8(0xff);
+            for (int c = 0; c < 4; c++)
+            {
+                pixels.val[c] = vbicq_u8(pixels.val[c], match);
+            }
+        }
+
+        uint8x16x4_t rgba;
+        rgba.val[0] = pixels.val[2];
+        rgba.val[1] = pixels.val[1];
+        rgba.val[2] = pixels.val[0];
+        rgba.val[3] = pixels.val[3];
+        vst4q_u8(dst + i * 4, rgba);
+    }
+
+    textureRowScalar(src + i, dst + i * 4, count - i, params);
+}
+
+void addToHistogramNEON(const uint32_t * src, size_t count, uint32_t * histogram)
+{
+    const uint32x4_t redMask = vdupq_n_u32(0x7c00);
+    const uint32x4_t greenMask = vdupq_n_u32(0x03e0);
+    const uint32x4_t blueMask = vdupq_n_u32(0x001f);
+    const uint32x4_t alphaLimit = vdupq_n_u32(128);
+
+    uint32_t indices[4];
+    uint32_t opaque[4];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint32x4_t pixels = vld1q_u32(src + i);
+        vst1q_u32(opaque, vcgtq_u32(vshrq_n_u32(pixels, 24), alphaLimit));
+        vst1q_u32(indices,
+                  vorrq_u32(vandq_u32(vshrq_n_u32(pixels, 9), redMask),
+                            vorrq_u32(vandq_u32(vshrq_n_u32(pixels, 6), greenMask), vandq_u32(vshrq_n_u32(pixels, 3), blueMask))));
+
+        for (int j = 0; j < 4; j++)
+        {
+            if (opaque[j])
+            {
+                histogram[indices[j]]++;
+            }
+        }
+    }
+
+    addToHistogramScalar(src + i, count - i, histogram);
+}
+#endif
+
+MCPixelKernels::Implementation fastestImplementation()
+{
+    if (MCPixelKernels::isSupported(MCPixelKernels::Implementation::NEON))
+    {
+        return MCPixelKernels::Implementation::NEON;
+    }
+
+    if (MCPixelKernels::isSupported(MCPixelKernels::Implementation::SSE2))
+    {
+        return MCPixelKernels::Implementation::SSE2;
+    }
+
+    return MCPixelKernels::Implementation::Scalar;
+}
+
+//! The kernels are run in the asset loading threads
+std::atomic<MCPixelKernels::Implementation> & currentImplementation()
+{
+    static std::atomic<MCPixelKernels::Implementation> implementation { fastestImplementation() };
+    return implementation;
+}
+
+} // namespace
+
+MCPixelKernels::Implementation MCPixelKernels::implementation()
+{
+    return currentImplementation().load(std::memory_order_relaxed);
+}
+
+bool MCPixelKernels::setImplementation(Implementation implementation)
+{
+    if (!isSupported(implementation))
+    {
+        return false;
+    }
+
+    currentImplementation().store(implementation, std::memory_order_relaxed);
+    return true;
+}
+
+bool MCPixelKernels::isSupported(Implementation implementation)
+{
+    switch (implementation)
+    {
+    case Implementation::Scalar:
+        return true;
+    case Implementation::SSE2:
+#if defined(MC_PIXEL_KERNELS_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+        return true;
+#elif defined(MC_PIXEL_KERNELS_SSE2) && defined(__GNUC__)
+        return __builtin_cpu_supports("sse2");
+#else
+        return false;
+#endif
+    case Implementation::NEON:
+#ifdef MC_PIXEL_KERNELS_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return false;
+}
+
+void MCPixelKernels::textureRow(const uint32_t * src, unsigned char * dst, size_t count, const TextureOptions & options)
+{
+    const auto params = textureParams(options);
+    switch (implementation())
+    {
+#ifdef MC_PIXEL_KERNELS_SSE2
+    case Implementation::SSE2:
+        textureRowSSE2(src, dst, count, params);
+        break;
+#endif
+#ifdef MC_PIXEL_KERNELS_NEON
+    case Implementation::NEON:
+        textureRowNEON(src, dst, count, params);
+        break;
+#endif
+    default:
+        textureRowScalar(src, dst, count, params);
+        break;
+    }
+}
+
+void MCPixelKernels::addToHistogram(const uint32_t * src, size_t count, uint32_t * histogram)
+{
+    switch (implementation())
+    {
+#ifdef MC_PIXEL_KERNELS_SSE2
+    case Implementation::SSE2:
+        addToHistogramSSE2(src, count, histogram);
+        break;
+#endif
+#ifdef MC_PIXEL_KERNELS_NEON
+    case Implementation::NEON:
+        addToHistogramNEON(src, count, histogram);
+        break;
+#endif
+    default:
+        addToHistogramScalar(src, count, histogram);
+        break;
+    }
+}
+
+size_t MCPixelKernels::histogramPeak(const uint32_t * histogram)
+{
+    size_t peak = 0;
+    for (size_t i = 1; i < HISTOGRAM_SIZE; i++)
+    {
+        if (histogram[i] > histogram[peak])
+        {
+            peak = i;
+        }
+    }
+
+    return peak;
+}
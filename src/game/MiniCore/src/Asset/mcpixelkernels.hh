@@ -0,0 +1,88 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#ifndef MCPIXELKERNELS_HH
+#define MCPIXELKERNELS_HH
+
+#include <cstddef>
+#include <cstdint>
+
+/*! Kernels for processing rows of pixels stored like QImage::Format_ARGB32, i.e. each
+ *  pixel is a 0xAARRGGBB value in native byte order. SSE2 or NEON is used when supported
+ *  by the CPU, otherwise the kernels fall back to plain C++. All implementations give
+ *  bit-exact results.
+ *
+ *  The kernels don't use Qt or GL, so they can be run in any thread. */
+class MCPixelKernels
+{
+public:
+    enum class Implementation
+    {
+        Scalar,
+        SSE2,
+        NEON
+    };
+
+    //! Settings for textureRow().
+    struct TextureOptions
+    {
+        //! Pixels with alpha below this are cleared. Zero disables the clamp.
+        unsigned int alphaClamp = 0;
+
+        //! True if the color key is used.
+        bool colorKeySet = false;
+
+        unsigned int colorKeyR = 0;
+
+        unsigned int colorKeyG = 0;
+
+        unsigned int colorKeyB = 0;
+    };
+
+    //! Number of bins in the color histogram with 5 bits per channel.
+    static const size_t HISTOGRAM_SIZE = 32 * 32 * 32;
+
+    //! \return the implementation in use. Defaults to the fastest one supported.
+    static Implementation implementation();
+
+    //! Force the given implementation, e.g. for tests. \return false if not supported.
+    static bool setImplementation(Implementation implementation);
+
+    //! \return true if the implementation is compiled in and supported by the CPU.
+    static bool isSupported(Implementation implementation);
+
+    /*! Apply the alpha clamp and the color key and convert to GL_RGBA byte order in one pass.
+     *  The alpha clamp is applied first. The color key then clears the pixels having each color
+     *  channel within +-2 of the key and makes the other pixels opaque.
+     *  \param dst count * 4 bytes. Must not overlap with src. */
+    static void textureRow(const uint32_t * src, unsigned char * dst, size_t count, const TextureOptions & options);
+
+    /*! Count the pixels with alpha above 128 in the histogram.
+     *  \param histogram HISTOGRAM_SIZE bins indexed by (r / 8) << 10 | (g / 8) << 5 | b / 8. */
+    static void addToHistogram(const uint32_t * src, size_t count, uint32_t * histogram);
+
+    //! \return index of the fullest bin. The first one wins on a tie.
+    static size_t histogramPeak(const uint32_t * histogram);
+
+private:
+    MCPixelKernels() = delete;
+};
+
+#endif // MCPIXELKERNELS_HH
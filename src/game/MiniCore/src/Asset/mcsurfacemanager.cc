@@ -18,233 +18,129 @@
 //
 
 #include "mcsurfacemanager.hh"
+#include "mcassetcache.hh"
+#include "mcglshaderprogram.hh"
+#include "mcgltexcoord.hh"
 #include "mclogger.hh"
+#include "mcpixelkernels.hh"
 #include "mcsurface.hh"
 #include "mcsurfaceconfigloader.hh"
+#include "mctextureatlas.hh"
+#include "mcthreadpool.hh"
 
 #include <MCGLEW>
 #include <QByteArray>
 #include <QDir>
 #include <QFile>
 #include <QImage>
-#include <QSysInfo>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <unordered_set>
 
-inline bool colorMatch(int val1, int val2, int threshold)
-{
-    return (val1 >= val2 - threshold) && (val1 <= val2 + threshold);
-}
+namespace {
+//! Pixels reserved around each surface in an atlas.
+const int ATLAS_PADDING = 2;
+
+//! Upper limit for the atlas size in addition to GL_MAX_TEXTURE_SIZE.
+const int MAX_ATLAS_SIZE = 2048;
 
-// This function is taken from Qt in order to drop dependency to QGLWidget::convertToGLFormat().
-static inline QRgb qt_gl_convertToGLFormatHelper(QRgb src_pixel, GLenum texture_format)
+//! Header of a cached texture. The GL_RGBA pixels follow the header.
+struct TextureCacheHeader
 {
-#ifdef __MC_GLES__
-    (void)texture_format;
-    if (false)
-    {
-#else
-    if (texture_format == GL_BGRA)
-    {
-#endif
-        if (QSysInfo::ByteOrder == QSysInfo::BigEndian)
-        {
-            return ((src_pixel << 24) & 0xff000000)
-              | ((src_pixel >> 24) & 0x000000ff)
-              | ((src_pixel << 8) & 0x00ff0000)
-              | ((src_pixel >> 8) & 0x0000ff00);
-        }
-        else
-        {
-            return src_pixel;
-        }
-    }
-    else
-    { // GL_RGBA
-        if (QSysInfo::ByteOrder == QSysInfo::BigEndian)
-        {
-            return (src_pixel << 8) | ((src_pixel >> 24) & 0xff);
-        }
-        else
-        {
-            return ((src_pixel << 16) & 0xff0000)
-              | ((src_pixel >> 16) & 0xff)
-              | (src_pixel & 0xff00ff00);
-        }
-    }
-}
+    int32_t width;
+
+    int32_t height;
+
+    int32_t imageWidth;
+
+    int32_t imageHeight;
 
-// This function is taken from Qt in order to drop dependency to QGLWidget::convertToGLFormat().
-static void convertToGLFormatHelper(QImage & dst, const QImage & img, GLenum texture_format)
+    float averageColor[3];
+
+    //! Keeps the pixels aligned.
+    int32_t reserved;
+};
+
+static_assert(sizeof(TextureCacheHeader) == 32, "Texture cache header must not have padding");
+} // namespace
+
+struct MCSurfaceManager::TextureData
 {
-    Q_ASSERT(dst.depth() == 32);
-    Q_ASSERT(img.depth() == 32);
+    //! Dimensions of the texture.
+    int width = 0;
 
-    if (dst.size() != img.size())
-    {
-        int target_width = dst.width();
-        int target_height = dst.height();
-        qreal sx = target_width / qreal(img.width());
-        qreal sy = target_height / qreal(img.height());
+    int height = 0;
 
-        quint32 * dest = (quint32 *)dst.scanLine(0); // NB! avoid detach here
-        uchar * srcPixels = (uchar *)img.scanLine(img.height() - 1);
-        int sbpl = img.bytesPerLine();
-        int dbpl = dst.bytesPerLine();
+    //! Dimensions of the image after the size divider. These are the default dimensions of the surface.
+    int imageWidth = 0;
 
-        int ix = int(0x00010000 / sx);
-        int iy = int(0x00010000 / sy);
+    int imageHeight = 0;
 
-        quint32 basex = int(0.5 * ix);
-        quint32 srcy = int(0.5 * iy);
+    MCGLColor averageColor;
 
-        // scale, swizzle and mirror in one loop
-        while (target_height--)
-        {
-            const uint * src = (const quint32 *)(srcPixels - (srcy >> 16) * sbpl);
-            int srcx = basex;
-            for (int x = 0; x < target_width; ++x)
-            {
-                dest[x] = qt_gl_convertToGLFormatHelper(src[srcx >> 16], texture_format);
-                srcx += ix;
-            }
-            dest = (quint32 *)(((uchar *)dest) + dbpl);
-            srcy += iy;
-        }
-    }
-    else
-    {
-        const int width = img.width();
-        const int height = img.height();
-        const uint * p = (const uint *)img.scanLine(img.height() - 1);
-        uint * q = (uint *)dst.scanLine(0);
+    //! GL_RGBA rows from bottom to top. Owned by either the image or the cache entry.
+    const unsigned char * pixels = nullptr;
 
-#ifdef __MC_GLES__
-        if (false)
-        {
-#else
-        if (texture_format == GL_BGRA)
-        {
-#endif
-            if (QSysInfo::ByteOrder == QSysInfo::BigEndian)
-            {
-                // mirror + swizzle
-                for (int i = 0; i < height; ++i)
-                {
-                    const uint * end = p + width;
-                    while (p < end)
-                    {
-                        *q = ((*p << 24) & 0xff000000)
-                          | ((*p >> 24) & 0x000000ff)
-                          | ((*p << 8) & 0x00ff0000)
-                          | ((*p >> 8) & 0x0000ff00);
-                        p++;
-                        q++;
-                    }
-                    p -= 2 * width;
-                }
-            }
-            else
-            {
-                const uint bytesPerLine = img.bytesPerLine();
-                for (int i = 0; i < height; ++i)
-                {
-                    memcpy(q, p, bytesPerLine);
-                    q += width;
-                    p -= width;
-                }
-            }
-        }
-        else
-        {
-            if (QSysInfo::ByteOrder == QSysInfo::BigEndian)
-            {
-                for (int i = 0; i < height; ++i)
-                {
-                    const uint * end = p + width;
-                    while (p < end)
-                    {
-                        *q = (*p << 8) | ((*p >> 24) & 0xff);
-                        p++;
-                        q++;
-                    }
-                    p -= 2 * width;
-                }
-            }
-            else
-            {
-                for (int i = 0; i < height; ++i)
-                {
-                    const uint * end = p + width;
-                    while (p < end)
-                    {
-                        *q = ((*p << 16) & 0xff0000) | ((*p >> 16) & 0xff) | (*p & 0xff00ff00);
-                        p++;
-                        q++;
-                    }
-                    p -= 2 * width;
-                }
-            }
-        }
-    }
-}
+    QImage image;
+
+    std::unique_ptr<MCAssetCache::Entry> cacheEntry;
+};
 
 MCSurfaceManager::MCSurfaceManager()
+  : m_threadPool(nullptr)
 {
 }
 
-MCGLColor getAverageColor(QImage image)
+static MCGLColor getAverageColor(const QImage & image)
 {
-    std::map<int, int> colorCounts;
-    const int scale = 8;
-    for (int i = 0; i < image.width(); i++)
-    {
-        for (int j = 0; j < image.height(); j++)
-        {
-            if (((image.pixel(i, j) & 0xff000000) >> 24) > 128)
-            {
-                const int r = ((image.pixel(i, j) & 0x00ff0000) >> 16) / scale;
-                const int g = ((image.pixel(i, j) & 0x0000ff00) >> 8) / scale;
-                const int b = ((image.pixel(i, j) & 0x000000ff)) / scale;
-                colorCounts[(r << 16) + (g << 8) + b]++;
-            }
-        }
-    }
-    int bestColor = 0;
-    int bestCount = 0;
-    for (auto && color : colorCounts)
+    const QImage argbImage = image.format() == QImage::Format_ARGB32 ? image : image.convertToFormat(QImage::Format_ARGB32);
+
+    // The most common color with 5 bits per channel
+    std::vector<uint32_t> histogram(MCPixelKernels::HISTOGRAM_SIZE, 0);
+    for (int j = 0; j < argbImage.height(); j++)
     {
-        if (color.second > bestCount)
-        {
-            bestCount = color.second;
-            bestColor = color.first;
-        }
+        MCPixelKernels::addToHistogram(reinterpret_cast<const uint32_t *>(argbImage.constScanLine(j)), static_cast<size_t>(argbImage.width()), histogram.data());
     }
+
+    const int scale = 8;
+    const auto bestColor = static_cast<int>(MCPixelKernels::histogramPeak(histogram.data()));
     return MCGLColor(
-      static_cast<float>(((bestColor & 0xff0000) >> 16) * scale) / 256,
-      static_cast<float>(((bestColor & 0x00ff00) >> 8) * scale) / 256,
-      static_cast<float>((bestColor & 0x0000ff) * scale) / 256);
+      static_cast<float>(((bestColor >> 10) & 0x1f) * scale) / 256,
+      static_cast<float>(((bestColor >> 5) & 0x1f) * scale) / 256,
+      static_cast<float>((bestColor & 0x1f) * scale) / 256);
 }
 
 std::shared_ptr<MCSurface> MCSurfaceManager::createSurfaceFromImage(const MCSurfaceMetaData & data, QImage image)
+{
+    GLint maxTextureSize = 0;
+    if (!MCGLObjectBase::headless())
+    {
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    }
+
+    return createSurface(data, createTextureData(data, image, true, maxTextureSize));
+}
+
+std::shared_ptr<MCSurface> MCSurfaceManager::createSurface(const MCSurfaceMetaData & data, const TextureData & textureData)
 {
     if (data.handle.size() == 0)
     {
         throw std::runtime_error("Cannot create surface with an empty handle!");
     }
 
-    image = image.scaled(image.width() / data.sizeDivider, image.height() / data.sizeDivider);
-
     // Store original width of the image
-    int origH = data.height.second ? data.height.first : image.height();
-    int origW = data.width.second ? data.width.first : image.width();
+    int origH = data.height.second ? data.height.first : textureData.imageHeight;
+    int origW = data.width.second ? data.width.first : textureData.imageWidth;
 
     // Create material. Possible secondary textures are taken from surfaces
     // that are initialized before this surface.
     MCGLMaterialPtr material(new MCGLMaterial);
-    material->setTexture(create2DTextureFromImage(data, image), 0);
+    material->setTexture(!MCGLObjectBase::headless() ? create2DTexture(data, textureData.width, textureData.height, textureData.pixels) : 0, 0);
     material->setTexture(data.handle2.length() ? surface(data.handle2)->material()->texture(0) : 0, 1);
     material->setTexture(data.handle3.length() ? surface(data.handle3)->material()->texture(0) : 0, 2);
 
@@ -258,7 +154,7 @@ std::shared_ptr<MCSurface> MCSurfaceManager::createSurfaceFromImage(const MCSurf
 
     // Maybe better place for this could be in the material?
     surface->setColor(data.color);
-    surface->setAverageColor(getAverageColor(image));
+    surface->setAverageColor(textureData.averageColor);
 
     createSurfaceCommon(surface, data);
 
@@ -319,17 +215,151 @@ static QImage forceToNearestPowerOfTwoImage(const MCSurfaceMetaData & data, cons
     return image.scaled(width, height);
 }
 #endif
-GLuint MCSurfaceManager::create2DTextureFromImage(const MCSurfaceMetaData & data, const QImage & image)
+MCSurfaceManager::TextureData MCSurfaceManager::createTextureData(const MCSurfaceMetaData & data, const QImage & image, bool forcePowerOfTwo, GLint maxTextureSize) const
 {
+    const QImage scaledImage = image.scaled(image.width() / data.sizeDivider, image.height() / data.sizeDivider);
+
+    TextureData textureData;
+    textureData.imageWidth = scaledImage.width();
+    textureData.imageHeight = scaledImage.height();
+    textureData.averageColor = getAverageColor(scaledImage);
+
+    // Only the dimensions and the color are needed without GL
+    if (MCGLObjectBase::headless())
+    {
+        return textureData;
+    }
+
 #ifdef __MC_GLES__
-    QImage textureImage = forceToNearestPowerOfTwoImage(data, image);
+    const QImage textureImage = prepareTextureImage(data, forcePowerOfTwo ? forceToNearestPowerOfTwoImage(data, scaledImage) : scaledImage, maxTextureSize);
 #else
-    QImage textureImage = image;
+    (void)forcePowerOfTwo;
+    const QImage textureImage = prepareTextureImage(data, scaledImage, maxTextureSize);
 #endif
 
+    // Apply the alpha settings, convert to GL_RGBA and flip in one pass, as GL expects the rows from bottom to top
+    MCPixelKernels::TextureOptions options;
+    if (data.alphaClamp.second)
+    {
+        options.alphaClamp = static_cast<unsigned int>(255.0f * data.alphaClamp.first);
+    }
+
+    if (data.colorKeySet)
+    {
+        options.colorKeySet = true;
+        options.colorKeyR = data.colorKey.m_r;
+        options.colorKeyG = data.colorKey.m_g;
+        options.colorKeyB = data.colorKey.m_b;
+    }
+
+    textureData.image = QImage(textureImage.width(), textureImage.height(), QImage::Format_ARGB32);
+    for (int j = 0; j < textureImage.height(); j++)
+    {
+        MCPixelKernels::textureRow(
+          reinterpret_cast<const uint32_t *>(textureImage.constScanLine(textureImage.height() - 1 - j)), textureData.image.scanLine(j),
+          static_cast<size_t>(textureImage.width()), options);
+    }
+
+    textureData.width = textureData.image.width();
+    textureData.height = textureData.image.height();
+    textureData.pixels = textureData.image.constBits();
+
+    return textureData;
+}
+
+//! \return key of the texture data created from the given file and the meta data.
+static uint64_t textureCacheKey(const MCSurfaceMetaData & data, const QByteArray & fileData, GLint maxTextureSize, bool forcePowerOfTwo)
+{
+    uint64_t key = MCAssetCache::hash(fileData.constData(), static_cast<size_t>(fileData.size()));
+    const auto combine = [&key](const auto & value) {
+        key = MCAssetCache::hash(&value, sizeof(value), key);
+    };
+
+    // Only the settings affecting the pixels. The rest is applied when the surface is created.
+    combine(data.sizeDivider);
+    combine(data.xAxisMirror);
+    combine(data.yAxisMirror);
+    combine(data.colorKeySet);
+    if (data.colorKeySet)
+    {
+        combine(data.colorKey.m_r);
+        combine(data.colorKey.m_g);
+        combine(data.colorKey.m_b);
+    }
+
+    combine(data.alphaClamp.second);
+    if (data.alphaClamp.second)
+    {
+        combine(data.alphaClamp.first);
+    }
+
+    combine(maxTextureSize);
+    combine(forcePowerOfTwo);
+
+    return key;
+}
+
+MCSurfaceManager::TextureData MCSurfaceManager::loadTextureData(
+  const MCSurfaceMetaData & data, const QByteArray & fileData, bool forcePowerOfTwo, GLint maxTextureSize, bool & cached) const
+{
+    cached = false;
+
+    if (!m_cache || MCGLObjectBase::headless())
+    {
+        QImage image;
+        image.loadFromData(fileData);
+        return createTextureData(data, image, forcePowerOfTwo, maxTextureSize);
+    }
+
+    const uint64_t key = textureCacheKey(data, fileData, maxTextureSize, forcePowerOfTwo);
+
+    if (auto entry = m_cache->load(MCAssetCache::Type::Texture, key); entry && entry->size() >= sizeof(TextureCacheHeader))
+    {
+        TextureCacheHeader header;
+        std::memcpy(&header, entry->data(), sizeof(TextureCacheHeader));
+        if (header.width > 0 && header.height > 0 && entry->size() == sizeof(TextureCacheHeader) + static_cast<size_t>(header.width) * header.height * 4)
+        {
+            TextureData textureData;
+            textureData.width = header.width;
+            textureData.height = header.height;
+            textureData.imageWidth = header.imageWidth;
+            textureData.imageHeight = header.imageHeight;
+            textureData.averageColor = MCGLColor(header.averageColor[0], header.averageColor[1], header.averageColor[2]);
+            textureData.pixels = entry->data() + sizeof(TextureCacheHeader);
+            textureData.cacheEntry = std::move(entry);
+            cached = true;
+            return textureData;
+        }
+    }
+
+    QImage image;
+    image.loadFromData(fileData);
+    auto textureData = createTextureData(data, image, forcePowerOfTwo, maxTextureSize);
+
+    TextureCacheHeader header;
+    header.width = textureData.width;
+    header.height = textureData.height;
+    header.imageWidth = textureData.imageWidth;
+    header.imageHeight = textureData.imageHeight;
+    header.averageColor[0] = textureData.averageColor.r();
+    header.averageColor[1] = textureData.averageColor.g();
+    header.averageColor[2] = textureData.averageColor.b();
+    header.reserved = 0;
+
+    const size_t pixelsSize = static_cast<size_t>(textureData.width) * textureData.height * 4;
+    if (!m_cache->store(MCAssetCache::Type::Texture, key, { { &header, sizeof(header) }, { textureData.pixels, pixelsSize } }))
+    {
+        MCLogger().warning() << "Cannot store surface '" << data.handle << "' in the asset cache '" << m_cache->path() << "'";
+    }
+
+    return textureData;
+}
+
+QImage MCSurfaceManager::prepareTextureImage(const MCSurfaceMetaData & data, const QImage & image, GLint maxTextureSize) const
+{
+    QImage textureImage = image;
+
     // Take the maximum supported texture size into account
-    GLint maxTextureSize;
-    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
     if (textureImage.width() > maxTextureSize && textureImage.height() > maxTextureSize)
     {
         textureImage = textureImage.scaled(maxTextureSize, maxTextureSize);
@@ -350,23 +380,11 @@ GLuint MCSurfaceManager::create2DTextureFromImage(const MCSurfaceMetaData & data
     }
 
     // Ensure alpha channel
-    textureImage = textureImage.convertToFormat(QImage::Format_ARGB32);
-
-    // Apply alpha clamp if it was set (clear alpha)
-    if (data.alphaClamp.second)
-    {
-        applyAlphaClamp(textureImage, static_cast<unsigned int>(255.0f * data.alphaClamp.first));
-    }
-
-    // Apply colorkey if it was set (set or clear alpha)
-    if (data.colorKeySet)
-    {
-        applyColorKey(textureImage, data.colorKey.m_r, data.colorKey.m_g, data.colorKey.m_b);
-    }
-
-    QImage glFormattedImage(textureImage.width(), textureImage.height(), textureImage.format());
-    convertToGLFormatHelper(glFormattedImage, textureImage, GL_RGBA);
+    return textureImage.convertToFormat(QImage::Format_ARGB32);
+}
 
+GLuint MCSurfaceManager::create2DTexture(const MCSurfaceMetaData & data, int width, int height, const void * pixels)
+{
     // Let OpenGL generate a texture handle
     GLuint textureHandle;
     glGenTextures(1, &textureHandle);
@@ -412,61 +430,224 @@ GLuint MCSurfaceManager::create2DTextureFromImage(const MCSurfaceMetaData & data
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
 
-    // Edit image data using the information textureImage gives us
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, glFormattedImage.width(), glFormattedImage.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, glFormattedImage.bits());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    MCGLShaderProgram::resetTextureBindings();
+
+    m_textures.push_back(textureHandle);
 
     return textureHandle;
 }
 
-void MCSurfaceManager::applyColorKey(QImage & textureImage, unsigned int r, unsigned int g, unsigned int b) const
+MCSurfaceManager::~MCSurfaceManager()
 {
-    for (int i = 0; i < textureImage.width(); i++)
+    if (MCGLObjectBase::headless())
     {
-        for (int j = 0; j < textureImage.height(); j++)
-        {
-            if (colorMatch(textureImage.pixel(i, j) & 0x000000ff, b, 2) && colorMatch((textureImage.pixel(i, j) & 0x0000ff00) >> 8, g, 2) && colorMatch((textureImage.pixel(i, j) & 0x00ff0000) >> 16, r, 2))
-            {
-                textureImage.setPixel(i, j, 0x00000000);
-            }
-            else
-            {
-                textureImage.setPixel(i, j, textureImage.pixel(i, j) | 0xff000000);
-            }
-        }
+        return;
+    }
+
+    // Delete OpenGL textures. Atlas textures are shared by many surfaces, so
+    // the textures are not deleted via the materials of the surfaces.
+    glDeleteTextures(static_cast<GLsizei>(m_textures.size()), m_textures.data());
+
+    MCGLShaderProgram::resetTextureBindings();
+}
+
+static bool isAtlasCandidate(const MCSurfaceMetaData & data)
+{
+    // Repeating textures and multitexturing need the texture coordinates of the whole texture
+    const auto isClamped = [](const std::pair<GLint, bool> & wrap) {
+        return !wrap.second || wrap.first == GL_CLAMP_TO_EDGE;
+    };
+
+    return data.atlas && data.handle2.empty() && data.handle3.empty() && isClamped(data.wrapS) && isClamped(data.wrapT);
+}
+
+//! \return true if the surfaces can share the texture and the material of an atlas.
+static bool canShareAtlas(const MCSurfaceMetaData & a, const MCSurfaceMetaData & b)
+{
+    const auto filter = [](const std::pair<GLint, bool> & filter) {
+        return filter.second ? filter.first : GL_NEAREST;
+    };
+
+    const auto specularCoeff = [](const std::pair<GLfloat, bool> & coeff) {
+        return coeff.second ? coeff.first : 1.0f;
+    };
+
+    if (filter(a.minFilter) != filter(b.minFilter) || filter(a.magFilter) != filter(b.magFilter))
+    {
+        return false;
     }
+
+    if (specularCoeff(a.specularCoeff) != specularCoeff(b.specularCoeff) || a.alphaBlend.second != b.alphaBlend.second)
+    {
+        return false;
+    }
+
+    return !a.alphaBlend.second || (a.alphaBlend.first.m_src == b.alphaBlend.first.m_src && a.alphaBlend.first.m_dst == b.alphaBlend.first.m_dst);
 }
 
-void MCSurfaceManager::applyAlphaClamp(QImage & textureImage, unsigned int a) const
+//! Copy the GL_RGBA pixels into the atlas and repeat the edge pixels over the padding, so that
+//! filtering at the edges of the surface doesn't pick up the neighbours. The rows are stored
+//! from bottom to top, so the rectangle is mirrored vertically.
+static void copyToAtlas(std::vector<uint32_t> & atlasPixels, const MCTextureAtlas & atlas, const uint32_t * pixels, const MCTextureAtlas::Rect & rect)
 {
-    for (int i = 0; i < textureImage.width(); i++)
+    const int padding = atlas.padding();
+    const int bottom = atlas.height() - rect.y - rect.height;
+    for (int j = -padding; j < rect.height + padding; j++)
     {
-        for (int j = 0; j < textureImage.height(); j++)
+        const auto src = pixels + static_cast<size_t>(std::clamp(j, 0, rect.height - 1)) * rect.width;
+        const auto dst = atlasPixels.data() + static_cast<size_t>(bottom + j) * atlas.width();
+        for (int i = -padding; i < rect.width + padding; i++)
         {
-            if (((textureImage.pixel(i, j) >> 24) & 0x000000ff) < a)
-            {
-                textureImage.setPixel(i, j, 0x00000000);
-            }
+            dst[rect.x + i] = src[std::clamp(i, 0, rect.width - 1)];
         }
     }
 }
 
-MCSurfaceManager::~MCSurfaceManager()
+void MCSurfaceManager::createAtlasSurfaces(std::vector<std::pair<MCSurfaceMetaData, TextureData>> & surfaces)
 {
-    // Delete OpenGL textures and Textures
-    for (auto && iter : m_surfaceMap)
+    GLint maxTextureSize;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    const int maxAtlasSize = std::min(static_cast<int>(maxTextureSize), MAX_ATLAS_SIZE);
+
+    std::vector<bool> grouped(surfaces.size(), false);
+    for (size_t first = 0; first < surfaces.size(); first++)
     {
-        if (iter.second)
+        if (grouped[first])
+        {
+            continue;
+        }
+
+        // Collect the surfaces compatible with the first ungrouped one
+        std::vector<size_t> group;
+        for (size_t i = first; i < surfaces.size(); i++)
         {
-            const auto surface = iter.second;
-            for (size_t i = 0; i < MCGLMaterial::MAX_TEXTURES; i++)
+            if (!grouped[i] && canShareAtlas(surfaces[first].first, surfaces[i].first))
             {
-                GLuint dummyHandle1 = surface->material()->texture(i);
-                glDeleteTextures(1, &dummyHandle1);
+                grouped[i] = true;
+
+                auto && textureData = surfaces[i].second;
+                if (textureData.width + 2 * ATLAS_PADDING <= maxAtlasSize && textureData.height + 2 * ATLAS_PADDING <= maxAtlasSize)
+                {
+                    group.push_back(i);
+                }
+                else
+                {
+                    createSurface(surfaces[i].first, textureData);
+                }
+            }
+        }
+
+        // The skyline packer works best with the tallest images first
+        std::stable_sort(group.begin(), group.end(), [&surfaces](size_t a, size_t b) {
+            return surfaces[a].second.height > surfaces[b].second.height;
+        });
+
+        while (!group.empty())
+        {
+            long long area = 0;
+            int maxDimension = 0;
+            for (auto && i : group)
+            {
+                auto && textureData = surfaces[i].second;
+                area += static_cast<long long>(textureData.width + 2 * ATLAS_PADDING) * (textureData.height + 2 * ATLAS_PADDING);
+                maxDimension = std::max({ maxDimension, textureData.width + 2 * ATLAS_PADDING, textureData.height + 2 * ATLAS_PADDING });
+            }
+
+            // Start from the smallest power of two that could hold everything and grow if needed
+            int size = 64;
+            while (size < maxAtlasSize && (static_cast<long long>(size) * size < area || size < maxDimension))
+            {
+                size *= 2;
+            }
+
+            std::vector<std::pair<size_t, MCTextureAtlas::Rect>> packed;
+            std::vector<size_t> leftover;
+            for (;;)
+            {
+                MCTextureAtlas atlas(size, size, ATLAS_PADDING);
+                packed.clear();
+                leftover.clear();
+                for (auto && i : group)
+                {
+                    MCTextureAtlas::Rect rect;
+                    if (atlas.insert(surfaces[i].second.width, surfaces[i].second.height, rect))
+                    {
+                        packed.push_back({ i, rect });
+                    }
+                    else
+                    {
+                        leftover.push_back(i);
+                    }
+                }
+
+                if (leftover.empty() || size >= maxAtlasSize)
+                {
+                    if (packed.size() > 1)
+                    {
+                        MCLogger().info() << "Packed " << packed.size() << " surfaces into a " << size << "x" << size
+                                          << " atlas (" << static_cast<int>(atlas.occupancy() * 100) << "% used)";
+                        createAtlas(atlas, packed, surfaces);
+                    }
+                    else
+                    {
+                        // Nothing to share with
+                        for (auto && item : packed)
+                        {
+                            createSurface(surfaces[item.first].first, surfaces[item.first].second);
+                        }
+                    }
+
+                    break;
+                }
+
+                size *= 2;
             }
+
+            group.swap(leftover);
         }
     }
 }
 
+void MCSurfaceManager::createAtlas(
+  const MCTextureAtlas & atlas, const std::vector<std::pair<size_t, MCTextureAtlas::Rect>> & packed,
+  const std::vector<std::pair<MCSurfaceMetaData, TextureData>> & surfaces)
+{
+    std::vector<uint32_t> atlasPixels(static_cast<size_t>(atlas.width()) * atlas.height(), 0);
+    for (auto && item : packed)
+    {
+        copyToAtlas(atlasPixels, atlas, reinterpret_cast<const uint32_t *>(surfaces[item.first].second.pixels), item.second);
+    }
+
+    // All surfaces in the atlas share the texture and the material, so the material
+    // doesn't need to be re-bound between them
+    const auto & groupData = surfaces[packed.front().first].first;
+    MCGLMaterialPtr material(new MCGLMaterial);
+    material->setTexture(create2DTexture(groupData, atlas.width(), atlas.height(), atlasPixels.data()), 0);
+    if (groupData.specularCoeff.second)
+    {
+        material->setSpecularCoeff(groupData.specularCoeff.first);
+    }
+
+    for (auto && item : packed)
+    {
+        auto && data = surfaces[item.first].first;
+        auto && textureData = surfaces[item.first].second;
+
+        MCGLTexCoord texCoords[4];
+        atlas.texCoords(item.second, texCoords);
+
+        const int origH = data.height.second ? data.height.first : textureData.imageHeight;
+        const int origW = data.width.second ? data.width.first : textureData.imageWidth;
+        const auto surface = std::make_shared<MCSurface>(data.handle, material, origW, origH, texCoords, data.z0, data.z1, data.z2, data.z3);
+        surface->setColor(data.color);
+        surface->setAverageColor(textureData.averageColor);
+
+        createSurfaceCommon(surface, data);
+    }
+}
+
 void MCSurfaceManager::load(const std::string & configFilePath, const std::string & baseDataPath)
 {
     MCSurfaceConfigLoader loader;
@@ -474,26 +655,106 @@ void MCSurfaceManager::load(const std::string & configFilePath, const std::strin
     // Parse the texture config file
     if (loader.load(configFilePath))
     {
+        // Textures used as secondary textures are sampled with the coordinates of other surfaces
+        std::unordered_set<std::string> secondaryHandles;
         for (size_t i = 0; i < loader.surfaceCount(); i++)
         {
-            const auto metaData = loader.surface(i);
+            secondaryHandles.insert(loader.surface(i).handle2);
+            secondaryHandles.insert(loader.surface(i).handle3);
+        }
+
+        // Queried here, because GL can only be used in the thread owning the context
+        GLint maxTextureSize = 0;
+        if (!MCGLObjectBase::headless())
+        {
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+        }
+
+        // Atlases don't need to be scaled to power of two dimensions
+        const auto isAtlas = [&secondaryHandles](const MCSurfaceMetaData & data) {
+            return !MCGLObjectBase::headless() && isAtlasCandidate(data) && !secondaryHandles.count(data.handle);
+        };
+
+        // The images are decoded and processed by the thread pool in batches. The textures are then created
+        // in this thread in the order of the config, because surfaces may use the textures of previous ones.
+        const size_t surfaceCount = loader.surfaceCount();
+        const size_t batchSize = m_threadPool ? (m_threadPool->threadCount() + 1) * 4 : 1;
+        std::vector<std::pair<MCSurfaceMetaData, TextureData>> atlasSurfaces;
+        size_t cachedCount = 0;
+        for (size_t first = 0; first < surfaceCount; first += batchSize)
+        {
+            const size_t count = std::min(batchSize, surfaceCount - first);
+            std::vector<TextureData> textureData(count);
+            std::vector<char> cached(count, false);
+            std::vector<std::exception_ptr> errors(count);
+            const auto decode = [&](size_t i) {
+                try
+                {
+                    auto && metaData = loader.surface(first + i);
+
+                    // Due to possible Android asset URLs, an explicit QFile-based loading
+                    // is used instead of directly using QImage::loadFromFile().
+                    QString path = QString(baseDataPath.c_str()) + QDir::separator() + metaData.imagePath.c_str();
+                    path.replace("./", "");
+                    path.replace("//", "/");
 
-            // Load the image and create a 2D texture. Due to possible Android asset URLs,
-            // an explicit QFile-based loading is used instead of directly using QImage::loadFromFile().
-            QString path = QString(baseDataPath.c_str()) + QDir::separator() + metaData.imagePath.c_str();
-            path.replace("./", "");
-            path.replace("//", "/");
+                    QFile imageFile(path);
+                    if (!imageFile.open(QIODevice::ReadOnly))
+                    {
+                        throw std::runtime_error("Cannot read file '" + path.toStdString() + "'");
+                    }
 
-            QFile imageFile(path);
-            if (!imageFile.open(QIODevice::ReadOnly))
+                    bool isCached = false;
+                    textureData[i] = loadTextureData(metaData, imageFile.readAll(), !isAtlas(metaData), maxTextureSize, isCached);
+                    cached[i] = isCached;
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            };
+
+            if (m_threadPool)
+            {
+                m_threadPool->run(count, decode);
+            }
+            else
             {
-                throw std::runtime_error("Cannot read file '" + path.toStdString() + "'");
+                decode(0);
             }
 
-            QImage textureImage;
-            textureImage.loadFromData(imageFile.readAll());
-            createSurfaceFromImage(metaData, textureImage);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (errors[i])
+                {
+                    std::rethrow_exception(errors[i]);
+                }
+
+                auto && metaData = loader.surface(first + i);
+                if (isAtlas(metaData))
+                {
+                    atlasSurfaces.push_back({ metaData, std::move(textureData[i]) });
+                }
+                else
+                {
+                    createSurface(metaData, textureData[i]);
+                }
+
+                cachedCount += cached[i];
+
+                if (m_progressCallback)
+                {
+                    m_progressCallback(first + i + 1, surfaceCount);
+                }
+            }
         }
+
+        if (m_cache)
+        {
+            MCLogger().info() << cachedCount << "/" << loader.surfaceCount() << " surfaces loaded from the cache";
+        }
+
+        createAtlasSurfaces(atlasSurfaces);
     }
     else
     {
@@ -502,6 +763,21 @@ void MCSurfaceManager::load(const std::string & configFilePath, const std::strin
     }
 }
 
+void MCSurfaceManager::setCache(MCAssetCachePtr cache)
+{
+    m_cache = cache;
+}
+
+void MCSurfaceManager::setThreadPool(MCThreadPool * threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+void MCSurfaceManager::setProgressCallback(ProgressCallback callback)
+{
+    m_progressCallback = callback;
+}
+
 std::shared_ptr<MCSurface> MCSurfaceManager::surface(const std::string & id) const
 {
     // Try to find existing texture for the surface
@@ -20,16 +20,22 @@
 #ifndef MCSURFACEMANAGER_HH
 #define MCSURFACEMANAGER_HH
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "mcassetcache.hh"
 #include "mcmacros.hh"
 #include "mcsurfacemetadata.hh"
+#include "mctextureatlas.hh"
 
+class QByteArray;
 class QImage;
 
 class MCSurface;
+class MCThreadPool;
 
 /*! Surface (texture) manager base class. Can be used via MCAssetManager.
  *
@@ -57,6 +63,7 @@ class MCSurface;
  *     <alphaBlend src="srcAlpha" dest="oneMinusSrcAlpha"/>
  *   </surface>
  *   <surface handle="wall" image="wall.png"/>
+ *   <surface handle="tree" image="tree.png" atlas="1"/>
  *   <surface handle="wallMultiTexture" image="wall.bmp" handle2="wall"/>
  *   <surface handle="Track" image="track.bmp"/>
  *   <surface handle="Bazooka" image="bazooka.jpg">
@@ -66,12 +73,26 @@ class MCSurface;
  *   <surface handle="WINDOW_ICON" image="logo_v2.bmp"/>
  * </surfaces>
  *
+ * Surfaces marked with atlas="1" are packed into shared texture atlases when possible. The surfaces
+ * in an atlas must have the same filters and material settings, clamped wrapping and no multitexturing.
+ * They then carry the texture coordinates of their sub-rectangle and share the same material.
+ *
+ * If a cache is set, the processed texture data is stored in it keyed by the contents of the
+ * image file and the meta data affecting the processing. The next load then uploads the
+ * memory-mapped data as such.
+ *
+ * If a thread pool is set, the images are decoded and processed in parallel. Only the textures
+ * are created in the calling thread, which must own the GL context.
+ *
  * Another option is to use MCSurfaceManager::createSurfaceFromImage() directly.
  *
  */
 class MCSurfaceManager
 {
 public:
+    //! Called with the number of surfaces loaded so far and the total number of surfaces.
+    using ProgressCallback = std::function<void(size_t loaded, size_t total)>;
+
     //! Consturctor
     MCSurfaceManager();
 
@@ -97,15 +118,43 @@ public:
      *  MCSurfaceManager keeps the ownership. */
     std::shared_ptr<MCSurface> createSurfaceFromImage(const MCSurfaceMetaData & data, QImage image);
 
+    //! Set the cache used by load() for the processed texture data. Can be nullptr.
+    void setCache(MCAssetCachePtr cache);
+
+    //! Set the thread pool used by load() for decoding the images. Can be nullptr.
+    void setThreadPool(MCThreadPool * threadPool);
+
+    //! Set the callback called by load() in the calling thread after each surface.
+    void setProgressCallback(ProgressCallback callback);
+
 private:
-    //! Apply alpha clamp (set alpha values off based on the given limit).
-    void applyAlphaClamp(QImage & textureImage, unsigned int a) const;
+    //! Texture pixels ready for upload. Defined in the source file.
+    struct TextureData;
+
+    //! Scale to the maximum texture size, mirror and convert to ARGB32 according to the given meta data.
+    QImage prepareTextureImage(const MCSurfaceMetaData & data, const QImage & image, GLint maxTextureSize) const;
 
-    //! Apply given color key (set alpha values on / off based on the given color).
-    void applyColorKey(QImage & textureImage, unsigned int r, unsigned int g, unsigned int b) const;
+    /*! Scale, prepare and convert the image into texture data. Doesn't use GL, so it can be called in any thread.
+     *  \param forcePowerOfTwo Scale to power of two dimensions on GLES. */
+    TextureData createTextureData(const MCSurfaceMetaData & data, const QImage & image, bool forcePowerOfTwo, GLint maxTextureSize) const;
 
-    //! Helper to create the actual OpenGL texture.
-    GLuint create2DTextureFromImage(const MCSurfaceMetaData & data, const QImage & image);
+    //! Get the texture data of the given image file from the cache or create and cache it. Can be called in any thread.
+    TextureData loadTextureData(
+      const MCSurfaceMetaData & data, const QByteArray & fileData, bool forcePowerOfTwo, GLint maxTextureSize, bool & cached) const;
+
+    //! Create a surface with its own texture.
+    std::shared_ptr<MCSurface> createSurface(const MCSurfaceMetaData & data, const TextureData & textureData);
+
+    //! Upload GL_RGBA pixels as a texture with the filter and wrap modes of the given meta data.
+    GLuint create2DTexture(const MCSurfaceMetaData & data, int width, int height, const void * pixels);
+
+    //! Pack the given surfaces into shared texture atlases grouped by filters and material settings.
+    void createAtlasSurfaces(std::vector<std::pair<MCSurfaceMetaData, TextureData>> & surfaces);
+
+    //! Create the atlas texture and the surfaces of the packed texture data.
+    void createAtlas(
+      const MCTextureAtlas & atlas, const std::vector<std::pair<size_t, MCTextureAtlas::Rect>> & packed,
+      const std::vector<std::pair<MCSurfaceMetaData, TextureData>> & surfaces);
 
     //! Helper to set surface meta data.
     void createSurfaceCommon(std::shared_ptr<MCSurface> surface, const MCSurfaceMetaData & data);
@@ -114,6 +163,15 @@ private:
     typedef std::unordered_map<std::string, std::shared_ptr<MCSurface>> SurfaceHash;
     SurfaceHash m_surfaceMap;
 
+    //! Textures created by the manager, each deleted once.
+    std::vector<GLuint> m_textures;
+
+    MCAssetCachePtr m_cache;
+
+    MCThreadPool * m_threadPool;
+
+    ProgressCallback m_progressCallback;
+
     DISABLE_COPY(MCSurfaceManager);
     DISABLE_ASSI(MCSurfaceManager);
 };
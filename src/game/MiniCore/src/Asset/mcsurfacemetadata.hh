@@ -89,6 +89,11 @@ struct MCSurfaceMetaData
     //! True if Y-Axis mirroring is wanted
     bool yAxisMirror = false;
 
+    /*! True if the surface can be packed into a shared texture atlas. The surface then gets
+     *  the texture coordinates of its sub-rectangle, so it must not be used by code that
+     *  assumes the texture coordinates to span the whole texture (e.g. particles, fonts). */
+    bool atlas = false;
+
     //! Min filter value
     std::pair<GLint, bool> minFilter;
 
@@ -0,0 +1,182 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "mctextureatlas.hh"
+#include "mcgltexcoord.hh"
+
+#include <algorithm>
+#include <cassert>
+
+MCTextureAtlas::MCTextureAtlas(int width, int height, int padding)
+  : m_width(width)
+  , m_height(height)
+  , m_padding(padding)
+{
+    assert(width > 0 && height > 0 && padding >= 0);
+
+    m_skyline.push_back({ 0, 0, width });
+}
+
+int MCTextureAtlas::fit(size_t index, int width, int height) const
+{
+    const int x = m_skyline[index].x;
+    if (x + width > m_width)
+    {
+        return -1;
+    }
+
+    // The rectangle rests on the highest node it spans
+    int y = 0;
+    int widthLeft = width;
+    while (widthLeft > 0)
+    {
+        y = std::max(y, m_skyline[index].y);
+        if (y + height > m_height)
+        {
+            return -1;
+        }
+
+        widthLeft -= m_skyline[index].width;
+        index++;
+    }
+
+    return y;
+}
+
+void MCTextureAtlas::addSkylineLevel(size_t index, int x, int y, int width, int height)
+{
+    m_skyline.insert(m_skyline.begin() + static_cast<long>(index), { x, y + height, width });
+
+    // Shrink or remove the nodes now covered by the new one
+    for (size_t i = index + 1; i < m_skyline.size(); i++)
+    {
+        auto && previous = m_skyline[i - 1];
+        auto && node = m_skyline[i];
+        if (node.x < previous.x + previous.width)
+        {
+            const int shrink = previous.x + previous.width - node.x;
+            node.x += shrink;
+            node.width -= shrink;
+            if (node.width <= 0)
+            {
+                m_skyline.erase(m_skyline.begin() + static_cast<long>(i));
+                i--;
+            }
+            else
+            {
+                break;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // Merge neighbours on the same level
+    for (size_t i = 0; i + 1 < m_skyline.size(); i++)
+    {
+        if (m_skyline[i].y == m_skyline[i + 1].y)
+        {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<long>(i) + 1);
+            i--;
+        }
+    }
+}
+
+bool MCTextureAtlas::insert(int width, int height, Rect & rect)
+{
+    const int paddedWidth = width + 2 * m_padding;
+    const int paddedHeight = height + 2 * m_padding;
+
+    // Choose the lowest position and break ties by the narrowest node to waste less space
+    int bestY = -1;
+    int bestWidth = 0;
+    size_t bestIndex = 0;
+    for (size_t i = 0; i < m_skyline.size(); i++)
+    {
+        const int y = fit(i, paddedWidth, paddedHeight);
+        if (y >= 0 && (bestY < 0 || y < bestY || (y == bestY && m_skyline[i].width < bestWidth)))
+        {
+            bestY = y;
+            bestWidth = m_skyline[i].width;
+            bestIndex = i;
+        }
+    }
+
+    if (bestY < 0)
+    {
+        return false;
+    }
+
+    const int x = m_skyline[bestIndex].x;
+    addSkylineLevel(bestIndex, x, bestY, paddedWidth, paddedHeight);
+
+    rect.x = x + m_padding;
+    rect.y = bestY + m_padding;
+    rect.width = width;
+    rect.height = height;
+
+    m_count++;
+    m_usedArea += static_cast<long long>(width) * height;
+
+    return true;
+}
+
+void MCTextureAtlas::texCoords(const Rect & rect, MCGLTexCoord texCoords[4]) const
+{
+    const GLfloat u0 = static_cast<GLfloat>(rect.x) / m_width;
+    const GLfloat u1 = static_cast<GLfloat>(rect.x + rect.width) / m_width;
+
+    // The first image row ends up at the top of the texture, i.e. at v = 1
+    const GLfloat v0 = 1.0f - static_cast<GLfloat>(rect.y + rect.height) / m_height;
+    const GLfloat v1 = 1.0f - static_cast<GLfloat>(rect.y) / m_height;
+
+    texCoords[0] = { u0, v0 };
+    texCoords[1] = { u0, v1 };
+    texCoords[2] = { u1, v1 };
+    texCoords[3] = { u1, v0 };
+}
+
+int MCTextureAtlas::width() const
+{
+    return m_width;
+}
+
+int MCTextureAtlas::height() const
+{
+    return m_height;
+}
+
+int MCTextureAtlas::padding() const
+{
+    return m_padding;
+}
+
+int MCTextureAtlas::count() const
+{
+    return m_count;
+}
+
+float MCTextureAtlas::occupancy() const
+{
+    return static_cast<float>(static_cast<double>(m_usedArea) / (static_cast<double>(m_width) * m_height));
+}
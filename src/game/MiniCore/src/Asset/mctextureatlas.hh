@@ -0,0 +1,105 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#ifndef MCTEXTUREATLAS_HH
+#define MCTEXTUREATLAS_HH
+
+#include <cstddef>
+#include <vector>
+
+struct MCGLTexCoord;
+
+/*! Packs rectangles into a fixed-size texture atlas with the skyline bottom-left method.
+ *  Only the layout is calculated here, so it doesn't need a GL context. The rectangles
+ *  are in image coordinates, i.e. the origin is at the top-left corner of the atlas.
+ *
+ *  Inserting the rectangles in the order of decreasing height gives the best density. */
+class MCTextureAtlas
+{
+public:
+    struct Rect
+    {
+        int x = 0;
+
+        int y = 0;
+
+        int width = 0;
+
+        int height = 0;
+    };
+
+    /*! Constructor.
+     *  \param width Width of the atlas in pixels.
+     *  \param height Height of the atlas in pixels.
+     *  \param padding Empty pixels reserved around each rectangle so that the
+     *         neighbours don't bleed into each other when filtering. */
+    MCTextureAtlas(int width, int height, int padding = 0);
+
+    /*! Find a place for a rectangle of the given size.
+     *  \param rect The placement (without the padding) is written here on success.
+     *  \return false if the rectangle doesn't fit anymore. */
+    bool insert(int width, int height, Rect & rect);
+
+    /*! Get texture coordinates of the given rectangle in the order expected by MCSurface:
+     *  bottom-left, top-left, top-right, bottom-right. The image is assumed to be
+     *  flipped vertically on upload like MCSurfaceManager does. */
+    void texCoords(const Rect & rect, MCGLTexCoord texCoords[4]) const;
+
+    int width() const;
+
+    int height() const;
+
+    int padding() const;
+
+    //! \return number of inserted rectangles.
+    int count() const;
+
+    //! \return ratio of the inserted area (without the padding) to the total area.
+    float occupancy() const;
+
+private:
+    struct SkylineNode
+    {
+        int x;
+
+        int y;
+
+        int width;
+    };
+
+    //! \return y of the rectangle placed at the given node or -1 if it doesn't fit.
+    int fit(size_t index, int width, int height) const;
+
+    void addSkylineLevel(size_t index, int x, int y, int width, int height);
+
+    int m_width;
+
+    int m_height;
+
+    int m_padding;
+
+    int m_count = 0;
+
+    long long m_usedArea = 0;
+
+    std::vector<SkylineNode> m_skyline;
+};
+
+#endif // MCTEXTUREATLAS_HH
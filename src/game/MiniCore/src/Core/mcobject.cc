@@ -35,9 +35,9 @@
 #include "mcworld.hh"
 #include "mcworldrenderer.hh"
 
+#include <atomic>
 #include <bitset>
 #include <cassert>
-#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -55,7 +55,8 @@ public:
     };
 
     Impl(MCObject & parent, const std::string & typeName)
-      : m_typeId(Impl::m_typeRegistry.registerType(typeName))
+      : m_id(Impl::m_nextId++)
+      , m_typeId(Impl::m_typeRegistry.registerType(typeName))
       , m_typeName(typeName)
       , m_this(parent)
       , m_parent(&parent)
@@ -204,16 +205,6 @@ public:
         }
     }
 
-    void addContact(MCContact & contact)
-    {
-        m_contacts[&contact.object()].push_back(&contact);
-    }
-
-    const MCObject::ContactHash & contacts() const
-    {
-        return m_contacts;
-    }
-
     void setCollisionLayer(int layer)
     {
         m_collisionLayer = layer;
@@ -349,8 +340,6 @@ public:
         }
         else
         {
-            const bool wasInWorld = !removing() && MCWorld::instance().objectGrid().remove(m_this);
-
             // Calculate velocity if this object is a child object and is thus moved
             // by the parent. This way we'll automatically get linear velocity +
             // possible orbital velocity.
@@ -366,38 +355,14 @@ public:
 
             updateChildTransforms();
 
-            if (wasInWorld)
+            // Only touches the broad phase if the covered cells changed
+            if (!removing())
             {
-                MCWorld::instance().objectGrid().insert(m_this);
+                MCWorld::instance().objectGrid().move(m_this);
             }
         }
     }
 
-    void deleteContacts()
-    {
-        for (auto && contact : m_contacts)
-        {
-            for (size_t j = 0; j < contact.second.size(); j++)
-            {
-                contact.second[j]->free();
-            }
-        }
-        m_contacts.clear();
-    }
-
-    void deleteContacts(MCObject & object)
-    {
-        const auto iter(m_contacts.find(&object));
-        if (iter != m_contacts.end())
-        {
-            for (size_t j = 0; j < iter->second.size(); j++)
-            {
-                iter->second[j]->free();
-            }
-            iter->second.clear();
-        }
-    }
-
     void displace(const MCVector3dF & displacement)
     {
         translate(m_location + displacement);
@@ -445,6 +410,11 @@ public:
         }
     }
 
+    unsigned int id() const
+    {
+        return m_id;
+    }
+
     size_t typeId() const
     {
         return m_typeId;
@@ -521,6 +491,16 @@ public:
         *j1 = m_j1;
     }
 
+    void setBroadPhaseProxy(int proxy)
+    {
+        m_broadPhaseProxy = proxy;
+    }
+
+    int broadPhaseProxy() const
+    {
+        return m_broadPhaseProxy;
+    }
+
     void setRemoving(bool flag)
     {
         setStatus(StatusBit::Removing, flag);
@@ -616,15 +596,10 @@ private:
             }
             else
             {
-                const bool wasInWorld = MCWorld::instance().objectGrid().remove(m_this);
-
                 m_shape->rotate(angle);
                 m_shape->translate(m_location - MCVector3dF(m_center));
 
-                if (wasInWorld)
-                {
-                    MCWorld::instance().objectGrid().insert(m_this);
-                }
+                MCWorld::instance().objectGrid().move(m_this);
             }
         }
     }
@@ -662,6 +637,10 @@ private:
 
     static MCTypeRegistry m_typeRegistry;
 
+    static std::atomic<unsigned int> m_nextId;
+
+    const unsigned int m_id;
+
     size_t m_typeId;
 
     std::string m_typeName;
@@ -682,6 +661,8 @@ private:
 
     size_t m_j1 = 0;
 
+    int m_broadPhaseProxy = -1;
+
     MCVector3dF m_initialLocation;
 
     int m_initialAngle = 0;
@@ -702,8 +683,6 @@ private:
 
     static TimerEventObjectsList m_timerEventObjects;
 
-    MCObject::ContactHash m_contacts;
-
     int m_timerEventObjectsIndex = -1;
 
     std::bitset<8> m_status;
@@ -718,6 +697,7 @@ private:
 };
 
 MCTypeRegistry MCObject::Impl::m_typeRegistry;
+std::atomic<unsigned int> MCObject::Impl::m_nextId(0);
 MCObject::Impl::TimerEventObjectsList MCObject::Impl::m_timerEventObjects;
 
 MCObject::MCObject(const std::string & typeName)
@@ -780,6 +760,11 @@ void MCObject::checkBoundaries()
 }
 
 
+unsigned int MCObject::id() const
+{
+    return m_impl->id();
+}
+
 size_t MCObject::typeId() const
 {
     return m_impl->typeId();
@@ -941,6 +926,19 @@ void MCObject::displace(const MCVector3dF & displacement)
     m_impl->displace(displacement);
 }
 
+void MCObject::resetRenderState()
+{
+    if (shape())
+    {
+        shape()->saveRenderState();
+    }
+
+    for (auto && child : children())
+    {
+        child->resetRenderState();
+    }
+}
+
 const MCVector3dF & MCObject::location() const
 {
     return m_impl->location();
@@ -1011,6 +1009,16 @@ void MCObject::restoreIndexRange(size_t * i0, size_t * i1, size_t * j0, size_t *
     m_impl->restoreIndexRange(i0, i1, j0, j1);
 }
 
+void MCObject::setBroadPhaseProxy(int proxy)
+{
+    m_impl->setBroadPhaseProxy(proxy);
+}
+
+int MCObject::broadPhaseProxy() const
+{
+    return m_impl->broadPhaseProxy();
+}
+
 void MCObject::setIndex(int index)
 {
     m_impl->setIndex(index);
@@ -1031,26 +1039,6 @@ int MCObject::index() const
     return m_impl->index();
 }
 
-void MCObject::addContact(MCContact & contact)
-{
-    m_impl->addContact(contact);
-}
-
-const MCObject::ContactHash & MCObject::contacts() const
-{
-    return m_impl->contacts();
-}
-
-void MCObject::deleteContacts()
-{
-    m_impl->deleteContacts();
-}
-
-void MCObject::deleteContacts(MCObject & object)
-{
-    m_impl->deleteContacts(object);
-}
-
 void MCObject::setInitialLocation(const MCVector3dF & location)
 {
     m_impl->setInitialLocation(location);
@@ -1084,5 +1072,4 @@ MCPhysicsComponent & MCObject::physicsComponent()
 MCObject::~MCObject()
 {
     MCObject::removeFromWorldNow();
-    deleteContacts();
 }
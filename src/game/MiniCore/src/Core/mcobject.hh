@@ -21,7 +21,6 @@
 #define MCOBJECT_HH
 
 #include "mcbbox.hh"
-#include "mccontact.hh"
 #include "mcmacros.hh"
 #include "mcobjectgrid.hh"
 #include "mcshape.hh"
@@ -52,9 +51,6 @@ typedef std::shared_ptr<MCObject> MCObjectPtr;
 class MCObject
 {
 public:
-    //! Hash container for contacts. Prefer map here for iteration performance.
-    typedef std::map<MCObject *, std::vector<MCContact *>> ContactHash;
-
     /*! Constructor.
      *  \param typeId Type name string e.g. "CAR". All identical objects should have the same typeName. */
     explicit MCObject(const std::string & typeName);
@@ -96,6 +92,9 @@ public:
      *  Returns 0 if type is not registered. */
     static size_t typeId(const std::string & typeName);
 
+    //! Return unique id of the object. Ids are not reused.
+    unsigned int id() const;
+
     //! Return the type name given to constructor.
     const std::string & typeName() const;
 
@@ -223,6 +222,10 @@ public:
     //! Get shape.
     MCShapePtr shape() const;
 
+    /*! Render the current location and angle without interpolation until the next step.
+     *  Call this after moving the object to a distant location. Applies also to children. */
+    void resetRenderState();
+
     /*! \brief Step internal time.
      *  This is called AFTER every update step. Note that you might need to prevent
      *  the object from sleeping via MCPhysicsComponent if these events are required for
@@ -238,18 +241,6 @@ public:
     //! Return the collision layer.
     int collisionLayer() const;
 
-    //! Add a collision contact.
-    void addContact(MCContact & contact);
-
-    //! Get collision contact hash.
-    const ContactHash & contacts() const;
-
-    //! Delete current contacts.
-    void deleteContacts();
-
-    //! Delete all contacts with the given object.
-    void deleteContacts(MCObject & object);
-
     //! Return index in MCWorld's object vector. Returns -1 if not in the world.
     int index() const;
 
@@ -315,6 +306,10 @@ private:
 
     void restoreIndexRange(size_t * i0, size_t * i1, size_t * j0, size_t * j1);
 
+    void setBroadPhaseProxy(int proxy);
+
+    int broadPhaseProxy() const;
+
     void setIndex(int index);
 
     void setRemoving(bool flag);
@@ -328,8 +323,10 @@ private:
     DISABLE_ASSI(MCObject);
     DISABLE_MOVE(MCObject);
 
+    friend class MCFlatObjectGrid;
     friend class MCObjectGrid;
     friend class MCObjectGridImpl;
+    friend class MCSweepAndPrune;
     friend class MCWorld;
     friend class MCCollisionDetector;
 };
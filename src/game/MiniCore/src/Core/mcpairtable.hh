@@ -0,0 +1,281 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCPAIRTABLE_HH
+#define MCPAIRTABLE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*! \class MCPairTable
+ *  \brief Hash table for unordered pairs of 32-bit ids.
+ *
+ *  The pair (a, b) is packed into a 64-bit key (min id, max id), so (a, b) and (b, a)
+ *  are the same entry. Entries are stored densely for fast iteration and the lookup
+ *  is done with an open-addressing table. Nothing is allocated once the table has
+ *  grown to its working size. Note that erase() moves the last entry to the place
+ *  of the erased one. */
+template<typename T>
+class MCPairTable
+{
+public:
+    struct Entry
+    {
+        uint64_t key;
+        T value;
+    };
+
+    typedef std::vector<Entry> Entries;
+
+    //! Constructor.
+    MCPairTable();
+
+    //! \return the packed key for the given unordered pair.
+    static uint64_t key(uint32_t a, uint32_t b);
+
+    //! \return the smaller id of the given key.
+    static uint32_t first(uint64_t key);
+
+    //! \return the bigger id of the given key.
+    static uint32_t second(uint64_t key);
+
+    //! \return the value of the given key or nullptr if not found.
+    T * find(uint64_t key);
+
+    /*! Insert the given key if it doesn't exist.
+     *  \param inserted Set to true if a new entry was created.
+     *  \return the value of the key. New values are default constructed. */
+    T & insert(uint64_t key, bool * inserted = nullptr);
+
+    //! Erase the given key. \return true if erased.
+    bool erase(uint64_t key);
+
+    //! Erase the entry at the given position of entries().
+    void eraseAt(size_t index);
+
+    //! Remove all entries. The allocated memory is kept.
+    void clear();
+
+    size_t size() const;
+
+    bool empty() const;
+
+    //! \return the dense array of entries.
+    Entries & entries();
+
+    //! \return the dense array of entries.
+    const Entries & entries() const;
+
+private:
+    static constexpr int32_t EMPTY_SLOT = -1;
+
+    size_t homeSlot(uint64_t key) const;
+
+    size_t findSlot(uint64_t key) const;
+
+    void rehash(size_t slotCount);
+
+    Entries m_entries;
+
+    std::vector<int32_t> m_slots;
+
+    size_t m_mask;
+};
+
+template<typename T>
+MCPairTable<T>::MCPairTable()
+  : m_mask(0)
+{
+    rehash(64);
+}
+
+template<typename T>
+uint64_t MCPairTable<T>::key(uint32_t a, uint32_t b)
+{
+    return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+}
+
+template<typename T>
+uint32_t MCPairTable<T>::first(uint64_t key)
+{
+    return static_cast<uint32_t>(key >> 32);
+}
+
+template<typename T>
+uint32_t MCPairTable<T>::second(uint64_t key)
+{
+    return static_cast<uint32_t>(key & 0xffffffff);
+}
+
+template<typename T>
+size_t MCPairTable<T>::homeSlot(uint64_t key) const
+{
+    // Fibonacci hashing
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & m_mask;
+}
+
+template<typename T>
+size_t MCPairTable<T>::findSlot(uint64_t key) const
+{
+    size_t slot = homeSlot(key);
+    while (m_slots[slot] != EMPTY_SLOT && m_entries[static_cast<size_t>(m_slots[slot])].key != key)
+    {
+        slot = (slot + 1) & m_mask;
+    }
+
+    return slot;
+}
+
+template<typename T>
+T * MCPairTable<T>::find(uint64_t key)
+{
+    const size_t slot = findSlot(key);
+    return m_slots[slot] != EMPTY_SLOT ? &m_entries[static_cast<size_t>(m_slots[slot])].value : nullptr;
+}
+
+template<typename T>
+T & MCPairTable<T>::insert(uint64_t key, bool * inserted)
+{
+    size_t slot = findSlot(key);
+    if (m_slots[slot] != EMPTY_SLOT)
+    {
+        if (inserted)
+        {
+            *inserted = false;
+        }
+
+        return m_entries[static_cast<size_t>(m_slots[slot])].value;
+    }
+
+    // Keep the load factor at 0.5 at most
+    if ((m_entries.size() + 1) * 2 > m_slots.size())
+    {
+        rehash(m_slots.size() * 2);
+        slot = findSlot(key);
+    }
+
+    m_slots[slot] = static_cast<int32_t>(m_entries.size());
+    m_entries.push_back({ key, T() });
+
+    if (inserted)
+    {
+        *inserted = true;
+    }
+
+    return m_entries.back().value;
+}
+
+template<typename T>
+bool MCPairTable<T>::erase(uint64_t key)
+{
+    const size_t slot = findSlot(key);
+    if (m_slots[slot] == EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    eraseAt(static_cast<size_t>(m_slots[slot]));
+    return true;
+}
+
+template<typename T>
+void MCPairTable<T>::eraseAt(size_t index)
+{
+    // Backward-shift deletion keeps the probe sequences intact without tombstones
+    size_t hole = findSlot(m_entries[index].key);
+    m_slots[hole] = EMPTY_SLOT;
+    size_t slot = hole;
+    while (true)
+    {
+        slot = (slot + 1) & m_mask;
+        if (m_slots[slot] == EMPTY_SLOT)
+        {
+            break;
+        }
+
+        const size_t home = homeSlot(m_entries[static_cast<size_t>(m_slots[slot])].key);
+        const bool canMove = hole <= slot ? (home <= hole || home > slot) : (home <= hole && home > slot);
+        if (canMove)
+        {
+            m_slots[hole] = m_slots[slot];
+            m_slots[slot] = EMPTY_SLOT;
+            hole = slot;
+        }
+    }
+
+    // Move the last entry to the freed position
+    const size_t last = m_entries.size() - 1;
+    if (index != last)
+    {
+        const size_t lastSlot = findSlot(m_entries[last].key);
+        m_entries[index] = std::move(m_entries[last]);
+        m_slots[lastSlot] = static_cast<int32_t>(index);
+    }
+
+    m_entries.pop_back();
+}
+
+template<typename T>
+void MCPairTable<T>::clear()
+{
+    m_entries.clear();
+    for (auto && slot : m_slots)
+    {
+        slot = EMPTY_SLOT;
+    }
+}
+
+template<typename T>
+size_t MCPairTable<T>::size() const
+{
+    return m_entries.size();
+}
+
+template<typename T>
+bool MCPairTable<T>::empty() const
+{
+    return m_entries.empty();
+}
+
+template<typename T>
+typename MCPairTable<T>::Entries & MCPairTable<T>::entries()
+{
+    return m_entries;
+}
+
+template<typename T>
+const typename MCPairTable<T>::Entries & MCPairTable<T>::entries() const
+{
+    return m_entries;
+}
+
+template<typename T>
+void MCPairTable<T>::rehash(size_t slotCount)
+{
+    m_slots.assign(slotCount, EMPTY_SLOT);
+    m_mask = slotCount - 1;
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        m_slots[findSlot(m_entries[i].key)] = static_cast<int32_t>(i);
+    }
+}
+
+#endif // MCPAIRTABLE_HH
@@ -0,0 +1,139 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcthreadpool.hh"
+
+MCThreadPool::MCThreadPool(size_t threadCount)
+  : m_task(nullptr)
+  , m_taskCount(0)
+  , m_nextTask(0)
+  , m_pendingTasks(0)
+  , m_batch(0)
+  , m_stop(false)
+{
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_threads.emplace_back(&MCThreadPool::work, this);
+    }
+}
+
+MCThreadPool::~MCThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeUp.notify_all();
+
+    for (auto && thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+size_t MCThreadPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+void MCThreadPool::run(size_t taskCount, const std::function<void(size_t)> & task)
+{
+    if (m_threads.empty() || taskCount < 2)
+    {
+        for (size_t i = 0; i < taskCount; i++)
+        {
+            task(i);
+        }
+
+        return;
+    }
+
+    size_t batch = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask = 0;
+        m_pendingTasks = taskCount;
+        batch = ++m_batch;
+    }
+
+    m_wakeUp.notify_all();
+
+    runTasks(batch);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] {
+        return m_pendingTasks == 0;
+    });
+
+    m_task = nullptr;
+}
+
+void MCThreadPool::work()
+{
+    size_t seenBatch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, seenBatch] {
+                return m_stop || m_batch != seenBatch;
+            });
+
+            if (m_stop)
+            {
+                return;
+            }
+
+            seenBatch = m_batch;
+        }
+
+        runTasks(seenBatch);
+    }
+}
+
+void MCThreadPool::runTasks(size_t batch)
+{
+    while (true)
+    {
+        const std::function<void(size_t)> * task = nullptr;
+        size_t index = 0;
+        {
+            // A late thread must not pick tasks of a batch that has already finished
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_batch != batch || m_nextTask >= m_taskCount)
+            {
+                return;
+            }
+
+            index = m_nextTask++;
+            task = m_task;
+        }
+
+        (*task)(index);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pendingTasks == 0)
+        {
+            m_done.notify_all();
+        }
+    }
+}
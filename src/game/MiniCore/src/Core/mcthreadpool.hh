@@ -0,0 +1,83 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCTHREADPOOL_HH
+#define MCTHREADPOOL_HH
+
+#include "mcmacros.hh"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*! \class MCThreadPool
+ *  \brief Fixed set of worker threads for running batches of independent tasks.
+ *
+ *  The tasks of a batch are handed out in index order, but may complete in any
+ *  order. Tasks must not depend on each other. The threads sleep between batches. */
+class MCThreadPool
+{
+public:
+    /*! Constructor.
+     *  \param threadCount Number of worker threads. With zero threads all tasks
+     *  are run in the calling thread. */
+    explicit MCThreadPool(size_t threadCount);
+
+    //! Destructor. Stops the worker threads.
+    ~MCThreadPool();
+
+    //! \return number of worker threads.
+    size_t threadCount() const;
+
+    /*! Run task(0) ... task(taskCount - 1) and wait until all of them are done.
+     *  The calling thread also runs tasks. */
+    void run(size_t taskCount, const std::function<void(size_t)> & task);
+
+private:
+    DISABLE_COPY(MCThreadPool);
+    DISABLE_ASSI(MCThreadPool);
+
+    void work();
+
+    void runTasks(size_t batch);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_wakeUp;
+
+    std::condition_variable m_done;
+
+    const std::function<void(size_t)> * m_task;
+
+    size_t m_taskCount;
+
+    size_t m_nextTask;
+
+    size_t m_pendingTasks;
+
+    size_t m_batch;
+
+    bool m_stop;
+};
+
+#endif // MCTHREADPOOL_HH
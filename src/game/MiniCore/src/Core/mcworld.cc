@@ -22,6 +22,7 @@
 #include "mcbbox.hh"
 #include "mccamera.hh"
 #include "mccollisiondetector.hh"
+#include "mcflatobjectgrid.hh"
 #include "mcforcegenerator.hh"
 #include "mcforceregistry.hh"
 #include "mcfrictiongenerator.hh"
@@ -34,9 +35,11 @@
 #include "mcrectshape.hh"
 #include "mcshape.hh"
 #include "mcshapeview.hh"
+#include "mcsweepandprune.hh"
 #include "mctrigonom.hh"
 #include "mcworldrenderer.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -65,6 +68,7 @@ MCWorld::MCWorld()
   , m_resolverLoopCount(5)
   , m_resolverStep(1.0f / m_resolverLoopCount)
   , m_gravity(MCVector3dF(0, 0, -9.81f))
+  , m_profilingEnabled(false)
 {
     if (!MCWorld::m_instance)
     {
@@ -89,8 +93,11 @@ MCWorld::~MCWorld()
 
 void MCWorld::integratePhysics(int step)
 {
-    // Integrate and update all registered objects
     m_forceRegistry->update();
+
+    measure(m_profile.forces);
+
+    // Integrate and update all registered objects
     for (auto && object : m_objects)
     {
         if (object->isPhysicsObject() && !object->physicsComponent().isStationary())
@@ -100,16 +107,18 @@ void MCWorld::integratePhysics(int step)
 
         object->onStepTime(step);
     }
+
+    measure(m_profile.integration);
 }
 
 void MCWorld::generateImpulses()
 {
-    m_impulseGenerator->generateImpulsesFromDeepestContacts(m_objects);
+    m_impulseGenerator->generateImpulsesFromDeepestContacts(m_collisionDetector->contacts());
 }
 
 void MCWorld::resolvePositions(float accuracy)
 {
-    m_impulseGenerator->resolvePositions(m_objects, accuracy);
+    m_impulseGenerator->resolvePositions(m_collisionDetector->contacts(), accuracy);
 }
 
 void MCWorld::prepareRendering(MCCamera * camera)
@@ -117,6 +126,11 @@ void MCWorld::prepareRendering(MCCamera * camera)
     m_renderer->buildBatches(camera);
 }
 
+void MCWorld::prepareRendering(const std::vector<MCCamera *> & cameras)
+{
+    m_renderer->buildBatches(cameras);
+}
+
 void MCWorld::render(MCCamera * camera, MCRenderGroup renderGroup)
 {
     m_renderer->render(camera, renderGroup);
@@ -145,9 +159,9 @@ void MCWorld::clear()
     // cleared and all objects will be removed at once.
     for (auto && object : m_objects)
     {
-        object->deleteContacts();
         object->physicsComponent().reset();
         object->setIndex(REMOVED_INDEX);
+        m_forceRegistry->updateIntegration(*object);
 
         if (object->isParticle())
         {
@@ -155,6 +169,13 @@ void MCWorld::clear()
         }
     }
 
+    for (auto && frictionGenerator : m_frictionGenerators)
+    {
+        m_forceRegistry->removeForceGenerator(frictionGenerator.second, *frictionGenerator.first);
+    }
+
+    m_frictionGenerators.clear();
+
     m_renderer->clear();
     m_objectGrid->removeAll();
     m_objects.clear();
@@ -164,7 +185,7 @@ void MCWorld::clear()
 
 void MCWorld::setDimensions(
   float minX, float maxX, float minY, float maxY, float minZ, float maxZ,
-  float metersPerUnit, bool addAreaWalls, size_t gridSize)
+  float metersPerUnit, bool addAreaWalls, size_t gridSize, MCBroadPhase::Type broadPhaseType)
 {
     assert(maxX - minX > 0);
     assert(maxY - minY > 0);
@@ -180,11 +201,47 @@ void MCWorld::setDimensions(
     m_minZ = minZ;
     m_maxZ = maxZ;
 
+    // Remove old walls from the old grid before it gets replaced
+    if (m_leftWallObject)
+    {
+        removeObjectNow(*m_leftWallObject);
+        m_leftWallObject.reset();
+    }
+
+    if (m_rightWallObject)
+    {
+        removeObjectNow(*m_rightWallObject);
+        m_rightWallObject.reset();
+    }
+
+    if (m_topWallObject)
+    {
+        removeObjectNow(*m_topWallObject);
+        m_topWallObject.reset();
+    }
+
+    if (m_bottomWallObject)
+    {
+        removeObjectNow(*m_bottomWallObject);
+        m_bottomWallObject.reset();
+    }
+
     // Init objectGrid
     const float leafWidth = (maxX - minX) / gridSize;
     const float leafHeight = (maxY - minY) / gridSize;
 
-    m_objectGrid = std::make_unique<MCObjectGrid>(m_minX, m_minY, m_maxX, m_maxY, leafWidth, leafHeight);
+    switch (broadPhaseType)
+    {
+    case MCBroadPhase::Type::ObjectGrid:
+        m_objectGrid = std::make_unique<MCObjectGrid>(m_minX, m_minY, m_maxX, m_maxY, leafWidth, leafHeight);
+        break;
+    case MCBroadPhase::Type::FlatObjectGrid:
+        m_objectGrid = std::make_unique<MCFlatObjectGrid>(m_minX, m_minY, m_maxX, m_maxY, leafWidth, leafHeight);
+        break;
+    case MCBroadPhase::Type::SweepAndPrune:
+        m_objectGrid = std::make_unique<MCSweepAndPrune>(m_minX, m_minY, m_maxX, m_maxY);
+        break;
+    }
 
     if (addAreaWalls)
     {
@@ -192,11 +249,6 @@ void MCWorld::setDimensions(
         const float w = m_maxX - m_minX;
         const float h = m_maxY - m_minY;
 
-        if (m_leftWallObject)
-        {
-            removeObjectNow(*m_leftWallObject);
-        }
-
         const float wallRestitution = 0.25f;
 
         m_leftWallObject = std::make_unique<MCObject>("__WORLD_LEFT_WALL");
@@ -206,11 +258,6 @@ void MCWorld::setDimensions(
         m_leftWallObject->addToWorld();
         m_leftWallObject->translate(MCVector3dF(-w / 2, h / 2, 0));
 
-        if (m_rightWallObject)
-        {
-            removeObjectNow(*m_rightWallObject);
-        }
-
         m_rightWallObject = std::make_unique<MCObject>("__WORLD_RIGHT_WALL");
         m_rightWallObject->setShape(std::make_shared<MCRectShape>(nullptr, w, h));
         m_rightWallObject->physicsComponent().setMass(0, true);
@@ -218,11 +265,6 @@ void MCWorld::setDimensions(
         m_rightWallObject->addToWorld();
         m_rightWallObject->translate(MCVector3dF(w + w / 2, h / 2, 0));
 
-        if (m_topWallObject)
-        {
-            removeObjectNow(*m_topWallObject);
-        }
-
         m_topWallObject = std::make_unique<MCObject>("__WORLD_TOP_WALL");
         m_topWallObject->setShape(std::make_shared<MCRectShape>(nullptr, w, h));
         m_topWallObject->physicsComponent().setMass(0, true);
@@ -230,11 +272,6 @@ void MCWorld::setDimensions(
         m_topWallObject->addToWorld();
         m_topWallObject->translate(MCVector3dF(w / 2, h + h / 2, 0));
 
-        if (m_bottomWallObject)
-        {
-            removeObjectNow(*m_bottomWallObject);
-        }
-
         m_bottomWallObject = std::make_unique<MCObject>("__WORLD_BOTTOM_WALL");
         m_bottomWallObject->setShape(std::make_shared<MCRectShape>(nullptr, w, h));
         m_bottomWallObject->physicsComponent().setMass(0, true);
@@ -242,32 +279,6 @@ void MCWorld::setDimensions(
         m_bottomWallObject->addToWorld();
         m_bottomWallObject->translate(MCVector3dF(w / 2, -h / 2, 0));
     }
-    else
-    {
-        if (m_leftWallObject)
-        {
-            removeObjectNow(*m_leftWallObject);
-            m_leftWallObject.reset();
-        }
-
-        if (m_rightWallObject)
-        {
-            removeObjectNow(*m_rightWallObject);
-            m_rightWallObject.reset();
-        }
-
-        if (m_topWallObject)
-        {
-            removeObjectNow(*m_topWallObject);
-            m_topWallObject.reset();
-        }
-
-        if (m_bottomWallObject)
-        {
-            removeObjectNow(*m_bottomWallObject);
-            m_bottomWallObject.reset();
-        }
-    }
 }
 
 float MCWorld::minX() const
@@ -316,16 +327,24 @@ void MCWorld::addObject(MCObject & object)
             // Add to object vector (O(1))
             m_objects.push_back(&object);
             object.setIndex(static_cast<int>(m_objects.size()) - 1);
+            m_forceRegistry->updateIntegration(object);
 
             m_objectGrid->insert(object);
 
-            // Add xy friction
+            // Nothing to interpolate from before the first step
+            object.resetRenderState();
+
+            // Add xy friction. An object gets only one friction generator however many times it's added.
             if (const float FrictionThreshold = 0.001f; object.physicsComponent().xyFriction() > FrictionThreshold)
             {
-                m_forceRegistry->addForceGenerator(
-                  std::make_shared<MCFrictionGenerator>(
-                    object.physicsComponent().xyFriction(), object.physicsComponent().xyFriction()),
-                  object);
+                auto && generator = m_frictionGenerators[&object];
+                if (!generator)
+                {
+                    generator = std::make_shared<MCFrictionGenerator>(
+                      object.physicsComponent().xyFriction(), object.physicsComponent().xyFriction());
+                }
+
+                m_forceRegistry->addForceGenerator(generator, object);
             }
         }
     }
@@ -349,13 +368,7 @@ void MCWorld::removeObjectNow(MCObject & object)
     if (object.index() > REMOVED_INDEX || object.physicsComponent().isSleeping())
     {
         object.setRemoving(true);
-        for (auto && obj : m_objects)
-        {
-            if (obj != &object && obj->isPhysicsObject())
-            {
-                obj->deleteContacts(object);
-            }
-        }
+        m_collisionDetector->contacts().removeObject(object);
 
         doRemoveObject(object);
     }
@@ -371,6 +384,8 @@ void MCWorld::doRemoveObject(MCObject & object)
     // Remove from object vector (O(1))
     removeObjectFromIntegration(object);
 
+    removeFrictionGenerator(object);
+
     // Remove from ObjectTree
     if (object.isPhysicsObject() && !object.bypassCollisions())
     {
@@ -390,6 +405,8 @@ void MCWorld::removeObjectFromIntegration(MCObject & object)
         m_objects[static_cast<size_t>(object.index())]->setIndex(object.index());
         m_objects.pop_back();
         object.setIndex(REMOVED_INDEX);
+
+        m_forceRegistry->updateIntegration(object);
     }
 }
 
@@ -400,6 +417,16 @@ void MCWorld::restoreObjectToIntegration(MCObject & object)
         // Add to object vector (O(1))
         m_objects.push_back(&object);
         object.setIndex(static_cast<int>(m_objects.size()) - 1);
+        m_forceRegistry->updateIntegration(object);
+    }
+}
+
+void MCWorld::removeFrictionGenerator(MCObject & object)
+{
+    if (const auto iter = m_frictionGenerators.find(&object); iter != m_frictionGenerators.end())
+    {
+        m_forceRegistry->removeForceGenerator(iter->second, object);
+        m_frictionGenerators.erase(iter);
     }
 }
 
@@ -418,10 +445,19 @@ void MCWorld::processRemovedObjects()
 
 void MCWorld::processCollisions()
 {
+    const auto & possibleCollisions = m_objectGrid->getPossibleCollisions();
+
+    measure(m_profile.broadPhase);
+
     // Check collisions for all registered objects
-    m_numCollisions = m_collisionDetector->detectCollisions(*m_objectGrid);
+    m_numCollisions = m_collisionDetector->detectCollisions(possibleCollisions, m_objectGrid->getSeparatedPairs());
+
+    measure(m_profile.narrowPhase);
+
     if (m_numCollisions)
     {
+        // The resolver runs serially: re-testing the contacts sends collision events, and
+        // resolving them wakes objects up and moves them in the broad phase.
         generateImpulses();
 
         // Process contacts and generate impulses
@@ -430,6 +466,8 @@ void MCWorld::processCollisions()
             m_numCollisions = m_collisionDetector->iterateCurrentCollisions();
             resolvePositions(m_resolverStep);
         }
+
+        measure(m_profile.resolver);
     }
 }
 
@@ -441,11 +479,60 @@ MCForceRegistry & MCWorld::forceRegistry() const
 
 void MCWorld::stepTime(int timeStep)
 {
+    // All contacts of the previous step have been handled
+    m_collisionDetector->contacts().reset();
+
+    for (auto && object : m_objects)
+    {
+        if (auto && shape = object->shape())
+        {
+            shape->saveRenderState();
+        }
+    }
+
+    if (m_profilingEnabled)
+    {
+        m_measureStart = std::chrono::steady_clock::now();
+        m_profile.steps++;
+    }
+
+    const size_t mutationCount = m_objectGrid->mutationCount();
+
     integratePhysics(timeStep);
 
     processCollisions();
 
     processRemovedObjects();
+
+    if (m_profilingEnabled)
+    {
+        m_profile.broadPhaseMutations += m_objectGrid->mutationCount() - mutationCount;
+    }
+}
+
+void MCWorld::measure(std::chrono::nanoseconds & stage)
+{
+    if (m_profilingEnabled)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        stage += now - m_measureStart;
+        m_measureStart = now;
+    }
+}
+
+void MCWorld::setProfilingEnabled(bool enabled)
+{
+    m_profilingEnabled = enabled;
+}
+
+const MCWorld::Profile & MCWorld::profile() const
+{
+    return m_profile;
+}
+
+void MCWorld::resetProfile()
+{
+    m_profile = Profile();
 }
 
 void MCWorld::stepTime(std::chrono::milliseconds timeStep)
@@ -453,12 +540,17 @@ void MCWorld::stepTime(std::chrono::milliseconds timeStep)
     stepTime(timeStep.count());
 }
 
+void MCWorld::setRenderInterpolation(float alpha)
+{
+    MCShape::setRenderInterpolation(std::clamp(alpha, 0.0f, 1.0f));
+}
+
 const MCWorld::ObjectVector & MCWorld::objects() const
 {
     return m_objects;
 }
 
-MCObjectGrid & MCWorld::objectGrid() const
+MCBroadPhase & MCWorld::objectGrid() const
 {
     assert(m_objectGrid);
     return *m_objectGrid;
@@ -20,6 +20,7 @@
 #ifndef MCWORLD_HH
 #define MCWORLD_HH
 
+#include "mcbroadphase.hh"
 #include "mcmacros.hh"
 #include "mcrendergroup.hh"
 #include "mcvector2d.hh"
@@ -27,15 +28,16 @@
 
 #include <chrono>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class MCCamera;
 class MCCollisionDetector;
 class MCContact;
+class MCForceGenerator;
 class MCForceRegistry;
 class MCImpulseGenerator;
 class MCObject;
-class MCObjectGrid;
 class MCWorldRenderer;
 
 /*! \class World base class.
@@ -55,6 +57,25 @@ class MCWorld
 public:
     typedef std::vector<MCObject *> ObjectVector;
 
+    //! Accumulated wall-clock time spent in the stages of stepTime() and related counters.
+    struct Profile
+    {
+        std::chrono::nanoseconds forces = {};
+
+        std::chrono::nanoseconds integration = {};
+
+        std::chrono::nanoseconds broadPhase = {};
+
+        std::chrono::nanoseconds narrowPhase = {};
+
+        std::chrono::nanoseconds resolver = {};
+
+        //! Changes to the broad phase, e.g. cells entered or left by moving objects.
+        size_t broadPhaseMutations = 0;
+
+        size_t steps = 0;
+    };
+
     //! Constructor.
     MCWorld();
 
@@ -76,7 +97,9 @@ public:
      *  of 1x2 meters, so the metersPerUnits would be 0.1 in that case.
      *
      *  \param gridSize ver and hor size of the object grid. This affects the collision
-     *  detection performance.
+     *  detection performance. Not used by MCBroadPhase::Type::SweepAndPrune.
+     *
+     *  \param broadPhaseType The broad phase implementation used for the collision detection.
      */
     void setDimensions(
       float minX,
@@ -87,7 +110,8 @@ public:
       float maxZ,
       float metersPerUnit = 1.0f,
       bool addAreaWalls = true,
-      size_t gridSize = 128);
+      size_t gridSize = 128,
+      MCBroadPhase::Type broadPhaseType = MCBroadPhase::Type::ObjectGrid);
 
     /*! Set gravity vector used by default friction generators (on XY-plane).
      *  The default is [0, 0, -9.81]. Set the gravity (acceleration) for objects
@@ -142,17 +166,28 @@ public:
     void stepTime(int timeStep);
     void stepTime(std::chrono::milliseconds timeStep);
 
+    /*! \brief Set the interpolation factor used when rendering objects.
+     *  Objects are rendered between their state before and after the latest step.
+     *  \param alpha 0.0 renders the previous state and 1.0 (the default) the current state. */
+    void setRenderInterpolation(float alpha);
+
     /*! \brief Call this (once) before calling render() or renderShadows().
      *  \param camera The camera window to be used. If nullptr, then
      *         no any translations or clipping done. */
     virtual void prepareRendering(MCCamera * camera);
 
+    /*! \brief Call this (once) before calling render() or renderShadows() when rendering
+     *  multiple viewports, e.g. a split screen. The visibility of the objects is tested
+     *  against all given cameras in one pass.
+     *  \param cameras The camera windows to be used. */
+    virtual void prepareRendering(const std::vector<MCCamera *> & cameras);
+
     /*! \brief Render given component.
      *  \param camera Camera box, can be nullptr. */
     virtual void render(MCCamera * camera, MCRenderGroup renderGroup);
 
-    //! \return Reference to the objectGrid.
-    MCObjectGrid & objectGrid() const;
+    //! \return Reference to the objectGrid (the broad phase selected in setDimensions()).
+    MCBroadPhase & objectGrid() const;
 
     //! \return The world renderer.
     MCWorldRenderer & renderer() const;
@@ -179,6 +214,14 @@ public:
      *  Lower loop count results in faster collision calculations, but lower accuracy. */
     void setResolverLoopCount(size_t resolverLoopCount = 5);
 
+    //! Enable or disable measuring the stages of stepTime(). Disabled by default.
+    void setProfilingEnabled(bool enabled);
+
+    //! \return the stage timings accumulated since the last resetProfile().
+    const Profile & profile() const;
+
+    void resetProfile();
+
     //! \return size of the current integration vector
     size_t objectCount() const;
 
@@ -198,23 +241,32 @@ private:
 
     void doRemoveObject(MCObject & object);
 
+    //! Remove the friction generator added by addObject().
+    void removeFrictionGenerator(MCObject & object);
+
     void generateImpulses();
 
     void resolvePositions(float accuracy);
 
     MCContact * getDeepestInterpenetration(const std::vector<MCContact *> & contacts);
 
+    //! Add the time elapsed since the previous measurement to the given stage.
+    void measure(std::chrono::nanoseconds & stage);
+
     static MCWorld * m_instance;
 
     std::unique_ptr<MCWorldRenderer> m_renderer;
 
     std::unique_ptr<MCForceRegistry> m_forceRegistry;
 
+    //! Friction generators added by addObject(). Removed along with the objects.
+    std::unordered_map<MCObject *, std::shared_ptr<MCForceGenerator>> m_frictionGenerators;
+
     std::unique_ptr<MCCollisionDetector> m_collisionDetector;
 
     std::unique_ptr<MCImpulseGenerator> m_impulseGenerator;
 
-    std::unique_ptr<MCObjectGrid> m_objectGrid;
+    std::unique_ptr<MCBroadPhase> m_objectGrid;
 
     static float m_metersPerUnit;
 
@@ -241,6 +293,12 @@ private:
     float m_resolverStep;
 
     MCVector3dF m_gravity;
+
+    bool m_profilingEnabled;
+
+    Profile m_profile;
+
+    std::chrono::steady_clock::time_point m_measureStart;
 };
 
 #endif // MCWORLD_HH
@@ -28,13 +28,18 @@
 
 GLuint MCGLObjectBase::m_boundVbo = 0;
 
+bool MCGLObjectBase::m_headless = false;
+
 MCGLObjectBase::MCGLObjectBase(std::string handle)
   : m_handle(handle)
   , m_program(MCGLScene::instance().defaultShaderProgram())
   , m_shadowProgram(MCGLScene::instance().defaultShadowShaderProgram())
 {
 #ifdef __MC_QOPENGLFUNCTIONS__
-    initializeOpenGLFunctions();
+    if (!MCGLObjectBase::m_headless)
+    {
+        initializeOpenGLFunctions();
+    }
 #endif
 }
 
@@ -226,6 +231,12 @@ MCGLMaterialPtr MCGLObjectBase::material() const
 void MCGLObjectBase::initBufferData(size_t totalDataSize, GLuint drawType)
 {
     m_totalDataSize = totalDataSize;
+    m_bufferDataOffset = 0;
+
+    if (MCGLObjectBase::m_headless)
+    {
+        return;
+    }
 
     createVAO();
     createVBO();
@@ -234,8 +245,6 @@ void MCGLObjectBase::initBufferData(size_t totalDataSize, GLuint drawType)
     bindVBO();
 
     glBufferData(GL_ARRAY_BUFFER, static_cast<int>(m_totalDataSize), nullptr, drawType);
-
-    m_bufferDataOffset = 0;
 }
 
 void MCGLObjectBase::addVertex(const MCGLVertex & vertex)
@@ -335,12 +344,17 @@ const GLfloat * MCGLObjectBase::texCoordsAsGlArray() const
 
 void MCGLObjectBase::initUpdateBufferData()
 {
+    m_bufferDataOffset = 0;
+
+    if (MCGLObjectBase::m_headless)
+    {
+        return;
+    }
+
     bindVAO();
     bindVBO();
 
     glBufferData(GL_ARRAY_BUFFER, static_cast<int>(m_totalDataSize), nullptr, GL_DYNAMIC_DRAW);
-
-    m_bufferDataOffset = 0;
 }
 
 void MCGLObjectBase::addBufferSubData(MCGLShaderProgram::VertexAttributeLocation dataType, size_t dataSize, const GLfloat * data)
@@ -352,7 +366,10 @@ void MCGLObjectBase::addBufferSubData(MCGLShaderProgram::VertexAttributeLocation
 {
     assert(dataSize <= offsetJump);
 
-    glBufferSubData(GL_ARRAY_BUFFER, static_cast<int>(m_bufferDataOffset), static_cast<int>(dataSize), data);
+    if (!MCGLObjectBase::m_headless)
+    {
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<int>(m_bufferDataOffset), static_cast<int>(dataSize), data);
+    }
 
     m_bufferDataOffset += offsetJump;
 
@@ -370,6 +387,10 @@ void MCGLObjectBase::addBufferSubData(MCGLShaderProgram::VertexAttributeLocation
     case MCGLShaderProgram::VertexAttributeLocation::Color:
         m_colorDataSize = dataSize;
         break;
+    case MCGLShaderProgram::VertexAttributeLocation::InstanceLocation:
+    case MCGLShaderProgram::VertexAttributeLocation::InstanceParams:
+    case MCGLShaderProgram::VertexAttributeLocation::InstanceColor:
+        break;
     }
 }
 
@@ -473,12 +494,27 @@ float MCGLObjectBase::maxZ() const
 
 void MCGLObjectBase::finishBufferData()
 {
+    if (MCGLObjectBase::m_headless)
+    {
+        return;
+    }
+
     setAttributePointers();
 
     releaseVBO();
     releaseVAO();
 }
 
+void MCGLObjectBase::setHeadless(bool headless)
+{
+    MCGLObjectBase::m_headless = headless;
+}
+
+bool MCGLObjectBase::headless()
+{
+    return MCGLObjectBase::m_headless;
+}
+
 size_t MCGLObjectBase::totalDataSize() const
 {
     return m_totalDataSize;
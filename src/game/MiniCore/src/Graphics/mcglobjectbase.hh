@@ -168,6 +168,12 @@ public:
 
     void setHandle(const std::string & handle);
 
+    /*! Skip all OpenGL calls when creating objects. Vertex data is still stored.
+     *  This allows loading assets and running the simulation without a GL context. */
+    static void setHeadless(bool headless);
+
+    static bool headless();
+
 protected:
     //! Store a vertex, needed for batching
     void addVertex(const MCGLVertex & vertex);
@@ -220,6 +226,8 @@ protected:
 private:
     static GLuint m_boundVbo;
 
+    static bool m_headless;
+
     std::string m_handle;
 
 #ifdef __MC_QOPENGLFUNCTIONS__
@@ -95,6 +95,18 @@ MCGLShaderProgramPtr MCGLScene::defaultShadowShaderProgram()
     return m_defaultShadowShader;
 }
 
+#ifdef __MC_GL33__
+MCGLShaderProgramPtr MCGLScene::defaultParticleShaderProgram()
+{
+    return m_defaultParticleShader;
+}
+
+MCGLShaderProgramPtr MCGLScene::defaultParticleShadowShaderProgram()
+{
+    return m_defaultParticleShadowShader;
+}
+#endif
+
 MCGLShaderProgramPtr MCGLScene::defaultTextShaderProgram()
 {
     return m_defaultTextShader;
@@ -135,6 +147,9 @@ void MCGLScene::initialize()
 #endif
 
     createDefaultShaderPrograms();
+
+    // The context may be new, so the cached texture bindings can't be trusted
+    MCGLShaderProgram::resetTextureBindings();
 }
 
 void MCGLScene::createDefaultShaderPrograms()
@@ -148,6 +163,14 @@ void MCGLScene::createDefaultShaderPrograms()
     m_defaultShadowShader = std::make_shared<MCGLShaderProgram>(
       MCGLShaderProgram::getDefaultShadowVertexShaderSource(), MCGLShaderProgram::getDefaultShadowFragmentShaderSource());
 
+#ifdef __MC_GL33__
+    m_defaultParticleShader = std::make_shared<MCGLShaderProgram>(
+      MCGLShaderProgram::getDefaultParticleVertexShaderSource(), MCGLShaderProgram::getDefaultFragmentShaderSource());
+
+    m_defaultParticleShadowShader = std::make_shared<MCGLShaderProgram>(
+      MCGLShaderProgram::getDefaultParticleShadowVertexShaderSource(), MCGLShaderProgram::getDefaultShadowFragmentShaderSource());
+#endif
+
     m_defaultTextShader = std::make_shared<MCGLShaderProgram>(
       MCGLShaderProgram::getDefaultTextVertexShaderSource(), MCGLShaderProgram::getDefaultTextFragmentShaderSource());
 
@@ -85,6 +85,14 @@ public:
     //! \return default shadow shader program.
     MCGLShaderProgramPtr defaultShadowShaderProgram();
 
+#ifdef __MC_GL33__
+    //! \return default shader program for instanced particles.
+    MCGLShaderProgramPtr defaultParticleShaderProgram();
+
+    //! \return default shadow shader program for instanced particles.
+    MCGLShaderProgramPtr defaultParticleShadowShaderProgram();
+#endif
+
     //! \return default shader program for text.
     MCGLShaderProgramPtr defaultTextShaderProgram();
 
@@ -154,6 +162,12 @@ private:
 
     MCGLShaderProgramPtr m_defaultShadowShader;
 
+#ifdef __MC_GL33__
+    MCGLShaderProgramPtr m_defaultParticleShader;
+
+    MCGLShaderProgramPtr m_defaultParticleShadowShader;
+#endif
+
     MCGLShaderProgramPtr m_defaultTextShader;
 
     MCGLShaderProgramPtr m_defaultTextShadowShader;
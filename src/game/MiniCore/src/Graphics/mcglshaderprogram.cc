@@ -31,14 +31,25 @@
 #include <MCLogger>
 #include <MCTrigonom>
 
+#ifdef __MC_QOPENGLFUNCTIONS__
+#include <QOpenGLContext>
+#endif
+
 #include <cassert>
 #include <exception>
+#include <limits>
 #include <vector>
 
 MCGLShaderProgram * MCGLShaderProgram::m_activeProgram = nullptr;
 
 std::vector<MCGLShaderProgram *> MCGLShaderProgram::m_programStack;
 
+std::array<GLuint, MCGLMaterial::MAX_TEXTURES> MCGLShaderProgram::m_boundTextures = {};
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+QOpenGLContext * MCGLShaderProgram::m_boundTexturesContext = nullptr;
+#endif
+
 MCGLShaderProgram::MCGLShaderProgram()
   : m_scene(MCGLScene::instance())
   , m_viewProjectionMatrixPending(false)
@@ -208,6 +219,9 @@ bool MCGLShaderProgram::addVertexShaderFromSource(const std::string & source)
     glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::Normal), "inNormal");
     glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::TexCoords), "inTexCoord");
     glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::Color), "inColor");
+    glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::InstanceLocation), "inInstanceLocation");
+    glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::InstanceParams), "inInstanceParams");
+    glBindAttribLocation(m_program, static_cast<int>(MCGLShaderProgram::VertexAttributeLocation::InstanceColor), "inInstanceColor");
 
     glAttachShader(m_program, m_vertexShader);
 
@@ -253,6 +267,18 @@ std::string MCGLShaderProgram::getDefaultShadowVertexShaderSource()
     return MCDefaultShadowVsh;
 }
 
+#ifdef __MC_GL33__
+std::string MCGLShaderProgram::getDefaultParticleVertexShaderSource()
+{
+    return MCDefaultParticleVsh;
+}
+
+std::string MCGLShaderProgram::getDefaultParticleShadowVertexShaderSource()
+{
+    return MCDefaultParticleShadowVsh;
+}
+#endif
+
 std::string MCGLShaderProgram::getDefaultShadowFragmentShaderSource()
 {
     return MCDefaultShadowFsh;
@@ -432,6 +458,12 @@ void MCGLShaderProgram::setPendingSpecularLight()
     }
 }
 
+void MCGLShaderProgram::resetTextureBindings()
+{
+    // Nothing is known about the bindings, so any texture will be bound on the next bindMaterial()
+    MCGLShaderProgram::m_boundTextures.fill(std::numeric_limits<GLuint>::max());
+}
+
 void MCGLShaderProgram::setAmbientLight(const MCGLAmbientLight & light)
 {
     m_ambientLight = light;
@@ -467,18 +499,31 @@ void MCGLShaderProgram::bindMaterial(MCGLMaterialPtr material)
 {
     material->doAlphaBlend();
 
-    const GLuint texture1 = material->texture(0);
-    const GLuint texture2 = material->texture(1);
-    const GLuint texture3 = material->texture(2);
+#ifdef __MC_QOPENGLFUNCTIONS__
+    // The bindings are per context
+    if (const auto context = QOpenGLContext::currentContext(); context != MCGLShaderProgram::m_boundTexturesContext)
+    {
+        MCGLShaderProgram::resetTextureBindings();
+        MCGLShaderProgram::m_boundTexturesContext = context;
+    }
+#endif
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture1);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, texture2);
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, texture3);
+    bool unitChanged = false;
+    for (size_t i = 0; i < MCGLMaterial::MAX_TEXTURES; i++)
+    {
+        if (const GLuint texture = material->texture(i); texture != MCGLShaderProgram::m_boundTextures[i])
+        {
+            glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+            glBindTexture(GL_TEXTURE_2D, texture);
+            MCGLShaderProgram::m_boundTextures[i] = texture;
+            unitChanged = unitChanged || i > 0;
+        }
+    }
 
-    glActiveTexture(GL_TEXTURE0);
+    if (unitChanged)
+    {
+        glActiveTexture(GL_TEXTURE0);
+    }
 
     glUniform1f(getUniformLocation(Uniform::MaterialSpecularCoeff), material->specularCoeff());
     glUniform1f(getUniformLocation(Uniform::MaterialDiffuseCoeff), material->diffuseCoeff());
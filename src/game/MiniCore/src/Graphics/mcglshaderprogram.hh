@@ -30,12 +30,16 @@
 
 #include "mcvector3d.hh"
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 class MCGLScene;
+#ifdef __MC_QOPENGLFUNCTIONS__
+class QOpenGLContext;
+#endif
 
 /*! Base class for GLSL shader programs compatible with MiniCore.
  *  The user needs to inherit from this class and re-implement the
@@ -55,7 +59,10 @@ public:
         Vertex = 0,
         Normal = 1,
         TexCoords = 2,
-        Color = 3
+        Color = 3,
+        InstanceLocation = 4,
+        InstanceParams = 5,
+        InstanceColor = 6
     };
 
     /*! Default constructor. MCGLScene must have been created before creating
@@ -107,6 +114,14 @@ public:
     /*! Get the default shadow vertex shader source. Defining __MC_GLES__ will select GLES version. */
     static std::string getDefaultShadowVertexShaderSource();
 
+#ifdef __MC_GL33__
+    //! Get the default vertex shader source for instanced particles.
+    static std::string getDefaultParticleVertexShaderSource();
+
+    //! Get the default shadow vertex shader source for instanced particles.
+    static std::string getDefaultParticleShadowVertexShaderSource();
+#endif
+
     /*! Get the default shadow fragment shader source. Defining __MC_GLES__ will select GLES version. */
     static std::string getDefaultShadowFragmentShaderSource();
 
@@ -153,9 +168,15 @@ public:
     //! Set fade value. The master FBO program can use this to fade in/out the scene.
     void setFadeValue(GLfloat value);
 
-    //! Bind given material.
+    /*! Bind given material. Textures that are already bound to their units are not re-bound,
+     *  so consecutive surfaces sharing a texture atlas don't cause texture switches.
+     *  The cached bindings are forgotten automatically if the current context changes. */
     void bindMaterial(MCGLMaterialPtr material);
 
+    /*! Forget the texture bindings cached by bindMaterial(). Must be called if textures
+     *  are bound or deleted by other means, e.g. by QOpenGLFramebufferObject. */
+    static void resetTextureBindings();
+
     //! Set ambient light.
     void setAmbientLight(const MCGLAmbientLight & light);
 
@@ -224,6 +245,13 @@ private:
 
     static std::vector<MCGLShaderProgram *> m_programStack;
 
+    static std::array<GLuint, MCGLMaterial::MAX_TEXTURES> m_boundTextures;
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+    //! The context m_boundTextures belongs to.
+    static QOpenGLContext * m_boundTexturesContext;
+#endif
+
     typedef std::map<Uniform, int> UniformLocationHash;
     UniformLocationHash m_uniformLocationHash;
 
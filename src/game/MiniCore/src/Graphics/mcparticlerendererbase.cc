@@ -19,6 +19,8 @@
 
 #include "mcparticlerendererbase.hh"
 
+#include <algorithm>
+
 MCParticleRendererBase::MCParticleRendererBase(size_t maxBatchSize)
   : MCGLObjectBase("mcparticlerendererbase")
   , m_batchSize(0)
@@ -37,6 +39,18 @@ void MCParticleRendererBase::setAlphaBlend(bool useAlphaBlend, GLenum src, GLenu
     m_dst = dst;
 }
 
+void MCParticleRendererBase::sortBatch(MCRenderLayer::ObjectBatch & batch) const
+{
+    const auto lessZ = [](auto lhs, auto rhs) {
+        return lhs->location().k() < rhs->location().k();
+    };
+
+    if (!std::is_sorted(batch.objects.begin(), batch.objects.end(), lessZ))
+    {
+        std::sort(batch.objects.begin(), batch.objects.end(), lessZ);
+    }
+}
+
 size_t MCParticleRendererBase::maxBatchSize() const
 {
     return m_maxBatchSize;
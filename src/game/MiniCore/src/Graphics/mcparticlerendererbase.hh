@@ -67,6 +67,10 @@ protected:
     //! Set max batch size
     size_t maxBatchSize() const;
 
+    /*! Sort the batch by z. The shadow pass renders the same batch right after
+     *  the normal pass, so an already sorted batch is not sorted again. */
+    void sortBatch(MCRenderLayer::ObjectBatch & batch) const;
+
     bool useAlphaBlend() const;
 
     GLenum alphaSrc() const;
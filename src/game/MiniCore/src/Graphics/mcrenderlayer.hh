@@ -20,6 +20,8 @@
 #ifndef MCRENDERLAYER_HH
 #define MCRENDERLAYER_HH
 
+#include "mcrenderqueue.hh"
+
 #include <map>
 #include <set>
 #include <vector>
@@ -43,14 +45,9 @@ public:
 
     bool depthMaskEnabled() const;
 
-    struct ObjectBatch
-    {
-        int objectViewId = -1;
-        float priority = 0;
-        std::vector<MCObject *> objects;
-    };
+    using ObjectBatch = MCRenderQueue::Batch;
 
-    typedef std::map<MCCamera *, std::vector<ObjectBatch>> CameraBatchMap;
+    typedef std::map<MCCamera *, MCRenderQueue> CameraBatchMap;
 
     CameraBatchMap & objectBatches();
 
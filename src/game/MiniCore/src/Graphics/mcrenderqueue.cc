@@ -0,0 +1,201 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcrenderqueue.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+const uint64_t INDEX_MASK = 0xffff;
+}
+
+void MCRenderQueue::clear()
+{
+    for (size_t i = 0; i < m_activeBatchCount; i++)
+    {
+        m_batches[i].objects.clear();
+    }
+
+    m_activeBatchCount = 0;
+}
+
+void MCRenderQueue::add(int objectViewId, MCObject & object, float priority, unsigned int group)
+{
+    size_t index = 0;
+    if (const auto iter = m_batchIndices.find(objectViewId); iter != m_batchIndices.end())
+    {
+        index = iter->second;
+    }
+    else
+    {
+        index = m_batches.size();
+        m_batches.emplace_back();
+        m_batches.back().objectViewId = objectViewId;
+        m_sortedBatches.emplace_back();
+        m_batchIndices[objectViewId] = index;
+    }
+
+    // Keep the batches added on this frame at the front in the order of addition
+    if (index >= m_activeBatchCount)
+    {
+        const size_t target = m_activeBatchCount++;
+        if (index != target)
+        {
+            std::swap(m_batches[index], m_batches[target]);
+            m_batchIndices[m_batches[index].objectViewId] = index;
+            m_batchIndices[objectViewId] = target;
+            index = target;
+        }
+
+        m_batches[index].priority = priority;
+        m_batches[index].group = group;
+    }
+    else
+    {
+        m_batches[index].priority = std::max(priority, m_batches[index].priority);
+    }
+
+    m_batches[index].objects.push_back(&object);
+}
+
+uint64_t MCRenderQueue::sortKey(float priority, uint32_t index)
+{
+    // Map the float to an unsigned integer that has the same order
+    uint32_t bits = 0;
+    std::memcpy(&bits, &priority, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+    return (static_cast<uint64_t>(bits) << 32) | index;
+}
+
+void MCRenderQueue::sort()
+{
+    if (m_activeBatchCount < 2)
+    {
+        return;
+    }
+
+    // Practically never happens, but the index of a batch must fit in the key
+    const bool indexFitsKey = m_activeBatchCount <= INDEX_MASK + 1;
+
+    m_keys.resize(m_activeBatchCount);
+    m_sortBuffer.resize(m_activeBatchCount);
+
+    // The lower half of a key is the order of the first batch of the group and the index
+    m_groupOrder.clear();
+    for (size_t i = 0; i < m_activeBatchCount; i++)
+    {
+        const unsigned int group = m_batches[i].group;
+        auto iter = std::find_if(m_groupOrder.begin(), m_groupOrder.end(), [group](auto && item) {
+            return item.first == group;
+        });
+
+        if (iter == m_groupOrder.end())
+        {
+            m_groupOrder.push_back({ group, static_cast<uint32_t>(i) });
+            iter = m_groupOrder.end() - 1;
+        }
+
+        m_keys[i] = indexFitsKey ? MCRenderQueue::sortKey(m_batches[i].priority, (iter->second << 16) | static_cast<uint32_t>(i))
+                                 : MCRenderQueue::sortKey(m_batches[i].priority, iter->second);
+    }
+
+    if (!indexFitsKey)
+    {
+        // Fall back to a stable comparison sort of the indices
+        m_indices.resize(m_activeBatchCount);
+        std::iota(m_indices.begin(), m_indices.end(), 0);
+        std::stable_sort(m_indices.begin(), m_indices.end(), [this](size_t lhs, size_t rhs) {
+            return m_keys[lhs] < m_keys[rhs];
+        });
+
+        for (size_t i = 0; i < m_activeBatchCount; i++)
+        {
+            std::swap(m_sortedBatches[i], m_batches[m_indices[i]]);
+        }
+
+        updateSortedBatches();
+        return;
+    }
+
+    // LSD radix sort of the keys without the index, which is already in order. It's stable,
+    // so equal keys stay in the order of addition. Passes where all keys have the same digit are skipped.
+    for (unsigned int shift = 16; shift < 64; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (auto && key : m_keys)
+        {
+            counts[(key >> shift) & 0xff]++;
+        }
+
+        if (counts[(m_keys[0] >> shift) & 0xff] == m_keys.size())
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto && count : counts)
+        {
+            const size_t digitCount = count;
+            count = offset;
+            offset += digitCount;
+        }
+
+        for (auto && key : m_keys)
+        {
+            m_sortBuffer[counts[(key >> shift) & 0xff]++] = key;
+        }
+
+        m_keys.swap(m_sortBuffer);
+    }
+
+    // Swapping the batches only moves the object vectors, so no allocations are made
+    for (size_t i = 0; i < m_activeBatchCount; i++)
+    {
+        std::swap(m_sortedBatches[i], m_batches[m_keys[i] & INDEX_MASK]);
+    }
+
+    updateSortedBatches();
+}
+
+void MCRenderQueue::updateSortedBatches()
+{
+    for (size_t i = 0; i < m_activeBatchCount; i++)
+    {
+        std::swap(m_batches[i], m_sortedBatches[i]);
+        m_batchIndices[m_batches[i].objectViewId] = i;
+    }
+}
+
+size_t MCRenderQueue::size() const
+{
+    return m_activeBatchCount;
+}
+
+MCRenderQueue::BatchVector::iterator MCRenderQueue::begin()
+{
+    return m_batches.begin();
+}
+
+MCRenderQueue::BatchVector::iterator MCRenderQueue::end()
+{
+    return m_batches.begin() + static_cast<BatchVector::difference_type>(m_activeBatchCount);
+}
@@ -0,0 +1,94 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCRENDERQUEUE_HH
+#define MCRENDERQUEUE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class MCObject;
+
+/*! Groups objects into batches by their view id and sorts the batches by priority.
+ *  The batches are persistent: clear() only empties them, so the allocated batches and
+ *  their capacity are reused on the next frame. Iteration goes through the sorted
+ *  non-empty batches. */
+class MCRenderQueue
+{
+public:
+    struct Batch
+    {
+        int objectViewId = -1;
+        float priority = 0;
+        unsigned int group = 0;
+        std::vector<MCObject *> objects;
+    };
+
+    using BatchVector = std::vector<Batch>;
+
+    //! Empty all batches.
+    void clear();
+
+    /*! Add object to the batch of the given view id. The priority of the batch is the
+     *  largest priority of its objects.
+     *  \param group Batches of the same group, e.g. surfaces sharing a texture atlas, are
+     *         rendered one after another when their priorities are equal. */
+    void add(int objectViewId, MCObject & object, float priority, unsigned int group = 0);
+
+    /*! Sort the batches by priority with a radix sort. Batches with an equal priority are
+     *  gathered by their group and otherwise keep the order in which they were first added to.
+     *  More than 65536 batches are sorted with a comparison sort. */
+    void sort();
+
+    //! \return number of non-empty batches.
+    size_t size() const;
+
+    BatchVector::iterator begin();
+
+    BatchVector::iterator end();
+
+    //! \return 64-bit sort key with the priority in the upper and the given index in the lower half.
+    static uint64_t sortKey(float priority, uint32_t index);
+
+private:
+    //! Move the sorted batches back to the front of m_batches and update their indices.
+    void updateSortedBatches();
+
+    BatchVector m_batches;
+
+    BatchVector m_sortedBatches;
+
+    std::unordered_map<int, size_t> m_batchIndices;
+
+    size_t m_activeBatchCount = 0;
+
+    std::vector<uint64_t> m_keys;
+
+    std::vector<uint64_t> m_sortBuffer;
+
+    std::vector<std::pair<unsigned int, uint32_t>> m_groupOrder;
+
+    //! Sorted order of the batches if there are too many for the 16-bit index of a key.
+    std::vector<size_t> m_indices;
+};
+
+#endif // MCRENDERQUEUE_HH
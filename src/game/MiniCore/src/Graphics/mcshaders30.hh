@@ -134,6 +134,87 @@ static const char * MCDefaultShadowVsh =
   "    texCoord0   = inTexCoord;\n"
   "}\n";
 
+// Instanced particles need OpenGL 3.3
+#ifdef __MC_GL33__
+static const char * MCDefaultParticleVsh =
+  "#version 130\n"
+  ""
+  "in      vec3  inVertex;\n"
+  "in      vec3  inNormal;\n"
+  "in      vec2  inTexCoord;\n"
+  "in      vec4  inInstanceColor;\n"
+  "in      vec4  inInstanceLocation;\n"
+  "in      vec3  inInstanceParams;\n"
+  "uniform vec4  scale = vec4(1, 1, 1, 1);\n"
+  "uniform vec4  color = vec4(1, 1, 1, 1);\n"
+  "uniform mat4  vp;\n"
+  "uniform mat4  model;\n"
+  "uniform vec4  dd = vec4(1, 1, 1, 1);\n"
+  "uniform vec4  dc = vec4(1, 1, 1, 1);\n"
+  "uniform vec4  ac = vec4(1, 1, 1, 1);\n"
+  "uniform float dCoeff = 1;\n"
+  "out     vec2  texCoord0;\n"
+  "out     vec4  vColor;\n"
+  ""
+  "void main()\n"
+  "{\n"
+  "    // Instance: location + angle in radians, radius + animation scale + animation style, color\n"
+  "    float size  = inInstanceParams.x;\n"
+  "    float alpha = inInstanceColor.a;\n"
+  "    float style = inInstanceParams.z;\n"
+  "    if (style == 1.0 || style == 3.0)\n"
+  "    {\n"
+  "        size *= inInstanceParams.y;\n"
+  "    }\n"
+  "    if (style == 2.0 || style == 3.0)\n"
+  "    {\n"
+  "        alpha *= inInstanceParams.y;\n"
+  "    }\n"
+  ""
+  "    float c = cos(inInstanceLocation.w);\n"
+  "    float s = sin(inInstanceLocation.w);\n"
+  "    vec2 corner = inVertex.xy * size;\n"
+  "    vec3 vertex = vec3(inInstanceLocation.xy + vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y), inInstanceLocation.z);\n"
+  "    gl_Position = vp * model * (vec4(vertex, 1) * scale);\n"
+  ""
+  "    mat4 normalRot = mat4(mat3(model));\n"
+  "    float di = dot(dd.xyz, (normalRot * vec4(-inNormal, 1)).xyz) * dc.a;\n"
+  "    vColor = vec4(inInstanceColor.rgb, alpha) * color * (\n"
+  "        vec4(ac.rgb * ac.a, 1.0) +\n"
+  "        vec4(dc.rgb * di * dCoeff, 1.0));\n"
+  ""
+  "    texCoord0 = inTexCoord;\n"
+  "}\n";
+
+static const char * MCDefaultParticleShadowVsh =
+  "#version 130\n"
+  ""
+  "in      vec3 inVertex;\n"
+  "in      vec2 inTexCoord;\n"
+  "in      vec4 inInstanceLocation;\n"
+  "in      vec3 inInstanceParams;\n"
+  "uniform vec4 scale = vec4(1, 1, 1, 1);\n"
+  "uniform mat4 vp;\n"
+  "uniform mat4 model;\n"
+  "out     vec2 texCoord0;\n"
+  ""
+  "void main()\n"
+  "{\n"
+  "    float size = inInstanceParams.x;\n"
+  "    if (inInstanceParams.z == 1.0 || inInstanceParams.z == 3.0)\n"
+  "    {\n"
+  "        size *= inInstanceParams.y;\n"
+  "    }\n"
+  ""
+  "    float c = cos(inInstanceLocation.w);\n"
+  "    float s = sin(inInstanceLocation.w);\n"
+  "    vec2 corner = inVertex.xy * size;\n"
+  "    vec2 vertex = inInstanceLocation.xy + vec2(c * corner.x - s * corner.y, s * corner.x + c * corner.y);\n"
+  "    gl_Position = vp * model * (vec4(vertex, 0, 1) * scale);\n"
+  "    texCoord0   = inTexCoord;\n"
+  "}\n";
+#endif
+
 static const char * MCDefaultShadowFsh =
   "#version 130\n"
   ""
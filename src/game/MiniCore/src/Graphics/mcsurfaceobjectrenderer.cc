@@ -89,7 +89,8 @@ void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCam
     {
         object = batch.objects[i];
         const auto view = static_cast<MCSurfaceView *>(object->shape()->view().get());
-        const auto location(object->shape()->location());
+        const auto location(object->shape()->renderLocation());
+        const float angle = object->shape()->renderAngle();
 
         float x, y, z;
         if (isShadow)
@@ -118,8 +119,8 @@ void MCSurfaceObjectRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCCam
 
             m_vertices[vertexIndex] =
               MCGLVertex(
-                x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->angle()) * view->scale().i(),
-                y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->angle()) * view->scale().j(),
+                x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), angle) * view->scale().i(),
+                y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), angle) * view->scale().j(),
                 !isShadow ? z + vertex.z() : z);
 
             m_normals[vertexIndex] = m_surface->normal(j);
@@ -66,7 +66,8 @@ void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch,
     {
         object = batch.objects[i];
         const auto view = static_cast<MCSurfaceView *>(object->shape()->view().get());
-        const auto location(object->shape()->location());
+        const auto location(object->shape()->renderLocation());
+        const float angle = object->shape()->renderAngle();
 
         float x, y, z;
         if (isShadow)
@@ -95,8 +96,8 @@ void MCSurfaceObjectRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batch,
 
             m_vertices[vertexIndex] =
               MCGLVertex(
-                x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), object->angle()) * view->scale().i(),
-                y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), object->angle()) * view->scale().j(),
+                x + MCMathUtil::rotatedX(vertex.x(), vertex.y(), angle) * view->scale().i(),
+                y + MCMathUtil::rotatedY(vertex.x(), vertex.y(), angle) * view->scale().j(),
                 !isShadow ? z + vertex.z() : z);
 
             m_normals[vertexIndex] = m_surface->normal(j);
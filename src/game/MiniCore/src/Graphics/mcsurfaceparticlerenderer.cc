@@ -65,9 +65,7 @@ void MCSurfaceParticleRenderer::setBatch(MCRenderLayer::ObjectBatch & batch, MCC
     }
 
     setBatchSize(std::min(batch.objects.size(), maxBatchSize()));
-    std::sort(batch.objects.begin(), batch.objects.end(), [](auto lhs, auto rhs) {
-        return lhs->location().k() < rhs->location().k();
-    });
+    sortBatch(batch);
 
     const auto numVertices = batchSize() * m_numVerticesPerParticle;
     const auto vertexDataSize = sizeof(MCGLVertex) * numVertices;
@@ -0,0 +1,302 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcsurfaceparticlerendererinstanced.hh"
+
+#include "mccamera.hh"
+#include "mcglscene.hh"
+#include "mcshape.hh"
+#include "mcsurface.hh"
+#include "mcsurfaceparticle.hh"
+#include "mctrigonom.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#endif
+
+static_assert(sizeof(MCSurfaceParticleRendererInstanced::Instance) == 32, "Instance record should be 32 bytes");
+
+// The quad is drawn as a fan so that it works also on core profiles
+const size_t MCSurfaceParticleRendererInstanced::m_numVerticesPerParticle = 4;
+
+namespace {
+const MCGLVertex QUAD_VERTICES[] = {
+    { -1, 1, 0 },
+    { -1, -1, 0 },
+    { 1, -1, 0 },
+    { 1, 1, 0 }
+};
+
+const MCGLVertex QUAD_NORMALS[] = {
+    { 0, 0, 1 },
+    { 0, 0, 1 },
+    { 0, 0, 1 },
+    { 0, 0, 1 }
+};
+
+const MCGLTexCoord QUAD_TEX_COORDS[] = {
+    { 0, 1 },
+    { 0, 0 },
+    { 1, 0 },
+    { 1, 1 }
+};
+
+const size_t QUAD_VERTEX_DATA_SIZE = sizeof(QUAD_VERTICES);
+
+const size_t QUAD_NORMAL_DATA_SIZE = sizeof(QUAD_NORMALS);
+
+const size_t QUAD_TEX_COORD_DATA_SIZE = sizeof(QUAD_TEX_COORDS);
+
+const size_t QUAD_DATA_SIZE = QUAD_VERTEX_DATA_SIZE + QUAD_NORMAL_DATA_SIZE + QUAD_TEX_COORD_DATA_SIZE;
+
+GLubyte toUnsignedByte(float value)
+{
+    return static_cast<GLubyte>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+} // namespace
+
+MCSurfaceParticleRendererInstanced::MCSurfaceParticleRendererInstanced(size_t maxBatchSize)
+  : MCParticleRendererBase(maxBatchSize)
+  , m_instances(maxBatchSize)
+{
+    setShaderProgram(MCGLScene::instance().defaultParticleShaderProgram());
+    setShadowShaderProgram(MCGLScene::instance().defaultParticleShadowShaderProgram());
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+    if (!MCGLObjectBase::headless())
+    {
+        m_extraFunctions = QOpenGLContext::currentContext()->extraFunctions();
+    }
+#endif
+
+    // The quad never changes, so it's uploaded only here
+    initBufferData(QUAD_DATA_SIZE, GL_STATIC_DRAW);
+
+    addQuadData();
+
+    if (!MCGLObjectBase::headless())
+    {
+        glGenBuffers(1, &m_instanceVbo);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<int>(sizeof(Instance) * maxBatchSize), nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    finishBufferData();
+}
+
+MCSurfaceParticleRendererInstanced::~MCSurfaceParticleRendererInstanced()
+{
+    if (m_instanceVbo != 0)
+    {
+        glDeleteBuffers(1, &m_instanceVbo);
+        m_instanceVbo = 0;
+    }
+}
+
+bool MCSurfaceParticleRendererInstanced::isSupported()
+{
+#ifdef __MC_QOPENGLFUNCTIONS__
+    const auto context = QOpenGLContext::currentContext();
+    return context && !context->isOpenGLES() && context->format().version() >= qMakePair(3, 3);
+#elif !defined(__MC_NO_GLEW__)
+    return GLEW_VERSION_3_3;
+#else
+    int major = 0;
+    int minor = 0;
+    const auto version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+    return version && std::sscanf(version, "%d.%d", &major, &minor) == 2 && (major > 3 || (major == 3 && minor >= 3));
+#endif
+}
+
+MCSurfaceParticleRendererInstanced::Instance MCSurfaceParticleRendererInstanced::packInstance(MCSurfaceParticle & particle, MCCamera * camera, bool isShadow)
+{
+    Instance instance;
+
+    const auto location = particle.location();
+    if (isShadow)
+    {
+        const auto shadowOffset = particle.shape()->shadowOffset();
+        instance.x = location.i() + shadowOffset.i();
+        instance.y = location.j() + shadowOffset.j();
+        instance.z = shadowOffset.k();
+    }
+    else
+    {
+        instance.x = location.i();
+        instance.y = location.j();
+        instance.z = location.k();
+    }
+
+    if (camera)
+    {
+        camera->mapToCamera(instance.x, instance.y);
+    }
+
+    // The animation is applied in the vertex shader
+    instance.angle = MCTrigonom::degToRad(particle.angle());
+    instance.radius = particle.radius();
+    instance.scale = particle.scale();
+    instance.animationStyle = static_cast<GLfloat>(particle.animationStyle());
+
+    const auto & color = particle.color();
+    instance.color[0] = toUnsignedByte(color.r());
+    instance.color[1] = toUnsignedByte(color.g());
+    instance.color[2] = toUnsignedByte(color.b());
+    instance.color[3] = toUnsignedByte(color.a());
+
+    return instance;
+}
+
+void MCSurfaceParticleRendererInstanced::addQuadData()
+{
+    addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::Vertex, QUAD_VERTEX_DATA_SIZE, reinterpret_cast<const GLfloat *>(QUAD_VERTICES));
+    addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::Normal, QUAD_NORMAL_DATA_SIZE, reinterpret_cast<const GLfloat *>(QUAD_NORMALS));
+    addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::TexCoords, QUAD_TEX_COORD_DATA_SIZE, reinterpret_cast<const GLfloat *>(QUAD_TEX_COORDS));
+}
+
+void MCSurfaceParticleRendererInstanced::setAttributePointers()
+{
+    const auto vertex = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::Vertex);
+    const auto normal = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::Normal);
+    const auto texCoords = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::TexCoords);
+    const auto instanceLocation = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::InstanceLocation);
+    const auto instanceParams = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::InstanceParams);
+    const auto instanceColor = static_cast<GLuint>(MCGLShaderProgram::VertexAttributeLocation::InstanceColor);
+
+    // The quad has no vertex colors
+    glEnableVertexAttribArray(vertex);
+    glEnableVertexAttribArray(normal);
+    glEnableVertexAttribArray(texCoords);
+    glEnableVertexAttribArray(instanceLocation);
+    glEnableVertexAttribArray(instanceParams);
+    glEnableVertexAttribArray(instanceColor);
+
+    bindVBO();
+
+    glVertexAttribPointer(vertex, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glVertexAttribPointer(normal, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<GLvoid *>(QUAD_VERTEX_DATA_SIZE));
+
+    glVertexAttribPointer(texCoords, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<GLvoid *>(QUAD_VERTEX_DATA_SIZE + QUAD_NORMAL_DATA_SIZE));
+
+    // Instance data: location + angle, radius + scale + animation style, color
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+
+    const auto stride = static_cast<GLsizei>(sizeof(Instance));
+    glVertexAttribPointer(instanceLocation, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid *>(offsetof(Instance, x)));
+
+    glVertexAttribPointer(instanceParams, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<GLvoid *>(offsetof(Instance, radius)));
+
+    glVertexAttribPointer(instanceColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<GLvoid *>(offsetof(Instance, color)));
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+    m_extraFunctions->glVertexAttribDivisor(instanceLocation, 1);
+    m_extraFunctions->glVertexAttribDivisor(instanceParams, 1);
+    m_extraFunctions->glVertexAttribDivisor(instanceColor, 1);
+#else
+    glVertexAttribDivisor(instanceLocation, 1);
+    glVertexAttribDivisor(instanceParams, 1);
+    glVertexAttribDivisor(instanceColor, 1);
+#endif
+}
+
+void MCSurfaceParticleRendererInstanced::setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera, bool isShadow)
+{
+    if (!batch.objects.size())
+    {
+        return;
+    }
+
+    setBatchSize(std::min(batch.objects.size(), maxBatchSize()));
+    sortBatch(batch);
+
+    // Take common properties from the first particle in the batch
+    const auto particle = dynamic_cast<MCSurfaceParticle *>(batch.objects.at(0));
+    setMaterial(particle->surface()->material());
+    setHasShadow(particle->hasShadow());
+    setAlphaBlend(particle->useAlphaBlend(), particle->alphaSrc(), particle->alphaDst());
+
+    for (size_t i = 0; i < batchSize(); i++)
+    {
+        m_instances[i] = packInstance(*static_cast<MCSurfaceParticle *>(batch.objects[i]), camera, isShadow);
+    }
+
+    updateInstanceData();
+}
+
+void MCSurfaceParticleRendererInstanced::updateInstanceData()
+{
+    if (MCGLObjectBase::headless())
+    {
+        return;
+    }
+
+    // Orphan the previous instance data, the quad stays untouched
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<int>(sizeof(Instance) * maxBatchSize()), nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<int>(sizeof(Instance) * batchSize()), m_instances.data());
+    releaseVBO();
+}
+
+void MCSurfaceParticleRendererInstanced::drawInstances()
+{
+#ifdef __MC_QOPENGLFUNCTIONS__
+    m_extraFunctions->glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, static_cast<int>(m_numVerticesPerParticle), static_cast<int>(batchSize()));
+#else
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, static_cast<int>(m_numVerticesPerParticle), static_cast<int>(batchSize()));
+#endif
+}
+
+void MCSurfaceParticleRendererInstanced::render()
+{
+    assert(shaderProgram());
+
+    bind();
+
+    shaderProgram()->setTransform(0, MCVector3dF(0, 0, 1));
+    shaderProgram()->setScale(1.0f, 1.0f, 1.0f);
+    shaderProgram()->setColor(MCGLColor(1.0f, 1.0f, 1.0f, 1.0f));
+
+    drawInstances();
+    glDisable(GL_BLEND);
+
+    releaseVBO();
+    releaseVAO();
+}
+
+void MCSurfaceParticleRendererInstanced::renderShadows()
+{
+    assert(shadowShaderProgram());
+
+    bindShadow();
+
+    shadowShaderProgram()->setTransform(0, MCVector3dF(0, 0, 0));
+    shadowShaderProgram()->setScale(1.0f, 1.0f, 1.0f);
+
+    drawInstances();
+
+    releaseVBO();
+    releaseVAO();
+}
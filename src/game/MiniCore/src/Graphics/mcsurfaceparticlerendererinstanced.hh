@@ -0,0 +1,113 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCSURFACEPARTICLERENDERERINSTANCED_HH
+#define MCSURFACEPARTICLERENDERERINSTANCED_HH
+
+#include <MCGLEW>
+
+#include "mcmacros.hh"
+#include "mcparticlerendererbase.hh"
+
+#include <vector>
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+class QOpenGLExtraFunctions;
+#endif
+
+class MCSurfaceParticle;
+class MCCamera;
+
+/*! Renders surface particle batches with GPU instancing.
+ *  A single quad is uploaded once to the vertex buffer and each particle is
+ *  uploaded as a 32-byte record to a separate instance buffer that the vertex
+ *  shader expands. Built only with __MC_GL33__, which requests an OpenGL 3.3
+ *  core context, see isSupported(). */
+class MCSurfaceParticleRendererInstanced : public MCParticleRendererBase
+{
+public:
+    //! Per-particle data uploaded to the GPU.
+    struct Instance
+    {
+        //! Location mapped to the camera.
+        GLfloat x, y, z;
+
+        //! Angle in radians.
+        GLfloat angle;
+
+        GLfloat radius;
+
+        //! Animation scale of the particle.
+        GLfloat scale;
+
+        //! MCParticle::AnimationStyle as a number.
+        GLfloat animationStyle;
+
+        //! RGBA8 color.
+        GLubyte color[4];
+    };
+
+    explicit MCSurfaceParticleRendererInstanced(size_t maxBatchSize = 1024);
+
+    //! Destructor.
+    virtual ~MCSurfaceParticleRendererInstanced() override;
+
+    //! \return true if the current GL context supports instanced rendering.
+    static bool isSupported();
+
+    //! Build the instance record for the given particle.
+    static Instance packInstance(MCSurfaceParticle & particle, MCCamera * camera, bool isShadow);
+
+private:
+    DISABLE_COPY(MCSurfaceParticleRendererInstanced);
+    DISABLE_ASSI(MCSurfaceParticleRendererInstanced);
+    DISABLE_MOVE(MCSurfaceParticleRendererInstanced);
+
+    //! \reimp
+    void setBatch(MCRenderLayer::ObjectBatch & batch, MCCamera * camera = nullptr, bool isShadow = false) override;
+
+    //! \reimp
+    void render() override;
+
+    //! \reimp
+    void renderShadows() override;
+
+    //! \reimp
+    void setAttributePointers() override;
+
+    void addQuadData();
+
+    void updateInstanceData();
+
+    void drawInstances();
+
+    static const size_t m_numVerticesPerParticle;
+
+    std::vector<Instance> m_instances;
+
+    GLuint m_instanceVbo = 0;
+
+#ifdef __MC_QOPENGLFUNCTIONS__
+    QOpenGLExtraFunctions * m_extraFunctions = nullptr;
+#endif
+
+    friend class MCWorldRenderer;
+};
+
+#endif // MCSURFACEPARTICLERENDERERINSTANCED_HH
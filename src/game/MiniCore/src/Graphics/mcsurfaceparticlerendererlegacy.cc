@@ -48,9 +48,7 @@ void MCSurfaceParticleRendererLegacy::setBatch(MCRenderLayer::ObjectBatch & batc
     }
 
     setBatchSize(std::min(batch.objects.size(), maxBatchSize()));
-    std::sort(batch.objects.begin(), batch.objects.end(), [](auto lhs, auto rhs) {
-        return lhs->location().k() < rhs->location().k();
-    });
+    sortBatch(batch);
 
     // Init vertice data for a quad
 
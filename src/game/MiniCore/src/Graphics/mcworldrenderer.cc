@@ -19,7 +19,9 @@
 
 #include "mcworldrenderer.hh"
 
+#include "mcbroadphase.hh"
 #include "mccamera.hh"
+#include "mcglobjectbase.hh"
 #include "mclogger.hh"
 #include "mcobject.hh"
 #include "mcparticle.hh"
@@ -27,13 +29,17 @@
 #include "mcshapeview.hh"
 #include "mcsurfaceparticle.hh"
 #include "mcsurfaceparticlerenderer.hh"
+#ifdef __MC_GL33__
+#include "mcsurfaceparticlerendererinstanced.hh"
+#endif
 #include "mcsurfaceparticlerendererlegacy.hh"
 #include "mcsurfaceview.hh"
 
-#include <algorithm>
-
 #include <MCGLEW>
 
+#include <algorithm>
+#include <cassert>
+
 MCWorldRenderer::MCWorldRenderer()
   : m_surfaceParticleRenderer(nullptr)
 {
@@ -44,14 +50,25 @@ MCGLScene & MCWorldRenderer::glScene()
     return m_glScene;
 }
 
-void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
+void MCWorldRenderer::buildObjectBatches()
 {
-    m_defaultLayer.objectBatches()[camera].clear();
-    auto & batchVector = m_defaultLayer.objectBatches()[camera];
+    m_cameraBBoxes.clear();
+    m_renderQueues.clear();
+    for (auto && camera : m_cameras)
+    {
+        m_cameraBBoxes.push_back(camera->bbox());
+        auto & renderQueue = m_defaultLayer.objectBatches()[camera];
+        renderQueue.clear();
+        m_renderQueues.push_back(&renderQueue);
+    }
+
     static std::vector<MCObject *> childStack;
     childStack.clear();
-    for (auto && object : MCWorld::instance().objectGrid().getObjectsWithinBBox(camera->bbox()))
+    for (auto && objectMask : MCWorld::instance().objectGrid().getObjectsWithinBBoxes(m_cameraBBoxes))
     {
+        const auto object = objectMask.first;
+        const auto cameraMask = objectMask.second;
+
         childStack.push_back(object);
         while (childStack.size())
         {
@@ -60,23 +77,18 @@ void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
 
             if (parent->isRenderable() && parent->shape() && parent->shape()->view())
             {
-                const int objectViewId = static_cast<int>(object->typeId()) * 1024 + static_cast<int>(parent->shape()->view()->viewId());
-                auto batchIter = std::find_if(batchVector.begin(), batchVector.end(), [&](const MCRenderLayer::ObjectBatch & batch) {
-                    return batch.objectViewId == objectViewId;
-                });
-                if (batchIter != batchVector.end())
-                {
-                    auto & batch = (*batchIter);
-                    batch.objects.push_back(parent);
-                    batch.priority = std::max(parent->location().k(), batch.priority);
-                }
-                else
+                const auto view = parent->shape()->view();
+                const int objectViewId = static_cast<int>(object->typeId()) * 1024 + static_cast<int>(view->viewId());
+
+                // Views sharing a texture (atlas) are grouped to avoid texture switches
+                const auto glObject = view->object();
+                const unsigned int texture = glObject && glObject->material() ? glObject->material()->texture(0) : 0;
+                for (size_t n = 0; n < m_renderQueues.size(); n++)
                 {
-                    MCRenderLayer::ObjectBatch batch;
-                    batch.objectViewId = objectViewId;
-                    batch.objects.push_back(parent);
-                    batch.priority = parent->location().k();
-                    batchVector.push_back(batch);
+                    if (cameraMask & (1u << n))
+                    {
+                        m_renderQueues[n]->add(objectViewId, *parent, parent->location().k(), texture);
+                    }
                 }
             }
 
@@ -87,15 +99,31 @@ void MCWorldRenderer::buildObjectBatches(MCCamera * camera)
         }
     }
 
-    std::stable_sort(batchVector.begin(), batchVector.end(), [](const MCRenderLayer::ObjectBatch & l, const MCRenderLayer::ObjectBatch & r) {
-        return l.priority < r.priority;
-    });
+    for (auto && renderQueue : m_renderQueues)
+    {
+        renderQueue->sort();
+    }
 }
 
-void MCWorldRenderer::buildParticleBatches(MCCamera * camera)
+void MCWorldRenderer::buildParticleBatches()
 {
-    m_defaultLayer.particleBatches()[camera].clear();
-    auto & batchVector = m_defaultLayer.particleBatches()[camera];
+    m_renderQueues.clear();
+    for (auto && camera : m_cameras)
+    {
+        auto & renderQueue = m_defaultLayer.particleBatches()[camera];
+        renderQueue.clear();
+        m_renderQueues.push_back(&renderQueue);
+    }
+
+    m_otherVisibilityCameras.clear();
+    for (auto && visibilityCamera : m_visibilityCameras)
+    {
+        if (std::find(m_cameras.begin(), m_cameras.end(), visibilityCamera) == m_cameras.end())
+        {
+            m_otherVisibilityCameras.push_back(visibilityCamera);
+        }
+    }
+
     for (auto && particleIter : m_particleSet)
     {
         MCParticle & particle = *particleIter;
@@ -105,55 +133,65 @@ void MCWorldRenderer::buildParticleBatches(MCCamera * camera)
           particle.location().i() + particle.radius(),
           particle.location().j() + particle.radius());
 
-        if (camera->isVisible(bbox))
+        bool isVisibleInAnyCamera = false;
+        for (size_t n = 0; n < m_cameras.size(); n++)
         {
-            auto batchIter = std::find_if(batchVector.begin(), batchVector.end(), [&](const MCRenderLayer::ObjectBatch & batch) {
-                return batch.objectViewId == static_cast<int>(particle.typeId());
-            });
-            if (batchIter != batchVector.end())
-            {
-                auto & batch = (*batchIter);
-                batch.objects.push_back(&particle);
-                batch.priority = std::max(particle.location().k(), batch.priority);
-            }
-            else
+            if (m_cameras[n]->isVisible(bbox))
             {
-                MCRenderLayer::ObjectBatch batch;
-                batch.objectViewId = static_cast<int>(particle.typeId());
-                batch.objects.push_back(&particle);
-                batch.priority = particle.location().k();
-                batchVector.push_back(batch);
+                m_renderQueues[n]->add(static_cast<int>(particle.typeId()), particle, particle.location().k());
+                isVisibleInAnyCamera = true;
             }
         }
-        else
+
+        // Optimization that kills non-visible particles.
+        if (!isVisibleInAnyCamera && particle.dieWhenOffScreen())
         {
-            // Optimization that kills non-visible particles.
-            if (particle.dieWhenOffScreen())
-            {
-                bool isVisibleInAnyCamera = false;
-                for (auto visibilityCamera : m_visibilityCameras)
-                {
-                    if (visibilityCamera != camera && visibilityCamera->isVisible(bbox))
-                    {
-                        isVisibleInAnyCamera = true;
-                        break;
-                    }
-                }
+            const bool isVisibleInOtherCamera = std::any_of(m_otherVisibilityCameras.begin(), m_otherVisibilityCameras.end(), [&bbox](auto && visibilityCamera) {
+                return visibilityCamera->isVisible(bbox);
+            });
 
-                if (!isVisibleInAnyCamera)
-                {
-                    particle.die();
-                }
+            if (!isVisibleInOtherCamera)
+            {
+                particle.die();
             }
         }
     }
 
-    std::stable_sort(batchVector.begin(), batchVector.end(), [](const MCRenderLayer::ObjectBatch & l, const MCRenderLayer::ObjectBatch & r) {
-        return l.priority < r.priority;
-    });
+    for (auto && renderQueue : m_renderQueues)
+    {
+        renderQueue->sort();
+    }
 }
 
 void MCWorldRenderer::buildBatches(MCCamera * camera)
+{
+    if (!camera)
+    {
+        return;
+    }
+
+    m_cameras.assign(1, camera);
+
+    buildCameraBatches();
+}
+
+void MCWorldRenderer::buildBatches(const std::vector<MCCamera *> & cameras)
+{
+    assert(cameras.size() <= MCBroadPhase::MAX_BBOXES);
+
+    m_cameras.clear();
+    for (auto && camera : cameras)
+    {
+        if (camera)
+        {
+            m_cameras.push_back(camera);
+        }
+    }
+
+    buildCameraBatches();
+}
+
+void MCWorldRenderer::buildCameraBatches()
 {
     // This code tests the visibility and sorts the objects with respect
     // to their view id's into "batches". MCWorld::render()
@@ -163,7 +201,10 @@ void MCWorldRenderer::buildBatches(MCCamera * camera)
     // Grouping the objects like this reduces texture switches etc and increases
     // overall performance.
 
-    if (!camera)
+    // All cameras are handled in the same pass, so that in split screen
+    // the broad phase is walked only once.
+
+    if (m_cameras.empty())
     {
         return;
     }
@@ -173,9 +214,9 @@ void MCWorldRenderer::buildBatches(MCCamera * camera)
         createSurfaceParticleRenderer();
     }
 
-    buildObjectBatches(camera);
+    buildObjectBatches();
 
-    buildParticleBatches(camera);
+    buildParticleBatches();
 }
 
 void MCWorldRenderer::render(MCCamera * camera, MCRenderGroup renderGroup)
@@ -262,6 +303,17 @@ void MCWorldRenderer::createSurfaceParticleRenderer()
 #ifdef __MC_GLES__
     MCLogger().info() << "Particle renderer using vertex arrays.";
     m_surfaceParticleRenderer = new MCSurfaceParticleRendererLegacy;
+#elif defined(__MC_GL33__)
+    if (MCSurfaceParticleRendererInstanced::isSupported())
+    {
+        MCLogger().info() << "Particle renderer using instancing.";
+        m_surfaceParticleRenderer = new MCSurfaceParticleRendererInstanced;
+    }
+    else
+    {
+        MCLogger().info() << "Particle renderer using VAO.";
+        m_surfaceParticleRenderer = new MCSurfaceParticleRenderer;
+    }
 #else
     MCLogger().info() << "Particle renderer using VAO.";
     m_surfaceParticleRenderer = new MCSurfaceParticleRenderer;
@@ -68,15 +68,23 @@ public:
     /*! Must be called before calls to render() or renderShadows() */
     void buildBatches(MCCamera * camera);
 
+    /*! Must be called before calls to render() or renderShadows(). Builds the batches
+     *  of all given cameras, e.g. the viewports of a split screen, in a single culling pass:
+     *  each object and particle is tested against all cameras at once. At most
+     *  MCBroadPhase::MAX_BBOXES cameras are supported. */
+    void buildBatches(const std::vector<MCCamera *> & cameras);
+
     //! Render the given object group. \see MCRenderGroup.
     void render(MCCamera * camera, MCRenderGroup renderGroup);
 
     void clear();
 
 private:
-    void buildObjectBatches(MCCamera * camera);
+    void buildCameraBatches();
+
+    void buildObjectBatches();
 
-    void buildParticleBatches(MCCamera * camera);
+    void buildParticleBatches();
 
     void createSurfaceParticleRenderer();
 
@@ -103,6 +111,16 @@ private:
 
     std::vector<MCCamera *> m_visibilityCameras;
 
+    //! Cameras of the current buildBatches() call.
+    std::vector<MCCamera *> m_cameras;
+
+    std::vector<MCBBox<float>> m_cameraBBoxes;
+
+    std::vector<MCRenderQueue *> m_renderQueues;
+
+    //! Visibility cameras not in m_cameras.
+    std::vector<MCCamera *> m_otherVisibilityCameras;
+
     MCParticleRendererBase * m_surfaceParticleRenderer;
 
     MCGLScene m_glScene;
@@ -0,0 +1,156 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcbroadphase.hh"
+#include "mcobject.hh"
+#include "mcphysicscomponent.hh"
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <algorithm>
+#include <cassert>
+
+MCBroadPhase::MCBroadPhase(float x1, float y1, float x2, float y2)
+  : m_bbox(x1, y1, x2, y2)
+{
+}
+
+MCBroadPhase::~MCBroadPhase()
+{
+}
+
+bool MCBroadPhase::move(MCObject & object)
+{
+    if (remove(object))
+    {
+        insert(object);
+        return true;
+    }
+
+    return false;
+}
+
+const MCBroadPhase::ObjectSet & MCBroadPhase::getObjectsWithinDistance(const MCVector2dF & p, float d)
+{
+    return getObjectsWithinDistance(p.i(), p.j(), d);
+}
+
+const MCBroadPhase::ObjectSet & MCBroadPhase::getObjectsWithinDistance(float x, float y, float d)
+{
+    return getObjectsWithinBBox(MCBBox<float>(x - d, y - d, x + d, y + d));
+}
+
+const MCBroadPhase::ObjectMaskVector & MCBroadPhase::getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes)
+{
+    assert(bboxes.size() <= MAX_BBOXES);
+
+    m_objectMasks.clear();
+
+    for (size_t n = 0; n < bboxes.size(); n++)
+    {
+        for (auto && object : getObjectsWithinBBox(bboxes[n]))
+        {
+            m_objectMasks.push_back({ object, 1u << n });
+        }
+    }
+
+    mergeObjectMasks(m_objectMasks);
+
+    return m_objectMasks;
+}
+
+const MCBroadPhase::CollisionVector & MCBroadPhase::getSeparatedPairs() const
+{
+    static const CollisionVector noPairs;
+    return noPairs;
+}
+
+bool MCBroadPhase::canCollide(MCObject & obj1, MCObject & obj2)
+{
+    // Optimization: ignore collisions between sleeping objects.
+    // Note that stationary objects are also sleeping objects.
+    return &obj1.parent() != &obj2 && &obj2.parent() != &obj1
+      && (!obj1.physicsComponent().isSleeping() || !obj2.physicsComponent().isSleeping())
+      && (obj1.isPhysicsObject() || obj1.isTriggerObject()) && !obj1.bypassCollisions()
+      && (obj2.isPhysicsObject() || obj2.isTriggerObject()) && !obj2.bypassCollisions()
+      && obj1.physicsComponent().neverCollideWithTag() != obj2.physicsComponent().collisionTag()
+      && obj2.physicsComponent().neverCollideWithTag() != obj1.physicsComponent().collisionTag()
+      && (obj1.collisionLayer() == obj2.collisionLayer() || obj1.collisionLayer() == -1 || obj2.collisionLayer() == -1)
+      && obj1.shape()->likelyIntersects(*obj2.shape().get());
+}
+
+uint32_t MCBroadPhase::viewOverlapMask(MCObject & object, const std::vector<MCBBox<float>> & bboxes)
+{
+    uint32_t mask = 0;
+    if (const auto view = object.shape()->view())
+    {
+        const auto viewBBox = view->bbox().translated(MCVector2dF(object.location()));
+        for (size_t n = 0; n < bboxes.size(); n++)
+        {
+            if (bboxes[n].intersects(viewBBox))
+            {
+                mask |= 1u << n;
+            }
+        }
+    }
+
+    return mask;
+}
+
+void MCBroadPhase::mergeObjectMasks(ObjectMaskVector & objectMasks)
+{
+    if (objectMasks.size() < 2)
+    {
+        return;
+    }
+
+    std::sort(objectMasks.begin(), objectMasks.end(), [](auto && lhs, auto && rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    size_t last = 0;
+    for (size_t i = 1; i < objectMasks.size(); i++)
+    {
+        if (objectMasks[i].first == objectMasks[last].first)
+        {
+            objectMasks[last].second |= objectMasks[i].second;
+        }
+        else
+        {
+            objectMasks[++last] = objectMasks[i];
+        }
+    }
+
+    objectMasks.resize(last + 1);
+}
+
+void MCBroadPhase::countMutations(size_t count)
+{
+    m_mutationCount += count;
+}
+
+const MCBBox<float> & MCBroadPhase::bbox() const
+{
+    return m_bbox;
+}
+
+size_t MCBroadPhase::mutationCount() const
+{
+    return m_mutationCount;
+}
@@ -0,0 +1,151 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCBROADPHASE_HH
+#define MCBROADPHASE_HH
+
+#include "mcbbox.hh"
+#include "mcmacros.hh"
+#include "mcvector2d.hh"
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+class MCObject;
+
+/*! \class MCBroadPhase
+ *  \brief Abstract base class for the broad phase of the collision detection.
+ *
+ *  The broad phase stores every collidable object of MCWorld and produces
+ *  pairs of objects that might be colliding. MCCollisionDetector then runs
+ *  the exact tests for these pairs. */
+class MCBroadPhase
+{
+public:
+    typedef std::set<MCObject *> ObjectSet;
+    typedef std::vector<std::pair<MCObject *, MCObject *>> CollisionVector;
+
+    //! An object and the mask of the boxes it overlaps. \see getObjectsWithinBBoxes().
+    typedef std::vector<std::pair<MCObject *, uint32_t>> ObjectMaskVector;
+
+    //! Max number of boxes that can be given to getObjectsWithinBBoxes().
+    static const size_t MAX_BBOXES = 32;
+
+    //! Available broad phase implementations.
+    enum class Type
+    {
+        //! MCObjectGrid: uniform grid with tree-based cells.
+        ObjectGrid,
+
+        //! MCFlatObjectGrid: uniform grid with flat cells and a dirty cell bitset.
+        FlatObjectGrid,
+
+        //! MCSweepAndPrune: incremental sort-and-sweep with a persistent pair table.
+        SweepAndPrune
+    };
+
+    /*! Constructor.
+     *  \param x1,y1,x2,y2 represent the size of the covered area. */
+    MCBroadPhase(float x1, float y1, float x2, float y2);
+
+    //! Destructor.
+    virtual ~MCBroadPhase();
+
+    /*! Insert an object.
+     *  \param object is the object to be inserted. */
+    virtual void insert(MCObject & object) = 0;
+
+    /*! Remove an object.
+     *  \param object is the object to be removed.
+     *  \return true if was removed. */
+    virtual bool remove(MCObject & object) = 0;
+
+    /*! Update an object after its shape has been moved or rotated. Unlike remove() followed
+     *  by insert(), only the parts that actually changed are touched, e.g. the cells the
+     *  object entered or left. Moves within the same cells don't add or remove anything.
+     *  The default implementation removes and re-inserts the object.
+     *  \param object is the object to be updated.
+     *  \return true if the object was in the broad phase. */
+    virtual bool move(MCObject & object);
+
+    //! Remove all objects.
+    virtual void removeAll() = 0;
+
+    //! Get objects within given distance.
+    const ObjectSet & getObjectsWithinDistance(const MCVector2dF & p, float d);
+
+    //! Get objects within given distance.
+    const ObjectSet & getObjectsWithinDistance(float x, float y, float d);
+
+    //! Get all objects overlapping given BBox.
+    virtual const ObjectSet & getObjectsWithinBBox(const MCBBox<float> & bbox) = 0;
+
+    /*! Get all objects overlapping any of the given boxes in a single pass, e.g. to cull
+     *  the objects against all cameras of a split screen at once. Each object is reported
+     *  once and bit n of its mask is set if it overlaps bboxes[n]. The objects are sorted
+     *  by address like in getObjectsWithinBBox(). The default implementation queries the
+     *  boxes one by one. */
+    virtual const ObjectMaskVector & getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes);
+
+    /*! Get possible collisions. Collisions between sleeping objects are ignored,
+     *  because that gives a huge performance boost.
+     *  \return possible collisions. */
+    virtual const CollisionVector & getPossibleCollisions() = 0;
+
+    /*! Get pairs that stopped overlapping during the last call to getPossibleCollisions().
+     *  Broad phases that don't track pairs return an empty vector.
+     *  \return separated pairs. */
+    virtual const CollisionVector & getSeparatedPairs() const;
+
+    //! Get bounding box
+    const MCBBox<float> & bbox() const;
+
+    /*! \return total number of changes to the stored objects, e.g. added and removed cell
+     *  entries. Used to profile the cost of keeping the broad phase up-to-date. */
+    size_t mutationCount() const;
+
+protected:
+    /*! \return true if the given objects should be tested against each other:
+     *  they are not related, at least one of them is awake, they both take part
+     *  in collisions, their tags and layers match and their shapes likely intersect. */
+    static bool canCollide(MCObject & obj1, MCObject & obj2);
+
+    /*! Test the view of the given object against the given boxes.
+     *  \return mask of the overlapped boxes or 0 if the object has no view. */
+    static uint32_t viewOverlapMask(MCObject & object, const std::vector<MCBBox<float>> & bboxes);
+
+    //! Sort the given objects by address and merge the masks of duplicates.
+    static void mergeObjectMasks(ObjectMaskVector & objectMasks);
+
+    //! Add to the count returned by mutationCount().
+    void countMutations(size_t count);
+
+private:
+    DISABLE_COPY(MCBroadPhase);
+    DISABLE_ASSI(MCBroadPhase);
+
+    MCBBox<float> m_bbox;
+
+    ObjectMaskVector m_objectMasks;
+
+    size_t m_mutationCount = 0;
+};
+
+#endif // MCBROADPHASE_HH
@@ -18,9 +18,9 @@
 //
 
 #include "mccollisiondetector.hh"
+#include "mcbroadphase.hh"
 #include "mccircleshape.hh"
 #include "mccollisionevent.hh"
-#include "mccontact.hh"
 #include "mcobject.hh"
 #include "mcrectshape.hh"
 #include "mcsegment.hh"
@@ -28,40 +28,48 @@
 #include "mcshape.hh"
 
 MCCollisionDetector::MCCollisionDetector()
+  : m_generation(0)
 {
 }
 
 bool MCCollisionDetector::areCurrentlyColliding(MCObject & object1, MCObject & object2)
 {
-    auto && iter = m_currentCollisions.find(&object1);
-    if (iter != m_currentCollisions.end() && iter->second.count(&object2))
+    return m_currentCollisions.find(MCPairTable<CollisionPair>::key(object1.id(), object2.id()));
+}
+
+void MCCollisionDetector::setColliding(MCObject & object1, MCObject & object2)
+{
+    bool inserted = false;
+    auto && pair = m_currentCollisions.insert(MCPairTable<CollisionPair>::key(object1.id(), object2.id()), &inserted);
+    if (inserted)
     {
-        return true;
+        pair.object1 = &object1;
+        pair.object2 = &object2;
     }
 
-    iter = m_currentCollisions.find(&object2);
-    return iter != m_currentCollisions.end() && iter->second.count(&object1);
+    pair.generation = m_generation;
 }
 
 void MCCollisionDetector::clear()
 {
     m_currentCollisions.clear();
+    m_contacts.reset();
+}
+
+MCContactStore & MCCollisionDetector::contacts()
+{
+    return m_contacts;
 }
 
 void MCCollisionDetector::remove(MCObject & object)
 {
-    auto && outer = m_currentCollisions.find(&object);
-    if (outer != m_currentCollisions.end())
+    auto && entries = m_currentCollisions.entries();
+    for (size_t i = entries.size(); i > 0; i--)
     {
-        for (auto && outerLinked : outer->second)
+        if (entries[i - 1].value.object1 == &object || entries[i - 1].value.object2 == &object)
         {
-            if (m_currentCollisions.count(outerLinked))
-            {
-                m_currentCollisions[outerLinked].erase(outer->first);
-            }
+            m_currentCollisions.eraseAt(i - 1);
         }
-
-        m_currentCollisions.erase(outer);
     }
 }
 
@@ -88,7 +96,7 @@ bool MCCollisionDetector::testRectAgainstRect(MCRectShape & rect1, MCRectShape &
                 MCObject::sendEvent(rect2.parent(), ev2);
             }
 
-            m_currentCollisions[&rect1.parent()].insert(&rect2.parent());
+            setColliding(rect1.parent(), rect2.parent());
 
             if ((ev1.accepted() && ev2.accepted()) || areColliding)
             {
@@ -99,17 +107,8 @@ bool MCCollisionDetector::testRectAgainstRect(MCRectShape & rect1, MCRectShape &
                     float depth = rect2.interpenetrationDepth(
                       MCSegment<float>(vertex, rect1.location()), contactNormal);
 
-                    {
-                        MCContact & contact = MCContact::create();
-                        contact.init(rect2.parent(), vertex, contactNormal, depth);
-                        rect1.parent().addContact(contact);
-                    }
-
-                    {
-                        MCContact & contact = MCContact::create();
-                        contact.init(rect1.parent(), vertex, -contactNormal, depth);
-                        rect2.parent().addContact(contact);
-                    }
+                    m_contacts.addContact(rect1.parent(), rect2.parent(), vertex, contactNormal, depth);
+                    m_contacts.addContact(rect2.parent(), rect1.parent(), vertex, -contactNormal, depth);
                 }
 
                 collided = true;
@@ -160,7 +159,7 @@ bool MCCollisionDetector::testRectAgainstCircle(MCRectShape & rect, MCCircleShap
                 MCObject::sendEvent(rect.parent(), ev2);
             }
 
-            m_currentCollisions[&rect.parent()].insert(&circle.parent());
+            setColliding(rect.parent(), circle.parent());
 
             if ((ev1.accepted() && ev2.accepted()) || areColliding)
             {
@@ -170,17 +169,8 @@ bool MCCollisionDetector::testRectAgainstCircle(MCRectShape & rect, MCCircleShap
                     float depth = rect.interpenetrationDepth(
                       MCSegment<float>(circleVertex, circle.location()), contactNormal);
 
-                    {
-                        MCContact & contact = MCContact::create();
-                        contact.init(rect.parent(), circleVertex, contactNormal, depth);
-                        circle.parent().addContact(contact);
-                    }
-
-                    {
-                        MCContact & contact = MCContact::create();
-                        contact.init(circle.parent(), circleVertex, -contactNormal, depth);
-                        rect.parent().addContact(contact);
-                    }
+                    m_contacts.addContact(circle.parent(), rect.parent(), circleVertex, contactNormal, depth);
+                    m_contacts.addContact(rect.parent(), circle.parent(), circleVertex, -contactNormal, depth);
                 }
 
                 collided = true;
@@ -215,23 +205,14 @@ bool MCCollisionDetector::testCircleAgainstCircle(MCCircleShape & circle1, MCCir
             MCObject::sendEvent(circle1.parent(), ev2);
         }
 
-        m_currentCollisions[&circle1.parent()].insert(&circle2.parent());
+        setColliding(circle1.parent(), circle2.parent());
 
         if ((ev1.accepted() && ev2.accepted()) || areColliding)
         {
             if (!triggerObjectInvolved)
             {
-                {
-                    MCContact & contact = MCContact::create();
-                    contact.init(circle1.parent(), contactPoint, -contactNormal, depth);
-                    circle2.parent().addContact(contact);
-                }
-
-                {
-                    MCContact & contact = MCContact::create();
-                    contact.init(circle1.parent(), contactPoint, contactNormal, depth);
-                    circle1.parent().addContact(contact);
-                }
+                m_contacts.addContact(circle2.parent(), circle1.parent(), contactPoint, -contactNormal, depth);
+                m_contacts.addContact(circle1.parent(), circle1.parent(), contactPoint, contactNormal, depth);
             }
 
             collided = true;
@@ -283,11 +264,39 @@ bool MCCollisionDetector::processPossibleCollision(MCObject & object1, MCObject
     return false;
 }
 
-unsigned int MCCollisionDetector::detectCollisions(MCObjectGrid & objectGrid)
+void MCCollisionDetector::separate(MCObject & object1, MCObject & object2)
+{
+    m_currentCollisions.erase(MCPairTable<CollisionPair>::key(object1.id(), object2.id()));
+
+    MCSeparationEvent ev1(object2);
+    object1.event(ev1);
+
+    MCSeparationEvent ev2(object1);
+    object2.event(ev2);
+}
+
+unsigned int MCCollisionDetector::detectCollisions(MCBroadPhase & broadPhase)
+{
+    const auto & possibleCollisions = broadPhase.getPossibleCollisions();
+    return detectCollisions(possibleCollisions, broadPhase.getSeparatedPairs());
+}
+
+unsigned int MCCollisionDetector::detectCollisions(
+  const MCBroadPhase::CollisionVector & possibleCollisions, const MCBroadPhase::CollisionVector & separatedPairs)
 {
     unsigned int numCollisions = 0;
 
-    for (auto && iter : objectGrid.getPossibleCollisions())
+    // Broad phases that track pairs report the pairs that stopped overlapping, so
+    // collisions that ended can be handled without re-testing all current collisions.
+    for (auto && iter : separatedPairs)
+    {
+        if (areCurrentlyColliding(*iter.first, *iter.second))
+        {
+            separate(*iter.first, *iter.second);
+        }
+    }
+
+    for (auto && iter : possibleCollisions)
     {
         numCollisions += processPossibleCollision(*iter.first, *iter.second);
     }
@@ -307,33 +316,31 @@ unsigned int MCCollisionDetector::iterateCurrentCollisions()
 {
     unsigned int numCollisions = 0;
 
-    std::vector<std::pair<MCObject *, MCObject *>> removedCollisions;
+    // Pairs that collide get stamped with the new generation
+    m_generation++;
 
-    for (auto && outer : m_currentCollisions)
+    auto && entries = m_currentCollisions.entries();
+    const size_t pairCount = entries.size();
+    for (size_t i = 0; i < pairCount; i++)
     {
-        for (auto && inner : outer.second)
+        const CollisionPair pair = entries[i].value;
+        numCollisions += processPossibleCollision(*pair.object1, *pair.object2);
+    }
+
+    // Diff the generations: pairs that were not seen now got separated
+    m_separatedPairs.clear();
+    for (auto && entry : entries)
+    {
+        const CollisionPair & pair = entry.value;
+        if (pair.generation != m_generation)
         {
-            if (!processPossibleCollision(*outer.first, *inner))
-            {
-                removedCollisions.push_back({ outer.first, inner });
-            }
-            else
-            {
-                numCollisions++;
-            }
+            m_separatedPairs.push_back({ pair.object1, pair.object2 });
         }
     }
 
-    for (auto && collisionPair : removedCollisions)
+    for (auto && collisionPair : m_separatedPairs)
     {
-        m_currentCollisions[collisionPair.first].erase(collisionPair.second);
-        m_currentCollisions[collisionPair.second].erase(collisionPair.first);
-
-        MCSeparationEvent ev1(*collisionPair.second);
-        collisionPair.first->event(ev1);
-
-        MCSeparationEvent ev2(*collisionPair.first);
-        collisionPair.second->event(ev2);
+        separate(*collisionPair.first, *collisionPair.second);
     }
 
     return numCollisions;
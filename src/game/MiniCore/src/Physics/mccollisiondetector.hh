@@ -20,15 +20,15 @@
 #ifndef MCCOLLISIONDETECTOR_HH
 #define MCCOLLISIONDETECTOR_HH
 
+#include "mcbroadphase.hh"
+#include "mccontactstore.hh"
 #include "mcmacros.hh"
+#include "mcpairtable.hh"
 
-#include <map>
-#include <set>
 #include <vector>
 
 class MCCircleShape;
 class MCObject;
-class MCObjectGrid;
 class MCRectShape;
 
 //! Collision detector and contact generator.
@@ -47,28 +47,60 @@ public:
 
     void remove(MCObject & object);
 
-    //! Detect collisions and generate contacts. Contacts are stored to MCObject.
-    unsigned int detectCollisions(MCObjectGrid & objectGrid);
+    //! Detect collisions and generate contacts. Contacts are stored to contacts().
+    unsigned int detectCollisions(MCBroadPhase & broadPhase);
 
-    //! Iterate current collisions and generate contacts. Contacts are stored to MCObject.
+    /*! Detect collisions from the result of an already updated broad phase.
+     *  \param possibleCollisions Pairs given by MCBroadPhase::getPossibleCollisions().
+     *  \param separatedPairs Pairs given by MCBroadPhase::getSeparatedPairs(). */
+    unsigned int detectCollisions(
+      const MCBroadPhase::CollisionVector & possibleCollisions, const MCBroadPhase::CollisionVector & separatedPairs);
+
+    //! Iterate current collisions and generate contacts. Contacts are stored to contacts().
     unsigned int iterateCurrentCollisions();
 
+    //! \return the generated contacts.
+    MCContactStore & contacts();
+
 private:
     DISABLE_COPY(MCCollisionDetector);
     DISABLE_ASSI(MCCollisionDetector);
 
     bool areCurrentlyColliding(MCObject & object1, MCObject & object2);
 
+    //! Add the pair to the current collisions or mark it seen in the current generation.
+    void setColliding(MCObject & object1, MCObject & object2);
+
     bool processPossibleCollision(MCObject & object1, MCObject & object2);
 
+    //! Forget the collision between the given objects and send separation events.
+    void separate(MCObject & object1, MCObject & object2);
+
     bool testRectAgainstRect(MCRectShape & object1, MCRectShape & object2);
 
     bool testRectAgainstCircle(MCRectShape & object1, MCCircleShape & object2);
 
     bool testCircleAgainstCircle(MCCircleShape & object1, MCCircleShape & object2);
 
-    using CollisionMap = std::map<MCObject *, std::set<MCObject *>>;
-    CollisionMap m_currentCollisions;
+    struct CollisionPair
+    {
+        MCObject * object1 = nullptr;
+
+        MCObject * object2 = nullptr;
+
+        //! The generation the pair was last seen colliding.
+        unsigned int generation = 0;
+    };
+
+    //! Current collisions keyed by the object ids.
+    MCPairTable<CollisionPair> m_currentCollisions;
+
+    //! Incremented on every pass over the current collisions.
+    unsigned int m_generation;
+
+    std::vector<std::pair<MCObject *, MCObject *>> m_separatedPairs;
+
+    MCContactStore m_contacts;
 };
 
 #endif // MCCOLLISIONDETECTOR_HH
@@ -18,32 +18,14 @@
 //
 
 #include "mccontact.hh"
-#include "mcobject.hh"
-#include <cassert>
 
-MCRecycler<MCContact> MCContact::m_recycler;
-
-MCContact::MCContact()
-  : m_pObject(nullptr)
-  , m_interpenetrationDepth(0.0)
-{
-}
-
-void MCContact::init(MCObject & object,
-                     const MCVector2d<float> & newContactPoint,
+MCContact::MCContact(const MCVector2d<float> & newContactPoint,
                      const MCVector2d<float> & newContactNormal,
                      float newInterpenetrationDepth)
+  : m_contactPoint(newContactPoint)
+  , m_contactNormal(newContactNormal)
+  , m_interpenetrationDepth(newInterpenetrationDepth)
 {
-    m_pObject = &object;
-    m_contactPoint = newContactPoint;
-    m_contactNormal = newContactNormal;
-    m_interpenetrationDepth = newInterpenetrationDepth;
-}
-
-MCObject & MCContact::object() const
-{
-    assert(m_pObject);
-    return *m_pObject;
 }
 
 const MCVector2d<float> & MCContact::contactPoint() const
@@ -60,17 +42,3 @@ float MCContact::interpenetrationDepth() const
 {
     return m_interpenetrationDepth;
 }
-
-MCContact & MCContact::create()
-{
-    return *MCContact::m_recycler.newObject();
-}
-
-void MCContact::free()
-{
-    return MCContact::m_recycler.freeObject(this);
-}
-
-MCContact::~MCContact()
-{
-}
@@ -20,42 +20,27 @@
 #ifndef MCCONTACT_HH
 #define MCCONTACT_HH
 
-#include "mcmacros.hh"
-#include "mcrecycler.hh"
 #include "mcvector2d.hh"
 
-class MCObject;
-
 /*! \class MCContact
  *  \brief MCContact is a class representing a collision contact.
  *
- * MCContact is added to object (A) to notify a contact with object(B) using
- * MCObject::addContact(MCContact * p). MCWorld then processes the contacts
+ * Contacts are stored by value to MCContactStore, which groups them by
+ * the pair of colliding objects. MCWorld then processes the contacts
  * on every world update.
  */
 class MCContact
 {
 public:
-    //! Return a new (empty) contact
-    static MCContact & create();
-
-    //! Move contact to the list of free contacts
-    void free();
-
-    /*! \brief Init the contact.
-     *  \param object The contacting object
+    /*! \brief Constructor.
      *  \param contactPoint The point of contact
-     *  \param contactNormal The contact normal pointing away from pObject
+     *  \param contactNormal The contact normal pointing away from the contacting object
      *  \param interpenetrationDepth The depth of interpenetration
      */
-    void init(MCObject & object,
-              const MCVector2d<float> & contactPoint,
+    MCContact(const MCVector2d<float> & contactPoint,
               const MCVector2d<float> & contactNormal,
               float interpenetrationDepth);
 
-    //! Return the contacting object
-    MCObject & object() const;
-
     //! Return the contact point
     const MCVector2d<float> & contactPoint() const;
 
@@ -66,21 +51,9 @@ public:
     float interpenetrationDepth() const;
 
 private:
-    //! Constructor disabled: use MCContact::create()
-    MCContact();
-
-    //! Destructor disabled: use MCContact::free()
-    ~MCContact();
-
-    DISABLE_COPY(MCContact);
-    DISABLE_ASSI(MCContact);
-
-    MCObject * m_pObject;
     MCVector2d<float> m_contactPoint;
     MCVector2d<float> m_contactNormal;
     float m_interpenetrationDepth;
-    static MCRecycler<MCContact> m_recycler;
-    friend class MCRecycler<MCContact>;
 };
 
 #endif // MCCONTACT_HH
@@ -0,0 +1,119 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mccontactstore.hh"
+#include "mcobject.hh"
+
+MCContactStore::MCContactStore()
+{
+}
+
+void MCContactStore::addContact(
+  MCObject & object, MCObject & other,
+  const MCVector2dF & contactPoint, const MCVector2dF & contactNormal, float interpenetrationDepth)
+{
+    bool inserted = false;
+    auto && manifoldIndex = m_manifoldIndex.insert(MCPairTable<unsigned int>::key(object.id(), other.id()), &inserted);
+    if (inserted)
+    {
+        manifoldIndex = static_cast<unsigned int>(m_manifolds.size());
+        m_manifolds.push_back({ &object, &other, -1, -1, 0 });
+    }
+
+    auto && manifold = m_manifolds[manifoldIndex];
+    if (!manifold.objectA)
+    {
+        // Re-enable a manifold disabled by removeObject()
+        manifold = { &object, &other, -1, -1, 0 };
+    }
+
+    m_arena.emplace_back(contactPoint, contactNormal, interpenetrationDepth);
+    manifold.contactCount++;
+
+    auto && deepestContact = &object == manifold.objectA ? manifold.deepestContactA : manifold.deepestContactB;
+    const float maxDepth = deepestContact >= 0 ? m_arena[static_cast<size_t>(deepestContact)].interpenetrationDepth() : 0;
+    if (interpenetrationDepth > maxDepth)
+    {
+        deepestContact = static_cast<int>(m_arena.size()) - 1;
+    }
+}
+
+const MCContactStore::Manifolds & MCContactStore::manifolds() const
+{
+    return m_manifolds;
+}
+
+const MCContact * MCContactStore::deepestContact(size_t manifold, const MCObject & object) const
+{
+    auto && m = m_manifolds[manifold];
+    const int deepestContact = &object == m.objectA ? m.deepestContactA : (&object == m.objectB ? m.deepestContactB : -1);
+    return deepestContact >= 0 ? &m_arena[static_cast<size_t>(deepestContact)] : nullptr;
+}
+
+void MCContactStore::clearContacts()
+{
+    for (auto && manifold : m_manifolds)
+    {
+        manifold.deepestContactA = -1;
+        manifold.deepestContactB = -1;
+        manifold.contactCount = 0;
+    }
+}
+
+void MCContactStore::clearContacts(size_t manifold)
+{
+    m_manifolds[manifold].deepestContactA = -1;
+    m_manifolds[manifold].deepestContactB = -1;
+}
+
+void MCContactStore::clearContacts(size_t manifold, const MCObject & object)
+{
+    auto && m = m_manifolds[manifold];
+    if (&object == m.objectA)
+    {
+        m.deepestContactA = -1;
+    }
+    else if (&object == m.objectB)
+    {
+        m.deepestContactB = -1;
+    }
+}
+
+void MCContactStore::removeObject(MCObject & object)
+{
+    for (auto && manifold : m_manifolds)
+    {
+        if (manifold.objectA == &object || manifold.objectB == &object)
+        {
+            manifold = { nullptr, nullptr, -1, -1, 0 };
+        }
+    }
+}
+
+void MCContactStore::reset()
+{
+    m_arena.clear();
+    m_manifolds.clear();
+    m_manifoldIndex.clear();
+}
+
+size_t MCContactStore::contactCount() const
+{
+    return m_arena.size();
+}
@@ -0,0 +1,114 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCCONTACTSTORE_HH
+#define MCCONTACTSTORE_HH
+
+#include "mccontact.hh"
+#include "mcmacros.hh"
+#include "mcpairtable.hh"
+
+#include <vector>
+
+class MCObject;
+
+/*! \class MCContactStore
+ *  \brief Frame-scoped storage for collision contacts.
+ *
+ *  Contacts are allocated from an arena that is only reset once per
+ *  world step, so no contact is ever freed individually. Contacts are
+ *  grouped to manifolds, one per pair of colliding objects, and the
+ *  manifolds are indexed by the object pair in a flat hash table.
+ *
+ *  A contact is stored from the point of view of the object that
+ *  receives it: the normal points to the direction that object should
+ *  move. The deepest contact is tracked separately for both objects of
+ *  a manifold. */
+class MCContactStore
+{
+public:
+    struct Manifold
+    {
+        MCObject * objectA;
+
+        MCObject * objectB;
+
+        //! Index of the deepest contact received by objectA in the arena or -1 if none.
+        int deepestContactA;
+
+        //! Index of the deepest contact received by objectB in the arena or -1 if none.
+        int deepestContactB;
+
+        unsigned int contactCount;
+    };
+
+    typedef std::vector<Manifold> Manifolds;
+
+    //! Constructor.
+    MCContactStore();
+
+    /*! Add a contact.
+     *  \param object The object that receives the contact.
+     *  \param other The contacting object.
+     *  \param contactPoint The point of contact.
+     *  \param contactNormal The contact normal pointing away from other.
+     *  \param interpenetrationDepth The depth of interpenetration. */
+    void addContact(
+      MCObject & object, MCObject & other,
+      const MCVector2dF & contactPoint, const MCVector2dF & contactNormal, float interpenetrationDepth);
+
+    //! \return the manifolds in the order they were created.
+    const Manifolds & manifolds() const;
+
+    /*! \return the deepest contact the given object has received in the given manifold
+     *  or nullptr if none has a positive depth. */
+    const MCContact * deepestContact(size_t manifold, const MCObject & object) const;
+
+    /*! Forget the contacts of all manifolds, e.g. after they have been resolved.
+     *  The manifolds and the arena are kept until reset(). */
+    void clearContacts();
+
+    //! Forget the contacts of both objects of the given manifold.
+    void clearContacts(size_t manifold);
+
+    //! Forget the contacts the given object has received in the given manifold.
+    void clearContacts(size_t manifold, const MCObject & object);
+
+    //! Disable all manifolds involving the given object.
+    void removeObject(MCObject & object);
+
+    //! Reset the arena and remove all manifolds. Allocated memory is kept.
+    void reset();
+
+    //! \return number of contacts added since the last reset.
+    size_t contactCount() const;
+
+private:
+    DISABLE_COPY(MCContactStore);
+    DISABLE_ASSI(MCContactStore);
+
+    std::vector<MCContact> m_arena;
+
+    Manifolds m_manifolds;
+
+    //! Object pair => index in m_manifolds.
+    MCPairTable<unsigned int> m_manifoldIndex;
+};
+
+#endif // MCCONTACTSTORE_HH
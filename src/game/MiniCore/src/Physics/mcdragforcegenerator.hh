@@ -24,7 +24,7 @@
 #include "mcmacros.hh"
 
 //! Force generator for drag
-class MCDragForceGenerator : public MCForceGenerator
+class MCDragForceGenerator final : public MCForceGenerator
 {
 public:
     /*! Constructor
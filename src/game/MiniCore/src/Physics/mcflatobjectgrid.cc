@@ -0,0 +1,441 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcflatobjectgrid.hh"
+#include "mcobject.hh"
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <cassert>
+
+namespace {
+const size_t BITS_PER_WORD = 64;
+}
+
+MCFlatObjectGrid::MCFlatObjectGrid(float x1, float y1, float x2, float y2, float leafMaxW, float leafMaxH)
+  : MCBroadPhase(x1, y1, x2, y2)
+  , m_leafMaxW(leafMaxW)
+  , m_leafMaxH(leafMaxH)
+  , m_horSize(static_cast<size_t>((x2 - x1) / m_leafMaxW))
+  , m_verSize(static_cast<size_t>((y2 - y1) / m_leafMaxH))
+  , m_i0(0)
+  , m_i1(0)
+  , m_j0(0)
+  , m_j1(0)
+  , m_helpHor(static_cast<float>(m_horSize) / (x2 - x1))
+  , m_helpVer(static_cast<float>(m_verSize) / (y2 - y1))
+  , m_cells(m_horSize * m_verSize)
+  , m_dirtyCells((m_horSize * m_verSize + BITS_PER_WORD - 1) / BITS_PER_WORD, 0)
+{
+}
+
+MCFlatObjectGrid::~MCFlatObjectGrid()
+{
+}
+
+void MCFlatObjectGrid::setIndexRange(const MCBBox<float> & bbox)
+{
+    const auto clamp = [](int value, size_t size) {
+        if (value >= static_cast<int>(size))
+        {
+            return size - 1;
+        }
+
+        return value < 0 ? 0 : static_cast<size_t>(value);
+    };
+
+    m_i0 = clamp(static_cast<int>(bbox.x1() * m_helpHor), m_horSize);
+    m_i1 = clamp(static_cast<int>(bbox.x2() * m_helpHor), m_horSize);
+    m_j0 = clamp(static_cast<int>(bbox.y1() * m_helpVer), m_verSize);
+    m_j1 = clamp(static_cast<int>(bbox.y2() * m_helpVer), m_verSize);
+}
+
+int MCFlatObjectGrid::validProxy(MCObject & object) const
+{
+    // The id cached to the object might be stale if the grid has been cleared or replaced.
+    const int proxy = object.broadPhaseProxy();
+    if (proxy >= 0 && proxy < static_cast<int>(m_proxies.size()) && m_proxies[static_cast<size_t>(proxy)].object == &object)
+    {
+        return proxy;
+    }
+
+    return -1;
+}
+
+size_t MCFlatObjectGrid::slotIndex(const Proxy & proxy, size_t i, size_t j) const
+{
+    return (j - proxy.j0) * (proxy.i1 - proxy.i0 + 1) + i - proxy.i0;
+}
+
+void MCFlatObjectGrid::setDirty(size_t cellIndex, bool dirty)
+{
+    const uint64_t mask = uint64_t(1) << (cellIndex % BITS_PER_WORD);
+    if (dirty)
+    {
+        m_dirtyCells[cellIndex / BITS_PER_WORD] |= mask;
+    }
+    else
+    {
+        m_dirtyCells[cellIndex / BITS_PER_WORD] &= ~mask;
+    }
+}
+
+unsigned int MCFlatObjectGrid::addToCell(size_t i, size_t j, MCObject & object, unsigned int proxyIndex)
+{
+    const size_t cellIndex = j * m_horSize + i;
+    auto && cell = m_cells[cellIndex];
+    cell.push_back({ &object, proxyIndex });
+    setDirty(cellIndex, true);
+    countMutations(1);
+
+    return static_cast<unsigned int>(cell.size() - 1);
+}
+
+void MCFlatObjectGrid::removeFromCell(size_t i, size_t j, unsigned int cellSlot)
+{
+    const size_t cellIndex = j * m_horSize + i;
+    auto && cell = m_cells[cellIndex];
+
+    // Swap-remove: move the last entry to the freed slot and tell its proxy about it.
+    const CellEntry last = cell.back();
+    cell[cellSlot] = last;
+    auto && lastProxy = m_proxies[last.proxy];
+    lastProxy.cellSlots[slotIndex(lastProxy, i, j)] = cellSlot;
+    cell.pop_back();
+
+    if (cell.empty())
+    {
+        setDirty(cellIndex, false);
+    }
+
+    countMutations(1);
+}
+
+void MCFlatObjectGrid::insert(MCObject & object)
+{
+    if (!object.shape())
+    {
+        return;
+    }
+
+    if (validProxy(object) >= 0)
+    {
+        remove(object);
+    }
+
+    unsigned int proxyIndex = 0;
+    if (m_freeProxies.size())
+    {
+        proxyIndex = m_freeProxies.back();
+        m_freeProxies.pop_back();
+    }
+    else
+    {
+        proxyIndex = static_cast<unsigned int>(m_proxies.size());
+        m_proxies.push_back(Proxy());
+    }
+
+    setIndexRange(object.shape()->bbox());
+    object.cacheIndexRange(m_i0, m_i1, m_j0, m_j1);
+    object.setBroadPhaseProxy(static_cast<int>(proxyIndex));
+
+    auto && proxy = m_proxies[proxyIndex];
+    proxy.object = &object;
+    proxy.i0 = m_i0;
+    proxy.i1 = m_i1;
+    proxy.j0 = m_j0;
+    proxy.j1 = m_j1;
+    proxy.cellSlots.resize((m_i1 - m_i0 + 1) * (m_j1 - m_j0 + 1));
+
+    size_t slot = 0;
+    for (size_t j = m_j0; j <= m_j1; j++)
+    {
+        for (size_t i = m_i0; i <= m_i1; i++)
+        {
+            proxy.cellSlots[slot++] = addToCell(i, j, object, proxyIndex);
+        }
+    }
+}
+
+bool MCFlatObjectGrid::remove(MCObject & object)
+{
+    if (!object.shape())
+    {
+        return false;
+    }
+
+    const int proxyIndex = validProxy(object);
+    if (proxyIndex < 0)
+    {
+        return false;
+    }
+
+    auto && proxy = m_proxies[static_cast<size_t>(proxyIndex)];
+    size_t slot = 0;
+    for (size_t j = proxy.j0; j <= proxy.j1; j++)
+    {
+        for (size_t i = proxy.i0; i <= proxy.i1; i++)
+        {
+            removeFromCell(i, j, proxy.cellSlots[slot++]);
+        }
+    }
+
+    proxy.object = nullptr;
+    m_freeProxies.push_back(static_cast<unsigned int>(proxyIndex));
+    object.setBroadPhaseProxy(-1);
+
+    return true;
+}
+
+bool MCFlatObjectGrid::move(MCObject & object)
+{
+    if (!object.shape())
+    {
+        return false;
+    }
+
+    const int proxyIndex = validProxy(object);
+    if (proxyIndex < 0)
+    {
+        return false;
+    }
+
+    auto && proxy = m_proxies[static_cast<size_t>(proxyIndex)];
+    setIndexRange(object.shape()->bbox());
+    if (m_i0 == proxy.i0 && m_i1 == proxy.i1 && m_j0 == proxy.j0 && m_j1 == proxy.j1)
+    {
+        // The cells stay the same, but the object might now collide with its neighbors
+        for (size_t j = m_j0; j <= m_j1; j++)
+        {
+            for (size_t i = m_i0; i <= m_i1; i++)
+            {
+                setDirty(j * m_horSize + i, true);
+            }
+        }
+
+        return true;
+    }
+
+    const auto inOldRange = [&proxy](size_t i, size_t j) {
+        return i >= proxy.i0 && i <= proxy.i1 && j >= proxy.j0 && j <= proxy.j1;
+    };
+
+    const auto inNewRange = [this](size_t i, size_t j) {
+        return i >= m_i0 && i <= m_i1 && j >= m_j0 && j <= m_j1;
+    };
+
+    // Leave the cells that are not covered anymore
+    size_t slot = 0;
+    for (size_t j = proxy.j0; j <= proxy.j1; j++)
+    {
+        for (size_t i = proxy.i0; i <= proxy.i1; i++)
+        {
+            const unsigned int cellSlot = proxy.cellSlots[slot++];
+            if (!inNewRange(i, j))
+            {
+                removeFromCell(i, j, cellSlot);
+            }
+        }
+    }
+
+    // Enter the new cells and keep the slots of the cells that are still covered
+    m_movedCellSlots.resize((m_i1 - m_i0 + 1) * (m_j1 - m_j0 + 1));
+    slot = 0;
+    for (size_t j = m_j0; j <= m_j1; j++)
+    {
+        for (size_t i = m_i0; i <= m_i1; i++)
+        {
+            if (inOldRange(i, j))
+            {
+                m_movedCellSlots[slot++] = proxy.cellSlots[slotIndex(proxy, i, j)];
+                setDirty(j * m_horSize + i, true);
+            }
+            else
+            {
+                m_movedCellSlots[slot++] = addToCell(i, j, object, static_cast<unsigned int>(proxyIndex));
+            }
+        }
+    }
+
+    proxy.cellSlots.swap(m_movedCellSlots);
+    proxy.i0 = m_i0;
+    proxy.i1 = m_i1;
+    proxy.j0 = m_j0;
+    proxy.j1 = m_j1;
+    object.cacheIndexRange(m_i0, m_i1, m_j0, m_j1);
+
+    return true;
+}
+
+void MCFlatObjectGrid::removeAll()
+{
+    for (auto && cell : m_cells)
+    {
+        cell.clear();
+    }
+
+    for (auto && word : m_dirtyCells)
+    {
+        word = 0;
+    }
+
+    m_proxies.clear();
+    m_freeProxies.clear();
+}
+
+const MCFlatObjectGrid::CollisionVector & MCFlatObjectGrid::getPossibleCollisions()
+{
+    m_collisions.clear();
+
+    for (size_t word = 0; word < m_dirtyCells.size(); word++)
+    {
+        if (!m_dirtyCells[word])
+        {
+            continue;
+        }
+
+        for (size_t bit = 0; bit < BITS_PER_WORD; bit++)
+        {
+            if (!(m_dirtyCells[word] & (uint64_t(1) << bit)))
+            {
+                continue;
+            }
+
+            const size_t cellIndex = word * BITS_PER_WORD + bit;
+            const auto & cell = m_cells[cellIndex];
+            bool hadCollisions = false;
+            for (size_t k = 0; k < cell.size(); k++)
+            {
+                auto * obj1 = cell[k].object;
+                for (size_t l = k + 1; l < cell.size(); l++)
+                {
+                    auto * obj2 = cell[l].object;
+                    if (canCollide(*obj1, *obj2))
+                    {
+                        // Keep the same pair orientation as MCObjectGrid
+                        if (obj1 < obj2)
+                        {
+                            m_collisions.push_back({ obj1, obj2 });
+                        }
+                        else
+                        {
+                            m_collisions.push_back({ obj2, obj1 });
+                        }
+
+                        hadCollisions = true;
+                    }
+                }
+            }
+
+            if (!hadCollisions)
+            {
+                setDirty(cellIndex, false);
+            }
+        }
+    }
+
+    return m_collisions;
+}
+
+const MCFlatObjectGrid::ObjectSet & MCFlatObjectGrid::getObjectsWithinBBox(const MCBBox<float> & bbox)
+{
+    setIndexRange(bbox);
+
+    m_resultObjs.clear();
+
+    for (size_t j = m_j0; j <= m_j1; j++)
+    {
+        for (size_t i = m_i0; i <= m_i1; i++)
+        {
+            for (auto && entry : m_cells[j * m_horSize + i])
+            {
+                const auto obj = entry.object;
+                if (obj->shape()->view())
+                {
+                    if (bbox.intersects(obj->shape()->view()->bbox().translated(MCVector2dF(obj->location()))))
+                    {
+                        m_resultObjs.insert(obj);
+                    }
+                }
+            }
+        }
+    }
+
+    return m_resultObjs;
+}
+
+const MCFlatObjectGrid::ObjectMaskVector & MCFlatObjectGrid::getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes)
+{
+    assert(bboxes.size() <= MAX_BBOXES);
+
+    m_indexRanges.clear();
+    for (auto && bbox : bboxes)
+    {
+        setIndexRange(bbox);
+        m_indexRanges.push_back({ m_i0, m_i1, m_j0, m_j1 });
+    }
+
+    m_resultMasks.clear();
+
+    // Visit each cell only once even if the boxes overlap and test its objects against all boxes.
+    // An object is reported for a box only via the cells of that box like in getObjectsWithinBBox().
+    for (size_t n = 0; n < m_indexRanges.size(); n++)
+    {
+        const auto & range = m_indexRanges[n];
+        for (size_t j = range.j0; j <= range.j1; j++)
+        {
+            for (size_t i = range.i0; i <= range.i1; i++)
+            {
+                const auto rangeMask = cellRangeMask(i, j);
+                if (rangeMask & ((1u << n) - 1))
+                {
+                    continue;
+                }
+
+                for (auto && entry : m_cells[j * m_horSize + i])
+                {
+                    if (const auto mask = viewOverlapMask(*entry.object, bboxes) & rangeMask)
+                    {
+                        m_resultMasks.push_back({ entry.object, mask });
+                    }
+                }
+            }
+        }
+    }
+
+    // Objects covering several cells were added once per cell
+    mergeObjectMasks(m_resultMasks);
+
+    return m_resultMasks;
+}
+
+uint32_t MCFlatObjectGrid::cellRangeMask(size_t i, size_t j) const
+{
+    uint32_t mask = 0;
+    for (size_t n = 0; n < m_indexRanges.size(); n++)
+    {
+        const auto & range = m_indexRanges[n];
+        if (i >= range.i0 && i <= range.i1 && j >= range.j0 && j <= range.j1)
+        {
+            mask |= 1u << n;
+        }
+    }
+
+    return mask;
+}
@@ -0,0 +1,154 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCFLATOBJECTGRID_HH
+#define MCFLATOBJECTGRID_HH
+
+#include "mcbroadphase.hh"
+#include "mcmacros.hh"
+
+#include <cstdint>
+#include <vector>
+
+/*! \class MCFlatObjectGrid
+ *  \brief Uniform grid like MCObjectGrid, but without per-node allocations.
+ *
+ *  Each cell is a contiguous array of entries. Every inserted object owns a proxy that
+ *  remembers its cell range and its slot in each of those cells, so removal is a
+ *  swap-remove without searching. Dirty cells are tracked in a dense bitset.
+ *  Once the arrays have grown to their working size, insert() and remove() don't allocate.
+ *
+ *  Produces the same set of possible collisions as MCObjectGrid. */
+class MCFlatObjectGrid : public MCBroadPhase
+{
+public:
+    /*! Constructor.
+     *  \param x1,y1,x2,y2 represent the size of the first-level bounding box.
+     *  \param leafMaxW,leafMaxH are the maximum dimensions for leaves. */
+    MCFlatObjectGrid(float x1, float y1, float x2, float y2, float leafMaxW, float leafMaxH);
+
+    //! Destructor.
+    virtual ~MCFlatObjectGrid() override;
+
+    /*! Insert an object into the grid (O(1) per covered cell).
+     *  \param object is the object to be inserted. */
+    void insert(MCObject & object) override;
+
+    /*! Remove an object from the grid (O(1) per covered cell).
+     *  \param object is the object to be removed.
+     *  \return true if was removed. */
+    bool remove(MCObject & object) override;
+
+    /*! Update an object after it has moved. Only the cells that the object
+     *  entered or left are touched.
+     *  \param object is the object to be updated.
+     *  \return true if the object was in the grid. */
+    bool move(MCObject & object) override;
+
+    //! \reimp
+    void removeAll() override;
+
+    //! \reimp
+    const ObjectSet & getObjectsWithinBBox(const MCBBox<float> & bbox) override;
+
+    //! \reimp
+    const ObjectMaskVector & getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes) override;
+
+    //! \reimp
+    const CollisionVector & getPossibleCollisions() override;
+
+private:
+    DISABLE_COPY(MCFlatObjectGrid);
+    DISABLE_ASSI(MCFlatObjectGrid);
+
+    struct IndexRange
+    {
+        size_t i0, i1, j0, j1;
+    };
+
+    struct CellEntry
+    {
+        MCObject * object;
+
+        unsigned int proxy;
+    };
+
+    typedef std::vector<CellEntry> Cell;
+
+    struct Proxy
+    {
+        MCObject * object = nullptr;
+
+        size_t i0 = 0, i1 = 0, j0 = 0, j1 = 0;
+
+        //! Slot in each covered cell, row-major within the cell range.
+        std::vector<unsigned int> cellSlots;
+    };
+
+    void setIndexRange(const MCBBox<float> & bbox);
+
+    //! \return mask of the index ranges containing cell (i, j).
+    uint32_t cellRangeMask(size_t i, size_t j) const;
+
+    int validProxy(MCObject & object) const;
+
+    size_t slotIndex(const Proxy & proxy, size_t i, size_t j) const;
+
+    void setDirty(size_t cellIndex, bool dirty);
+
+    //! Add the object to the given cell. \return slot of the new entry.
+    unsigned int addToCell(size_t i, size_t j, MCObject & object, unsigned int proxyIndex);
+
+    //! Remove the entry in the given slot from the given cell.
+    void removeFromCell(size_t i, size_t j, unsigned int cellSlot);
+
+    float m_leafMaxW;
+
+    float m_leafMaxH;
+
+    size_t m_horSize;
+
+    size_t m_verSize;
+
+    size_t m_i0, m_i1, m_j0, m_j1;
+
+    std::vector<IndexRange> m_indexRanges;
+
+    float m_helpHor;
+
+    float m_helpVer;
+
+    std::vector<Cell> m_cells;
+
+    std::vector<Proxy> m_proxies;
+
+    std::vector<unsigned int> m_freeProxies;
+
+    std::vector<unsigned int> m_movedCellSlots;
+
+    std::vector<uint64_t> m_dirtyCells;
+
+    CollisionVector m_collisions;
+
+    ObjectSet m_resultObjs;
+
+    ObjectMaskVector m_resultMasks;
+};
+
+#endif // MCFLATOBJECTGRID_HH
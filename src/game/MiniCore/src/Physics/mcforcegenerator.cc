@@ -19,18 +19,27 @@
 
 #include "mcforcegenerator.hh"
 
+#include <atomic>
+
 struct MCForceGenerator::Impl
 {
     Impl()
       : enabled(true)
+      , id(nextId++)
     {
     }
 
     bool enabled;
 
+    const unsigned int id;
+
+    static std::atomic<unsigned int> nextId;
+
     friend class MCForceGenerator;
 };
 
+std::atomic<unsigned int> MCForceGenerator::Impl::nextId(0);
+
 MCForceGenerator::MCForceGenerator()
   : m_impl(std::make_unique<Impl>())
 {
@@ -46,4 +55,9 @@ bool MCForceGenerator::enabled() const
     return m_impl->enabled;
 }
 
+unsigned int MCForceGenerator::id() const
+{
+    return m_impl->id;
+}
+
 MCForceGenerator::~MCForceGenerator() = default;
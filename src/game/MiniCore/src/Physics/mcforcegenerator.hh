@@ -45,6 +45,9 @@ public:
     //! Return true if enabled.
     bool enabled() const;
 
+    //! Return unique id of the generator. Ids are not reused.
+    unsigned int id() const;
+
 private:
     DISABLE_COPY(MCForceGenerator);
     DISABLE_ASSI(MCForceGenerator);
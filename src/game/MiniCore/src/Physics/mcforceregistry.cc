@@ -18,76 +18,256 @@
 //
 
 #include "mcforceregistry.hh"
+#include "mcdragforcegenerator.hh"
+#include "mcfrictiongenerator.hh"
+#include "mcgravitygenerator.hh"
 #include "mcobject.hh"
+#include "mcspringforcegenerator.hh"
+#include "mcspringforcegenerator2dfast.hh"
 
 #include <algorithm>
 
 MCForceRegistry::MCForceRegistry()
-  : m_registryHash()
+  : m_integratedCount(0)
+  , m_pairCount(0)
+  , m_updating(false)
 {
 }
 
+MCForceRegistry::~MCForceRegistry() = default;
+
+MCForceRegistry::Type MCForceRegistry::type(MCForceGenerator & generator)
+{
+    if (dynamic_cast<MCFrictionGenerator *>(&generator))
+    {
+        return Type::Friction;
+    }
+    else if (dynamic_cast<MCDragForceGenerator *>(&generator))
+    {
+        return Type::Drag;
+    }
+    else if (dynamic_cast<MCGravityGenerator *>(&generator))
+    {
+        return Type::Gravity;
+    }
+    else if (dynamic_cast<MCSpringForceGenerator *>(&generator))
+    {
+        return Type::Spring;
+    }
+    else if (dynamic_cast<MCSpringForceGenerator2dFast *>(&generator))
+    {
+        return Type::Spring2dFast;
+    }
+
+    return Type::Generic;
+}
+
+MCForceRegistry::Entries::iterator MCForceRegistry::find(Entries & entries, const MCForceGeneratorPtr & generator)
+{
+    // An object has only a few generators
+    return std::find_if(entries.begin(), entries.end(), [&generator](const Entry & entry) {
+        return entry.generator == generator;
+    });
+}
+
+unsigned int * MCForceRegistry::find(MCObject & object)
+{
+    return m_indices.find(object.id());
+}
+
+void MCForceRegistry::swap(unsigned int index1, unsigned int index2)
+{
+    if (index1 != index2)
+    {
+        std::swap(m_objects[index1], m_objects[index2]);
+        *m_indices.find(m_objects[index1].id) = index1;
+        *m_indices.find(m_objects[index2].id) = index2;
+    }
+}
+
+void MCForceRegistry::removeAt(unsigned int index)
+{
+    // Keep the integrated objects first
+    if (index < m_integratedCount)
+    {
+        swap(index, --m_integratedCount);
+        index = m_integratedCount;
+    }
+
+    swap(index, static_cast<unsigned int>(m_objects.size()) - 1);
+
+    m_pairCount -= m_objects.back().entries.size();
+    m_indices.erase(m_objects.back().id);
+    m_objects.pop_back();
+}
+
 void MCForceRegistry::update()
 {
-    auto iter = m_registryHash.begin();
-    while (iter != m_registryHash.end())
+    m_updating = true;
+
+    // The built-in generator classes are final, so these calls are not virtual
+    for (unsigned int i = 0; i < m_integratedCount; i++)
     {
-        Registry & registry = iter->second;
-        for (unsigned int i = 0; i < registry.size(); i++)
+        auto && object = *m_objects[i].object;
+        for (auto && entry : m_objects[i].entries)
         {
-            if (iter->first->index() != -1)
+            if (entry.generator->enabled())
             {
-                if (registry[i]->enabled())
+                switch (entry.type)
                 {
-                    registry[i]->updateForce(*iter->first);
+                case Type::Friction:
+                    static_cast<MCFrictionGenerator *>(entry.generator.get())->updateForce(object);
+                    break;
+                case Type::Drag:
+                    static_cast<MCDragForceGenerator *>(entry.generator.get())->updateForce(object);
+                    break;
+                case Type::Gravity:
+                    static_cast<MCGravityGenerator *>(entry.generator.get())->updateForce(object);
+                    break;
+                case Type::Spring:
+                    static_cast<MCSpringForceGenerator *>(entry.generator.get())->updateForce(object);
+                    break;
+                case Type::Spring2dFast:
+                    static_cast<MCSpringForceGenerator2dFast *>(entry.generator.get())->updateForce(object);
+                    break;
+                case Type::Generic:
+                    entry.generator->updateForce(object);
+                    break;
                 }
             }
         }
+    }
+
+    m_updating = false;
+
+    applyChanges();
+}
+
+void MCForceRegistry::applyChanges()
+{
+    for (auto && change : m_changes)
+    {
+        if (change.add)
+        {
+            addForceGenerator(change.generator, *change.object);
+        }
+        else if (change.generator)
+        {
+            removeForceGenerator(change.generator, *change.object);
+        }
+        else
+        {
+            removeForceGenerators(*change.object);
+        }
+    }
 
-        iter++;
+    m_changes.clear();
+
+    // E.g. springs wake up their other object
+    for (auto && object : m_changedObjects)
+    {
+        updateIntegration(*object);
     }
+
+    m_changedObjects.clear();
 }
 
 void MCForceRegistry::addForceGenerator(MCForceGeneratorPtr generator, MCObject & object)
 {
-    MCForceRegistry::Registry & registry = m_registryHash[&object];
-    if (std::find(registry.begin(), registry.end(), generator) == registry.end())
+    if (m_updating)
+    {
+        m_changes.push_back({ generator, &object, true });
+        return;
+    }
+
+    bool inserted = false;
+    auto && index = m_indices.insert(object.id(), &inserted);
+    if (inserted)
+    {
+        index = static_cast<unsigned int>(m_objects.size());
+        m_objects.push_back({ &object, object.id(), {} });
+        updateIntegration(object);
+    }
+
+    auto && entries = m_objects[*find(object)].entries;
+    if (find(entries, generator) == entries.end())
     {
-        registry.push_back(generator);
+        entries.push_back({ generator, type(*generator) });
+        m_pairCount++;
     }
 }
 
 void MCForceRegistry::removeForceGenerator(MCForceGeneratorPtr generator, MCObject & object)
 {
-    if (auto iter = m_registryHash.find(&object); iter != m_registryHash.end())
+    if (m_updating)
+    {
+        m_changes.push_back({ generator, &object, false });
+        return;
+    }
+
+    if (const auto index = find(object); index)
     {
-        Registry & registry = iter->second;
-        for (unsigned int i = 0; i < registry.size(); i++)
+        auto && entries = m_objects[*index].entries;
+        if (const auto entry = find(entries, generator); entry != entries.end())
         {
-            if (registry[i] == generator && iter->first == &object)
-            {
-                registry[i] = registry.back();
-                registry.pop_back();
-                break;
-            }
+            entries.erase(entry);
+            m_pairCount--;
         }
 
-        if (!registry.size())
+        if (entries.empty())
         {
-            m_registryHash.erase(iter);
+            removeAt(*index);
         }
     }
 }
 
 void MCForceRegistry::removeForceGenerators(MCObject & object)
 {
-    if (auto iter = m_registryHash.find(&object); iter != m_registryHash.end())
+    if (m_updating)
+    {
+        m_changes.push_back({ nullptr, &object, false });
+        return;
+    }
+
+    if (const auto index = find(object); index)
+    {
+        removeAt(*index);
+    }
+}
+
+void MCForceRegistry::updateIntegration(MCObject & object)
+{
+    if (m_updating)
     {
-        m_registryHash.erase(iter);
+        m_changedObjects.push_back(&object);
+        return;
+    }
+
+    if (const auto index = find(object); index)
+    {
+        const bool integrated = *index < m_integratedCount;
+        if (object.index() != -1 && !integrated)
+        {
+            swap(*index, m_integratedCount++);
+        }
+        else if (object.index() == -1 && integrated)
+        {
+            swap(*index, --m_integratedCount);
+        }
     }
 }
 
 void MCForceRegistry::clear()
 {
-    m_registryHash.clear();
+    m_objects.clear();
+    m_integratedCount = 0;
+    m_indices.clear();
+    m_pairCount = 0;
+    m_changes.clear();
+    m_changedObjects.clear();
+}
+
+size_t MCForceRegistry::size() const
+{
+    return m_pairCount;
 }
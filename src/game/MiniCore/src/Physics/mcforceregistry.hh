@@ -22,16 +22,23 @@
 
 #include "mcforcegenerator.hh"
 #include "mcmacros.hh"
+#include "mcpairtable.hh"
 
-#include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 class MCObject;
 
 /*! \class MCForceRegistry
  *  \brief MCForceRegistry stores object-force -pairs
+ *
+ *  The pairs of each object are stored in the order of registration, which is also the
+ *  order the forces of the object are accumulated in. The objects are stored in a dense
+ *  array, in which the objects in the integration of MCWorld come first, so update()
+ *  only walks those. An object is indexed by its id, so adding and removing a pair and
+ *  moving an object in or out of the integration are constant time: removed objects are
+ *  replaced with the last ones. The built-in generator classes are final, so they are
+ *  updated with direct (non-virtual) calls according to the type stored in the pair.
  */
 class MCForceRegistry
 {
@@ -39,6 +46,9 @@ public:
     //! Constructor.
     MCForceRegistry();
 
+    //! Destructor.
+    ~MCForceRegistry();
+
     /*! Add given force generator to given object
      * \param generator Force generator to be attached.
      * \param object Target object. */
@@ -53,20 +63,99 @@ public:
      * \param object Object to be matched */
     void removeForceGenerators(MCObject & object);
 
+    /*! Update the force generators of the given object only if it is in the integration.
+     *  MCWorld calls this whenever the object is added to or removed from the integration. */
+    void updateIntegration(MCObject & object);
+
     //! Update force generators
     void update();
 
     //! Clear registry
     void clear();
 
+    //! \return number of object-force -pairs.
+    size_t size() const;
+
 private:
     DISABLE_COPY(MCForceRegistry);
     DISABLE_ASSI(MCForceRegistry);
 
-    // Prefer map and set here for iteration performance.
-    typedef std::vector<MCForceGeneratorPtr> Registry;
-    typedef std::map<MCObject *, Registry> RegistryHash;
-    RegistryHash m_registryHash;
+    enum class Type : unsigned int
+    {
+        Friction,
+        Drag,
+        Gravity,
+        Spring,
+        Spring2dFast,
+        Generic
+    };
+
+    struct Entry
+    {
+        MCForceGeneratorPtr generator;
+
+        Type type;
+    };
+
+    typedef std::vector<Entry> Entries;
+
+    //! An object and its pairs in the order of registration.
+    struct ObjectEntries
+    {
+        MCObject * object;
+
+        //! Id of the object, which may already be deleted when its pairs are moved.
+        unsigned int id;
+
+        Entries entries;
+    };
+
+    //! A change requested during update().
+    struct Change
+    {
+        MCForceGeneratorPtr generator;
+
+        MCObject * object;
+
+        //! Add the generator or remove it (all generators of the object if nullptr).
+        bool add;
+    };
+
+    static Type type(MCForceGenerator & generator);
+
+    //! \return iterator to the entry of the given generator or end.
+    static Entries::iterator find(Entries & entries, const MCForceGeneratorPtr & generator);
+
+    //! \return pointer to the index of the given object in m_objects or nullptr if it has no pairs.
+    unsigned int * find(MCObject & object);
+
+    //! Swap the objects at the given places in m_objects.
+    void swap(unsigned int index1, unsigned int index2);
+
+    //! Remove the object at the given place in m_objects.
+    void removeAt(unsigned int index);
+
+    //! Apply the changes requested during update().
+    void applyChanges();
+
+    //! The objects in the integration first.
+    std::vector<ObjectEntries> m_objects;
+
+    //! Number of objects in the integration at the beginning of m_objects.
+    unsigned int m_integratedCount;
+
+    //! Object id (used as the key as such) => index in m_objects.
+    MCPairTable<unsigned int> m_indices;
+
+    size_t m_pairCount;
+
+    //! Pairs added or removed during update().
+    std::vector<Change> m_changes;
+
+    //! Objects added to or removed from the integration during update().
+    std::vector<MCObject *> m_changedObjects;
+
+    bool m_updating;
 };
 
 #endif // MCFORCEREGISTRY_HH
@@ -36,7 +36,7 @@
  * velocities are considered. Fast approximation is used to calculate
  * magnitude of the velocity.
  */
-class MCFrictionGenerator : public MCForceGenerator
+class MCFrictionGenerator final : public MCForceGenerator
 {
 public:
     /*! Constructor.
@@ -25,7 +25,7 @@
 #include "mcvector3d.hh"
 
 //! Force generator for gravity
-class MCGravityGenerator : public MCForceGenerator
+class MCGravityGenerator final : public MCForceGenerator
 {
 public:
     /*! Constructor
@@ -19,29 +19,50 @@
 
 #include "mcimpulsegenerator.hh"
 #include "mccontact.hh"
+#include "mccontactstore.hh"
 #include "mcmathutil.hh"
 #include "mcobject.hh"
 #include "mcphysicscomponent.hh"
 #include "mcshape.hh"
 
+#include <algorithm>
+#include <functional>
+
 MCImpulseGenerator::MCImpulseGenerator()
 {
 }
 
-MCContact * MCImpulseGenerator::getDeepestInterpenetration(
-  const std::vector<MCContact *> & contacts)
+void MCImpulseGenerator::sortReceivers(const MCContactStore & contacts)
 {
-    float maxDepth = 0;
-    MCContact * bestContact = nullptr;
-    for (auto && contact : contacts)
+    m_receivers.clear();
+
+    auto && manifolds = contacts.manifolds();
+    for (size_t i = 0; i < manifolds.size(); i++)
     {
-        if (contact->interpenetrationDepth() > maxDepth)
+        auto && manifold = manifolds[i];
+        if (manifold.objectA)
         {
-            maxDepth = contact->interpenetrationDepth();
-            bestContact = contact;
+            // Objects that are not integrated don't process their contacts
+            if (manifold.deepestContactA >= 0 && manifold.objectA->index() >= 0)
+            {
+                m_receivers.push_back({ manifold.objectA, manifold.objectB, i });
+            }
+
+            if (manifold.deepestContactB >= 0 && manifold.objectB->index() >= 0)
+            {
+                m_receivers.push_back({ manifold.objectB, manifold.objectA, i });
+            }
         }
     }
-    return bestContact;
+
+    std::sort(m_receivers.begin(), m_receivers.end(), [](const Receiver & lhs, const Receiver & rhs) {
+        if (lhs.object->index() != rhs.object->index())
+        {
+            return lhs.object->index() < rhs.object->index();
+        }
+
+        return std::less<MCObject *>()(lhs.other, rhs.other);
+    });
 }
 
 void MCImpulseGenerator::displace(
@@ -82,65 +103,69 @@ void MCImpulseGenerator::generateImpulsesFromContact(
     }
 }
 
-void MCImpulseGenerator::resolvePositions(std::vector<MCObject *> & objs, float accuracy)
+void MCImpulseGenerator::resolvePositions(MCContactStore & contacts, float accuracy)
 {
-    for (auto && object : objs)
+    sortReceivers(contacts);
+
+    for (auto && receiver : m_receivers)
     {
-        for (auto && contact : object->contacts())
+        if (const auto deepestContact = contacts.deepestContact(receiver.manifold, *receiver.object); deepestContact)
         {
-            if (const auto deepestContact = getDeepestInterpenetration(contact.second); deepestContact)
-            {
-                auto & pa(*object);
-                auto & pb(deepestContact->object());
+            auto & pa(*receiver.object);
+            auto & pb(*receiver.other);
 
-                const MCVector3dF displacement(
-                  deepestContact->contactNormal() * deepestContact->interpenetrationDepth() * accuracy);
+            const MCVector3dF displacement(
+              deepestContact->contactNormal() * deepestContact->interpenetrationDepth() * accuracy);
 
-                displace(pa, pb, displacement);
-                displace(pb, pa, -displacement);
+            displace(pa, pb, displacement);
+            displace(pb, pa, -displacement);
 
-                pb.deleteContacts(pa);
-                pa.deleteContacts(pb);
-            }
+            contacts.clearContacts(receiver.manifold);
         }
-
-        object->deleteContacts();
     }
+
+    contacts.clearContacts();
 }
 
-void MCImpulseGenerator::generateImpulsesFromDeepestContacts(std::vector<MCObject *> & objs)
+void MCImpulseGenerator::generateImpulsesFromDeepestContacts(MCContactStore & contacts)
 {
-    for (auto && object : objs)
+    sortReceivers(contacts);
+
+    const MCObject * handledObject = nullptr;
+    for (auto && receiver : m_receivers)
     {
-        for (auto && contact : object->contacts())
+        if (receiver.object == handledObject)
         {
-            if (const auto deepestContact = getDeepestInterpenetration(contact.second); deepestContact)
-            {
-                auto & pa(*object);
-                auto & pb(deepestContact->object());
-
-                const float restitution(
-                  std::min(pa.physicsComponent().restitution(), pb.physicsComponent().restitution()));
+            continue;
+        }
 
-                const MCVector2dF velocityDelta(pb.physicsComponent().velocity() - pa.physicsComponent().velocity());
-                const float projection = deepestContact->contactNormal().dot(velocityDelta);
+        if (const auto deepestContact = contacts.deepestContact(receiver.manifold, *receiver.object); deepestContact)
+        {
+            auto & pa(*receiver.object);
+            auto & pb(*receiver.other);
 
-                if (projection > 0)
-                {
-                    const MCVector3dF linearImpulse(
-                      deepestContact->contactNormal() * deepestContact->contactNormal().dot(velocityDelta));
+            const float restitution(
+              std::min(pa.physicsComponent().restitution(), pb.physicsComponent().restitution()));
 
-                    generateImpulsesFromContact(pa, pb, *deepestContact, linearImpulse, restitution);
-                    generateImpulsesFromContact(pb, pa, *deepestContact, -linearImpulse, restitution);
-                }
+            const MCVector2dF velocityDelta(pb.physicsComponent().velocity() - pa.physicsComponent().velocity());
+            const float projection = deepestContact->contactNormal().dot(velocityDelta);
 
-                // Remove contact with pa from pb, because it was already handled here.
-                pb.deleteContacts(pa);
+            if (projection > 0)
+            {
+                const MCVector3dF linearImpulse(
+                  deepestContact->contactNormal() * deepestContact->contactNormal().dot(velocityDelta));
 
-                break;
+                generateImpulsesFromContact(pa, pb, *deepestContact, linearImpulse, restitution);
+                generateImpulsesFromContact(pb, pa, *deepestContact, -linearImpulse, restitution);
             }
-        }
 
-        object->deleteContacts();
+            // Remove contact with pa from pb, because it was already handled here.
+            contacts.clearContacts(receiver.manifold, pb);
+
+            // Only the first contacting object is handled
+            handledObject = &pa;
+        }
     }
+
+    contacts.clearContacts();
 }
@@ -21,10 +21,12 @@
 #define MCIMPULSEGENERATOR_HH
 
 #include "mcvector3d.hh"
+
 #include <vector>
 
 class MCObject;
 class MCContact;
+class MCContactStore;
 
 //! Generates impulses due to detected collisions.
 class MCImpulseGenerator
@@ -36,15 +38,28 @@ public:
     //! Destructor.
     ~MCImpulseGenerator() {};
 
-    //! Generate impulses to the given objects according to current contacts.
-    //! Delete contacts.
-    void generateImpulsesFromDeepestContacts(std::vector<MCObject *> & objs);
+    //! Generate impulses according to the deepest contact of the first contacting
+    //! object of each integrated object. Clear contacts.
+    void generateImpulsesFromDeepestContacts(MCContactStore & contacts);
 
-    //! Resolve positions of the given objects according to current contacts.
-    //! Delete contacts.
-    void resolvePositions(std::vector<MCObject *> & objs, float accuracy);
+    //! Resolve positions according to the deepest contact of each contacting
+    //! pair of objects. Clear contacts.
+    void resolvePositions(MCContactStore & contacts, float accuracy);
 
 private:
+    //! Contacts received by an object from another object.
+    struct Receiver
+    {
+        MCObject * object;
+
+        MCObject * other;
+
+        size_t manifold;
+    };
+
+    //! Order the receivers by the integration index of the object and then by the other object.
+    void sortReceivers(const MCContactStore & contacts);
+
     void generateImpulsesFromContact(
       MCObject & pa, MCObject & pb, const MCContact & contact,
       const MCVector3dF & linearImpulse,
@@ -52,7 +67,7 @@ private:
 
     void displace(MCObject & pa, MCObject & pb, const MCVector3dF & displacement);
 
-    MCContact * getDeepestInterpenetration(const std::vector<MCContact *> & contacts);
+    std::vector<Receiver> m_receivers;
 };
 
 #endif // MCIMPULSEGENERATOR_HH
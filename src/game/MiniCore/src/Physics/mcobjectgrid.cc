@@ -22,9 +22,10 @@
 #include "mcshape.hh"
 
 #include <algorithm>
+#include <cassert>
 
 MCObjectGrid::MCObjectGrid(float x1, float y1, float x2, float y2, float leafMaxW, float leafMaxH)
-  : m_bbox(x1, y1, x2, y2)
+  : MCBroadPhase(x1, y1, x2, y2)
   , m_leafMaxW(leafMaxW)
   , m_leafMaxH(leafMaxH)
   , m_horSize(static_cast<size_t>((x2 - x1) / m_leafMaxW))
@@ -109,6 +110,8 @@ void MCObjectGrid::insert(MCObject & object)
             m_dirtyCellCache.insert(cell);
         }
     }
+
+    countMutations((m_i1 - m_i0 + 1) * (m_j1 - m_j0 + 1));
 }
 
 bool MCObjectGrid::remove(MCObject & object)
@@ -131,6 +134,7 @@ bool MCObjectGrid::remove(MCObject & object)
             {
                 cell->m_objects.erase(iter);
                 removed = true;
+                countMutations(1);
 
                 if (!cell->m_objects.size())
                 {
@@ -142,6 +146,78 @@ bool MCObjectGrid::remove(MCObject & object)
     return removed;
 }
 
+bool MCObjectGrid::move(MCObject & object)
+{
+    if (!object.shape())
+    {
+        return false;
+    }
+
+    size_t i0, i1, j0, j1;
+    object.restoreIndexRange(&i0, &i1, &j0, &j1);
+
+    // An object in the grid is in all cells of its cached range
+    auto && objects = m_matrix[j0 * m_horSize + i0]->m_objects;
+    if (objects.find(&object) == objects.end())
+    {
+        return false;
+    }
+
+    setIndexRange(object.shape()->bbox());
+    if (m_i0 == i0 && m_i1 == i1 && m_j0 == j0 && m_j1 == j1)
+    {
+        // The cells stay the same, but the object might now collide with its neighbors
+        for (size_t j = m_j0; j <= m_j1; j++)
+        {
+            for (size_t i = m_i0; i <= m_i1; i++)
+            {
+                m_dirtyCellCache.insert(m_matrix[j * m_horSize + i]);
+            }
+        }
+
+        return true;
+    }
+
+    // Leave the cells that are not covered anymore
+    for (size_t j = j0; j <= j1; j++)
+    {
+        for (size_t i = i0; i <= i1; i++)
+        {
+            if (i < m_i0 || i > m_i1 || j < m_j0 || j > m_j1)
+            {
+                const auto cell = m_matrix[j * m_horSize + i];
+                cell->m_objects.erase(&object);
+                countMutations(1);
+
+                if (!cell->m_objects.size())
+                {
+                    m_dirtyCellCache.erase(cell);
+                }
+            }
+        }
+    }
+
+    // Enter the new cells
+    for (size_t j = m_j0; j <= m_j1; j++)
+    {
+        for (size_t i = m_i0; i <= m_i1; i++)
+        {
+            auto && cell = m_matrix[j * m_horSize + i];
+            if (i < i0 || i > i1 || j < j0 || j > j1)
+            {
+                cell->m_objects.insert(&object);
+                countMutations(1);
+            }
+
+            m_dirtyCellCache.insert(cell);
+        }
+    }
+
+    object.cacheIndexRange(m_i0, m_i1, m_j0, m_j1);
+
+    return true;
+}
+
 void MCObjectGrid::removeAll()
 {
     for (size_t j = 0; j < m_verSize; j++)
@@ -180,9 +256,6 @@ const MCObjectGrid::CollisionVector & MCObjectGrid::getPossibleCollisions()
     static MCObjectGrid::CollisionVector collisions;
     collisions.clear();
 
-    // Optimization: ignore collisions between sleeping objects.
-    // Note that stationary objects are also sleeping objects.
-
     auto cellIter = m_dirtyCellCache.begin();
     while (cellIter != m_dirtyCellCache.end())
     {
@@ -196,7 +269,7 @@ const MCObjectGrid::CollisionVector & MCObjectGrid::getPossibleCollisions()
             for (auto && objIter2 = std::next(objIter1); objIter2 != end; objIter2++)
             {
                 auto * obj2 = *objIter2; // Note that ob1 != obj2 always holds
-                if (&obj1->parent() != obj2 && &obj2->parent() != obj1 && (!obj1->physicsComponent().isSleeping() || !obj2->physicsComponent().isSleeping()) && (obj1->isPhysicsObject() || obj1->isTriggerObject()) && !obj1->bypassCollisions() && (obj2->isPhysicsObject() || obj2->isTriggerObject()) && !obj2->bypassCollisions() && obj1->physicsComponent().neverCollideWithTag() != obj2->physicsComponent().collisionTag() && obj2->physicsComponent().neverCollideWithTag() != obj1->physicsComponent().collisionTag() && (obj1->collisionLayer() == obj2->collisionLayer() || obj1->collisionLayer() == -1 || obj2->collisionLayer() == -1) && obj1->shape()->likelyIntersects(*obj2->shape().get()))
+                if (canCollide(*obj1, *obj2))
                 {
                     collisions.push_back({ obj1, obj2 });
                     hadCollisions = true;
@@ -217,16 +290,6 @@ const MCObjectGrid::CollisionVector & MCObjectGrid::getPossibleCollisions()
     return collisions;
 }
 
-const MCObjectGrid::ObjectSet & MCObjectGrid::getObjectsWithinDistance(const MCVector2dF & p, float d)
-{
-    return getObjectsWithinDistance(p.i(), p.j(), d);
-}
-
-const MCObjectGrid::ObjectSet & MCObjectGrid::getObjectsWithinDistance(float x, float y, float d)
-{
-    return getObjectsWithinBBox(MCBBox<float>(x - d, y - d, x + d, y + d));
-}
-
 const MCObjectGrid::ObjectSet & MCObjectGrid::getObjectsWithinBBox(const MCBBox<float> & bbox)
 {
     setIndexRange(bbox);
@@ -254,7 +317,62 @@ const MCObjectGrid::ObjectSet & MCObjectGrid::getObjectsWithinBBox(const MCBBox<
     return resultObjs;
 }
 
-const MCBBox<float> & MCObjectGrid::bbox() const
+const MCObjectGrid::ObjectMaskVector & MCObjectGrid::getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes)
+{
+    assert(bboxes.size() <= MAX_BBOXES);
+
+    m_indexRanges.clear();
+    for (auto && bbox : bboxes)
+    {
+        setIndexRange(bbox);
+        m_indexRanges.push_back({ m_i0, m_i1, m_j0, m_j1 });
+    }
+
+    m_resultMasks.clear();
+
+    // Visit each cell only once even if the boxes overlap and test its objects against all boxes.
+    // An object is reported for a box only via the cells of that box like in getObjectsWithinBBox().
+    for (size_t n = 0; n < m_indexRanges.size(); n++)
+    {
+        const auto & range = m_indexRanges[n];
+        for (size_t j = range.j0; j <= range.j1; j++)
+        {
+            for (size_t i = range.i0; i <= range.i1; i++)
+            {
+                const auto rangeMask = cellRangeMask(i, j);
+                if (rangeMask & ((1u << n) - 1))
+                {
+                    continue;
+                }
+
+                for (auto && obj : m_matrix[j * m_horSize + i]->m_objects)
+                {
+                    if (const auto mask = viewOverlapMask(*obj, bboxes) & rangeMask)
+                    {
+                        m_resultMasks.push_back({ obj, mask });
+                    }
+                }
+            }
+        }
+    }
+
+    // Objects covering several cells were added once per cell
+    mergeObjectMasks(m_resultMasks);
+
+    return m_resultMasks;
+}
+
+uint32_t MCObjectGrid::cellRangeMask(size_t i, size_t j) const
 {
-    return m_bbox;
+    uint32_t mask = 0;
+    for (size_t n = 0; n < m_indexRanges.size(); n++)
+    {
+        const auto & range = m_indexRanges[n];
+        if (i >= range.i0 && i <= range.i1 && j >= range.j0 && j <= range.j1)
+        {
+            mask |= 1u << n;
+        }
+    }
+
+    return mask;
 }
@@ -21,6 +21,7 @@
 #define MCOBJECTGRID_HH
 
 #include "mcbbox.hh"
+#include "mcbroadphase.hh"
 #include "mcmacros.hh"
 #include "mcobject.hh"
 
@@ -32,12 +33,9 @@
  *  The tree stores objects inherited from MCObject -class.
  *  A (2d) collision test for a given object can be requested against all
  *  objects of a given typeid. */
-class MCObjectGrid
+class MCObjectGrid : public MCBroadPhase
 {
 public:
-    typedef std::set<MCObject *> ObjectSet;
-    typedef std::vector<std::pair<MCObject *, MCObject *>> CollisionVector;
-
     //! Container for objects.
     struct GridCell
     {
@@ -50,46 +48,50 @@ public:
     MCObjectGrid(float x1, float y1, float x2, float y2, float leafMaxW, float leafMaxH);
 
     //! Destructor.
-    ~MCObjectGrid();
+    virtual ~MCObjectGrid() override;
 
     /*! Insert an object into the tree (O(1)).
      *  \param object is the object to be inserted. */
-    void insert(MCObject & object);
+    void insert(MCObject & object) override;
 
     /*! Remove an object from the tree (O(1)).
      *  \param object is the object to be removed.
      *  \return true if was removed. */
-    bool remove(MCObject & object);
-
-    //! Remove all objects.
-    void removeAll();
+    bool remove(MCObject & object) override;
 
-    //! Get objects within given distance.
-    const ObjectSet & getObjectsWithinDistance(const MCVector2dF & p, float d);
+    /*! Update an object after it has moved. Only the cells that the object
+     *  entered or left are touched.
+     *  \param object is the object to be updated.
+     *  \return true if the object was in the grid. */
+    bool move(MCObject & object) override;
 
-    //! Get objects within given distance.
-    const ObjectSet & getObjectsWithinDistance(float x, float y, float d);
+    //! \reimp
+    void removeAll() override;
 
-    //! Get all objects of given type overlapping given BBox.
-    const ObjectSet & getObjectsWithinBBox(const MCBBox<float> & bbox);
+    //! \reimp
+    const ObjectSet & getObjectsWithinBBox(const MCBBox<float> & bbox) override;
 
-    /*! Get possible collisions. Collisions between sleeping objects are ignored,
-     *  because that gives a huge performance boost.
-     *  \return possible collisions. */
-    const CollisionVector & getPossibleCollisions();
+    //! \reimp
+    const ObjectMaskVector & getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes) override;
 
-    //! Get bounding box
-    const MCBBox<float> & bbox() const;
+    //! \reimp
+    const CollisionVector & getPossibleCollisions() override;
 
 private:
     DISABLE_COPY(MCObjectGrid);
     DISABLE_ASSI(MCObjectGrid);
 
+    struct IndexRange
+    {
+        size_t i0, i1, j0, j1;
+    };
+
     void setIndexRange(const MCBBox<float> & bbox);
 
-    void build();
+    //! \return mask of the index ranges containing cell (i, j).
+    uint32_t cellRangeMask(size_t i, size_t j) const;
 
-    MCBBox<float> m_bbox;
+    void build();
 
     float m_leafMaxW;
 
@@ -101,6 +103,8 @@ private:
 
     size_t m_i0, m_i1, m_j0, m_j1;
 
+    std::vector<IndexRange> m_indexRanges;
+
     float m_helpHor;
 
     float m_helpVer;
@@ -109,6 +113,8 @@ private:
 
     typedef std::set<GridCell *> DirtyCellCache;
     DirtyCellCache m_dirtyCellCache;
+
+    ObjectMaskVector m_resultMasks;
 };
 
 #endif // MCOBJECTGRID_HH
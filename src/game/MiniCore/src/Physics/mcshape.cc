@@ -20,11 +20,16 @@
 #include "mcshape.hh"
 #include "mccamera.hh"
 
+#include <cmath>
+
 MCVector3dF MCShape::m_defaultShadowOffset = MCVector3dF(2, -2, 0.5f);
 
+float MCShape::m_renderInterpolation = 1.0f;
+
 MCShape::MCShape(MCShapeViewPtr view)
   : m_parent(nullptr)
   , m_angle(0)
+  , m_previousAngle(0)
   , m_radius(0)
 {
     if (view)
@@ -61,7 +66,7 @@ void MCShape::render(MCCamera * p)
 {
     if (m_view)
     {
-        m_view->render(m_location, m_angle, p);
+        m_view->render(renderLocation(), renderAngle(), p);
     }
 }
 
@@ -69,12 +74,13 @@ void MCShape::renderShadow(MCCamera * p)
 {
     if (m_view)
     {
+        const auto location = renderLocation();
         const MCVector3dF shadowLocation(
-          m_shadowOffset.i() + m_location.i(),
-          m_shadowOffset.j() + m_location.j(),
+          m_shadowOffset.i() + location.i(),
+          m_shadowOffset.j() + location.j(),
           m_shadowOffset.k());
 
-        m_view->renderShadow(shadowLocation, m_angle, p);
+        m_view->renderShadow(shadowLocation, renderAngle(), p);
     }
 }
 
@@ -113,6 +119,48 @@ float MCShape::angle() const
     return m_angle;
 }
 
+void MCShape::saveRenderState()
+{
+    m_previousLocation = m_location;
+    m_previousAngle = m_angle;
+}
+
+MCVector3dF MCShape::renderLocation() const
+{
+    if (m_renderInterpolation >= 1.0f)
+    {
+        return m_location;
+    }
+
+    return m_previousLocation + (m_location - m_previousLocation) * m_renderInterpolation;
+}
+
+float MCShape::renderAngle() const
+{
+    if (m_renderInterpolation >= 1.0f)
+    {
+        return m_angle;
+    }
+
+    // Interpolate over the shorter arc
+    float delta = std::fmod(m_angle - m_previousAngle, 360.0f);
+    if (delta > 180.0f)
+    {
+        delta -= 360.0f;
+    }
+    else if (delta < -180.0f)
+    {
+        delta += 360.0f;
+    }
+
+    return m_previousAngle + delta * m_renderInterpolation;
+}
+
+void MCShape::setRenderInterpolation(float alpha)
+{
+    MCShape::m_renderInterpolation = alpha;
+}
+
 float MCShape::radius() const
 {
     return m_radius;
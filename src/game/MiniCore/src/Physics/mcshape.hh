@@ -98,6 +98,20 @@ public:
     //! Return the current angle.
     float angle() const;
 
+    //! Store the current location and angle as the previous state for render interpolation.
+    //! MCWorld calls this before each step.
+    void saveRenderState();
+
+    //! \return the location interpolated between the previous and the current step.
+    MCVector3dF renderLocation() const;
+
+    //! \return the angle interpolated between the previous and the current step.
+    float renderAngle() const;
+
+    /*! Set global render interpolation factor.
+     *  \param alpha 0.0 renders the state of the previous step, 1.0 the current state. */
+    static void setRenderInterpolation(float alpha);
+
     //! Return non-rotated, translated bounding box of the shape in 2d.
     virtual MCBBoxF bbox() const = 0;
 
@@ -144,6 +158,12 @@ private:
 
     float m_angle;
 
+    MCVector3dF m_previousLocation;
+
+    float m_previousAngle;
+
+    static float m_renderInterpolation;
+
     float m_radius;
 
     MCShapeViewPtr m_view;
@@ -31,7 +31,7 @@
  * By carefully selecting the nominal length, min length, max length and the spring
  * coefficient one can create traditional springs as well as rods and cables.
  */
-class MCSpringForceGenerator : public MCForceGenerator
+class MCSpringForceGenerator final : public MCForceGenerator
 {
 public:
     /*! Constructor
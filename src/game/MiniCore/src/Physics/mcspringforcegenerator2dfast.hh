@@ -35,7 +35,7 @@
  * coordinates are considered. Fast approximation is used to calculate
  * the distance between end nodes.
  */
-class MCSpringForceGenerator2dFast : public MCForceGenerator
+class MCSpringForceGenerator2dFast final : public MCForceGenerator
 {
 public:
     /*! Constructor
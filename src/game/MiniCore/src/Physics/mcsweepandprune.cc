@@ -0,0 +1,450 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "mcsweepandprune.hh"
+#include "mcobject.hh"
+#include "mcshape.hh"
+#include "mcshapeview.hh"
+
+#include <algorithm>
+#include <cassert>
+
+MCSweepAndPrune::MCSweepAndPrune(float x1, float y1, float x2, float y2)
+  : MCBroadPhase(x1, y1, x2, y2)
+{
+}
+
+MCSweepAndPrune::~MCSweepAndPrune()
+{
+}
+
+int MCSweepAndPrune::validProxy(MCObject & object) const
+{
+    // The id cached to the object might be stale if the proxy has been purged or cleared.
+    const int proxy = object.broadPhaseProxy();
+    if (proxy >= 0 && proxy < static_cast<int>(m_proxies.size()) && m_proxies[static_cast<size_t>(proxy)].object == &object)
+    {
+        return proxy;
+    }
+
+    return -1;
+}
+
+bool MCSweepAndPrune::overlaps(const Proxy & proxy1, const Proxy & proxy2) const
+{
+    return proxy1.min[0] < proxy2.max[0] && proxy2.min[0] < proxy1.max[0]
+      && proxy1.min[1] < proxy2.max[1] && proxy2.min[1] < proxy1.max[1];
+}
+
+bool MCSweepAndPrune::less(const EndPoint & endPoint1, const EndPoint & endPoint2) const
+{
+    // On equal values max points go first. This makes the order of a min point and a max point
+    // match the strict comparison in overlaps(), so every change in overlap causes a swap.
+    return endPoint1.value < endPoint2.value
+      || (endPoint1.value == endPoint2.value && (endPoint1.data & 1) && !(endPoint2.data & 1));
+}
+
+bool MCSweepAndPrune::setBounds(Proxy & proxy, const MCBBox<float> & bbox)
+{
+    if (proxy.min[0] == bbox.x1() && proxy.min[1] == bbox.y1() && proxy.max[0] == bbox.x2() && proxy.max[1] == bbox.y2())
+    {
+        return false;
+    }
+
+    proxy.min[0] = bbox.x1();
+    proxy.min[1] = bbox.y1();
+    proxy.max[0] = bbox.x2();
+    proxy.max[1] = bbox.y2();
+    proxy.movedStep = m_step;
+
+    m_maxWidth = std::max(m_maxWidth, bbox.x2() - bbox.x1());
+
+    // Until the next sort the view queries find the proxy by its sorted x bounds
+    if (proxy.added)
+    {
+        m_maxDrift = std::max(m_maxDrift, std::max(proxy.sortedMin - bbox.x1(), bbox.x2() - proxy.sortedMax));
+    }
+
+    return true;
+}
+
+void MCSweepAndPrune::insert(MCObject & object)
+{
+    if (!object.shape())
+    {
+        return;
+    }
+
+    int proxyIndex = validProxy(object);
+    if (proxyIndex < 0)
+    {
+        if (m_freeProxies.size())
+        {
+            proxyIndex = static_cast<int>(m_freeProxies.back());
+            m_freeProxies.pop_back();
+        }
+        else
+        {
+            proxyIndex = static_cast<int>(m_proxies.size());
+            m_proxies.push_back(Proxy());
+        }
+
+        m_proxies[static_cast<size_t>(proxyIndex)] = Proxy();
+        m_proxies[static_cast<size_t>(proxyIndex)].object = &object;
+        m_newProxies.push_back(static_cast<unsigned int>(proxyIndex));
+        object.setBroadPhaseProxy(proxyIndex);
+    }
+
+    // Just update the bounds of an existing proxy. The end points are sorted lazily.
+    auto && proxy = m_proxies[static_cast<size_t>(proxyIndex)];
+    setBounds(proxy, object.shape()->bbox());
+    proxy.movedStep = m_step;
+    proxy.attached = true;
+    countMutations(1);
+
+    if (const auto view = object.shape()->view())
+    {
+        const auto & viewBBox = view->bbox();
+        m_maxViewExtent = std::max(m_maxViewExtent, std::max(-viewBBox.x1(), viewBBox.x2()));
+    }
+}
+
+bool MCSweepAndPrune::remove(MCObject & object)
+{
+    const int proxyIndex = validProxy(object);
+    if (proxyIndex < 0 || !m_proxies[static_cast<size_t>(proxyIndex)].attached)
+    {
+        return false;
+    }
+
+    // The object might get inserted again before the next update, e.g. when translated,
+    // so the proxy is not purged yet.
+    m_proxies[static_cast<size_t>(proxyIndex)].attached = false;
+    m_detachedProxies.push_back(static_cast<unsigned int>(proxyIndex));
+    countMutations(1);
+
+    return true;
+}
+
+bool MCSweepAndPrune::move(MCObject & object)
+{
+    const int proxyIndex = validProxy(object);
+    if (proxyIndex < 0 || !m_proxies[static_cast<size_t>(proxyIndex)].attached)
+    {
+        return false;
+    }
+
+    auto && proxy = m_proxies[static_cast<size_t>(proxyIndex)];
+    if (setBounds(proxy, object.shape()->bbox()))
+    {
+        countMutations(1);
+    }
+
+    return true;
+}
+
+void MCSweepAndPrune::removeAll()
+{
+    m_proxies.clear();
+    m_freeProxies.clear();
+    m_detachedProxies.clear();
+    m_newProxies.clear();
+    m_axes[0].clear();
+    m_axes[1].clear();
+    m_pairs.clear();
+    m_collisions.clear();
+    m_separatedPairs.clear();
+    m_maxViewExtent = 0;
+    m_maxWidth = 0;
+    m_maxDrift = 0;
+}
+
+void MCSweepAndPrune::purgeDetachedProxies()
+{
+    bool endPointsRemoved = false;
+    for (auto && proxyIndex : m_detachedProxies)
+    {
+        auto && proxy = m_proxies[proxyIndex];
+
+        // Skip re-attached and already purged proxies. Note that the object might not exist anymore.
+        if (proxy.attached || !proxy.object)
+        {
+            continue;
+        }
+
+        proxy.object = nullptr;
+        endPointsRemoved = endPointsRemoved || proxy.added;
+        m_freeProxies.push_back(proxyIndex);
+    }
+
+    m_detachedProxies.clear();
+
+    if (!endPointsRemoved)
+    {
+        return;
+    }
+
+    const auto isPurged = [this](const EndPoint & endPoint) {
+        return !m_proxies[endPoint.data >> 1].object;
+    };
+
+    // Removing keeps the order, so the axes stay sorted
+    for (auto && axis : m_axes)
+    {
+        axis.erase(std::remove_if(axis.begin(), axis.end(), isPurged), axis.end());
+    }
+
+    auto && entries = m_pairs.entries();
+    for (size_t i = entries.size(); i > 0; i--)
+    {
+        const uint64_t key = entries[i - 1].key;
+        if (!m_proxies[PairTable::first(key)].object || !m_proxies[PairTable::second(key)].object)
+        {
+            m_pairs.eraseAt(i - 1);
+        }
+    }
+
+    for (auto && proxy : m_proxies)
+    {
+        if (!proxy.object)
+        {
+            proxy.added = false;
+        }
+    }
+}
+
+void MCSweepAndPrune::addNewEndPoints()
+{
+    // New end points are appended to the end: until sorted they are beyond all other
+    // end points and don't overlap with anything, which is consistent with the pair table.
+    for (auto && proxyIndex : m_newProxies)
+    {
+        auto && proxy = m_proxies[proxyIndex];
+        if (proxy.object && !proxy.added)
+        {
+            for (size_t axis = 0; axis < 2; axis++)
+            {
+                m_axes[axis].push_back({ proxy.min[axis], proxyIndex << 1 });
+                m_axes[axis].push_back({ proxy.max[axis], (proxyIndex << 1) | 1 });
+            }
+
+            proxy.added = true;
+        }
+    }
+
+    m_newProxies.clear();
+}
+
+void MCSweepAndPrune::sortAxis(size_t axisIndex)
+{
+    auto && axis = m_axes[axisIndex];
+
+    for (auto && endPoint : axis)
+    {
+        auto && proxy = m_proxies[endPoint.data >> 1];
+        endPoint.value = (endPoint.data & 1) ? proxy.max[axisIndex] : proxy.min[axisIndex];
+        if (!axisIndex)
+        {
+            (endPoint.data & 1 ? proxy.sortedMax : proxy.sortedMin) = endPoint.value;
+        }
+    }
+
+    if (!axisIndex)
+    {
+        m_maxDrift = 0;
+    }
+
+    for (size_t i = 1; i < axis.size(); i++)
+    {
+        const EndPoint endPoint = axis[i];
+        const unsigned int proxyIndex = endPoint.data >> 1;
+        const bool isMax = endPoint.data & 1;
+
+        size_t j = i;
+        while (j > 0 && less(endPoint, axis[j - 1]))
+        {
+            const EndPoint & other = axis[j - 1];
+            const unsigned int otherIndex = other.data >> 1;
+            const bool otherIsMax = other.data & 1;
+
+            if (proxyIndex != otherIndex && isMax != otherIsMax)
+            {
+                if (!isMax)
+                {
+                    // A min point passed a max point: the proxies might start to overlap
+                    if (overlaps(m_proxies[proxyIndex], m_proxies[otherIndex]))
+                    {
+                        m_pairs.insert(PairTable::key(proxyIndex, otherIndex));
+                    }
+                }
+                else
+                {
+                    // A max point passed a min point: the proxies are separated on this axis
+                    if (m_pairs.erase(PairTable::key(proxyIndex, otherIndex)))
+                    {
+                        auto * obj1 = m_proxies[proxyIndex].object;
+                        auto * obj2 = m_proxies[otherIndex].object;
+                        m_separatedPairs.push_back(obj1 < obj2 ? std::make_pair(obj1, obj2) : std::make_pair(obj2, obj1));
+                    }
+                }
+            }
+
+            axis[j] = other;
+            j--;
+        }
+
+        axis[j] = endPoint;
+    }
+}
+
+const MCSweepAndPrune::CollisionVector & MCSweepAndPrune::getPossibleCollisions()
+{
+    m_separatedPairs.clear();
+
+    purgeDetachedProxies();
+    addNewEndPoints();
+    sortAxis(0);
+    sortAxis(1);
+
+    m_collisions.clear();
+
+    for (auto && entry : m_pairs.entries())
+    {
+        const auto & proxy1 = m_proxies[PairTable::first(entry.key)];
+        const auto & proxy2 = m_proxies[PairTable::second(entry.key)];
+
+        // Skip pairs that failed the filtering and haven't moved since, e.g. sleeping objects.
+        if (entry.value && proxy1.movedStep <= entry.value && proxy2.movedStep <= entry.value)
+        {
+            continue;
+        }
+
+        auto * obj1 = proxy1.object;
+        auto * obj2 = proxy2.object;
+        if (canCollide(*obj1, *obj2))
+        {
+            entry.value = 0;
+
+            // Keep the same pair orientation as the grids
+            if (obj1 < obj2)
+            {
+                m_collisions.push_back({ obj1, obj2 });
+            }
+            else
+            {
+                m_collisions.push_back({ obj2, obj1 });
+            }
+        }
+        else
+        {
+            entry.value = m_step;
+        }
+    }
+
+    m_step++;
+
+    return m_collisions;
+}
+
+const MCSweepAndPrune::CollisionVector & MCSweepAndPrune::getSeparatedPairs() const
+{
+    return m_separatedPairs;
+}
+
+size_t MCSweepAndPrune::pairCount() const
+{
+    return m_pairs.size();
+}
+
+template<typename Function>
+void MCSweepAndPrune::forEachProxyNear(float x1, float x2, Function function)
+{
+    // The shape covers the location, so the shape of an object whose view overlaps the range
+    // overlaps the range widened by the view extent. The sorted min point of such a shape is
+    // at most the width of the shapes and the drift since the last sort away from the range.
+    const float margin = m_maxViewExtent + m_maxDrift;
+    const float min = x1 - margin - m_maxWidth;
+    const float max = x2 + margin;
+
+    auto && axis = m_axes[0];
+    auto iter = std::lower_bound(axis.begin(), axis.end(), min, [](const EndPoint & endPoint, float value) {
+        return endPoint.value < value;
+    });
+
+    for (; iter != axis.end() && iter->value <= max; iter++)
+    {
+        if (!(iter->data & 1))
+        {
+            auto && proxy = m_proxies[iter->data >> 1];
+            if (proxy.attached)
+            {
+                function(*proxy.object);
+            }
+        }
+    }
+
+    // The end points of new proxies are added on the next update
+    for (auto && proxyIndex : m_newProxies)
+    {
+        auto && proxy = m_proxies[proxyIndex];
+        if (proxy.attached && !proxy.added)
+        {
+            function(*proxy.object);
+        }
+    }
+}
+
+const MCSweepAndPrune::ObjectSet & MCSweepAndPrune::getObjectsWithinBBox(const MCBBox<float> & bbox)
+{
+    m_resultObjs.clear();
+
+    forEachProxyNear(bbox.x1(), bbox.x2(), [&](MCObject & object) {
+        if (object.shape()->view())
+        {
+            if (bbox.intersects(object.shape()->view()->bbox().translated(MCVector2dF(object.location()))))
+            {
+                m_resultObjs.insert(&object);
+            }
+        }
+    });
+
+    return m_resultObjs;
+}
+
+const MCSweepAndPrune::ObjectMaskVector & MCSweepAndPrune::getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes)
+{
+    assert(bboxes.size() <= MAX_BBOXES);
+
+    m_resultMasks.clear();
+
+    for (auto && bbox : bboxes)
+    {
+        forEachProxyNear(bbox.x1(), bbox.x2(), [&](MCObject & object) {
+            if (const auto mask = viewOverlapMask(object, bboxes))
+            {
+                m_resultMasks.push_back({ &object, mask });
+            }
+        });
+    }
+
+    // Objects near several boxes were added once per box
+    mergeObjectMasks(m_resultMasks);
+
+    return m_resultMasks;
+}
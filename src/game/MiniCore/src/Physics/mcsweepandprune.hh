@@ -0,0 +1,186 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#ifndef MCSWEEPANDPRUNE_HH
+#define MCSWEEPANDPRUNE_HH
+
+#include "mcbroadphase.hh"
+#include "mcmacros.hh"
+#include "mcpairtable.hh"
+
+#include <vector>
+
+/*! \class MCSweepAndPrune
+ *  \brief Incremental sort-and-sweep broad phase.
+ *
+ *  The end points of the object bounding boxes are kept sorted on both axes.
+ *  Because objects move only a little between steps, the arrays are nearly sorted
+ *  and insertion sort updates them in almost linear time. Each swap of end points
+ *  adds or removes a pair in a persistent table of overlapping pairs, so pairs that
+ *  keep overlapping cost nothing to maintain.
+ *
+ *  Unlike the grids, the result doesn't depend on any cell size, which makes this
+ *  a good fit for large areas with many small objects.
+ *
+ *  Removed objects are only marked as detached and purged in getPossibleCollisions().
+ *  This keeps the remove() + insert() done by MCObject::translate() cheap.
+ *
+ *  Like the dirty cells of the grids, a pair that doesn't pass the filtering, e.g. because
+ *  both objects are sleeping or stationary, is not tested again until either object moves.
+ *
+ *  The view queries use the sorted x axis, so they only visit the objects around the
+ *  given boxes. This assumes that the shape of an object covers its location. */
+class MCSweepAndPrune : public MCBroadPhase
+{
+public:
+    /*! Constructor.
+     *  \param x1,y1,x2,y2 represent the size of the covered area. Objects outside
+     *  of the area are handled normally. */
+    MCSweepAndPrune(float x1, float y1, float x2, float y2);
+
+    //! Destructor.
+    virtual ~MCSweepAndPrune() override;
+
+    /*! Insert an object or update the bounds of an already inserted object (O(1)).
+     *  \param object is the object to be inserted. */
+    void insert(MCObject & object) override;
+
+    /*! Remove an object (O(1)).
+     *  \param object is the object to be removed.
+     *  \return true if was removed. */
+    bool remove(MCObject & object) override;
+
+    /*! Update the bounds of an object after it has moved. Unchanged bounds are a no-op.
+     *  \param object is the object to be updated.
+     *  \return true if the object was in the broad phase. */
+    bool move(MCObject & object) override;
+
+    //! \reimp
+    void removeAll() override;
+
+    //! \reimp
+    const ObjectSet & getObjectsWithinBBox(const MCBBox<float> & bbox) override;
+
+    //! \reimp
+    const ObjectMaskVector & getObjectsWithinBBoxes(const std::vector<MCBBox<float>> & bboxes) override;
+
+    /*! Update the end points and the pair table.
+     *  \return all pairs with overlapping bounding boxes that pass the filtering. */
+    const CollisionVector & getPossibleCollisions() override;
+
+    //! \reimp
+    const CollisionVector & getSeparatedPairs() const override;
+
+    //! \return number of overlapping pairs in the pair table.
+    size_t pairCount() const;
+
+private:
+    DISABLE_COPY(MCSweepAndPrune);
+    DISABLE_ASSI(MCSweepAndPrune);
+
+    struct Proxy
+    {
+        MCObject * object = nullptr;
+
+        float min[2] = { 0, 0 };
+
+        float max[2] = { 0, 0 };
+
+        //! The x bounds at the last sort of the x axis.
+        float sortedMin = 0;
+
+        float sortedMax = 0;
+
+        //! The step on which the bounds were last changed.
+        unsigned int movedStep = 0;
+
+        bool attached = false;
+
+        //! True until the end points have been added to the axes.
+        bool added = false;
+    };
+
+    //! End point data is the proxy index shifted left by one, or'ed with 1 for max points.
+    struct EndPoint
+    {
+        float value;
+
+        unsigned int data;
+    };
+
+    typedef std::vector<EndPoint> Axis;
+
+    typedef MCPairTable<unsigned int> PairTable;
+
+    int validProxy(MCObject & object) const;
+
+    //! Set the bounds of the proxy. \return true if they changed.
+    bool setBounds(Proxy & proxy, const MCBBox<float> & bbox);
+
+    bool overlaps(const Proxy & proxy1, const Proxy & proxy2) const;
+
+    bool less(const EndPoint & endPoint1, const EndPoint & endPoint2) const;
+
+    void purgeDetachedProxies();
+
+    void addNewEndPoints();
+
+    void sortAxis(size_t axis);
+
+    /*! Call the given function for every attached proxy whose shape might overlap the given
+     *  x range widened by the view extent. */
+    template<typename Function>
+    void forEachProxyNear(float x1, float x2, Function function);
+
+    std::vector<Proxy> m_proxies;
+
+    std::vector<unsigned int> m_freeProxies;
+
+    std::vector<unsigned int> m_detachedProxies;
+
+    std::vector<unsigned int> m_newProxies;
+
+    Axis m_axes[2];
+
+    /*! Overlapping pairs of proxies. The value is the step on which the pair last failed
+     *  the filtering or zero if it passed. */
+    PairTable m_pairs;
+
+    //! Incremented on every call to getPossibleCollisions().
+    unsigned int m_step = 1;
+
+    //! Max half size of the views relative to the locations of the objects.
+    float m_maxViewExtent = 0;
+
+    //! Max width of the shapes.
+    float m_maxWidth = 0;
+
+    //! Max distance the x bounds have grown beyond the sorted ones since the last sort.
+    float m_maxDrift = 0;
+
+    CollisionVector m_collisions;
+
+    CollisionVector m_separatedPairs;
+
+    ObjectSet m_resultObjs;
+
+    ObjectMaskVector m_resultMasks;
+};
+
+#endif // MCSWEEPANDPRUNE_HH
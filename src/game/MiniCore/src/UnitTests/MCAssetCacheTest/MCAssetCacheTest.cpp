@@ -0,0 +1,171 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "MCAssetCacheTest.hpp"
+
+#include "../../Asset/mcassetcache.hh"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <cstring>
+
+namespace {
+
+//! A PNG-encoded test image similar to the game textures.
+QByteArray createPng(int size)
+{
+    QImage image(size, size, QImage::Format_ARGB32);
+    for (int j = 0; j < size; j++)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            image.setPixel(i, j, qRgba(i % 256, j % 256, (i * j) % 256, (i + j) % 2 ? 255 : 128));
+        }
+    }
+
+    QByteArray png;
+    QBuffer buffer(&png);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+    return png;
+}
+
+//! Decode and convert the image as if creating a texture and store the result.
+bool decodeAndStore(const MCAssetCache & cache, uint64_t key, const QByteArray & png)
+{
+    QImage image;
+    image.loadFromData(png);
+    image = image.convertToFormat(QImage::Format_ARGB32).mirrored(false, true);
+    return cache.store(MCAssetCache::Type::Texture, key, { { image.constBits(), static_cast<size_t>(image.sizeInBytes()) } });
+}
+
+} // namespace
+
+MCAssetCacheTest::MCAssetCacheTest() = default;
+
+void MCAssetCacheTest::testHash()
+{
+    QCOMPARE(MCAssetCache::hash("", 0), uint64_t(14695981039346656037ull));
+    QCOMPARE(MCAssetCache::hash("a", 1), uint64_t(0xaf63dc4c8601ec8cull));
+
+    // Hashes can be combined by passing the previous hash as the seed
+    QCOMPARE(MCAssetCache::hash("b", 1, MCAssetCache::hash("a", 1)), MCAssetCache::hash("ab", 2));
+    QVERIFY(MCAssetCache::hash("ab", 2) != MCAssetCache::hash("ba", 2));
+}
+
+void MCAssetCacheTest::testStoreAndLoad()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    // The directory is created on the first store
+    const MCAssetCache cache((dir.path() + "/cache").toStdString());
+    QVERIFY(cache.store(MCAssetCache::Type::Texture, 42, { { "abc", 3 }, { "de", 2 } }));
+
+    auto entry = cache.load(MCAssetCache::Type::Texture, 42);
+    QVERIFY(entry);
+    QCOMPARE(entry->size(), size_t(5));
+    QVERIFY(!std::memcmp(entry->data(), "abcde", 5));
+
+    // Overwrite. Mapped files cannot be replaced on all platforms.
+    entry.reset();
+    QVERIFY(cache.store(MCAssetCache::Type::Texture, 42, { { "xyz", 3 } }));
+    const auto newEntry = cache.load(MCAssetCache::Type::Texture, 42);
+    QVERIFY(newEntry);
+    QCOMPARE(newEntry->size(), size_t(3));
+    QVERIFY(!std::memcmp(newEntry->data(), "xyz", 3));
+}
+
+void MCAssetCacheTest::testMissingEntry()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const MCAssetCache cache(dir.path().toStdString());
+    QVERIFY(!cache.load(MCAssetCache::Type::Texture, 1));
+
+    QVERIFY(cache.store(MCAssetCache::Type::Texture, 1, { { "abc", 3 } }));
+    QVERIFY(!cache.load(MCAssetCache::Type::Texture, 2));
+    QVERIFY(!cache.load(MCAssetCache::Type::Mesh, 1));
+    QVERIFY(!cache.load(MCAssetCache::Type::Data, 1));
+    QVERIFY(cache.load(MCAssetCache::Type::Texture, 1));
+}
+
+void MCAssetCacheTest::testStaleEntry()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const MCAssetCache cache(dir.path().toStdString());
+    QVERIFY(cache.store(MCAssetCache::Type::Mesh, 7, { { "abc", 3 } }));
+
+    const auto files = QDir(dir.path()).entryList(QDir::Files);
+    QCOMPARE(files.size(), qsizetype(1));
+
+    // Pretend that the entry was written by another version
+    QFile file(dir.path() + "/" + files.at(0));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.seek(4));
+    const uint32_t version = MCAssetCache::VERSION + 1;
+    QCOMPARE(file.write(reinterpret_cast<const char *>(&version), sizeof(version)), qint64(sizeof(version)));
+    file.close();
+    QVERIFY(!cache.load(MCAssetCache::Type::Mesh, 7));
+
+    // Truncated
+    QVERIFY(cache.store(MCAssetCache::Type::Mesh, 7, { { "abc", 3 } }));
+    QVERIFY(file.resize(file.size() - 1));
+    QVERIFY(!cache.load(MCAssetCache::Type::Mesh, 7));
+}
+
+void MCAssetCacheTest::testBenchmarkCold()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const MCAssetCache cache(dir.path().toStdString());
+    const auto png = createPng(512);
+
+    QBENCHMARK
+    {
+        QVERIFY(decodeAndStore(cache, 1, png));
+    }
+}
+
+void MCAssetCacheTest::testBenchmarkWarm()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const MCAssetCache cache(dir.path().toStdString());
+    QVERIFY(decodeAndStore(cache, 1, createPng(512)));
+
+    QBENCHMARK
+    {
+        const auto entry = cache.load(MCAssetCache::Type::Texture, 1);
+        QVERIFY(entry);
+        QCOMPARE(entry->size(), size_t(512 * 512 * 4));
+    }
+}
+
+QTEST_GUILESS_MAIN(MCAssetCacheTest)
@@ -0,0 +1,652 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2014 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "MCBroadPhaseTest.hpp"
+#include "../../Core/mcobject.hh"
+#include "../../Core/mcworld.hh"
+#include "../../Graphics/mcshapeview.hh"
+#include "../../Physics/mccircleshape.hh"
+#include "../../Physics/mcflatobjectgrid.hh"
+#include "../../Physics/mcobjectgrid.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcrectshape.hh"
+#include "../../Physics/mcshape.hh"
+#include "../../Physics/mcsweepandprune.hh"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+typedef std::set<std::pair<MCObject *, MCObject *>> PairSet;
+
+PairSet toPairSet(const MCBroadPhase::CollisionVector & collisions)
+{
+    return PairSet(collisions.begin(), collisions.end());
+}
+
+bool bboxesOverlap(MCObject & object1, MCObject & object2)
+{
+    const auto bbox1 = object1.shape()->bbox();
+    const auto bbox2 = object2.shape()->bbox();
+    return bbox1.x1() < bbox2.x2() && bbox2.x1() < bbox1.x2() && bbox1.y1() < bbox2.y2() && bbox2.y1() < bbox1.y2();
+}
+
+std::vector<std::unique_ptr<MCObject>> createObjects(std::mt19937 & engine, size_t count, float size)
+{
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (size_t i = 0; i < count; i++)
+    {
+        MCShapePtr shape;
+        if (i % 2)
+        {
+            shape = std::make_shared<MCRectShape>(nullptr, 5 + engine() % 40, 5 + engine() % 20);
+        }
+        else
+        {
+            shape = std::make_shared<MCCircleShape>(nullptr, 2 + engine() % 20);
+        }
+
+        auto object = std::make_unique<MCObject>(shape, "TestObject");
+        object->physicsComponent().setMass(i % 10 ? 1.0f : 0.0f, !(i % 10)); // Mix in some stationary objects
+        object->translate(MCVector3dF(engine() % static_cast<int>(size), engine() % static_cast<int>(size)));
+        object->rotate(engine() % 360);
+        objects.push_back(std::move(object));
+    }
+
+    return objects;
+}
+
+//! View with a fixed bbox for the visibility queries.
+class TestView : public MCShapeView
+{
+public:
+    TestView(float size)
+      : MCShapeView("TestView")
+      , m_bbox(-size / 2, -size / 2, size / 2, size / 2)
+    {
+    }
+
+    const MCBBoxF & bbox() const override
+    {
+        return m_bbox;
+    }
+
+    void bind() override
+    {
+    }
+
+    void bindShadow() override
+    {
+    }
+
+    void release() override
+    {
+    }
+
+    void releaseShadow() override
+    {
+    }
+
+    MCGLObjectBase * object() const override
+    {
+        return nullptr;
+    }
+
+private:
+    MCBBoxF m_bbox;
+};
+
+bool matchesObjectsWithinBBox(MCBroadPhase & broadPhase, const std::vector<MCBBox<float>> & bboxes)
+{
+    // Take a copy, as the single box queries below may share the storage
+    const auto objectMasks = broadPhase.getObjectsWithinBBoxes(bboxes);
+    for (size_t i = 1; i < objectMasks.size(); i++)
+    {
+        if (!(objectMasks[i - 1].first < objectMasks[i].first))
+        {
+            return false;
+        }
+    }
+
+    for (size_t n = 0; n < bboxes.size(); n++)
+    {
+        std::set<MCObject *> objects;
+        for (auto && objectMask : objectMasks)
+        {
+            if (!objectMask.second)
+            {
+                return false;
+            }
+
+            if (objectMask.second & (1u << n))
+            {
+                objects.insert(objectMask.first);
+            }
+        }
+
+        if (objects != broadPhase.getObjectsWithinBBox(bboxes[n]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool moveMatchesReinsert(MCBroadPhase & broadPhase, MCBroadPhase & reference, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    auto objects = createObjects(engine, 800, 1000);
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        // The grids find only the views within the cells of the shapes, so keep the views small
+        objects[i]->shape()->setView(std::make_shared<TestView>(2));
+
+        // Leave some objects out to test moving objects that are not in the broad phase
+        if (i % 20)
+        {
+            reference.insert(*objects[i]);
+            broadPhase.insert(*objects[i]);
+        }
+    }
+
+    const auto overlappingPairs = [](MCBroadPhase & broadPhase) {
+        PairSet pairs;
+        for (auto && pair : broadPhase.getPossibleCollisions())
+        {
+            if (bboxesOverlap(*pair.first, *pair.second))
+            {
+                pairs.insert(pair);
+            }
+        }
+
+        return pairs;
+    };
+
+    for (int round = 0; round < 20; round++)
+    {
+        // Move some objects by small steps like in a simulation and move some far away
+        for (int i = 0; i < 300; i++)
+        {
+            auto && object = objects[engine() % objects.size()];
+            if (engine() % 2)
+            {
+                object->translate(object->location() + MCVector3dF(static_cast<float>(engine() % 200) / 10 - 10, static_cast<float>(engine() % 200) / 10 - 10));
+            }
+            else
+            {
+                object->translate(MCVector3dF(static_cast<float>(engine() % 10000) / 10, static_cast<float>(engine() % 10000) / 10));
+            }
+
+            object->rotate(engine() % 360);
+
+            const bool wasIn = reference.remove(*object);
+            if (wasIn)
+            {
+                reference.insert(*object);
+            }
+
+            if (broadPhase.move(*object) != wasIn)
+            {
+                return false;
+            }
+        }
+
+        const auto expected = overlappingPairs(reference);
+        if (expected.empty() || overlappingPairs(broadPhase) != expected)
+        {
+            return false;
+        }
+
+        const MCBBox<float> bbox(100, 200, 600, 700);
+        if (broadPhase.getObjectsWithinBBox(bbox) != reference.getObjectsWithinBBox(bbox))
+        {
+            return false;
+        }
+    }
+
+    // Removing must still find everything after the moves
+    for (auto && object : objects)
+    {
+        if (broadPhase.remove(*object) != reference.remove(*object))
+        {
+            return false;
+        }
+    }
+
+    return broadPhase.getObjectsWithinBBox(MCBBox<float>(0, 0, 1000, 1000)).empty();
+}
+
+} // namespace
+
+MCBroadPhaseTest::MCBroadPhaseTest()
+{
+}
+
+void MCBroadPhaseTest::testFlatObjectGridMatchesObjectGrid()
+{
+    // Objects are not added to the world so that only the grids under test see them.
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 100, 1, false);
+
+    const float leafSize = 1000.0f / 64;
+    MCObjectGrid objectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+    MCFlatObjectGrid flatObjectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+
+    std::mt19937 engine(1);
+    auto objects = createObjects(engine, 800, 1000);
+    for (auto && object : objects)
+    {
+        objectGrid.insert(*object);
+        flatObjectGrid.insert(*object);
+    }
+
+    for (int round = 0; round < 20; round++)
+    {
+        const auto expected = toPairSet(objectGrid.getPossibleCollisions());
+        QVERIFY(expected.size() > 0);
+        QVERIFY(toPairSet(flatObjectGrid.getPossibleCollisions()) == expected);
+
+        const MCBBox<float> bbox(100, 200, 600, 700);
+        QVERIFY(flatObjectGrid.getObjectsWithinBBox(bbox) == objectGrid.getObjectsWithinBBox(bbox));
+
+        // Move some objects and leave some of them out of the grids
+        for (int i = 0; i < 300; i++)
+        {
+            auto && object = objects[engine() % objects.size()];
+            QCOMPARE(flatObjectGrid.remove(*object), objectGrid.remove(*object));
+            if (engine() % 10)
+            {
+                object->translate(MCVector3dF(engine() % 1000, engine() % 1000));
+                object->rotate(engine() % 360);
+                objectGrid.insert(*object);
+                flatObjectGrid.insert(*object);
+            }
+        }
+    }
+}
+
+void MCBroadPhaseTest::testFlatObjectGridRemove()
+{
+    MCWorld world;
+    world.setDimensions(0, 100, 0, 100, 0, 100, 1, false);
+
+    MCFlatObjectGrid grid(0, 0, 100, 100, 10, 10);
+
+    MCObject object1(std::make_shared<MCRectShape>(nullptr, 30, 30), "TestObject");
+    MCObject object2(std::make_shared<MCRectShape>(nullptr, 30, 30), "TestObject");
+    object1.translate(MCVector3dF(50, 50));
+    object2.translate(MCVector3dF(55, 55));
+
+    QVERIFY(!grid.remove(object1));
+
+    grid.insert(object1);
+    grid.insert(object2);
+    QCOMPARE(grid.getPossibleCollisions().size(), size_t(9)); // The objects share 3x3 cells
+
+    QVERIFY(grid.remove(object1));
+    QVERIFY(!grid.remove(object1));
+    QVERIFY(grid.getPossibleCollisions().empty());
+
+    grid.insert(object1);
+    grid.removeAll();
+    QVERIFY(!grid.remove(object1));
+    QVERIFY(!grid.remove(object2));
+}
+
+void MCBroadPhaseTest::testSweepAndPruneMatchesObjectGrid()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 100, 1, false);
+
+    const float leafSize = 1000.0f / 64;
+    MCObjectGrid objectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+    MCSweepAndPrune sweepAndPrune(0, 0, 1000, 1000);
+
+    std::mt19937 engine(2);
+    auto objects = createObjects(engine, 800, 1000);
+    for (auto && object : objects)
+    {
+        objectGrid.insert(*object);
+        sweepAndPrune.insert(*object);
+    }
+
+    for (int round = 0; round < 20; round++)
+    {
+        // The grid reports all pairs sharing a cell, so filter out the pairs that don't overlap.
+        PairSet expected;
+        for (auto && pair : objectGrid.getPossibleCollisions())
+        {
+            if (bboxesOverlap(*pair.first, *pair.second))
+            {
+                expected.insert(pair);
+            }
+        }
+
+        QVERIFY(expected.size() > 0);
+        QVERIFY(toPairSet(sweepAndPrune.getPossibleCollisions()) == expected);
+
+        for (auto && pair : sweepAndPrune.getSeparatedPairs())
+        {
+            QVERIFY(!bboxesOverlap(*pair.first, *pair.second));
+        }
+
+        const MCBBox<float> bbox(100, 200, 600, 700);
+        QVERIFY(sweepAndPrune.getObjectsWithinBBox(bbox) == objectGrid.getObjectsWithinBBox(bbox));
+
+        // Move some objects by small steps like in a simulation, move some far away and leave some out
+        for (int i = 0; i < 300; i++)
+        {
+            auto && object = objects[engine() % objects.size()];
+            QCOMPARE(sweepAndPrune.remove(*object), objectGrid.remove(*object));
+            if (engine() % 10)
+            {
+                if (engine() % 2)
+                {
+                    object->translate(object->location() + MCVector3dF(static_cast<float>(engine() % 200) / 10 - 10, static_cast<float>(engine() % 200) / 10 - 10));
+                }
+                else
+                {
+                    object->translate(MCVector3dF(static_cast<float>(engine() % 10000) / 10, static_cast<float>(engine() % 10000) / 10));
+                }
+
+                object->rotate(engine() % 360);
+                objectGrid.insert(*object);
+                sweepAndPrune.insert(*object);
+            }
+        }
+    }
+}
+
+void MCBroadPhaseTest::testSweepAndPruneSeparatedPairs()
+{
+    MCWorld world;
+    world.setDimensions(0, 100, 0, 100, 0, 100, 1, false);
+
+    MCSweepAndPrune sweepAndPrune(0, 0, 100, 100);
+
+    MCObject object1(std::make_shared<MCRectShape>(nullptr, 10, 10), "TestObject");
+    MCObject object2(std::make_shared<MCRectShape>(nullptr, 10, 10), "TestObject");
+    object1.translate(MCVector3dF(50, 50));
+    object2.translate(MCVector3dF(55, 55));
+
+    QVERIFY(!sweepAndPrune.remove(object1));
+
+    sweepAndPrune.insert(object1);
+    sweepAndPrune.insert(object2);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+    QVERIFY(sweepAndPrune.getSeparatedPairs().empty());
+
+    // The pair is kept while the objects keep overlapping
+    object2.translate(MCVector3dF(54, 56));
+    sweepAndPrune.insert(object2);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+    QCOMPARE(sweepAndPrune.pairCount(), size_t(1));
+
+    // Touching edges is not an overlap
+    object2.translate(MCVector3dF(60, 50));
+    sweepAndPrune.insert(object2);
+    QVERIFY(sweepAndPrune.getPossibleCollisions().empty());
+    QCOMPARE(sweepAndPrune.getSeparatedPairs().size(), size_t(1));
+
+    object2.translate(MCVector3dF(59, 50));
+    sweepAndPrune.insert(object2);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+    QVERIFY(sweepAndPrune.getSeparatedPairs().empty());
+
+    // Removed objects don't produce separations
+    QVERIFY(sweepAndPrune.remove(object1));
+    QVERIFY(!sweepAndPrune.remove(object1));
+    QVERIFY(sweepAndPrune.getPossibleCollisions().empty());
+    QVERIFY(sweepAndPrune.getSeparatedPairs().empty());
+    QCOMPARE(sweepAndPrune.pairCount(), size_t(0));
+
+    sweepAndPrune.insert(object1);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+
+    sweepAndPrune.removeAll();
+    QVERIFY(!sweepAndPrune.remove(object1));
+    QVERIFY(!sweepAndPrune.remove(object2));
+}
+
+void MCBroadPhaseTest::testSweepAndPruneSkipsRestingPairs()
+{
+    MCWorld world;
+    world.setDimensions(0, 100, 0, 100, 0, 100, 1, false);
+
+    MCSweepAndPrune sweepAndPrune(0, 0, 100, 100);
+
+    MCObject object1(std::make_shared<MCRectShape>(nullptr, 10, 10), "TestObject");
+    MCObject object2(std::make_shared<MCRectShape>(nullptr, 10, 10), "TestObject");
+    object1.translate(MCVector3dF(50, 50));
+    object2.translate(MCVector3dF(55, 55));
+
+    sweepAndPrune.insert(object1);
+    sweepAndPrune.insert(object2);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+
+    object1.physicsComponent().toggleSleep(true);
+    object2.physicsComponent().toggleSleep(true);
+    QVERIFY(sweepAndPrune.getPossibleCollisions().empty());
+
+    // Like a clean cell of the grids, the pair is not tested again until either object moves
+    object2.physicsComponent().toggleSleep(false);
+    QVERIFY(sweepAndPrune.getPossibleCollisions().empty());
+    QCOMPARE(sweepAndPrune.pairCount(), size_t(1));
+
+    object2.translate(MCVector3dF(54, 56));
+    QVERIFY(sweepAndPrune.move(object2));
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+
+    // A re-inserted object is tested again even if it didn't move
+    object2.physicsComponent().toggleSleep(true);
+    QVERIFY(sweepAndPrune.getPossibleCollisions().empty());
+    object1.physicsComponent().toggleSleep(false);
+    QVERIFY(sweepAndPrune.remove(object1));
+    sweepAndPrune.insert(object1);
+    QCOMPARE(sweepAndPrune.getPossibleCollisions().size(), size_t(1));
+
+    object1.physicsComponent().toggleSleep(true);
+}
+
+void MCBroadPhaseTest::testSweepAndPruneViewQueries()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 100, 1, false);
+
+    MCSweepAndPrune sweepAndPrune(0, 0, 1000, 1000);
+
+    std::mt19937 engine(7);
+    auto objects = createObjects(engine, 800, 1000);
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        // Some views are much larger than the shapes, e.g. the trees
+        objects[i]->shape()->setView(std::make_shared<TestView>(i % 50 ? 5 + engine() % 60 : 300));
+        sweepAndPrune.insert(*objects[i]);
+    }
+
+    const auto expectedObjects = [&](const MCBBox<float> & bbox) {
+        MCBroadPhase::ObjectSet result;
+        for (auto && object : objects)
+        {
+            if (object->shape()->view() && bbox.intersects(object->shape()->view()->bbox().translated(MCVector2dF(object->location()))))
+            {
+                result.insert(object.get());
+            }
+        }
+
+        return result;
+    };
+
+    const std::vector<MCBBox<float>> bboxes = { MCBBox<float>(100, 200, 400, 500), MCBBox<float>(700, 0, 1000, 300) };
+    for (int round = 0; round < 10; round++)
+    {
+        // New end points are not added yet on the first round
+        for (auto && bbox : bboxes)
+        {
+            QVERIFY(!expectedObjects(bbox).empty());
+            QVERIFY(sweepAndPrune.getObjectsWithinBBox(bbox) == expectedObjects(bbox));
+        }
+
+        QVERIFY(matchesObjectsWithinBBox(sweepAndPrune, bboxes));
+
+        sweepAndPrune.getPossibleCollisions();
+
+        for (auto && bbox : bboxes)
+        {
+            QVERIFY(sweepAndPrune.getObjectsWithinBBox(bbox) == expectedObjects(bbox));
+        }
+
+        // Queries between the updates must also find the objects that moved since the last sort
+        for (int i = 0; i < 300; i++)
+        {
+            auto && object = objects[engine() % objects.size()];
+            if (engine() % 10)
+            {
+                object->translate(object->location() + MCVector3dF(static_cast<float>(engine() % 200) / 10 - 10, static_cast<float>(engine() % 200) / 10 - 10));
+            }
+            else
+            {
+                object->translate(MCVector3dF(static_cast<float>(engine() % 10000) / 10, static_cast<float>(engine() % 10000) / 10));
+            }
+
+            object->rotate(engine() % 360);
+            sweepAndPrune.move(*object);
+        }
+
+        for (auto && bbox : bboxes)
+        {
+            QVERIFY(sweepAndPrune.getObjectsWithinBBox(bbox) == expectedObjects(bbox));
+        }
+    }
+}
+
+void MCBroadPhaseTest::testGetObjectsWithinBBoxes()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 100, 1, false);
+
+    const float leafSize = 1000.0f / 64;
+    MCObjectGrid objectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+    MCFlatObjectGrid flatObjectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+    MCSweepAndPrune sweepAndPrune(0, 0, 1000, 1000);
+    const std::vector<MCBroadPhase *> broadPhases = { &objectGrid, &flatObjectGrid, &sweepAndPrune };
+
+    std::mt19937 engine(3);
+    auto objects = createObjects(engine, 800, 1000);
+    for (auto && object : objects)
+    {
+        object->shape()->setView(std::make_shared<TestView>(5 + engine() % 60));
+        for (auto && broadPhase : broadPhases)
+        {
+            broadPhase->insert(*object);
+        }
+    }
+
+    QVERIFY(objectGrid.getObjectsWithinBBox(MCBBox<float>(100, 200, 600, 700)).size() > 0);
+
+    // Disjoint, overlapping and identical boxes like the cameras of a split screen
+    const std::vector<std::vector<MCBBox<float>>> bboxSets = {
+        {},
+        { MCBBox<float>(100, 200, 600, 700) },
+        { MCBBox<float>(0, 0, 300, 400), MCBBox<float>(600, 500, 900, 900) },
+        { MCBBox<float>(100, 100, 500, 400), MCBBox<float>(300, 200, 700, 600) },
+        { MCBBox<float>(200, 200, 500, 500), MCBBox<float>(200, 200, 500, 500), MCBBox<float>(-100, -100, 50, 2000) }
+    };
+
+    for (auto && bboxes : bboxSets)
+    {
+        for (auto && broadPhase : broadPhases)
+        {
+            QVERIFY(matchesObjectsWithinBBox(*broadPhase, bboxes));
+        }
+    }
+}
+
+void MCBroadPhaseTest::testMoveMatchesReinsert()
+{
+    MCWorld world;
+    world.setDimensions(0, 1000, 0, 1000, 0, 100, 1, false);
+
+    // The objects cache the index range and the proxy of a single broad phase, so each
+    // implementation is compared against one that caches different data.
+    const float leafSize = 1000.0f / 64;
+    {
+        MCObjectGrid objectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+        MCSweepAndPrune reference(0, 0, 1000, 1000);
+        QVERIFY(moveMatchesReinsert(objectGrid, reference, 4));
+    }
+
+    {
+        MCFlatObjectGrid flatObjectGrid(0, 0, 1000, 1000, leafSize, leafSize);
+        MCObjectGrid reference(0, 0, 1000, 1000, leafSize, leafSize);
+        QVERIFY(moveMatchesReinsert(flatObjectGrid, reference, 5));
+    }
+
+    {
+        MCSweepAndPrune sweepAndPrune(0, 0, 1000, 1000);
+        MCObjectGrid reference(0, 0, 1000, 1000, leafSize, leafSize);
+        QVERIFY(moveMatchesReinsert(sweepAndPrune, reference, 6));
+    }
+}
+
+void MCBroadPhaseTest::testMoveWithinCells()
+{
+    MCWorld world;
+    world.setDimensions(0, 100, 0, 100, 0, 100, 1, false);
+
+    MCObjectGrid objectGrid(0, 0, 100, 100, 10, 10);
+    MCFlatObjectGrid flatObjectGrid(0, 0, 100, 100, 10, 10);
+    for (MCBroadPhase * grid : std::vector<MCBroadPhase *> { &objectGrid, &flatObjectGrid })
+    {
+        MCObject object(std::make_shared<MCRectShape>(nullptr, 2, 2), "TestObject");
+        object.shape()->setView(std::make_shared<TestView>(2));
+        object.translate(MCVector3dF(55, 55));
+
+        QVERIFY(!grid->move(object));
+
+        grid->insert(object);
+        QCOMPARE(grid->mutationCount(), size_t(1));
+
+        // Stays in the same cell
+        object.translate(MCVector3dF(56, 54));
+        QVERIFY(grid->move(object));
+        QCOMPARE(grid->mutationCount(), size_t(1));
+
+        // Leaves one cell and enters another
+        object.translate(MCVector3dF(75, 54));
+        QVERIFY(grid->move(object));
+        QCOMPARE(grid->mutationCount(), size_t(3));
+
+        // Spans two cells
+        object.translate(MCVector3dF(80, 54));
+        QVERIFY(grid->move(object));
+        QCOMPARE(grid->mutationCount(), size_t(4));
+
+        QVERIFY(grid->getObjectsWithinBBox(MCBBox<float>(79, 53, 81, 55)).count(&object));
+
+        QVERIFY(grid->remove(object));
+        QCOMPARE(grid->mutationCount(), size_t(6));
+    }
+}
+
+QTEST_GUILESS_MAIN(MCBroadPhaseTest)
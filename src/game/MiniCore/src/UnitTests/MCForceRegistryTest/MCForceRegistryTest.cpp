@@ -21,9 +21,16 @@
 #include "../../Core/mcobject.hh"
 #include "../../Core/mcworld.hh"
 #include "../../Physics/mcforcegenerator.hh"
+#include "../../Physics/mcdragforcegenerator.hh"
 #include "../../Physics/mcforceregistry.hh"
+#include "../../Physics/mcfrictiongenerator.hh"
+#include "../../Physics/mcgravitygenerator.hh"
+#include "../../Physics/mcphysicscomponent.hh"
+#include "../../Physics/mcspringforcegenerator.hh"
+#include "../../Physics/mcspringforcegenerator2dfast.hh"
 
 #include <memory>
+#include <vector>
 
 class TestForceGenerator : public MCForceGenerator
 {
@@ -51,16 +58,55 @@ public:
 
 unsigned int TestForceGenerator::m_destructorCallCount = 0;
 
+class OrderedForceGenerator : public MCForceGenerator
+{
+public:
+    OrderedForceGenerator(std::vector<int> & updates, int id)
+      : m_updates(updates)
+      , m_id(id)
+    {
+    }
+
+    //! \reimp
+    void updateForce(MCObject &)
+    {
+        m_updates.push_back(m_id);
+    }
+
+private:
+    std::vector<int> & m_updates;
+
+    int m_id;
+};
+
+class ConstantForceGenerator : public MCForceGenerator
+{
+public:
+    ConstantForceGenerator(const MCVector3dF & force)
+      : m_force(force)
+    {
+    }
+
+    //! \reimp
+    void updateForce(MCObject & object)
+    {
+        object.physicsComponent().addForce(m_force);
+    }
+
+private:
+    MCVector3dF m_force;
+};
+
 MCForceRegistryTest::MCForceRegistryTest()
 {
 }
 
 void MCForceRegistryTest::testAddUpdateRemove()
 {
-    MCForceRegistry dut;
+    MCWorld world;
+    auto && dut = world.forceRegistry();
     MCForceGeneratorPtr force(new TestForceGenerator);
     MCObject object("TestObject");
-    MCWorld world;
     dut.addForceGenerator(force, object);
     dut.update();
     QVERIFY(static_cast<TestForceGenerator *>(force.get())->m_updated == false);
@@ -81,8 +127,8 @@ void MCForceRegistryTest::testAddUpdateRemoveMulti()
     {
         std::vector<MCForceGeneratorPtr> forces;
 
-        MCForceRegistry dut;
         MCWorld world;
+        auto && dut = world.forceRegistry();
 
         std::vector<std::unique_ptr<MCObject>> objects;
         for (unsigned int i = 0; i < NUM_OBJECTS; i++)
@@ -115,10 +161,10 @@ void MCForceRegistryTest::testAddUpdateRemoveMulti()
 
 void MCForceRegistryTest::testUpdateWithEnable()
 {
-    MCForceRegistry dut;
+    MCWorld world;
+    auto && dut = world.forceRegistry();
     MCForceGeneratorPtr force(new TestForceGenerator);
     MCObject object("TestObject");
-    MCWorld world;
     dut.addForceGenerator(force, object);
     world.addObject(object);
     dut.update();
@@ -134,10 +180,10 @@ void MCForceRegistryTest::testUpdateWithEnable()
 
 void MCForceRegistryTest::testClear()
 {
-    MCForceRegistry dut;
+    MCWorld world;
+    auto && dut = world.forceRegistry();
     MCForceGeneratorPtr force(new TestForceGenerator);
     MCObject object("TestObject");
-    MCWorld world;
     dut.addForceGenerator(force, object);
     world.addObject(object);
     dut.clear();
@@ -145,4 +191,177 @@ void MCForceRegistryTest::testClear()
     QVERIFY(static_cast<TestForceGenerator *>(force.get())->m_updated == false);
 }
 
+void MCForceRegistryTest::testRemoveForceGenerators()
+{
+    MCWorld world;
+    auto && dut = world.forceRegistry();
+    MCObject object1("TestObject");
+    MCObject object2("TestObject");
+    world.addObject(object1);
+    world.addObject(object2);
+
+    std::vector<MCForceGeneratorPtr> forces;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        forces.push_back(std::make_shared<TestForceGenerator>());
+        dut.addForceGenerator(forces.back(), i % 2 ? object2 : object1);
+    }
+
+    dut.addForceGenerator(forces[0], object1);
+    QCOMPARE(dut.size(), size_t(4));
+
+    dut.removeForceGenerators(object1);
+    QCOMPARE(dut.size(), size_t(2));
+
+    dut.update();
+    for (unsigned int i = 0; i < forces.size(); i++)
+    {
+        QCOMPARE(static_cast<TestForceGenerator *>(forces[i].get())->m_updated, i % 2 == 1);
+    }
+}
+
+void MCForceRegistryTest::testNumericalEquivalence()
+{
+    MCWorld world;
+    world.setDimensions(-1000, 1000, -1000, 1000, -100, 100, 1, false);
+
+    MCObject anchor("Anchor");
+    world.addObject(anchor);
+    anchor.translate(MCVector3dF(10, 20));
+
+    std::vector<std::vector<MCForceGeneratorPtr>> generatorSets = {
+        { std::make_shared<MCFrictionGenerator>(0.5f, 0.25f) },
+        { std::make_shared<MCDragForceGenerator>(0.1f, 0.01f) },
+        { std::make_shared<MCGravityGenerator>(MCVector3dF(0, 0, -9.81f)) },
+        { std::make_shared<MCSpringForceGenerator>(anchor, 2.0f, 5.0f) },
+        { std::make_shared<MCSpringForceGenerator2dFast>(anchor, 2.0f, 5.0f, 1.0f, 10.0f) },
+        { std::make_shared<ConstantForceGenerator>(MCVector3dF(1, 2, 3)) },
+        { std::make_shared<ConstantForceGenerator>(MCVector3dF(1, 2, 3)),
+          std::make_shared<MCDragForceGenerator>(0.1f, 0.01f),
+          std::make_shared<MCFrictionGenerator>(0.5f, 0.25f),
+          std::make_shared<MCSpringForceGenerator>(anchor, 2.0f, 5.0f),
+          std::make_shared<MCDragForceGenerator>(0.2f, 0.02f) }
+    };
+
+    // The objects updated by the registry and the reference objects updated directly
+    auto && dut = world.forceRegistry();
+    std::vector<std::unique_ptr<MCObject>> objects;
+    std::vector<std::unique_ptr<MCObject>> referenceObjects;
+    for (size_t i = 0; i < generatorSets.size(); i++)
+    {
+        for (auto objectVector : { &objects, &referenceObjects })
+        {
+            auto object = std::make_unique<MCObject>("TestObject");
+            world.addObject(*object);
+            object->translate(MCVector3dF(1.5f * i, -0.5f * i));
+            object->physicsComponent().setMass(1.0f + i);
+            object->physicsComponent().setVelocity(MCVector3dF(0.3f * i, 1.7f, 0.1f));
+            object->physicsComponent().setAngularVelocity(0.7f);
+            object->physicsComponent().preventSleeping(true);
+            objectVector->push_back(std::move(object));
+        }
+
+        for (auto && generator : generatorSets[i])
+        {
+            dut.addForceGenerator(generator, *objects[i]);
+        }
+    }
+
+    for (int step = 0; step < 5; step++)
+    {
+        dut.update();
+
+        for (size_t i = 0; i < generatorSets.size(); i++)
+        {
+            for (auto && generator : generatorSets[i])
+            {
+                generator->updateForce(*referenceObjects[i]);
+            }
+
+            objects[i]->physicsComponent().stepTime(10);
+            referenceObjects[i]->physicsComponent().stepTime(10);
+        }
+    }
+
+    // The results must be identical, not just close
+    for (size_t i = 0; i < generatorSets.size(); i++)
+    {
+        const MCVector3dF velocity = objects[i]->physicsComponent().velocity();
+        const MCVector3dF referenceVelocity = referenceObjects[i]->physicsComponent().velocity();
+        QVERIFY(velocity.i() == referenceVelocity.i());
+        QVERIFY(velocity.j() == referenceVelocity.j());
+        QVERIFY(velocity.k() == referenceVelocity.k());
+        QVERIFY(objects[i]->physicsComponent().angularVelocity() == referenceObjects[i]->physicsComponent().angularVelocity());
+    }
+}
+
+void MCForceRegistryTest::testOrderKeptOverIntegrationChanges()
+{
+    MCWorld world;
+    auto && dut = world.forceRegistry();
+    MCObject object1("TestObject");
+    MCObject object2("TestObject");
+    MCObject object3("TestObject");
+    world.addObject(object1);
+    world.addObject(object2);
+    world.addObject(object3);
+
+    const std::vector<MCObject *> objects = { &object1, &object2, &object3 };
+    std::vector<std::vector<int>> updates(objects.size());
+    for (int i = 0; i < 9; i++)
+    {
+        dut.addForceGenerator(std::make_shared<OrderedForceGenerator>(updates[i % 3], i), *objects[i % 3]);
+    }
+
+    const auto clearUpdates = [&updates] {
+        for (auto && objectUpdates : updates)
+        {
+            objectUpdates.clear();
+        }
+    };
+
+    const std::vector<std::vector<int>> allUpdates = { { 0, 3, 6 }, { 1, 4, 7 }, { 2, 5, 8 } };
+    dut.update();
+    QCOMPARE(updates, allUpdates);
+
+    // The pairs of an object out of the integration are not updated
+    clearUpdates();
+    world.removeObjectFromIntegration(object1);
+    dut.update();
+    QCOMPARE(updates, std::vector<std::vector<int>>({ {}, { 1, 4, 7 }, { 2, 5, 8 } }));
+
+    // ..and the pairs of each object are still updated in the order of registration
+    clearUpdates();
+    world.restoreObjectToIntegration(object1);
+    dut.update();
+    QCOMPARE(updates, allUpdates);
+
+    // Also after other objects have been moved in place of a removed one
+    clearUpdates();
+    dut.removeForceGenerators(object1);
+    dut.update();
+    QCOMPARE(updates, std::vector<std::vector<int>>({ {}, { 1, 4, 7 }, { 2, 5, 8 } }));
+    QCOMPARE(dut.size(), size_t(6));
+}
+
+void MCForceRegistryTest::testFrictionGeneratorAddedOnce()
+{
+    MCWorld world;
+    auto && dut = world.forceRegistry();
+    MCObject object("TestObject");
+    object.physicsComponent().setXYFriction(0.5f);
+
+    // Re-adding an object must not pile up friction generators
+    world.addObject(object);
+    QCOMPARE(dut.size(), size_t(1));
+    world.removeObjectNow(object);
+    QCOMPARE(dut.size(), size_t(0));
+    world.addObject(object);
+    world.addObject(object);
+    QCOMPARE(dut.size(), size_t(1));
+
+    world.clear();
+    QCOMPARE(dut.size(), size_t(0));
+}
+
 QTEST_GUILESS_MAIN(MCForceRegistryTest)
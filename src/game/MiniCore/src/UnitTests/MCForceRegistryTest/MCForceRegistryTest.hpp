@@ -35,4 +35,12 @@ private slots:
     void testUpdateWithEnable();
 
     void testClear();
+
+    void testRemoveForceGenerators();
+
+    void testNumericalEquivalence();
+
+    void testOrderKeptOverIntegrationChanges();
+
+    void testFrictionGeneratorAddedOnce();
 };
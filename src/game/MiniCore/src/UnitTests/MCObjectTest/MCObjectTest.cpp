@@ -30,6 +30,7 @@
 #include "../../Physics/mcrectshape.hh"
 
 #include <cmath>
+#include <functional>
 
 // Default damping factors defined in MCPhysicsComponent
 static const float LINEAR_DAMPING = 0.999f;
@@ -58,6 +59,24 @@ public:
     bool m_timerEventReceived;
 };
 
+class UpdatedObject : public MCObject
+{
+public:
+    UpdatedObject(std::function<void()> update)
+      : MCObject("TEST_OBJECT")
+      , m_update(update)
+    {
+    }
+
+    virtual void onStepTime(int) override
+    {
+        m_update();
+    }
+
+private:
+    std::function<void()> m_update;
+};
+
 static void vector3dCompare(MCVector3dF vector1, MCVector3dF vector2)
 {
     QVERIFY(qFuzzyCompare(vector1.i(), vector2.i()));
@@ -560,4 +579,33 @@ void MCObjectTest::testVelocityIntegration()
     vector3dCompare(object.location(), location + velocity * LINEAR_DAMPING);
 }
 
+void MCObjectTest::testStepOrder()
+{
+    MCWorld world;
+    world.setDimensions(0, 1024, 0, 768, 0, 100, 1);
+
+    MCObject target("TestObject");
+    MCVector3dF targetLocation;
+    UpdatedObject updater([&] {
+        targetLocation = target.location();
+        target.physicsComponent().setVelocity(MCVector3dF(1, 0, 0));
+    });
+
+    // The velocity is set before adding to the world
+    MCObject object("TestObject");
+    object.physicsComponent().setVelocity(MCVector3dF(0, 2, 0));
+
+    updater.addToWorld();
+    target.translate(MCVector3dF(100, 100));
+    target.addToWorld();
+    object.addToWorld();
+
+    world.stepTime(1);
+
+    // Updates of objects are interleaved with the integration in the order of the objects
+    vector3dCompare(targetLocation, MCVector3dF(100, 100, 0));
+    vector3dCompare(target.location(), MCVector3dF(100 + LINEAR_DAMPING, 100, 0));
+    vector3dCompare(object.location(), MCVector3dF(0, 2 * LINEAR_DAMPING, 0));
+}
+
 QTEST_GUILESS_MAIN(MCObjectTest)
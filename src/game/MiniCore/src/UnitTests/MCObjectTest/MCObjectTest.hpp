@@ -58,6 +58,8 @@ private slots:
 
     void testRotate();
 
+    void testStepOrder();
+
     void testTimerEvent();
 
     void testTranslate();
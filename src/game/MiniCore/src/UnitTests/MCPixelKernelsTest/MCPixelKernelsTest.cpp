@@ -0,0 +1,320 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "MCPixelKernelsTest.hpp"
+
+#include "../../Asset/mcpixelkernels.hh"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Image
+{
+    Image(int width, int height)
+      : width(width)
+      , height(height)
+      , pixels(static_cast<size_t>(width * height))
+    {
+    }
+
+    uint32_t pixel(int i, int j) const
+    {
+        return pixels[static_cast<size_t>(j * width + i)];
+    }
+
+    void setPixel(int i, int j, uint32_t pixel)
+    {
+        pixels[static_cast<size_t>(j * width + i)] = pixel;
+    }
+
+    int width;
+
+    int height;
+
+    std::vector<uint32_t> pixels;
+};
+
+// The reference implementation is the per-pixel code MCSurfaceManager used before the kernels.
+
+bool colorMatch(int val1, int val2, int threshold)
+{
+    return (val1 >= val2 - threshold) && (val1 <= val2 + threshold);
+}
+
+void referenceAlphaClamp(Image & textureImage, unsigned int a)
+{
+    for (int i = 0; i < textureImage.width; i++)
+    {
+        for (int j = 0; j < textureImage.height; j++)
+        {
+            if (((textureImage.pixel(i, j) >> 24) & 0x000000ff) < a)
+            {
+                textureImage.setPixel(i, j, 0x00000000);
+            }
+        }
+    }
+}
+
+void referenceColorKey(Image & textureImage, unsigned int r, unsigned int g, unsigned int b)
+{
+    for (int i = 0; i < textureImage.width; i++)
+    {
+        for (int j = 0; j < textureImage.height; j++)
+        {
+            if (colorMatch(textureImage.pixel(i, j) & 0x000000ff, b, 2) && colorMatch((textureImage.pixel(i, j) & 0x0000ff00) >> 8, g, 2) && colorMatch((textureImage.pixel(i, j) & 0x00ff0000) >> 16, r, 2))
+            {
+                textureImage.setPixel(i, j, 0x00000000);
+            }
+            else
+            {
+                textureImage.setPixel(i, j, textureImage.pixel(i, j) | 0xff000000);
+            }
+        }
+    }
+}
+
+//! Mirror + swizzle to GL_RGBA. Returns the bytes as they were in memory on a little-endian machine.
+std::vector<unsigned char> referenceConvertToGLFormat(const Image & img)
+{
+    std::vector<unsigned char> result;
+    for (int j = img.height - 1; j >= 0; j--)
+    {
+        for (int i = 0; i < img.width; i++)
+        {
+            const uint32_t p = img.pixel(i, j);
+            const uint32_t q = ((p << 16) & 0xff0000) | ((p >> 16) & 0xff) | (p & 0xff00ff00);
+            for (int k = 0; k < 4; k++)
+            {
+                result.push_back(static_cast<unsigned char>(q >> (8 * k)));
+            }
+        }
+    }
+
+    return result;
+}
+
+int referenceAverageColor(const Image & image)
+{
+    std::map<int, int> colorCounts;
+    const int scale = 8;
+    for (int i = 0; i < image.width; i++)
+    {
+        for (int j = 0; j < image.height; j++)
+        {
+            if (((image.pixel(i, j) & 0xff000000) >> 24) > 128)
+            {
+                const int r = ((image.pixel(i, j) & 0x00ff0000) >> 16) / scale;
+                const int g = ((image.pixel(i, j) & 0x0000ff00) >> 8) / scale;
+                const int b = ((image.pixel(i, j) & 0x000000ff)) / scale;
+                colorCounts[(r << 16) + (g << 8) + b]++;
+            }
+        }
+    }
+    int bestColor = 0;
+    int bestCount = 0;
+    for (auto && color : colorCounts)
+    {
+        if (color.second > bestCount)
+        {
+            bestCount = color.second;
+            bestColor = color.first;
+        }
+    }
+    return bestColor;
+}
+
+//! Random pixels. Every third pixel is close to the given color to hit the color key.
+Image createImage(int width, int height, uint32_t nearColor, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<uint32_t> pixel;
+    std::uniform_int_distribution<int> offset(-3, 3);
+
+    Image image(width, height);
+    for (auto && p : image.pixels)
+    {
+        p = pixel(engine);
+        if (pixel(engine) % 3 == 0)
+        {
+            uint32_t nearPixel = p & 0xff000000;
+            for (int shift = 0; shift < 24; shift += 8)
+            {
+                const int value = std::clamp(static_cast<int>((nearColor >> shift) & 0xff) + offset(engine), 0, 255);
+                nearPixel |= static_cast<uint32_t>(value) << shift;
+            }
+
+            p = nearPixel;
+        }
+    }
+
+    return image;
+}
+
+std::vector<MCPixelKernels::Implementation> supportedImplementations()
+{
+    std::vector<MCPixelKernels::Implementation> implementations;
+    for (auto && implementation : { MCPixelKernels::Implementation::Scalar, MCPixelKernels::Implementation::SSE2, MCPixelKernels::Implementation::NEON })
+    {
+        if (MCPixelKernels::isSupported(implementation))
+        {
+            implementations.push_back(implementation);
+        }
+    }
+
+    return implementations;
+}
+
+//! Test all supported implementations and widths that leave a tail for the SIMD loops.
+bool textureMatchesReference(const MCPixelKernels::TextureOptions & options, bool alphaClamp, bool colorKey)
+{
+    const auto original = MCPixelKernels::implementation();
+    bool matches = true;
+    for (auto && implementation : supportedImplementations())
+    {
+        MCPixelKernels::setImplementation(implementation);
+
+        for (int width : { 1, 3, 4, 15, 16, 17, 33, 64 })
+        {
+            Image image = createImage(width, 7, (options.colorKeyR << 16) | (options.colorKeyG << 8) | options.colorKeyB, static_cast<unsigned int>(width));
+
+            std::vector<unsigned char> result(image.pixels.size() * 4);
+            for (int j = 0; j < image.height; j++)
+            {
+                MCPixelKernels::textureRow(&image.pixels[static_cast<size_t>((image.height - 1 - j) * width)], &result[static_cast<size_t>(j * width * 4)], static_cast<size_t>(width), options);
+            }
+
+            if (alphaClamp)
+            {
+                referenceAlphaClamp(image, options.alphaClamp);
+            }
+
+            if (colorKey)
+            {
+                referenceColorKey(image, options.colorKeyR, options.colorKeyG, options.colorKeyB);
+            }
+
+            matches = matches && result == referenceConvertToGLFormat(image);
+        }
+    }
+
+    MCPixelKernels::setImplementation(original);
+    return matches;
+}
+
+} // namespace
+
+MCPixelKernelsTest::MCPixelKernelsTest() = default;
+
+void MCPixelKernelsTest::testTextureRowNoOptions()
+{
+    QVERIFY(MCPixelKernels::isSupported(MCPixelKernels::Implementation::Scalar));
+    QVERIFY(textureMatchesReference({}, false, false));
+}
+
+void MCPixelKernelsTest::testTextureRowAlphaClamp()
+{
+    for (unsigned int alphaClamp : { 0u, 1u, 127u, 128u, 254u, 255u, 256u, 300u })
+    {
+        MCPixelKernels::TextureOptions options;
+        options.alphaClamp = alphaClamp;
+        QVERIFY(textureMatchesReference(options, true, false));
+    }
+}
+
+void MCPixelKernelsTest::testTextureRowColorKey()
+{
+    for (unsigned int key : { 0u, 1u, 2u, 100u, 253u, 254u, 255u, 256u, 257u, 258u, 1000u })
+    {
+        MCPixelKernels::TextureOptions options;
+        options.colorKeySet = true;
+        options.colorKeyR = key;
+        options.colorKeyG = 255 - key % 256;
+        options.colorKeyB = key / 2;
+        QVERIFY(textureMatchesReference(options, false, true));
+    }
+}
+
+void MCPixelKernelsTest::testTextureRowAlphaClampAndColorKey()
+{
+    // The clamp makes pixels black, which the color key then makes opaque unless the key is black
+    for (unsigned int key : { 0u, 1u, 128u, 255u })
+    {
+        MCPixelKernels::TextureOptions options;
+        options.alphaClamp = 128;
+        options.colorKeySet = true;
+        options.colorKeyR = key;
+        options.colorKeyG = key;
+        options.colorKeyB = key;
+        QVERIFY(textureMatchesReference(options, true, true));
+    }
+}
+
+void MCPixelKernelsTest::testAverageColor()
+{
+    const auto original = MCPixelKernels::implementation();
+    for (auto && implementation : supportedImplementations())
+    {
+        MCPixelKernels::setImplementation(implementation);
+
+        for (int width : { 1, 3, 17, 64 })
+        {
+            // Few colors so that the counts differ
+            Image image = createImage(width, 9, 0x406080, static_cast<unsigned int>(width));
+            for (auto && pixel : image.pixels)
+            {
+                pixel &= 0xffe0e0e0;
+            }
+
+            std::vector<uint32_t> histogram(MCPixelKernels::HISTOGRAM_SIZE, 0);
+            for (int j = 0; j < image.height; j++)
+            {
+                MCPixelKernels::addToHistogram(&image.pixels[static_cast<size_t>(j * width)], static_cast<size_t>(width), histogram.data());
+            }
+
+            const auto peak = static_cast<int>(MCPixelKernels::histogramPeak(histogram.data()));
+            const int expected = referenceAverageColor(image);
+            QCOMPARE(((peak >> 10) << 16) | (((peak >> 5) & 0x1f) << 8) | (peak & 0x1f), expected);
+        }
+
+        // Only transparent pixels
+        Image image(5, 5);
+        std::vector<uint32_t> histogram(MCPixelKernels::HISTOGRAM_SIZE, 0);
+        MCPixelKernels::addToHistogram(image.pixels.data(), image.pixels.size(), histogram.data());
+        QCOMPARE(MCPixelKernels::histogramPeak(histogram.data()), size_t(0));
+        QCOMPARE(referenceAverageColor(image), 0);
+    }
+
+    MCPixelKernels::setImplementation(original);
+}
+
+void MCPixelKernelsTest::testHistogramPeakTie()
+{
+    std::vector<uint32_t> histogram(MCPixelKernels::HISTOGRAM_SIZE, 0);
+    histogram[100] = 3;
+    histogram[50] = 3;
+    histogram[200] = 2;
+    QCOMPARE(MCPixelKernels::histogramPeak(histogram.data()), size_t(50));
+}
+
+QTEST_GUILESS_MAIN(MCPixelKernelsTest)
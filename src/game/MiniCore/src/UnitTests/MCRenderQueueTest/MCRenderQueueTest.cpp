@@ -0,0 +1,234 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "MCRenderQueueTest.hpp"
+
+#include "../../Core/mcobject.hh"
+#include "../../Graphics/mcrenderqueue.hh"
+
+#include <memory>
+#include <vector>
+
+MCRenderQueueTest::MCRenderQueueTest()
+{
+}
+
+void MCRenderQueueTest::testAdd()
+{
+    MCRenderQueue queue;
+    MCObject object1("TEST_OBJECT");
+    MCObject object2("TEST_OBJECT");
+    MCObject object3("TEST_OBJECT");
+
+    queue.add(1, object1, 2);
+    queue.add(2, object2, 1);
+    queue.add(1, object3, 3);
+
+    QCOMPARE(queue.size(), size_t(2));
+
+    auto batch = queue.begin();
+    QCOMPARE(batch->objectViewId, 1);
+    QCOMPARE(batch->priority, 3.0f);
+    QCOMPARE(batch->objects.size(), size_t(2));
+    QCOMPARE(batch->objects[0], &object1);
+    QCOMPARE(batch->objects[1], &object3);
+
+    batch++;
+    QCOMPARE(batch->objectViewId, 2);
+    QCOMPARE(batch->priority, 1.0f);
+    QCOMPARE(batch->objects.size(), size_t(1));
+
+    batch++;
+    QVERIFY(batch == queue.end());
+}
+
+void MCRenderQueueTest::testClear()
+{
+    MCRenderQueue queue;
+    MCObject object1("TEST_OBJECT");
+    MCObject object2("TEST_OBJECT");
+
+    queue.add(1, object1, 0);
+    queue.add(2, object2, 0);
+    queue.sort();
+    queue.clear();
+
+    QCOMPARE(queue.size(), size_t(0));
+    QVERIFY(queue.begin() == queue.end());
+
+    // Only the batches added after clear() are iterated
+    queue.add(2, object2, 5);
+    QCOMPARE(queue.size(), size_t(1));
+    QCOMPARE(queue.begin()->objectViewId, 2);
+    QCOMPARE(queue.begin()->priority, 5.0f);
+    QCOMPARE(queue.begin()->objects.size(), size_t(1));
+    QVERIFY(queue.begin()->objects.capacity() >= 1);
+}
+
+void MCRenderQueueTest::testSort()
+{
+    MCRenderQueue queue;
+    MCObject object("TEST_OBJECT");
+
+    const std::vector<float> priorities = { 3.5f, -1.0f, 0.0f, 1000.0f, -0.5f, 2.0f, -200.0f };
+    for (size_t i = 0; i < priorities.size(); i++)
+    {
+        queue.add(static_cast<int>(i), object, priorities[i]);
+    }
+
+    queue.sort();
+
+    QCOMPARE(queue.size(), priorities.size());
+
+    float previous = -1000.0f;
+    for (auto && batch : queue)
+    {
+        QVERIFY(batch.priority >= previous);
+        QCOMPARE(batch.priority, priorities[static_cast<size_t>(batch.objectViewId)]);
+        previous = batch.priority;
+    }
+
+    // Batches must be found by their view id after sorting
+    queue.add(3, object, 0);
+    for (auto && batch : queue)
+    {
+        QCOMPARE(batch.objects.size(), size_t(batch.objectViewId == 3 ? 2 : 1));
+    }
+}
+
+void MCRenderQueueTest::testSortKey()
+{
+    QVERIFY(MCRenderQueue::sortKey(-2.0f, 0) < MCRenderQueue::sortKey(-1.0f, 0));
+    QVERIFY(MCRenderQueue::sortKey(-1.0f, 0) < MCRenderQueue::sortKey(0.0f, 0));
+    QVERIFY(MCRenderQueue::sortKey(0.0f, 0) < MCRenderQueue::sortKey(0.5f, 0));
+    QVERIFY(MCRenderQueue::sortKey(0.5f, 0) < MCRenderQueue::sortKey(100.0f, 0));
+    QVERIFY(MCRenderQueue::sortKey(1.0f, 0) < MCRenderQueue::sortKey(1.0f, 1));
+    QCOMPARE(MCRenderQueue::sortKey(1.0f, 7) & 0xffffffff, uint64_t(7));
+}
+
+void MCRenderQueueTest::testSortStable()
+{
+    MCRenderQueue queue;
+    MCObject object("TEST_OBJECT");
+
+    // Equal priorities must stay in the order of addition also over frames
+    for (int frame = 0; frame < 3; frame++)
+    {
+        queue.clear();
+        queue.add(5, object, 1);
+        queue.add(3, object, 0);
+        queue.add(4, object, 1);
+        queue.add(1, object, 0);
+        queue.sort();
+
+        std::vector<int> ids;
+        for (auto && batch : queue)
+        {
+            ids.push_back(batch.objectViewId);
+        }
+
+        QVERIFY(ids == std::vector<int>({ 3, 1, 5, 4 }));
+    }
+}
+
+void MCRenderQueueTest::testSortGroups()
+{
+    MCRenderQueue queue;
+    MCObject object("TEST_OBJECT");
+
+    // Equal priorities are gathered by group in the order of the first batch of each group
+    queue.add(1, object, 0, 10);
+    queue.add(2, object, 0, 20);
+    queue.add(3, object, 0, 10);
+    queue.add(4, object, -1, 20);
+    queue.add(5, object, 0, 20);
+    queue.add(6, object, 0, 30);
+    queue.sort();
+
+    std::vector<int> ids;
+    for (auto && batch : queue)
+    {
+        ids.push_back(batch.objectViewId);
+    }
+
+    QVERIFY(ids == std::vector<int>({ 4, 1, 3, 2, 5, 6 }));
+}
+
+void MCRenderQueueTest::testSortManyBatches()
+{
+    MCRenderQueue queue;
+    MCObject object("TEST_OBJECT");
+
+    // More batches than fit in the 16-bit index of a sort key
+    const int batchCount = 70000;
+    for (int i = 0; i < batchCount; i++)
+    {
+        queue.add(i, object, static_cast<float>(2 - i % 3), static_cast<unsigned int>(i % 2));
+    }
+
+    queue.sort();
+
+    QCOMPARE(queue.size(), size_t(batchCount));
+
+    // Equal priorities are gathered by group and keep the order of addition
+    auto previous = queue.begin();
+    for (auto batch = previous + 1; batch != queue.end(); batch++)
+    {
+        QVERIFY(batch->priority >= previous->priority);
+        if (batch->priority == previous->priority)
+        {
+            QVERIFY(batch->group >= previous->group);
+            if (batch->group == previous->group)
+            {
+                QVERIFY(batch->objectViewId > previous->objectViewId);
+            }
+        }
+
+        previous = batch;
+    }
+}
+
+void MCRenderQueueTest::testBenchmark()
+{
+    // A typical frame: a few thousand objects spread over some tens of views
+    const size_t objectCount = 2000;
+    const int viewCount = 64;
+
+    std::vector<std::unique_ptr<MCObject>> objects;
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        objects.push_back(std::make_unique<MCObject>("TEST_OBJECT"));
+    }
+
+    MCRenderQueue queue;
+    QBENCHMARK
+    {
+        queue.clear();
+        for (size_t i = 0; i < objectCount; i++)
+        {
+            queue.add(static_cast<int>(i * 7919) % viewCount, *objects[i], static_cast<float>(i % 10));
+        }
+
+        queue.sort();
+    }
+
+    QCOMPARE(queue.size(), size_t(viewCount));
+}
+
+QTEST_GUILESS_MAIN(MCRenderQueueTest)
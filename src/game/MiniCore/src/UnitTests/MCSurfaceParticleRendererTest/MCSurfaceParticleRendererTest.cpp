@@ -0,0 +1,113 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+#include "MCSurfaceParticleRendererTest.hpp"
+
+#include "../../Core/mctrigonom.hh"
+#include "../../Core/mcworld.hh"
+#include "../../Graphics/mccamera.hh"
+#include "../../Graphics/mcsurfaceparticle.hh"
+#include "../../Graphics/mcsurfaceparticlerendererinstanced.hh"
+#include "../../Physics/mcshape.hh"
+
+using Instance = MCSurfaceParticleRendererInstanced::Instance;
+
+MCSurfaceParticleRendererTest::MCSurfaceParticleRendererTest()
+{
+}
+
+void MCSurfaceParticleRendererTest::testPackInstance()
+{
+    MCWorld world;
+    MCSurfaceParticle particle("TEST_PARTICLE", nullptr);
+    particle.init(MCVector3dF(10, 20, 30), 5, 100);
+    particle.rotate(90);
+    particle.setColor(MCGLColor(1.0f, 0.5f, 0.0f, 0.25f));
+
+    const Instance instance = MCSurfaceParticleRendererInstanced::packInstance(particle, nullptr, false);
+    QCOMPARE(instance.x, 10.0f);
+    QCOMPARE(instance.y, 20.0f);
+    QCOMPARE(instance.z, 30.0f);
+    QCOMPARE(instance.angle, MCTrigonom::degToRad(90));
+    QCOMPARE(instance.radius, 5.0f);
+    QCOMPARE(instance.scale, 1.0f);
+    QCOMPARE(instance.animationStyle, 0.0f);
+    QCOMPARE(static_cast<int>(instance.color[0]), 255);
+    QCOMPARE(static_cast<int>(instance.color[1]), 128);
+    QCOMPARE(static_cast<int>(instance.color[2]), 0);
+    QCOMPARE(static_cast<int>(instance.color[3]), 64);
+}
+
+void MCSurfaceParticleRendererTest::testPackInstanceAnimation()
+{
+    MCWorld world;
+    MCSurfaceParticle particle("TEST_PARTICLE", nullptr);
+    particle.init(MCVector3dF(0, 0, 0), 8, 100);
+    particle.setAnimationStyle(MCParticle::AnimationStyle::FadeOutAndExpand);
+    particle.onStepTime(25);
+
+    // The vertex shader applies the scale, so the values are passed as is
+    const Instance instance = MCSurfaceParticleRendererInstanced::packInstance(particle, nullptr, false);
+    QCOMPARE(instance.radius, particle.radius());
+    QCOMPARE(instance.scale, 0.75f);
+    QCOMPARE(instance.animationStyle, static_cast<float>(MCParticle::AnimationStyle::FadeOutAndExpand));
+}
+
+void MCSurfaceParticleRendererTest::testPackInstanceCamera()
+{
+    MCWorld world;
+    MCSurfaceParticle particle("TEST_PARTICLE", nullptr);
+    particle.init(MCVector3dF(150, 250, 1), 1, 100);
+
+    MCCamera camera(100, 100, 150, 250, 1000, 1000);
+
+    const Instance instance = MCSurfaceParticleRendererInstanced::packInstance(particle, &camera, false);
+    QCOMPARE(instance.x, 50.0f);
+    QCOMPARE(instance.y, 50.0f);
+    QCOMPARE(instance.z, 1.0f);
+}
+
+void MCSurfaceParticleRendererTest::testPackInstanceColorClamping()
+{
+    MCWorld world;
+    MCSurfaceParticle particle("TEST_PARTICLE", nullptr);
+    particle.init(MCVector3dF(0, 0, 0), 1, 100);
+    particle.setColor(MCGLColor(2.0f, -1.0f, 1.0f, 0.0f));
+
+    const Instance instance = MCSurfaceParticleRendererInstanced::packInstance(particle, nullptr, false);
+    QCOMPARE(static_cast<int>(instance.color[0]), 255);
+    QCOMPARE(static_cast<int>(instance.color[1]), 0);
+    QCOMPARE(static_cast<int>(instance.color[2]), 255);
+    QCOMPARE(static_cast<int>(instance.color[3]), 0);
+}
+
+void MCSurfaceParticleRendererTest::testPackInstanceShadow()
+{
+    MCWorld world;
+    MCSurfaceParticle particle("TEST_PARTICLE", nullptr);
+    particle.init(MCVector3dF(10, 20, 30), 1, 100);
+    particle.shape()->setShadowOffset(MCVector3dF(2, -3, 1));
+
+    const Instance instance = MCSurfaceParticleRendererInstanced::packInstance(particle, nullptr, true);
+    QCOMPARE(instance.x, 12.0f);
+    QCOMPARE(instance.y, 17.0f);
+    QCOMPARE(instance.z, 1.0f);
+}
+
+QTEST_GUILESS_MAIN(MCSurfaceParticleRendererTest)
@@ -0,0 +1,196 @@
+// This file belongs to the "MiniCore" game engine.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+// MA  02110-1301, USA.
+//
+
+
+#include "MCTextureAtlasTest.hpp"
+
+#include "../../Asset/mctextureatlas.hh"
+#include "../../Graphics/mcgltexcoord.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+bool overlaps(const MCTextureAtlas::Rect & a, const MCTextureAtlas::Rect & b, int gap)
+{
+    return a.x < b.x + b.width + gap && b.x < a.x + a.width + gap && a.y < b.y + b.height + gap && b.y < a.y + a.height + gap;
+}
+
+bool isValidLayout(const MCTextureAtlas & atlas, const std::vector<MCTextureAtlas::Rect> & rects)
+{
+    for (size_t i = 0; i < rects.size(); i++)
+    {
+        auto && rect = rects[i];
+        if (rect.x < atlas.padding() || rect.y < atlas.padding() || //
+            rect.x + rect.width + atlas.padding() > atlas.width() || rect.y + rect.height + atlas.padding() > atlas.height())
+        {
+            return false;
+        }
+
+        for (size_t j = i + 1; j < rects.size(); j++)
+        {
+            if (overlaps(rect, rects[j], 2 * atlas.padding()))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+MCTextureAtlasTest::MCTextureAtlasTest()
+{
+}
+
+void MCTextureAtlasTest::testInsert()
+{
+    MCTextureAtlas atlas(128, 128);
+    std::vector<MCTextureAtlas::Rect> rects;
+    for (auto && size : std::vector<std::pair<int, int>> { { 64, 32 }, { 32, 32 }, { 16, 64 }, { 128, 16 }, { 8, 8 } })
+    {
+        MCTextureAtlas::Rect rect;
+        QVERIFY(atlas.insert(size.first, size.second, rect));
+        QCOMPARE(rect.width, size.first);
+        QCOMPARE(rect.height, size.second);
+        rects.push_back(rect);
+    }
+
+    QCOMPARE(atlas.count(), 5);
+    QVERIFY(isValidLayout(atlas, rects));
+
+    // The first one goes to the bottom-left corner, i.e. to the origin of the image
+    QCOMPARE(rects[0].x, 0);
+    QCOMPARE(rects[0].y, 0);
+}
+
+void MCTextureAtlasTest::testInsertFull()
+{
+    MCTextureAtlas atlas(64, 64);
+    MCTextureAtlas::Rect rect;
+
+    QVERIFY(!atlas.insert(65, 1, rect));
+    QVERIFY(!atlas.insert(1, 65, rect));
+    QCOMPARE(atlas.count(), 0);
+
+    QVERIFY(atlas.insert(64, 48, rect));
+    QVERIFY(!atlas.insert(32, 32, rect));
+
+    // A failed insert doesn't change the layout
+    QVERIFY(atlas.insert(64, 16, rect));
+    QCOMPARE(rect.y, 48);
+    QCOMPARE(atlas.occupancy(), 1.0f);
+}
+
+void MCTextureAtlasTest::testPadding()
+{
+    MCTextureAtlas atlas(256, 256, 2);
+    std::vector<MCTextureAtlas::Rect> rects;
+    MCTextureAtlas::Rect rect;
+    while (atlas.insert(30, 20, rect))
+    {
+        rects.push_back(rect);
+    }
+
+    // 34 x 24 pixels are reserved for each
+    QCOMPARE(rects.size(), size_t((256 / 34) * (256 / 24)));
+    QVERIFY(isValidLayout(atlas, rects));
+}
+
+void MCTextureAtlasTest::testDensityEqualSizes()
+{
+    MCTextureAtlas atlas(256, 256);
+    MCTextureAtlas::Rect rect;
+    for (int i = 0; i < 256; i++)
+    {
+        QVERIFY(atlas.insert(16, 16, rect));
+    }
+
+    QVERIFY(!atlas.insert(1, 1, rect));
+    QCOMPARE(atlas.occupancy(), 1.0f);
+}
+
+void MCTextureAtlasTest::testDensityMixedSizes()
+{
+    // Sizes like those of typical sprites sorted by decreasing height
+    std::vector<std::pair<int, int>> sizes;
+    unsigned int seed = 1;
+    for (int i = 0; i < 200; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        const int w = 8 + static_cast<int>((seed >> 16) % 57);
+        seed = seed * 1103515245 + 12345;
+        const int h = 8 + static_cast<int>((seed >> 16) % 57);
+        sizes.push_back({ w, h });
+    }
+
+    std::sort(sizes.begin(), sizes.end(), [](auto && a, auto && b) {
+        return a.second > b.second;
+    });
+
+    MCTextureAtlas atlas(512, 512, 1);
+    std::vector<MCTextureAtlas::Rect> rects;
+    for (auto && size : sizes)
+    {
+        MCTextureAtlas::Rect rect;
+        if (atlas.insert(size.first, size.second, rect))
+        {
+            rects.push_back(rect);
+        }
+    }
+
+    QVERIFY(isValidLayout(atlas, rects));
+    QVERIFY(atlas.occupancy() > 0.8f);
+}
+
+void MCTextureAtlasTest::testTexCoords()
+{
+    MCTextureAtlas atlas(256, 128);
+    MCTextureAtlas::Rect rect;
+    rect.x = 16;
+    rect.y = 32;
+    rect.width = 64;
+    rect.height = 16;
+
+    MCGLTexCoord texCoords[4];
+    atlas.texCoords(rect, texCoords);
+
+    // Bottom-left, top-left, top-right, bottom-right of the flipped image
+    QCOMPARE(texCoords[0].u, 16.0f / 256);
+    QCOMPARE(texCoords[0].v, 1.0f - 48.0f / 128);
+    QCOMPARE(texCoords[1].u, 16.0f / 256);
+    QCOMPARE(texCoords[1].v, 1.0f - 32.0f / 128);
+    QCOMPARE(texCoords[2].u, 80.0f / 256);
+    QCOMPARE(texCoords[2].v, 1.0f - 32.0f / 128);
+    QCOMPARE(texCoords[3].u, 80.0f / 256);
+    QCOMPARE(texCoords[3].v, 1.0f - 48.0f / 128);
+
+    // The whole atlas maps to the whole texture
+    rect = { 0, 0, 256, 128 };
+    atlas.texCoords(rect, texCoords);
+    QCOMPARE(texCoords[0].u, 0.0f);
+    QCOMPARE(texCoords[0].v, 0.0f);
+    QCOMPARE(texCoords[2].u, 1.0f);
+    QCOMPARE(texCoords[2].v, 1.0f);
+}
+
+QTEST_GUILESS_MAIN(MCTextureAtlasTest)
@@ -22,10 +22,14 @@
 #include "../../Core/mcworld.hh"
 #include "../../Physics/mccircleshape.hh"
 #include "../../Physics/mccollisionevent.hh"
+#include "../../Physics/mccontactstore.hh"
+#include "../../Physics/mcimpulsegenerator.hh"
 #include "../../Physics/mcphysicscomponent.hh"
 #include "../../Physics/mcrectshape.hh"
 #include "../../Physics/mcseparationevent.hh"
 
+#include <functional>
+
 class TestObject : public MCObject
 {
 public:
@@ -285,4 +289,109 @@ void MCWorldTest::testSleepingObjectRemovalFromIntegration()
     QVERIFY(world.objectCount() == 5);
 }
 
+void MCWorldTest::testImpulsesFromFirstContactingObjectOnly()
+{
+    MCWorld world;
+
+    MCObject object1("TEST_OBJECT");
+    object1.physicsComponent().setMass(1);
+    object1.physicsComponent().preventSleeping(true);
+    object1.physicsComponent().setVelocity({ -1, 0, 0 });
+    world.addObject(object1);
+
+    MCObject object2("TEST_OBJECT");
+    object2.physicsComponent().setMass(1);
+    object2.translate({ -1, 0, 0 });
+    world.addObject(object2);
+    object2.physicsComponent().toggleSleep(true);
+
+    MCObject object3("TEST_OBJECT");
+    object3.physicsComponent().setMass(1);
+    object3.translate({ -1, 1, 0 });
+    world.addObject(object3);
+    object3.physicsComponent().toggleSleep(true);
+
+    // Object1 hits both, but only its first contacting object in pointer order gets the impulse
+    MCContactStore contacts;
+    contacts.addContact(object1, object2, { -0.5f, 0 }, { 1, 0 }, 0.1f);
+    contacts.addContact(object1, object3, { -0.5f, 0.5f }, { 1, 0 }, 0.1f);
+
+    MCImpulseGenerator impulseGenerator;
+    impulseGenerator.generateImpulsesFromDeepestContacts(contacts);
+
+    auto & first = std::less<MCObject *>()(&object2, &object3) ? object2 : object3;
+    auto & second = &first == &object2 ? object3 : object2;
+    QVERIFY(!first.physicsComponent().isSleeping());
+    QVERIFY(second.physicsComponent().isSleeping());
+
+    // Positions are resolved for every contacting pair
+    contacts.addContact(object1, object2, { -0.5f, 0 }, { 1, 0 }, 0.1f);
+    contacts.addContact(object1, object3, { -0.5f, 0.5f }, { 1, 0 }, 0.1f);
+    impulseGenerator.resolvePositions(contacts, 1.0f);
+
+    QVERIFY(object2.location().i() < -1);
+    QVERIFY(object3.location().i() < -1);
+}
+
+void MCWorldTest::testRenderInterpolation()
+{
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -10, 10, 1, false, 16, MCBroadPhase::Type::SweepAndPrune);
+
+    MCObject object("TEST_OBJECT");
+    object.setShape(MCShapePtr(new MCCircleShape(nullptr, 1.0f)));
+    object.translate({ 10, 0, 0 });
+    object.rotate(350);
+    object.addToWorld();
+
+    world.stepTime(10);
+    object.translate({ 20, 0, 0 });
+    object.rotate(10);
+
+    world.setRenderInterpolation(0.25f);
+    QVERIFY(qFuzzyCompare(object.shape()->renderLocation().i(), 12.5f));
+    QVERIFY(qFuzzyCompare(object.shape()->renderAngle(), 355.0f)); // Over the shorter arc
+
+    world.setRenderInterpolation(1.0f);
+    QCOMPARE(object.shape()->renderLocation().i(), 20.0f);
+    QCOMPARE(object.shape()->renderAngle(), 10.0f);
+
+    // Teleporting must not be interpolated
+    world.setRenderInterpolation(0.5f);
+    object.translate({ -50, 0, 0 });
+    object.resetRenderState();
+    QCOMPARE(object.shape()->renderLocation().i(), -50.0f);
+
+    world.setRenderInterpolation(1.0f);
+}
+
+void MCWorldTest::testProfile()
+{
+    MCWorld world;
+    world.setDimensions(-100, 100, -100, 100, -10, 10, 1, false, 16, MCBroadPhase::Type::SweepAndPrune);
+
+    MCObject object1("TEST_OBJECT");
+    object1.setShape(MCShapePtr(new MCCircleShape(nullptr, 10.0f)));
+    object1.addToWorld();
+
+    MCObject object2("TEST_OBJECT");
+    object2.setShape(MCShapePtr(new MCCircleShape(nullptr, 10.0f)));
+    object2.translate({ 5, 0, 0 });
+    object2.addToWorld();
+
+    world.stepTime(10);
+    QCOMPARE(world.profile().steps, size_t(0));
+
+    world.setProfilingEnabled(true);
+    world.stepTime(10);
+    world.stepTime(10);
+    QCOMPARE(world.profile().steps, size_t(2));
+    QVERIFY(world.profile().broadPhase.count() > 0);
+    QVERIFY(world.profile().narrowPhase.count() > 0);
+
+    world.resetProfile();
+    QCOMPARE(world.profile().steps, size_t(0));
+    QCOMPARE(world.profile().narrowPhase.count(), 0);
+}
+
 QTEST_GUILESS_MAIN(MCWorldTest)
@@ -41,4 +41,10 @@ private slots:
     void testSetDimensions();
 
     void testSleepingObjectRemovalFromIntegration();
+
+    void testImpulsesFromFirstContactingObjectOnly();
+
+    void testRenderInterpolation();
+
+    void testProfile();
 };
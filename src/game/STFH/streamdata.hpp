@@ -0,0 +1,55 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef STREAMDATA_HPP
+#define STREAMDATA_HPP
+
+#include "data.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace STFH {
+
+/*! Sound data that is decoded on demand instead of being fully resident.
+ *  The decoded samples are signed 16-bit PCM. */
+class StreamData : public Data
+{
+public:
+    //! Constructor.
+    StreamData();
+
+    //! Destructor.
+    virtual ~StreamData() override;
+
+    /*! Decode up to size bytes of PCM into the given buffer.
+     *  \return number of bytes decoded or 0 at the end of the stream. */
+    virtual size_t read(char * buffer, size_t size) = 0;
+
+    //! Continue decoding from the beginning.
+    virtual void rewind() = 0;
+
+    //! \return number of channels.
+    virtual int channels() const = 0;
+
+    //! \return samples per second.
+    virtual int sampleRate() const = 0;
+};
+
+typedef std::shared_ptr<StreamData> StreamDataPtr;
+
+} // namespace STFH
+
+#endif // STREAMDATA_HPP
@@ -0,0 +1,138 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "streamqueue.hpp"
+
+#include <cassert>
+
+namespace STFH {
+
+StreamQueue::StreamQueue(StreamDataPtr data, size_t bufferCount, size_t bufferSize)
+  : m_data(data)
+  , m_buffer(bufferSize)
+  , m_bufferCount(bufferCount)
+  , m_first(0)
+  , m_queued(0)
+  , m_loop(false)
+  , m_ended(false)
+  , m_playing(false)
+{
+    assert(m_data);
+    assert(m_bufferCount > 0);
+}
+
+void StreamQueue::play(bool loop)
+{
+    stop();
+
+    m_data->rewind();
+    m_loop = loop;
+    m_ended = false;
+
+    while (m_queued < m_bufferCount && fillAndQueueBuffer())
+    {
+    }
+
+    if (m_queued)
+    {
+        m_playing = true;
+        startPlayback();
+    }
+}
+
+void StreamQueue::stop()
+{
+    stopPlayback();
+
+    m_first = 0;
+    m_queued = 0;
+    m_playing = false;
+}
+
+bool StreamQueue::update()
+{
+    if (!m_playing)
+    {
+        return false;
+    }
+
+    const size_t processed = unqueueProcessedBuffers();
+    assert(processed <= m_queued);
+    m_first = (m_first + processed) % m_bufferCount;
+    m_queued -= processed;
+
+    while (m_queued < m_bufferCount && fillAndQueueBuffer())
+    {
+    }
+
+    if (!m_queued)
+    {
+        m_playing = false;
+        return false;
+    }
+
+    // The device stops if it runs out of buffers before the update
+    startPlayback();
+
+    return true;
+}
+
+bool StreamQueue::isPlaying() const
+{
+    return m_playing;
+}
+
+bool StreamQueue::fillAndQueueBuffer()
+{
+    // Keep the buffers aligned to whole sample frames
+    const size_t frameSize = static_cast<size_t>(m_data->channels()) * 2;
+    const size_t capacity = m_buffer.size() / frameSize * frameSize;
+
+    size_t size = 0;
+    bool rewound = false;
+    while (size < capacity && !m_ended)
+    {
+        if (const size_t bytes = m_data->read(m_buffer.data() + size, capacity - size))
+        {
+            size += bytes;
+            rewound = false;
+        }
+        else if (m_loop && !rewound)
+        {
+            m_data->rewind();
+            rewound = true;
+        }
+        else
+        {
+            m_ended = true;
+        }
+    }
+
+    if (!size)
+    {
+        return false;
+    }
+
+    queueBuffer((m_first + m_queued) % m_bufferCount, m_buffer.data(), size);
+    m_queued++;
+
+    return true;
+}
+
+StreamQueue::~StreamQueue()
+{
+}
+
+} // namespace STFH
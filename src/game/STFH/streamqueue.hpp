@@ -0,0 +1,92 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef STREAMQUEUE_HPP
+#define STREAMQUEUE_HPP
+
+#include "streamdata.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace STFH {
+
+/*! Plays StreamData through a small ring of buffers that are refilled as soon as they
+ *  have been played, so only a fraction of the decoded stream is resident at a time.
+ *  Re-implement the protected methods to queue the buffers to the actual device. */
+class StreamQueue
+{
+public:
+    /*! Constructor.
+     *  \param bufferCount Number of buffers in the ring.
+     *  \param bufferSize Max size of a buffer in bytes. */
+    StreamQueue(StreamDataPtr data, size_t bufferCount, size_t bufferSize);
+
+    //! Destructor.
+    virtual ~StreamQueue();
+
+    //! Rewind the stream, fill all buffers and start playing.
+    void play(bool loop);
+
+    //! Stop playing and release the queued buffers.
+    void stop();
+
+    /*! Refill and requeue the buffers that have been played. Must be called
+     *  periodically while playing, at least once per played buffer.
+     *  \return true if still playing. */
+    bool update();
+
+    //! \return true if not stopped and not yet played to the end.
+    bool isPlaying() const;
+
+protected:
+    /*! Unqueue the buffers that have been played. The buffers are played
+     *  in the order they were queued.
+     *  \return number of unqueued buffers. */
+    virtual size_t unqueueProcessedBuffers() = 0;
+
+    //! Copy the given PCM to the buffer of the given index and queue it.
+    virtual void queueBuffer(size_t index, const char * data, size_t size) = 0;
+
+    //! Start playing the queued buffers unless already playing, e.g. after running out of buffers.
+    virtual void startPlayback() = 0;
+
+    //! Stop playing and unqueue all buffers.
+    virtual void stopPlayback() = 0;
+
+private:
+    bool fillAndQueueBuffer();
+
+    StreamDataPtr m_data;
+
+    std::vector<char> m_buffer;
+
+    size_t m_bufferCount;
+
+    //! Index of the oldest queued buffer.
+    size_t m_first;
+
+    size_t m_queued;
+
+    bool m_loop;
+
+    bool m_ended;
+
+    bool m_playing;
+};
+
+} // namespace STFH
+
+#endif // STREAMQUEUE_HPP
@@ -50,7 +50,7 @@ void AI::update(bool isRaceCompleted)
         const Route & route = m_track->trackData().route();
         steerControl(route.get(m_race->getCurrentTargetNodeIndex(m_car.index())));
 
-        speedControl(*m_track->trackTileAtLocation(m_car.location().i(), m_car.location().j()), isRaceCompleted);
+        speedControl(m_track->trackTileAtLocation(m_car.location().i(), m_car.location().j()), isRaceCompleted);
 
         m_lastTargetNodeIndex = m_race->getCurrentTargetNodeIndex(m_car.index());
     }
@@ -111,7 +111,7 @@ void AI::steerControl(TargetNodeBasePtr targetNode)
     m_lastDiff = diff;
 }
 
-void AI::speedControl(TrackTile & currentTile, bool isRaceCompleted)
+void AI::speedControl(const TrackTile & currentTile, bool isRaceCompleted)
 {
     // TODO: Maybe it'd be possible to adjust speed according to
     // the difference between current and target angles so that
@@ -46,7 +46,7 @@ private:
     void steerControl(TargetNodeBasePtr tnode);
 
     //! Brake/accelerate logic.
-    void speedControl(TrackTile & currentTile, bool isRaceCompleted);
+    void speedControl(const TrackTile & currentTile, bool isRaceCompleted);
 
     void setRandomTolerance();
 
@@ -0,0 +1,123 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "audiocommandqueue.hpp"
+
+#include <algorithm>
+
+AudioCommandQueue::AudioCommandQueue(size_t capacity)
+  : m_head(0)
+  , m_tail(0)
+{
+    size_t size = 1;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+
+    m_buffer.resize(size);
+    m_mask = size - 1;
+}
+
+bool AudioCommandQueue::push(const AudioCommand & command)
+{
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_buffer.size())
+    {
+        return false;
+    }
+
+    m_buffer[tail & m_mask] = command;
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+size_t AudioCommandQueue::pop(std::vector<AudioCommand> & batch)
+{
+    batch.clear();
+
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; i++)
+    {
+        batch.push_back(m_buffer[i & m_mask]);
+    }
+
+    m_head.store(tail, std::memory_order_release);
+
+    coalesce(batch);
+
+    return batch.size();
+}
+
+void AudioCommandQueue::coalesce(std::vector<AudioCommand> & batch)
+{
+    size_t count = 0;
+    for (auto && command : batch)
+    {
+        if (command.source == AudioCommand::NO_SOURCE)
+        {
+            continue;
+        }
+
+        if (command.source >= m_lastPitch.size())
+        {
+            m_lastPitch.resize(command.source + 1, -1);
+            m_lastLocation.resize(command.source + 1, -1);
+        }
+
+        auto && lastPitch = m_lastPitch[command.source];
+        auto && lastLocation = m_lastLocation[command.source];
+        switch (command.type)
+        {
+        case AudioCommand::Type::SetPitch:
+            if (lastPitch >= 0)
+            {
+                batch[static_cast<size_t>(lastPitch)] = command;
+                continue;
+            }
+
+            lastPitch = static_cast<int>(count);
+            break;
+        case AudioCommand::Type::SetLocation:
+            if (lastLocation >= 0)
+            {
+                batch[static_cast<size_t>(lastLocation)] = command;
+                continue;
+            }
+
+            lastLocation = static_cast<int>(count);
+            break;
+        default:
+            // Keep the updates that were done before e.g. playing
+            lastPitch = -1;
+            lastLocation = -1;
+            break;
+        }
+
+        batch[count++] = command;
+    }
+
+    batch.resize(count);
+
+    std::fill(m_lastPitch.begin(), m_lastPitch.end(), -1);
+    std::fill(m_lastLocation.begin(), m_lastLocation.end(), -1);
+}
+
+size_t AudioCommandQueue::capacity() const
+{
+    return m_buffer.size();
+}
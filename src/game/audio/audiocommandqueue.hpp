@@ -0,0 +1,91 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AUDIOCOMMANDQUEUE_HPP
+#define AUDIOCOMMANDQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! A command to a sound source. The source is referred by its id in AudioSourceBank.
+struct AudioCommand
+{
+    enum class Type : uint8_t
+    {
+        Play,
+        PlayLooped,
+        Stop,
+        SetPitch,
+        SetVolume,
+        SetLocation
+    };
+
+    //! Id of unknown sources. Commands to it are ignored.
+    static const uint16_t NO_SOURCE = 0xffff;
+
+    Type type;
+
+    uint16_t source;
+
+    //! Pitch, volume or the x and y of the location.
+    float args[2];
+};
+
+/*! Single-producer/single-consumer ring buffer of audio commands. The game thread pushes
+ *  commands and the audio thread drains them in batches, so no events, locks or
+ *  allocations are needed per command. */
+class AudioCommandQueue
+{
+public:
+    /*! Constructor.
+     *  \param capacity Max number of queued commands. Rounded up to a power of two. */
+    explicit AudioCommandQueue(size_t capacity = 1024);
+
+    /*! Add a command. Only one thread may push.
+     *  \return false if the queue is full and the command was dropped. */
+    bool push(const AudioCommand & command);
+
+    /*! Move all queued commands to the given batch and coalesce consecutive pitch and location
+     *  updates of each source. Only one thread may pop.
+     *  \return the number of commands in the batch. */
+    size_t pop(std::vector<AudioCommand> & batch);
+
+    /*! Drop pitch and location updates that are overridden by a later update
+     *  of the same source before any other command to the source. */
+    void coalesce(std::vector<AudioCommand> & batch);
+
+    size_t capacity() const;
+
+private:
+    std::vector<AudioCommand> m_buffer;
+
+    size_t m_mask;
+
+    //! Next slot to pop. Written only by the consumer.
+    alignas(64) std::atomic<size_t> m_head;
+
+    //! Next slot to push. Written only by the producer.
+    alignas(64) std::atomic<size_t> m_tail;
+
+    //! Position in the batch of the last pitch update of each source.
+    std::vector<int> m_lastPitch;
+
+    //! Position in the batch of the last location update of each source.
+    std::vector<int> m_lastLocation;
+};
+
+#endif // AUDIOCOMMANDQUEUE_HPP
@@ -14,7 +14,26 @@
 // along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
 
 #include "audiosource.hpp"
+#include "audioworker.hpp"
 
 AudioSource::AudioSource() = default;
 
+void AudioSource::setAudioWorker(AudioWorker * audioWorker)
+{
+    m_audioWorker = audioWorker;
+}
+
+uint16_t AudioSource::sourceId(const QString & handle) const
+{
+    return m_audioWorker ? m_audioWorker->sourceId(handle) : AudioCommand::NO_SOURCE;
+}
+
+void AudioSource::queueCommand(AudioCommand::Type type, uint16_t source, float arg0, float arg1)
+{
+    if (m_audioWorker && source != AudioCommand::NO_SOURCE)
+    {
+        m_audioWorker->queueCommand({ type, source, { arg0, arg1 } });
+    }
+}
+
 AudioSource::~AudioSource() = default;
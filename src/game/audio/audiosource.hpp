@@ -18,8 +18,13 @@
 
 #include <QObject>
 
+#include "audiocommandqueue.hpp"
+
+class AudioWorker;
+
 /*! Class that defines a set of signals used to play sounds.
- *  AudioWorker can connect to a class inherited from AudioSource. */
+ *  AudioWorker can connect to a class inherited from AudioSource.
+ *  Sources that update sounds every frame should queue commands instead of emitting signals. */
 class AudioSource : public QObject
 {
     Q_OBJECT
@@ -31,6 +36,9 @@ public:
     //! Destructor.
     virtual ~AudioSource() override;
 
+    //! Set by AudioWorker on connect and cleared on disconnect.
+    virtual void setAudioWorker(AudioWorker * audioWorker);
+
 signals:
 
     void playRequested(const QString & handle, bool loop);
@@ -42,6 +50,16 @@ signals:
     void volumeChanged(const QString & handle, float pitch);
 
     void locationChanged(const QString & handle, float x, float y);
+
+protected:
+    //! \return id of the sound of the given handle or AudioCommand::NO_SOURCE if not connected.
+    uint16_t sourceId(const QString & handle) const;
+
+    //! Queue a command to the connected AudioWorker. Does nothing if not connected.
+    void queueCommand(AudioCommand::Type type, uint16_t source, float arg0 = 0, float arg1 = 0);
+
+private:
+    AudioWorker * m_audioWorker = nullptr;
 };
 
 #endif // AUDIOSOURCE_HPP
@@ -0,0 +1,93 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "audiosourcebank.hpp"
+#include "audiocommandqueue.hpp"
+
+#include <cassert>
+
+AudioSourceBank::AudioSourceBank(STFH::DevicePtr device)
+  : m_device(device)
+  , m_enabled(true)
+{
+    assert(m_device);
+}
+
+STFH::Device & AudioSourceBank::device() const
+{
+    return *m_device;
+}
+
+void AudioSourceBank::setSource(size_t id, STFH::SourcePtr source)
+{
+    if (id >= m_sources.size())
+    {
+        m_sources.resize(id + 1);
+    }
+
+    m_sources[id] = source;
+}
+
+STFH::SourcePtr AudioSourceBank::source(size_t id) const
+{
+    return id < m_sources.size() ? m_sources[id] : nullptr;
+}
+
+size_t AudioSourceBank::size() const
+{
+    return m_sources.size();
+}
+
+void AudioSourceBank::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+}
+
+bool AudioSourceBank::enabled() const
+{
+    return m_enabled;
+}
+
+void AudioSourceBank::execute(const AudioCommand & command)
+{
+    if (command.source >= m_sources.size() || !m_sources[command.source])
+    {
+        return;
+    }
+
+    auto && source = *m_sources[command.source];
+    switch (command.type)
+    {
+    case AudioCommand::Type::Play:
+    case AudioCommand::Type::PlayLooped:
+        if (m_enabled)
+        {
+            source.play(command.type == AudioCommand::Type::PlayLooped);
+        }
+        break;
+    case AudioCommand::Type::Stop:
+        source.stop();
+        break;
+    case AudioCommand::Type::SetPitch:
+        source.setPitch(command.args[0]);
+        break;
+    case AudioCommand::Type::SetVolume:
+        source.setVolume(command.args[0]);
+        break;
+    case AudioCommand::Type::SetLocation:
+        source.setLocation(STFH::Location(command.args[0], command.args[1]));
+        break;
+    }
+}
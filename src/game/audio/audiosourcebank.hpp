@@ -0,0 +1,63 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef AUDIOSOURCEBANK_HPP
+#define AUDIOSOURCEBANK_HPP
+
+#include <Device>
+#include <Source>
+
+#include <atomic>
+#include <vector>
+
+struct AudioCommand;
+
+/*! The sound sources of a device indexed by integer ids. Executes the
+ *  commands of AudioCommandQueue in the audio thread. */
+class AudioSourceBank
+{
+public:
+    //! Constructor.
+    explicit AudioSourceBank(STFH::DevicePtr device);
+
+    //! \return the device.
+    STFH::Device & device() const;
+
+    //! Set the source of the given id. The bank grows as needed.
+    void setSource(size_t id, STFH::SourcePtr source);
+
+    //! \return the source of the given id or nullptr.
+    STFH::SourcePtr source(size_t id) const;
+
+    //! \return the number of ids.
+    size_t size() const;
+
+    //! Play requests are ignored if disabled. Can be called from any thread.
+    void setEnabled(bool enabled);
+
+    bool enabled() const;
+
+    //! Execute the given command. Commands to unknown sources are ignored.
+    void execute(const AudioCommand & command);
+
+private:
+    STFH::DevicePtr m_device;
+
+    std::vector<STFH::SourcePtr> m_sources;
+
+    std::atomic<bool> m_enabled;
+};
+
+#endif // AUDIOSOURCEBANK_HPP
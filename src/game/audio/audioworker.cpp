@@ -15,33 +15,111 @@
 
 #include "audioworker.hpp"
 #include "audiosource.hpp"
+#include "oggstreamdata.hpp"
 #include "openaloggdata.hpp"
 #include "openalwavdata.hpp"
 #include "settings.hpp"
 
+#include <MCThreadPool>
+
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QString>
+#include <QThread>
+#include <QTimer>
 
-#include <sstream>
+#include <exception>
+#include <thread>
+#include <vector>
 
 #include <AL/al.h>
 
 static const int MAX_DIST = 250;
 static const int REFERENCE_DIST = 50;
 
+// Longer sounds are streamed instead of being decoded fully into memory
+static const qint64 STREAM_MIN_FILE_SIZE = 100 * 1024;
+
+static const int STREAM_UPDATE_INTERVAL_MS = 50;
+
+namespace {
+
+enum class SoundType
+{
+    Common,
+    SingleInstanceCar,
+    MultiInstanceCar
+};
+
+struct Sound
+{
+    const char * handle;
+
+    const char * fileName;
+
+    //! Relative to the default volume.
+    float volume;
+
+    SoundType type;
+};
+
+const std::vector<Sound> SOUNDS = {
+    { "bell", "bell.ogg", 0.5f, SoundType::Common },
+    { "cheering", "cheering.ogg", 0.5f, SoundType::Common },
+    { "menuBoom", "menuBoom.ogg", 0.5f, SoundType::Common },
+    { "menuClick", "menuClick.ogg", 1.0f, SoundType::Common },
+    { "pit", "pit.ogg", 1.0f, SoundType::Common },
+    { "carEngine", "carEngine.ogg", 0.33f, SoundType::MultiInstanceCar },
+    { "carHit", "carHit.ogg", 0.5f, SoundType::MultiInstanceCar },
+    { "skid", "skid.ogg", 0.25f, SoundType::MultiInstanceCar },
+    { "carHit2", "carHit2.ogg", 0.5f, SoundType::SingleInstanceCar },
+    { "carHit3", "carHit3.ogg", 0.5f, SoundType::SingleInstanceCar }
+};
+
+} // namespace
+
 AudioWorker::AudioWorker(int numCars, bool enabled)
-  : m_openALDevice(std::make_shared<OpenALDevice>())
+  : m_sourceBank(std::make_shared<OpenALDevice>())
+  , m_commandsPending(false)
   , m_inited(false)
   , m_defaultVolume(0.5)
   , m_numCars(numCars)
-  , m_enabled(enabled)
 {
+    m_sourceBank.setEnabled(enabled);
+
+    // The ids are assigned up front, so that the game thread can use them before the sounds are loaded
+    for (auto && sound : SOUNDS)
+    {
+        if (sound.type == SoundType::MultiInstanceCar)
+        {
+            for (int i = 0; i < m_numCars; i++)
+            {
+                addSourceId(sound.handle + QString::number(i));
+            }
+        }
+        else
+        {
+            addSourceId(sound.handle);
+        }
+    }
+}
+
+void AudioWorker::addSourceId(const QString & handle)
+{
+    const auto id = static_cast<uint16_t>(m_sourceIds.size());
+    m_sourceIds[handle] = id;
+}
+
+uint16_t AudioWorker::sourceId(const QString & handle) const
+{
+    const auto iter = m_sourceIds.find(handle);
+    return iter != m_sourceIds.end() ? iter->second : AudioCommand::NO_SOURCE;
 }
 
 void AudioWorker::init()
 {
-    m_openALDevice->initialize(); // Throws on failure
+    m_sourceBank.device().initialize(); // Throws on failure
 
     alDistanceModel(AL_LINEAR_DISTANCE_CLAMPED);
     alSpeedOfSound(1000.0);
@@ -57,11 +135,12 @@ void AudioWorker::checkFile(QString path)
 
 bool AudioWorker::enabled() const
 {
-    return m_enabled;
+    return m_sourceBank.enabled();
 }
 
 void AudioWorker::connectAudioSource(AudioSource & source)
 {
+    source.setAudioWorker(this);
     connect(&source, &AudioSource::playRequested, this, &AudioWorker::playSound);
     connect(&source, &AudioSource::stopRequested, this, &AudioWorker::stopSound);
     connect(&source, &AudioSource::pitchChanged, this, &AudioWorker::setPitch);
@@ -71,6 +150,7 @@ void AudioWorker::connectAudioSource(AudioSource & source)
 
 void AudioWorker::disconnectAudioSource(AudioSource & source)
 {
+    source.setAudioWorker(nullptr);
     disconnect(&source, &AudioSource::playRequested, this, &AudioWorker::playSound);
     disconnect(&source, &AudioSource::stopRequested, this, &AudioWorker::stopSound);
     disconnect(&source, &AudioSource::pitchChanged, this, &AudioWorker::setPitch);
@@ -80,86 +160,167 @@ void AudioWorker::disconnectAudioSource(AudioSource & source)
 
 void AudioWorker::loadSounds()
 {
-    loadCommonSound("bell", "bell.ogg", m_defaultVolume * 0.5f);
-    loadCommonSound("cheering", "cheering.ogg", m_defaultVolume * 0.5f);
-    loadCommonSound("menuBoom", "menuBoom.ogg", m_defaultVolume * 0.5f);
-    loadCommonSound("menuClick", "menuClick.ogg", m_defaultVolume * 1.0f);
-    loadCommonSound("pit", "pit.ogg", m_defaultVolume);
+    std::vector<std::string> paths;
+    std::vector<bool> streamed;
+    for (auto && sound : SOUNDS)
+    {
+        const QString soundPath = QString(DATA_PATH) + QDir::separator() + "sounds" + QDir::separator() + sound.fileName;
+        checkFile(soundPath);
+        paths.push_back(soundPath.toStdString());
 
-    loadMultiInstanceCarSound("carEngine", "carEngine.ogg", m_defaultVolume * 0.33f);
+        // A stream can be played by only one source at a time
+        streamed.push_back(sound.type != SoundType::MultiInstanceCar && QFileInfo(soundPath).size() >= STREAM_MIN_FILE_SIZE);
+    }
 
-    loadMultiInstanceCarSound("carHit", "carHit.ogg", m_defaultVolume * 0.5f);
-    loadMultiInstanceCarSound("skid", "skid.ogg", m_defaultVolume * 0.25f);
+    // Decode in parallel. Only the buffers are created in this thread, because it owns the OpenAL context.
+    std::vector<OpenALOggData::Samples> samples(SOUNDS.size());
+    std::vector<std::exception_ptr> errors(SOUNDS.size());
+    const unsigned int cores = std::thread::hardware_concurrency();
+    MCThreadPool threadPool(cores > 1 ? cores - 1 : 0);
+    threadPool.run(SOUNDS.size(), [&](size_t i) {
+        if (streamed[i])
+        {
+            return;
+        }
+
+        try
+        {
+            samples[i] = OpenALOggData::decode(paths[i]);
+        }
+        catch (...)
+        {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for (size_t i = 0; i < SOUNDS.size(); i++)
+    {
+        if (errors[i])
+        {
+            std::rethrow_exception(errors[i]);
+        }
+
+        STFH::DataPtr data;
+        if (streamed[i])
+        {
+            data = std::make_shared<OggStreamData>(paths[i]);
+        }
+        else
+        {
+            data = std::make_shared<OpenALOggData>(paths[i], samples[i]);
+            samples[i] = {};
+        }
+
+        auto && sound = SOUNDS[i];
+        const float volume = m_defaultVolume * sound.volume;
+        switch (sound.type)
+        {
+        case SoundType::Common:
+            loadCommonSound(sound.handle, data, volume);
+            break;
+        case SoundType::SingleInstanceCar:
+            loadSingleInstanceCarSound(sound.handle, data, volume);
+            break;
+        case SoundType::MultiInstanceCar:
+            loadMultiInstanceCarSound(sound.handle, data, volume);
+            break;
+        }
+    }
 
-    loadSingleInstanceCarSound("carHit2", "carHit2.ogg", m_defaultVolume * 0.5f);
-    loadSingleInstanceCarSound("carHit3", "carHit3.ogg", m_defaultVolume * 0.5f);
+    if (!m_streamedSources.empty())
+    {
+        m_streamTimer = new QTimer(this);
+        connect(m_streamTimer, &QTimer::timeout, this, &AudioWorker::updateStreams);
+        connect(thread(), &QThread::finished, m_streamTimer, &QTimer::stop);
+        m_streamTimer->start(STREAM_UPDATE_INTERVAL_MS);
+    }
 }
 
-void AudioWorker::loadSingleInstanceCarSound(QString handle, QString path, float volume)
+void AudioWorker::updateStreams()
 {
-    const auto soundPath =
-      QString(DATA_PATH) + QDir::separator() + "sounds" + QDir::separator() + path;
-    checkFile(soundPath);
+    for (auto && source : m_streamedSources)
+    {
+        source->update();
+    }
+}
 
-    const auto source(std::make_shared<OpenALSource>(std::make_shared<OpenALOggData>(soundPath.toStdString())));
+void AudioWorker::addSource(const QString & handle, std::shared_ptr<OpenALSource> source)
+{
+    m_sourceBank.setSource(sourceId(handle), source);
+
+    if (source->isStreamed())
+    {
+        m_streamedSources.push_back(source);
+    }
+}
+
+void AudioWorker::loadSingleInstanceCarSound(QString handle, STFH::DataPtr data, float volume)
+{
+    const auto source(std::make_shared<OpenALSource>(data));
     source->setMaxDist(MAX_DIST);
     source->setReferenceDist(REFERENCE_DIST);
     source->setVolume(volume);
-    m_soundMap[handle] = source;
+    addSource(handle, source);
 }
 
-void AudioWorker::loadCommonSound(QString handle, QString path, float volume)
+void AudioWorker::loadCommonSound(QString handle, STFH::DataPtr data, float volume)
 {
-    const QString soundPath =
-      QString(DATA_PATH) + QDir::separator() + "sounds" + QDir::separator() + path;
-    checkFile(soundPath);
-
-    m_soundMap[handle] = std::make_shared<OpenALSource>(std::make_shared<OpenALOggData>(soundPath.toStdString()));
-    m_soundMap[handle]->setVolume(volume);
+    const auto source(std::make_shared<OpenALSource>(data));
+    source->setVolume(volume);
+    addSource(handle, source);
 }
 
-void AudioWorker::loadMultiInstanceCarSound(QString baseName, QString path, float volume)
+void AudioWorker::loadMultiInstanceCarSound(QString baseName, STFH::DataPtr data, float volume)
 {
-    const QString soundPath =
-      QString(DATA_PATH) + QDir::separator() + "sounds" + QDir::separator() + path;
-    checkFile(soundPath);
-
-    const auto sharedData = std::make_shared<OpenALOggData>(soundPath.toStdString());
-
     for (int i = 0; i < m_numCars; i++)
     {
-        std::stringstream ss;
-        ss << baseName.toStdString() << i;
-        const auto source = std::make_shared<OpenALSource>(sharedData);
-        m_soundMap[ss.str().c_str()] = source;
+        const auto source = std::make_shared<OpenALSource>(data);
         source->setMaxDist(MAX_DIST);
         source->setReferenceDist(REFERENCE_DIST);
         source->setVolume(volume);
+        addSource(baseName + QString::number(i), source);
+    }
+}
+
+void AudioWorker::queueCommand(const AudioCommand & command)
+{
+    // Post only one event per batch of commands
+    if (m_commandQueue.push(command) && !m_commandsPending.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, &AudioWorker::processCommands, Qt::QueuedConnection);
+    }
+}
+
+void AudioWorker::processCommands()
+{
+    // Clear before popping, so that commands queued meanwhile post a new event
+    m_commandsPending = false;
+
+    m_commandQueue.pop(m_commands);
+    for (auto && command : m_commands)
+    {
+        m_sourceBank.execute(command);
     }
 }
 
 void AudioWorker::playSound(const QString & handle, bool loop)
 {
-    if (m_soundMap.count(handle) && m_enabled)
-        m_soundMap[handle]->play(loop);
+    m_sourceBank.execute({ loop ? AudioCommand::Type::PlayLooped : AudioCommand::Type::Play, sourceId(handle), {} });
 }
 
 void AudioWorker::stopSound(const QString & handle)
 {
-    if (m_soundMap.count(handle))
-        m_soundMap[handle]->stop();
+    m_sourceBank.execute({ AudioCommand::Type::Stop, sourceId(handle), {} });
 }
 
 void AudioWorker::setPitch(const QString & handle, float pitch)
 {
-    if (m_soundMap.count(handle))
-        m_soundMap[handle]->setPitch(pitch);
+    m_sourceBank.execute({ AudioCommand::Type::SetPitch, sourceId(handle), { pitch, 0 } });
 }
 
 void AudioWorker::setVolume(const QString & handle, float volume)
 {
-    if (m_soundMap.count(handle))
-        m_soundMap[handle]->setVolume(volume);
+    m_sourceBank.execute({ AudioCommand::Type::SetVolume, sourceId(handle), { volume, 0 } });
 }
 
 void AudioWorker::setDefaultVolume(float volume)
@@ -169,8 +330,7 @@ void AudioWorker::setDefaultVolume(float volume)
 
 void AudioWorker::setLocation(const QString & handle, float x, float y)
 {
-    if (m_soundMap.count(handle))
-        m_soundMap[handle]->setLocation(STFH::Location(x, y));
+    m_sourceBank.execute({ AudioCommand::Type::SetLocation, sourceId(handle), { x, y } });
 }
 
 void AudioWorker::setListenerLocation(float x, float y)
@@ -180,7 +340,7 @@ void AudioWorker::setListenerLocation(float x, float y)
 
 void AudioWorker::setEnabled(bool enabled)
 {
-    m_enabled = enabled;
+    m_sourceBank.setEnabled(enabled);
 }
 
 AudioWorker::~AudioWorker() = default;
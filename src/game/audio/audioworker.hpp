@@ -19,12 +19,19 @@
 #include <QObject>
 #include <QString>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <vector>
 
+#include "audiocommandqueue.hpp"
+#include "audiosourcebank.hpp"
+#include "openaldata.hpp"
 #include "openaldevice.hpp"
 #include "openalsource.hpp"
 
 class AudioSource;
+class QTimer;
 
 class AudioWorker : public QObject
 {
@@ -41,6 +48,14 @@ public:
 
     bool enabled() const;
 
+    /*! \return id of the sound of the given handle or AudioCommand::NO_SOURCE.
+     *  The ids are fixed on construction, so this can be called from any thread. */
+    uint16_t sourceId(const QString & handle) const;
+
+    /*! Queue a command to be executed in the audio thread. Only the game thread may queue
+     *  commands. The commands are dropped if the audio thread can't keep up. */
+    void queueCommand(const AudioCommand & command);
+
 public slots:
 
     void init();
@@ -63,27 +78,44 @@ public slots:
 
     void setEnabled(bool enabled);
 
+    //! Execute the queued commands.
+    void processCommands();
+
 private:
     void checkFile(QString path);
 
-    void loadCommonSound(QString handle, QString path, float volume = 1.0f);
+    void loadCommonSound(QString handle, STFH::DataPtr data, float volume = 1.0f);
+
+    void loadSingleInstanceCarSound(QString handle, STFH::DataPtr data, float volume = 1.0f);
+
+    void loadMultiInstanceCarSound(QString baseName, STFH::DataPtr data, float volume = 1.0f);
+
+    void addSource(const QString & handle, std::shared_ptr<OpenALSource> source);
 
-    void loadSingleInstanceCarSound(QString handle, QString path, float volume = 1.0f);
+    void addSourceId(const QString & handle);
 
-    void loadMultiInstanceCarSound(QString baseName, QString path, float volume = 1.0f);
+    void updateStreams();
 
-    STFH::DevicePtr m_openALDevice;
+    AudioSourceBank m_sourceBank;
 
-    typedef std::map<QString, STFH::SourcePtr> SoundMap;
-    SoundMap m_soundMap;
+    typedef std::map<QString, uint16_t> SourceIdMap;
+    SourceIdMap m_sourceIds;
+
+    AudioCommandQueue m_commandQueue;
+
+    std::vector<AudioCommand> m_commands;
+
+    std::atomic<bool> m_commandsPending;
+
+    std::vector<std::shared_ptr<OpenALSource>> m_streamedSources;
+
+    QTimer * m_streamTimer = nullptr;
 
     bool m_inited;
 
     float m_defaultVolume;
 
     int m_numCars;
-
-    bool m_enabled;
 };
 
 #endif // AUDIOWORKER_HPP
@@ -0,0 +1,101 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "oggstreamdata.hpp"
+
+#include <stdexcept>
+
+#include <vorbis/vorbisfile.h>
+
+OggStreamData::OggStreamData(const std::string & path)
+  : m_channels(0)
+  , m_sampleRate(0)
+{
+    OggStreamData::load(path);
+}
+
+void OggStreamData::load(const std::string & path)
+{
+    close();
+
+    Data::load(path);
+
+    m_file = std::make_unique<OggVorbis_File>();
+    if (ov_fopen(path.c_str(), m_file.get()) < 0)
+    {
+        m_file.reset();
+        throw std::runtime_error("Failed to open '" + path + "'");
+    }
+
+    const vorbis_info * info = ov_info(m_file.get(), -1);
+    m_channels = info->channels;
+    m_sampleRate = static_cast<int>(info->rate);
+}
+
+size_t OggStreamData::read(char * buffer, size_t size)
+{
+    size_t total = 0;
+    while (m_file && total < size)
+    {
+        const int endian = 0; // 0 for Little-Endian, 1 for Big-Endian
+        int bitStream = 0;
+        const long bytes = ov_read(m_file.get(), buffer + total, static_cast<int>(size - total), endian, 2, 1, &bitStream);
+        if (bytes == OV_HOLE)
+        {
+            continue; // Interruption in the data, but decoding can continue
+        }
+
+        if (bytes <= 0)
+        {
+            break;
+        }
+
+        total += static_cast<size_t>(bytes);
+    }
+
+    return total;
+}
+
+void OggStreamData::rewind()
+{
+    if (m_file && ov_pcm_seek(m_file.get(), 0) < 0)
+    {
+        throw std::runtime_error("Failed to rewind '" + path() + "'");
+    }
+}
+
+int OggStreamData::channels() const
+{
+    return m_channels;
+}
+
+int OggStreamData::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+void OggStreamData::close()
+{
+    if (m_file)
+    {
+        ov_clear(m_file.get());
+        m_file.reset();
+    }
+}
+
+OggStreamData::~OggStreamData()
+{
+    close();
+}
@@ -0,0 +1,62 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OGGSTREAMDATA_HPP
+#define OGGSTREAMDATA_HPP
+
+#include <StreamData>
+
+#include <memory>
+#include <string>
+
+struct OggVorbis_File;
+
+//! Decodes an Ogg Vorbis file on demand. Doesn't use OpenAL, so it can be used in any thread.
+class OggStreamData : public STFH::StreamData
+{
+public:
+    /*! Constructor. Opens the given file.
+     *  \throws std::runtime_error on failure. */
+    explicit OggStreamData(const std::string & path);
+
+    //! Destructor.
+    virtual ~OggStreamData() override;
+
+    //! \reimp
+    virtual void load(const std::string & path) override;
+
+    //! \reimp
+    virtual size_t read(char * buffer, size_t size) override;
+
+    //! \reimp
+    virtual void rewind() override;
+
+    //! \reimp
+    virtual int channels() const override;
+
+    //! \reimp
+    virtual int sampleRate() const override;
+
+private:
+    void close();
+
+    std::unique_ptr<OggVorbis_File> m_file;
+
+    int m_channels;
+
+    int m_sampleRate;
+};
+
+#endif // OGGSTREAMDATA_HPP
@@ -15,78 +15,63 @@
 
 #include "openaloggdata.hpp"
 
+#include "oggstreamdata.hpp"
+
 #include <AL/alc.h>
 
-#include <cstdio>
-#include <vector>
 #include <stdexcept>
 
-#include <vorbis/vorbisfile.h>
-
 static bool checkError()
 {
     ALCenum error = alGetError();
     return error == AL_NO_ERROR;
 }
 
-static const int BUFFER_SIZE = 32768; // 32 KB buffers
+static const size_t BUFFER_SIZE = 32768; // 32 KB reads
 
-// This routine is originally from
-// http://www.gamedev.net/page/resources/_/technical/game-programming/introduction-to-ogg-vorbis-r2031
-static void loadOgg(const char * fileName, std::vector<char> & buffer, ALenum & format, ALsizei & freq)
+OpenALOggData::OpenALOggData(const std::string & path)
+  : m_freq(0)
+  , m_buffer(0)
 {
-    int endian = 0; // 0 for Little-Endian, 1 for Big-Endian
-    int bitStream;
-    long bytes;
-    char array[BUFFER_SIZE]; // Local fixed size array
-    FILE * f;
-
-    // Open for binary reading
-    f = std::fopen(fileName, "rb");
-
-    vorbis_info * pInfo;
-    OggVorbis_File oggFile;
-    ov_open(f, &oggFile, nullptr, 0);
+    OpenALOggData::load(path);
+}
 
-    // Get some information about the OGG file
-    pInfo = ov_info(&oggFile, -1);
+OpenALOggData::OpenALOggData(const std::string & path, const Samples & samples)
+  : m_freq(0)
+  , m_buffer(0)
+{
+    Data::load(path);
+    upload(samples);
+}
 
-    // Check the number of channels... always use 16-bit samples
-    if (pInfo->channels == 1)
-    {
-        format = AL_FORMAT_MONO16;
-    }
-    else
-    {
-        format = AL_FORMAT_STEREO16;
-    }
+OpenALOggData::Samples OpenALOggData::decode(const std::string & path)
+{
+    OggStreamData stream(path); // Throws on failure
 
-    freq = static_cast<ALsizei>(pInfo->rate);
+    Samples samples;
+    samples.format = stream.channels() == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+    samples.freq = static_cast<ALsizei>(stream.sampleRate());
 
+    size_t size = 0;
     do
     {
-        // Read up to a buffer's worth of decoded sound data
-        bytes = ov_read(&oggFile, array, BUFFER_SIZE, endian, 2, 1, &bitStream);
+        samples.buffer.resize(size + BUFFER_SIZE);
+        size += stream.read(samples.buffer.data() + size, BUFFER_SIZE);
+    } while (size == samples.buffer.size());
 
-        // Append to end of buffer
-        buffer.insert(buffer.end(), array, array + bytes);
+    samples.buffer.resize(size);
 
-    } while (bytes > 0);
-
-    ov_clear(&oggFile);
-}
-
-OpenALOggData::OpenALOggData(const std::string & path)
-  : m_freq(0)
-  , m_buffer(0)
-{
-    OpenALOggData::load(path);
+    return samples;
 }
 
 void OpenALOggData::load(const std::string & path)
 {
     Data::load(path);
+    upload(decode(path));
+}
 
+void OpenALOggData::upload(const Samples & samples)
+{
     alGetError();
 
     if (!m_buffer)
@@ -94,14 +79,13 @@ void OpenALOggData::load(const std::string & path)
         alGenBuffers(1, &m_buffer);
     }
 
-    std::vector<char> oggBuffer;
-    loadOgg(path.c_str(), oggBuffer, m_format, m_freq);
-
-    alBufferData(m_buffer, m_format, &oggBuffer[0], static_cast<ALsizei>(oggBuffer.size()), m_freq);
+    m_format = samples.format;
+    m_freq = samples.freq;
+    alBufferData(m_buffer, m_format, samples.buffer.data(), static_cast<ALsizei>(samples.buffer.size()), m_freq);
 
     if (!checkError())
     {
-        throw std::runtime_error("Failed to set buffer data of '" + path + "'");
+        throw std::runtime_error("Failed to set buffer data of '" + path() + "'");
     }
 }
 
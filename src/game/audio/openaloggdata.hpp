@@ -18,13 +18,33 @@
 
 #include "openaldata.hpp"
 
+#include <vector>
+
 //! OpenAL Ogg data loader.
 class OpenALOggData : public OpenALData
 {
 public:
+    //! Decoded 16-bit PCM data.
+    struct Samples
+    {
+        std::vector<char> buffer;
+
+        ALenum format = AL_FORMAT_MONO16;
+
+        ALsizei freq = 0;
+    };
+
     //! Constructor.
     OpenALOggData(const std::string & path);
 
+    //! Constructor. Uploads already decoded samples of the given file.
+    OpenALOggData(const std::string & path, const Samples & samples);
+
+    /*! Decode the given file. Doesn't use OpenAL, so decoding can be done in
+     *  any thread and only the upload in the thread owning the context.
+     *  \throws std::runtime_error on failure. */
+    static Samples decode(const std::string & path);
+
     //! Destructor.
     virtual ~OpenALOggData() override;
 
@@ -35,6 +55,8 @@ public:
     virtual ALuint buffer() const override;
 
 private:
+    void upload(const Samples & samples);
+
     ALsizei m_freq;
     ALenum m_format;
     ALuint m_buffer;
@@ -15,6 +15,7 @@
 
 #include "openalsource.hpp"
 #include "openaldata.hpp"
+#include "openalstreamqueue.hpp"
 
 #include <AL/alc.h>
 
@@ -45,9 +46,22 @@ void OpenALSource::setData(STFH::DataPtr data)
 {
     alGetError();
 
-    if (const auto soundData = std::dynamic_pointer_cast<OpenALData>(data))
+    if (const auto streamData = std::dynamic_pointer_cast<STFH::StreamData>(data))
     {
         Source::setData(data);
+        m_streamQueue.reset();
+        alSourcei(m_handle, AL_BUFFER, 0);
+        m_streamQueue = std::make_unique<OpenALStreamQueue>(m_handle, streamData);
+
+        if (!checkError())
+        {
+            throw std::runtime_error("Failed to create stream buffers for '" + data->path() + "'");
+        }
+    }
+    else if (const auto soundData = std::dynamic_pointer_cast<OpenALData>(data))
+    {
+        Source::setData(data);
+        m_streamQueue.reset();
         alSourcei(m_handle, AL_BUFFER, static_cast<ALint>(soundData->buffer()));
 
         if (!checkError())
@@ -63,13 +77,28 @@ void OpenALSource::setData(STFH::DataPtr data)
 
 void OpenALSource::play(bool loop)
 {
-    alSourcei(m_handle, AL_LOOPING, loop);
-    alSourcePlay(m_handle);
+    if (m_streamQueue)
+    {
+        // Streams loop by rewinding the decoder, not the queued buffers
+        m_streamQueue->play(loop);
+    }
+    else
+    {
+        alSourcei(m_handle, AL_LOOPING, loop);
+        alSourcePlay(m_handle);
+    }
 }
 
 void OpenALSource::stop()
 {
-    alSourceStop(m_handle);
+    if (m_streamQueue)
+    {
+        m_streamQueue->stop();
+    }
+    else
+    {
+        alSourceStop(m_handle);
+    }
 }
 
 void OpenALSource::setVolume(float volume)
@@ -102,7 +131,22 @@ void OpenALSource::setReferenceDist(float refDist)
     alSourcef(m_handle, AL_REFERENCE_DISTANCE, refDist);
 }
 
+bool OpenALSource::isStreamed() const
+{
+    return m_streamQueue != nullptr;
+}
+
+void OpenALSource::update()
+{
+    if (m_streamQueue)
+    {
+        m_streamQueue->update();
+    }
+}
+
 OpenALSource::~OpenALSource()
 {
+    // The buffers must be unqueued before deleting the source
+    m_streamQueue.reset();
     alDeleteSources(1, &m_handle);
 }
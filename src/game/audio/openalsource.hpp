@@ -22,8 +22,13 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include <memory>
 #include <string>
 
+class OpenALStreamQueue;
+
+/*! A sound source. Plays either a fully decoded OpenALData or streams
+ *  STFH::StreamData through a ring of buffers. */
 class OpenALSource : public STFH::Source
 {
 public:
@@ -57,8 +62,17 @@ public:
     //! \reimp
     virtual void setReferenceDist(float refDist) override;
 
+    //! \return true if the data is streamed.
+    bool isStreamed() const;
+
+    /*! Refill the buffers of a streamed source. Call periodically
+     *  in the thread owning the context. */
+    void update();
+
 private:
     ALuint m_handle;
+
+    std::unique_ptr<OpenALStreamQueue> m_streamQueue;
 };
 
 #endif // OPENALSOURCE_HPP
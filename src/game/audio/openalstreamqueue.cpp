@@ -0,0 +1,79 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "openalstreamqueue.hpp"
+
+#include <stdexcept>
+
+// 4 x 32 KB is about 0.7 s of 44.1 kHz stereo
+static const size_t BUFFER_COUNT = 4;
+
+static const size_t BUFFER_SIZE = 32768;
+
+OpenALStreamQueue::OpenALStreamQueue(ALuint source, STFH::StreamDataPtr data)
+  : StreamQueue(data, BUFFER_COUNT, BUFFER_SIZE)
+  , m_source(source)
+  , m_buffers(BUFFER_COUNT)
+  , m_format(data->channels() == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16)
+  , m_sampleRate(data->sampleRate())
+{
+    if (data->channels() < 1 || data->channels() > 2)
+    {
+        throw std::runtime_error("Unsupported number of channels in '" + data->path() + "'");
+    }
+
+    alGenBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+}
+
+size_t OpenALStreamQueue::unqueueProcessedBuffers()
+{
+    ALint processed = 0;
+    alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+    for (ALint i = 0; i < processed; i++)
+    {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(m_source, 1, &buffer);
+    }
+
+    return static_cast<size_t>(processed);
+}
+
+void OpenALStreamQueue::queueBuffer(size_t index, const char * data, size_t size)
+{
+    alBufferData(m_buffers[index], m_format, data, static_cast<ALsizei>(size), m_sampleRate);
+    alSourceQueueBuffers(m_source, 1, &m_buffers[index]);
+}
+
+void OpenALStreamQueue::startPlayback()
+{
+    ALint state = 0;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+    if (state != AL_PLAYING)
+    {
+        alSourcePlay(m_source);
+    }
+}
+
+void OpenALStreamQueue::stopPlayback()
+{
+    alSourceStop(m_source);
+    alSourcei(m_source, AL_BUFFER, 0); // Unqueues all buffers
+}
+
+OpenALStreamQueue::~OpenALStreamQueue()
+{
+    stopPlayback();
+    alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), m_buffers.data());
+}
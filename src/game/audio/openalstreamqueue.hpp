@@ -0,0 +1,58 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OPENALSTREAMQUEUE_HPP
+#define OPENALSTREAMQUEUE_HPP
+
+#include <StreamQueue>
+
+#include <AL/al.h>
+
+#include <vector>
+
+//! Queues the buffers of a streamed sound to an OpenAL source.
+class OpenALStreamQueue : public STFH::StreamQueue
+{
+public:
+    //! Constructor. Generates the buffers for the given source.
+    OpenALStreamQueue(ALuint source, STFH::StreamDataPtr data);
+
+    //! Destructor.
+    virtual ~OpenALStreamQueue() override;
+
+protected:
+    //! \reimp
+    virtual size_t unqueueProcessedBuffers() override;
+
+    //! \reimp
+    virtual void queueBuffer(size_t index, const char * data, size_t size) override;
+
+    //! \reimp
+    virtual void startPlayback() override;
+
+    //! \reimp
+    virtual void stopPlayback() override;
+
+private:
+    ALuint m_source;
+
+    std::vector<ALuint> m_buffers;
+
+    ALenum m_format;
+
+    ALsizei m_sampleRate;
+};
+
+#endif // OPENALSTREAMQUEUE_HPP
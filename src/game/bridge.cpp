@@ -94,7 +94,7 @@ Bridge::Bridge()
     const auto railLayer = static_cast<int>(Layers::Collision::BridgeRails);
     rail0->setCollisionLayer(railLayer);
     rail0->physicsComponent().setMass(0, true);
-    const auto railShader = Renderer::instance().program("defaultSpecular");
+    const auto railShader = Renderer::hasInstance() ? Renderer::instance().program("defaultSpecular") : nullptr;
     rail0->shape()->view()->setShaderProgram(railShader);
     rail1->setCollisionLayer(railLayer);
     rail1->physicsComponent().setMass(0, true);
@@ -36,15 +36,26 @@ CarSoundEffectManager::CarSoundEffectManager(
     m_skidTimer.setInterval(100);
 }
 
+void CarSoundEffectManager::setAudioWorker(AudioWorker * audioWorker)
+{
+    AudioSource::setAudioWorker(audioWorker);
+
+    m_sourceIds.engine = sourceId(m_handles.engineSoundHandle);
+    m_sourceIds.hit = sourceId(m_handles.hitSoundHandle);
+    m_sourceIds.skid = sourceId(m_handles.skidSoundHandle);
+    m_sourceIds.wallHit = sourceId("carHit2");
+    m_sourceIds.objectHit = sourceId("carHit3");
+}
+
 void CarSoundEffectManager::startEngineSound()
 {
-    emit playRequested(m_handles.engineSoundHandle, true);
-    emit locationChanged(m_handles.engineSoundHandle, m_car.location().i(), m_car.location().j());
+    queueCommand(AudioCommand::Type::PlayLooped, m_sourceIds.engine);
+    queueCommand(AudioCommand::Type::SetLocation, m_sourceIds.engine, m_car.location().i(), m_car.location().j());
 }
 
 void CarSoundEffectManager::stopEngineSound()
 {
-    emit stopRequested(m_handles.engineSoundHandle);
+    queueCommand(AudioCommand::Type::Stop, m_sourceIds.engine);
 }
 
 void CarSoundEffectManager::update()
@@ -78,10 +89,10 @@ void CarSoundEffectManager::processEngineSound()
         }
 
         m_prevSpeed = speed;
-        emit pitchChanged(m_handles.engineSoundHandle, pitch);
+        queueCommand(AudioCommand::Type::SetPitch, m_sourceIds.engine, pitch);
     }
 
-    emit locationChanged(m_handles.engineSoundHandle, m_car.location().i(), m_car.location().j());
+    queueCommand(AudioCommand::Type::SetLocation, m_sourceIds.engine, m_car.location().i(), m_car.location().j());
     m_prevLocation = m_car.location();
 }
 
@@ -91,19 +102,24 @@ void CarSoundEffectManager::processSkidSound()
     {
         if (!m_skidTimer.isActive())
         {
-            emit locationChanged(m_handles.skidSoundHandle, m_car.location().i(), m_car.location().j());
-            emit playRequested(m_handles.skidSoundHandle, false);
+            playAtCarLocation(m_sourceIds.skid);
             m_skidPlaying = true;
             m_skidTimer.start();
         }
     }
     else if (m_skidPlaying)
     {
-        emit stopRequested(m_handles.skidSoundHandle);
+        queueCommand(AudioCommand::Type::Stop, m_sourceIds.skid);
         m_skidPlaying = false;
     }
 }
 
+void CarSoundEffectManager::playAtCarLocation(uint16_t source)
+{
+    queueCommand(AudioCommand::Type::SetLocation, source, m_car.location().i(), m_car.location().j());
+    queueCommand(AudioCommand::Type::Play, source);
+}
+
 void CarSoundEffectManager::collision(MCObject & collidingObject)
 {
     const MCVector3dF speedDiff(collidingObject.physicsComponent().velocity() - m_car.physicsComponent().velocity());
@@ -111,22 +127,19 @@ void CarSoundEffectManager::collision(MCObject & collidingObject)
     {
         if (collidingObject.typeId() == m_car.typeId() || collidingObject.typeId() == MCObject::typeId("grandstand") || collidingObject.typeId() == MCObject::typeId("tree") || collidingObject.typeId() == MCObject::typeId("rock"))
         {
-            emit locationChanged(m_handles.hitSoundHandle, m_car.location().i(), m_car.location().j());
-            emit playRequested(m_handles.hitSoundHandle, false);
+            playAtCarLocation(m_sourceIds.hit);
             m_hitTimer.start();
         }
         else if (
           collidingObject.typeId() == MCObject::typeId("wall") || collidingObject.typeId() == MCObject::typeId("bridgeRail") || collidingObject.typeId() == MCObject::typeId("wallLong"))
         {
-            emit locationChanged("carHit2", m_car.location().i(), m_car.location().j());
-            emit playRequested("carHit2", false);
+            playAtCarLocation(m_sourceIds.wallHit);
             m_hitTimer.start();
         }
         else if (
           collidingObject.typeId() == MCObject::typeId("dustRacing2DBanner") || collidingObject.typeId() == MCObject::typeId("brake") || collidingObject.typeId() == MCObject::typeId("crate") || collidingObject.typeId() == MCObject::typeId("left") || collidingObject.typeId() == MCObject::typeId("plant") || collidingObject.typeId() == MCObject::typeId("right") || collidingObject.typeId() == MCObject::typeId("tire"))
         {
-            emit locationChanged("carHit3", m_car.location().i(), m_car.location().j());
-            emit playRequested("carHit3", false);
+            playAtCarLocation(m_sourceIds.objectHit);
             m_hitTimer.start();
         }
     }
@@ -27,8 +27,8 @@
 class Car;
 class MCObject;
 
-/*! Manages sound effects, like the engine sound. These are connected
- *  to the AudioThread via Qt signals. */
+/*! Manages sound effects, like the engine sound. These are updated every frame,
+ *  so they are queued to the AudioWorker as commands with pre-resolved source ids. */
 class CarSoundEffectManager : public AudioSource
 {
     Q_OBJECT
@@ -48,6 +48,9 @@ public:
     //! Destructor.
     virtual ~CarSoundEffectManager();
 
+    //! \reimp
+    virtual void setAudioWorker(AudioWorker * audioWorker) override;
+
     void update();
 
     void collision(MCObject & collidingObject);
@@ -63,6 +66,17 @@ private:
 
     void processSkidSound();
 
+    void playAtCarLocation(uint16_t source);
+
+    struct SourceIds
+    {
+        uint16_t engine = AudioCommand::NO_SOURCE;
+        uint16_t hit = AudioCommand::NO_SOURCE;
+        uint16_t skid = AudioCommand::NO_SOURCE;
+        uint16_t wallHit = AudioCommand::NO_SOURCE;
+        uint16_t objectHit = AudioCommand::NO_SOURCE;
+    };
+
     Car & m_car;
 
     int m_gear;
@@ -77,6 +91,8 @@ private:
 
     MultiSoundHandles m_handles;
 
+    SourceIds m_sourceIds;
+
     bool m_skidPlaying;
 };
 
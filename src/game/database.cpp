@@ -17,7 +17,6 @@
 #include "../common/config.hpp"
 #include "../contrib/SimpleLogger/src/simple_logger.hpp"
 #include "track.hpp"
-#include "trackdata.hpp"
 
 #include <stdexcept>
 
@@ -77,6 +76,12 @@ void printError(QSqlQuery & query)
 Database * Database::m_instance = nullptr;
 
 Database::Database()
+  : Database(getDbFilePath())
+{
+}
+
+Database::Database(QString filePath)
+  : m_filePath(filePath)
 {
     if (!Database::m_instance)
     {
@@ -92,10 +97,10 @@ Database::Database()
 
 void Database::initialize()
 {
-    L().info() << "Creating SQLite database file at " << getDbFilePath().toStdString();
+    L().info() << "Creating SQLite database file at " << m_filePath.toStdString();
 
     QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName(getDbFilePath());
+    db.setDatabaseName(m_filePath);
     db.open();
 
     QSqlQuery query;
@@ -132,7 +137,7 @@ void Database::saveLapRecord(const Track & track, int msecs)
     QSqlQuery query;
     query.prepare("SELECT time FROM " + LAP_RECORD_TABLE + " WHERE " + LAP_RECORD_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     if (!query.exec())
     {
         printError(query);
@@ -141,12 +146,12 @@ void Database::saveLapRecord(const Track & track, int msecs)
 
     if (!query.first())
     {
-        L().debug() << "New lap record database entry added for " << track.trackData().name().toStdString();
+        L().debug() << "New lap record database entry added for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("INSERT INTO " + LAP_RECORD_TABLE + " (track_name, version, time) VALUES (:track_name, :version, :time)");
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":time", msecs);
         if (!query.exec())
         {
@@ -155,12 +160,12 @@ void Database::saveLapRecord(const Track & track, int msecs)
     }
     else
     {
-        L().debug() << "Updated lap record database entry for " << track.trackData().name().toStdString();
+        L().debug() << "Updated lap record database entry for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("UPDATE " + LAP_RECORD_TABLE + " SET track_name = :track_name, version = :version, time = :time WHERE " + LAP_RECORD_FILTER);
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":time", msecs);
         if (!query.exec())
         {
@@ -176,7 +181,7 @@ std::pair<int, bool> Database::loadLapRecord(const Track & track) const
     QSqlQuery query;
     query.prepare("SELECT time FROM " + LAP_RECORD_TABLE + " WHERE " + LAP_RECORD_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     if (!query.exec())
     {
         printError(query);
@@ -211,7 +216,7 @@ void Database::saveRaceRecord(const Track & track, int msecs, int lapCount, Diff
     QSqlQuery query;
     query.prepare("SELECT time FROM " + RACE_RECORD_TABLE + " WHERE " + RACE_RECORD_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -222,12 +227,12 @@ void Database::saveRaceRecord(const Track & track, int msecs, int lapCount, Diff
 
     if (!query.first())
     {
-        L().debug() << "New race record database entry added for " << track.trackData().name().toStdString();
+        L().debug() << "New race record database entry added for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("INSERT INTO " + RACE_RECORD_TABLE + " (track_name, version, lap_count, difficulty, time) VALUES (:track_name, :version, :lap_count, :difficulty, :time)");
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":lap_count", lapCount);
         query.bindValue(":difficulty", static_cast<int>(difficulty));
         query.bindValue(":time", msecs);
@@ -238,12 +243,12 @@ void Database::saveRaceRecord(const Track & track, int msecs, int lapCount, Diff
     }
     else
     {
-        L().debug() << "Updated race record database entry for " << track.trackData().name().toStdString();
+        L().debug() << "Updated race record database entry for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("UPDATE " + RACE_RECORD_TABLE + " SET track_name = :track_name, version = :version, time = :time WHERE " + RACE_RECORD_FILTER);
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":lap_count", lapCount);
         query.bindValue(":difficulty", static_cast<int>(difficulty));
         query.bindValue(":time", msecs);
@@ -261,7 +266,7 @@ std::pair<int, bool> Database::loadRaceRecord(const Track & track, int lapCount,
     QSqlQuery query;
     query.prepare("SELECT time FROM " + RACE_RECORD_TABLE + " WHERE " + RACE_RECORD_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -298,7 +303,7 @@ void Database::saveBestPos(const Track & track, int pos, int lapCount, Difficult
     QSqlQuery query;
     query.prepare("SELECT position FROM " + BEST_POSITION_TABLE + " WHERE " + BEST_POSITION_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -309,12 +314,12 @@ void Database::saveBestPos(const Track & track, int pos, int lapCount, Difficult
 
     if (!query.first())
     {
-        L().debug() << "New best position database entry added for " << track.trackData().name().toStdString();
+        L().debug() << "New best position database entry added for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("INSERT INTO " + BEST_POSITION_TABLE + " (track_name, version, lap_count, difficulty, position) VALUES (:track_name, :version, :lap_count, :difficulty, :position)");
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":lap_count", lapCount);
         query.bindValue(":difficulty", static_cast<int>(difficulty));
         query.bindValue(":position", pos);
@@ -325,12 +330,12 @@ void Database::saveBestPos(const Track & track, int pos, int lapCount, Difficult
     }
     else
     {
-        L().debug() << "Updated best position database entry for " << track.trackData().name().toStdString();
+        L().debug() << "Updated best position database entry for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("UPDATE " + BEST_POSITION_TABLE + " SET track_name = :track_name, version = :version, position = :position WHERE " + BEST_POSITION_FILTER);
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":lap_count", lapCount);
         query.bindValue(":difficulty", static_cast<int>(difficulty));
         query.bindValue(":position", pos);
@@ -348,7 +353,7 @@ std::pair<int, bool> Database::loadBestPos(const Track & track, int lapCount, Di
     QSqlQuery query;
     query.prepare("SELECT position FROM " + BEST_POSITION_TABLE + " WHERE " + BEST_POSITION_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -385,7 +390,7 @@ void Database::saveTrackUnlockStatus(const Track & track, int lapCount, Difficul
     QSqlQuery query;
     query.prepare("SELECT * FROM " + TRACK_UNLOCK_TABLE + " WHERE " + TRACK_UNLOCK_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -396,12 +401,12 @@ void Database::saveTrackUnlockStatus(const Track & track, int lapCount, Difficul
 
     if (!query.first())
     {
-        L().debug() << "New track unlock database entry added for " << track.trackData().name().toStdString();
+        L().debug() << "New track unlock database entry added for " << track.name().toStdString();
 
         QSqlQuery query;
         query.prepare("INSERT INTO " + TRACK_UNLOCK_TABLE + " (track_name, version, lap_count, difficulty) VALUES (:track_name, :version, :lap_count, :difficulty)");
         query.bindValue(":version", TRACK_SET_VERSION);
-        query.bindValue(":track_name", track.trackData().name());
+        query.bindValue(":track_name", track.name());
         query.bindValue(":lap_count", lapCount);
         query.bindValue(":difficulty", static_cast<int>(difficulty));
         if (!query.exec())
@@ -418,7 +423,7 @@ bool Database::loadTrackUnlockStatus(const Track & track, int lapCount, Difficul
     QSqlQuery query;
     query.prepare("SELECT * FROM " + TRACK_UNLOCK_TABLE + " WHERE " + TRACK_UNLOCK_FILTER);
     query.bindValue(":version", TRACK_SET_VERSION);
-    query.bindValue(":track_name", track.trackData().name());
+    query.bindValue(":track_name", track.name());
     query.bindValue(":lap_count", lapCount);
     query.bindValue(":difficulty", static_cast<int>(difficulty));
     if (!query.exec())
@@ -21,6 +21,8 @@
 #include <map>
 #include <mutex>
 
+#include <QString>
+
 class Track;
 
 class Database
@@ -28,6 +30,9 @@ class Database
 public:
     Database();
 
+    //! Use the given SQLite database file, e.g. ":memory:" for a database that is never saved.
+    explicit Database(QString filePath);
+
     void saveLapRecord(const Track & track, int msecs);
 
     std::pair<int, bool> loadLapRecord(const Track & track) const;
@@ -59,6 +64,8 @@ private:
 
     static Database * m_instance;
 
+    QString m_filePath;
+
     mutable std::mutex m_mutex;
 };
 
@@ -45,6 +45,7 @@
 #include "argengine.hpp"
 #include "simple_logger.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 static const unsigned int MAX_PLAYERS = 2;
@@ -53,9 +54,9 @@ Game * Game::m_instance = nullptr;
 
 using juzzlin::L;
 
-Game::Game(int & argc, char ** argv)
+Game::Game(int & argc, char ** argv, bool headless)
   : m_app(argc, argv)
-  , m_database(std::make_unique<Database>())
+  , m_database(headless ? std::make_unique<Database>(":memory:") : std::make_unique<Database>())
   , m_forceNoVSync(false)
   , m_settings()
   , m_difficultyProfile(m_settings.loadDifficulty())
@@ -67,8 +68,7 @@ Game::Game(int & argc, char ** argv)
   , m_trackLoader(new TrackLoader)
   , m_screenIndex(m_settings.loadValue(m_settings.screenKey(), 0))
   , m_updateFps(60)
-  , m_updateDelay(1000 / m_updateFps)
-  , m_timeStep(1000 / m_updateFps)
+  , m_simulationClock(std::chrono::milliseconds { 1000 / m_updateFps }, 5)
   , m_lapCount(m_settings.loadValue(Settings::lapCountKey(), 5))
   , m_paused(false)
   , m_renderElapsed(0)
@@ -83,9 +83,12 @@ Game::Game(int & argc, char ** argv)
     assert(!Game::m_instance);
     Game::m_instance = this;
 
-    parseArgs(argc, argv);
+    if (!headless)
+    {
+        parseArgs(argc, argv);
 
-    createRenderer();
+        createRenderer();
+    }
 
     connect(&m_difficultyProfile, &DifficultyProfile::difficultyChanged, this, [this]() {
         m_trackLoader->updateLockedTracks(m_lapCount, m_difficultyProfile.difficulty());
@@ -109,16 +112,23 @@ Game::Game(int & argc, char ** argv)
 
     connect(&m_updateTimer, &QTimer::timeout, this, [this]() {
         const qint64 now = m_elapsedTimer.elapsed();
-        const qint64 deltaMs = now - m_lastUpdateTime;
+        const size_t steps = m_simulationClock.advance(std::chrono::milliseconds { now - m_lastUpdateTime });
         m_lastUpdateTime = now;
         m_stateMachine->update();
-        m_scene->updateFrame(*m_inputHandler, std::chrono::milliseconds { (deltaMs + m_lastDeltaMs) / 2 });
-        m_lastDeltaMs = deltaMs;
+
+        // Run whole steps of fixed length so that the results don't depend on the frame rate
+        for (size_t i = 0; i < steps; i++)
+        {
+            m_scene->updateFrame(*m_inputHandler, m_simulationClock.stepLength());
+        }
+
+        m_world->setRenderInterpolation(m_simulationClock.interpolation());
+        m_scene->updateView();
         m_scene->updateOverlays();
         m_renderer->renderNow();
     });
 
-    m_updateTimer.setInterval(m_updateDelay);
+    m_updateTimer.setInterval(updateDelay());
 
     connect(m_stateMachine, &StateMachine::exitGameRequested, this, &Game::exitGame);
 
@@ -185,6 +195,12 @@ void Game::parseArgs(int argc, char ** argv)
       },
       false, "Force vsync off.");
 
+    ae.addOption(
+      { "--time-scale" }, [=](std::string value) {
+          m_simulationClock.setTimeScale(std::max(std::stof(value), 0.1f));
+      },
+      false, "Run the simulation faster (> 1.0) or slower (< 1.0) than real time.");
+
     ae.addOption(
       { "--debug" }, [=]() {
           L::setLoggingLevel(L::Level::Debug);
@@ -208,7 +224,10 @@ void Game::createRenderer()
 {
     QSurfaceFormat format;
 
-#ifdef __MC_GL30__
+#ifdef __MC_GL33__
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+#elif defined(__MC_GL30__)
     format.setVersion(3, 0);
     format.setProfile(QSurfaceFormat::CoreProfile);
 #elif defined(__MC_GLES__)
@@ -428,6 +447,11 @@ void Game::init()
 void Game::start()
 {
     m_paused = false;
+
+    // Don't try to catch up the time spent in pause
+    m_lastUpdateTime = m_elapsedTimer.elapsed();
+    m_simulationClock.reset();
+
     m_updateTimer.start();
 }
 
@@ -445,6 +469,12 @@ Game::Fps Game::fps() const
 void Game::setFps(Game::Fps fps)
 {
     m_fps = fps;
+    m_updateTimer.setInterval(updateDelay());
+}
+
+int Game::updateDelay() const
+{
+    return 1000 / (m_fps == Fps::Fps30 ? 30 : 60);
 }
 
 void Game::togglePause()
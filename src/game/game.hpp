@@ -28,6 +28,7 @@
 
 #include "application.hpp"
 #include "settings.hpp"
+#include "simulationclock.hpp"
 
 class AudioWorker;
 class Database;
@@ -68,7 +69,10 @@ public:
         Fps60
     };
 
-    Game(int & argc, char ** argv);
+    /*! Constructor.
+     *  \param headless Don't create the window and the renderer and use a database that
+     *  is never saved. Only the simulation can be run, e.g. for benchmarking. */
+    Game(int & argc, char ** argv, bool headless = false);
     virtual ~Game() override;
 
     //! Return the game instance.
@@ -127,6 +131,9 @@ private:
     void start();
     void stop();
 
+    //! \return interval of the update timer in msecs according to the selected fps.
+    int updateDelay() const;
+
     Application m_app;
 
     QTranslator m_appTranslator;
@@ -154,9 +161,8 @@ private:
     int m_screenIndex = 0;
 
     int m_updateFps;
-    int m_updateDelay;
 
-    float m_timeStep;
+    SimulationClock m_simulationClock;
 
     int m_lapCount;
 
@@ -178,7 +184,6 @@ private:
 
     QElapsedTimer m_elapsedTimer;
     qint64 m_lastUpdateTime = 0;
-    qint64 m_lastDeltaMs = 0;
 
     static Game * m_instance;
 };
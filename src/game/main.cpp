@@ -43,6 +43,7 @@ static void initLogger()
     L::setLevelSymbol(L::Level::Warning, "<W>");
     L::setLevelSymbol(L::Level::Fatal, "<F>");
     L::enableEchoMode(true);
+    L::enableAsyncMode(true); // Don't block the game loop on writing the log
     L().info() << "Dust Racing 2D version " << VERSION;
     L().info() << "Compiled against Qt version " << QT_VERSION_STR;
 }
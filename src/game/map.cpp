@@ -16,24 +16,74 @@
 #include "map.hpp"
 #include "tracktile.hpp"
 
-#include <QPoint>
-#include <QPointF>
-
 Map::Map(size_t cols, size_t rows)
-  : MapBase(cols, rows)
+  : m_cols(cols)
+  , m_rows(rows)
 {
-    // Create tiles and set coordinates.
-    for (size_t i = 0; i < cols; i++)
+    m_tiles.reserve(cols * rows);
+    for (size_t j = 0; j < rows; j++)
     {
-        for (size_t j = 0; j < rows; j++)
+        for (size_t i = 0; i < cols; i++)
         {
-            const auto newTile = std::make_shared<TrackTile>(
-              QPointF(TrackTile::width() / 2 + i * TrackTile::width(),
-                      TrackTile::height() / 2 + j * TrackTile::height()),
-              QPoint(static_cast<int>(i), static_cast<int>(j)));
-            setTile(i, j, newTile);
+            m_tiles.emplace_back(i, j);
         }
     }
 }
 
+size_t Map::cols() const
+{
+    return m_cols;
+}
+
+size_t Map::rows() const
+{
+    return m_rows;
+}
+
+TrackTile & Map::tile(size_t x, size_t y)
+{
+    return m_tiles[y * m_cols + x];
+}
+
+const TrackTile & Map::tile(size_t x, size_t y) const
+{
+    return m_tiles[y * m_cols + x];
+}
+
+void Map::setSurface(TrackTile & tile, MCSurfacePtr surface)
+{
+    tile.setSurfaceIndex(surfaceIndex(surface));
+}
+
+void Map::setPreviewSurface(TrackTile & tile, MCSurfacePtr surface)
+{
+    tile.setPreviewSurfaceIndex(surfaceIndex(surface));
+}
+
+const MCSurfacePtr & Map::surface(uint16_t index) const
+{
+    static const MCSurfacePtr noSurface;
+    return index < m_surfaces.size() ? m_surfaces[index] : noSurface;
+}
+
+uint16_t Map::surfaceIndex(MCSurfacePtr surface)
+{
+    if (!surface)
+    {
+        return TrackTile::NO_SURFACE;
+    }
+
+    // A track uses only a dozen surfaces
+    for (size_t index = 0; index < m_surfaces.size(); index++)
+    {
+        if (m_surfaces[index] == surface)
+        {
+            return static_cast<uint16_t>(index);
+        }
+    }
+
+    m_surfaces.push_back(surface);
+    return static_cast<uint16_t>(m_surfaces.size() - 1);
+}
+
 Map::~Map() = default;
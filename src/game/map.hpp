@@ -16,19 +16,60 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
-#include "../common/mapbase.hpp"
+#include "tracktile.hpp"
+
+#include <MCSurface>
+
+#include <vector>
 
 class TrackData;
 
-//! Base class for the tile matrix used by TrackData.
-class Map : public MapBase
+/*! The tile matrix used by TrackData. The game keeps its tiles in a contiguous array
+ *  instead of the shared tile objects of MapBase, which is only used by the editor.
+ *  The game never resizes the map. */
+class Map
 {
 public:
     //! Constuctor.
     Map(size_t cols, size_t rows);
 
+    Map(const Map & other) = delete;
+
+    Map & operator=(const Map & other) = delete;
+
     //! Destructor.
-    virtual ~Map();
+    ~Map();
+
+    //! Get column count
+    size_t cols() const;
+
+    //! Get row count
+    size_t rows() const;
+
+    //! Get tile at given coordinates. It is assumed that the coordinates are valid.
+    TrackTile & tile(size_t x, size_t y);
+
+    //! Get tile at given coordinates. It is assumed that the coordinates are valid.
+    const TrackTile & tile(size_t x, size_t y) const;
+
+    //! Set the surface of the given tile.
+    void setSurface(TrackTile & tile, MCSurfacePtr surface);
+
+    //! Set the preview surface of the given tile.
+    void setPreviewSurface(TrackTile & tile, MCSurfacePtr surface);
+
+    //! \return surface of the given index or nullptr if TrackTile::NO_SURFACE.
+    const MCSurfacePtr & surface(uint16_t index) const;
+
+private:
+    uint16_t surfaceIndex(MCSurfacePtr surface);
+
+    size_t m_cols, m_rows;
+
+    std::vector<TrackTile> m_tiles;
+
+    //! The distinct surfaces referred by the tiles.
+    std::vector<MCSurfacePtr> m_surfaces;
 };
 
 #endif // MAP_HPP
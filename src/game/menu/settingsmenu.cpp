@@ -26,7 +26,6 @@
 #include "surfacemenu.hpp"
 #include "textmenuitemview.hpp"
 #include "track.hpp"
-#include "trackdata.hpp"
 #include "trackloader.hpp"
 #include "vsyncmenu.hpp"
 
@@ -107,9 +106,9 @@ private:
                     for (size_t i = 0; i < trackLoader.tracks(); i++)
                     {
                         Track & track = *trackLoader.track(i);
-                        if (track.trackData().index() > 0)
+                        if (track.index() > 0)
                         {
-                            track.trackData().setIsLocked(true);
+                            track.setIsLocked(true);
                         }
                 }
                 Database::instance().resetTrackUnlockStatuses(); });
@@ -23,7 +23,6 @@
 #include "settings.hpp"
 #include "timing.hpp"
 #include "track.hpp"
-#include "trackdata.hpp"
 #include "tracktile.hpp"
 
 #include <MenuItem>
@@ -35,7 +34,6 @@
 #include <MCTextureText>
 
 #include "../common/config.hpp"
-#include "../common/mapbase.hpp"
 
 #include <cassert>
 #include <memory>
@@ -89,6 +87,18 @@ public:
         if (focused)
         {
             updateData();
+
+            // Parse the current and the adjacent tracks in the background, so that they can be selected without a delay
+            m_track->prefetch();
+            if (auto && next = m_track->next().lock())
+            {
+                next->prefetch();
+            }
+
+            if (auto && prev = m_track->prev().lock())
+            {
+                prev->prefetch();
+            }
         }
     }
 
@@ -148,14 +158,18 @@ void TrackItem::updateData()
 
 void TrackItem::renderTiles()
 {
-    const MapBase & rMap = m_track->trackData().map();
+    // The thumbnail is cached, so that the track doesn't need to be loaded for the preview.
+    // A track found broken while loading the thumbnail gets an empty one.
+    const auto & thumbnail = m_track->thumbnail();
+    const auto cols = m_track->info().cols;
+    const auto rows = m_track->info().rows;
 
     const auto previewW = width();
     const auto previewH = height();
 
     // Set tileW and tileH so that they are squares
-    float tileW = previewW / rMap.cols();
-    float tileH = previewH / rMap.rows();
+    float tileW = previewW / cols;
+    float tileH = previewH / rows;
 
     if (tileW > tileH)
     {
@@ -168,48 +182,39 @@ void TrackItem::renderTiles()
 
     // Center the preview
     float initX;
-    if (rMap.cols() % 2 == 0)
+    if (cols % 2 == 0)
     {
-        initX = x() - rMap.cols() * tileW / 2 + tileW / 4 + menu()->x();
+        initX = x() - cols * tileW / 2 + tileW / 4 + menu()->x();
     }
     else
     {
-        initX = x() - rMap.cols() * tileW / 2 + menu()->x();
+        initX = x() - cols * tileW / 2 + menu()->x();
     }
 
-    // Loop through the visible tile matrix and draw the tiles
-    float tileY = y() - rMap.rows() * tileH / 2 + menu()->y();
-    for (size_t j = 0; j < rMap.rows(); j++)
+    const float initY = y() - rows * tileH / 2 + menu()->y();
+
+    // Draw the visible tiles
+    for (auto && tile : thumbnail.tiles)
     {
-        float tileX = initX;
-        for (size_t i = 0; i < rMap.cols(); i++)
-        {
-            const auto tile = std::static_pointer_cast<TrackTile>(rMap.getTile(i, j));
-            const auto surface = tile->previewSurface();
-            if (surface && !tile->excludeFromMinimap())
-            {
-                surface->setShaderProgram(Renderer::instance().program("menu"));
-                surface->bind();
-
-                if (m_track->trackData().isLocked())
-                {
-                    surface->setColor(MCGLColor(0.5, 0.5, 0.5));
-                }
-                else
-                {
-                    surface->setColor(MCGLColor(1.0, 1.0, 1.0));
-                }
-
-                surface->setSize(tileH, tileW);
-                surface->render(
-                  nullptr,
-                  MCVector3dF(tileX + tileW / 2, tileY + tileH / 2), tile->rotation());
-            }
+        auto && surface = tile.surface;
+        surface->setShaderProgram(Renderer::instance().program("menu"));
+        surface->bind();
 
-            tileX += tileW;
+        if (m_track->isLocked())
+        {
+            surface->setColor(MCGLColor(0.5, 0.5, 0.5));
+        }
+        else
+        {
+            surface->setColor(MCGLColor(1.0, 1.0, 1.0));
         }
 
-        tileY += tileH;
+        const float tileX = initX + tile.i * tileW;
+        const float tileY = initY + tile.j * tileH;
+        surface->setSize(tileH, tileW);
+        surface->render(
+          nullptr,
+          MCVector3dF(tileX + tileW / 2, tileY + tileH / 2), tile.rotation);
     }
 }
 
@@ -221,7 +226,7 @@ void TrackItem::renderTitle()
     const int shadowX = 2;
 
     std::wstringstream ss;
-    ss << m_track->trackData().name().toUpper().toStdWString();
+    ss << m_track->name().toUpper().toStdWString();
     text.setText(ss.str());
     text.setGlyphSize(30, 30);
     text.setShadowOffset(shadowX, shadowY);
@@ -230,7 +235,7 @@ void TrackItem::renderTitle()
 
 void TrackItem::renderStars()
 {
-    if (!m_track->trackData().isLocked())
+    if (!m_track->isLocked())
     {
         const auto starW = m_star->width();
         const auto starH = m_star->height();
@@ -270,7 +275,7 @@ void TrackItem::renderStars()
 
 void TrackItem::renderLock()
 {
-    if (m_track->trackData().isLocked())
+    if (m_track->isLocked() || m_track->isBroken())
     {
         m_lock->render(nullptr, { menu()->x() + x(), menu()->y() + y(), 0 }, 0);
     }
@@ -297,7 +302,7 @@ void TrackItem::renderTrackProperties()
 
     ss.str(L"");
     ss << QObject::tr("     Length: ").toStdWString()
-       << static_cast<int>(m_track->trackData().route().geometricLength() * MCWorld::metersPerUnit());
+       << static_cast<int>(m_track->thumbnail().routeLength * MCWorld::metersPerUnit());
     text.setText(ss.str());
     maxWidth = std::fmax(maxWidth, text.width(m_font));
     texts.push_back(text);
@@ -306,14 +311,14 @@ void TrackItem::renderTrackProperties()
     ss << QObject::tr(" Lap Record: ").toStdWString() << Timing::msecsToString(m_lapRecord);
     text.setText(ss.str());
     maxWidth = std::fmax(maxWidth, text.width(m_font));
-    if (!m_track->trackData().isLocked())
+    if (!m_track->isLocked())
         texts.push_back(text);
 
     ss.str(L"");
     ss << QObject::tr("Race Record: ").toStdWString() << Timing::msecsToString(m_raceRecord);
     text.setText(ss.str());
     maxWidth = std::fmax(maxWidth, text.width(m_font));
-    if (!m_track->trackData().isLocked())
+    if (!m_track->isLocked())
         texts.push_back(text);
 
     const float yPos = menu()->y() + y() - height() / 2;
@@ -328,10 +333,15 @@ void TrackItem::renderTrackProperties()
 
     line++;
 
-    if (m_track->trackData().isLocked())
+    if (m_track->isLocked() || m_track->isBroken())
     {
         ss.str(L"");
-        if (m_game.hasComputerPlayers())
+        if (m_track->isBroken())
+        {
+            //: Try to keep the translation as short as possible.
+            ss << QObject::tr("The track file cannot be loaded!").toStdWString();
+        }
+        else if (m_game.hasComputerPlayers())
         {
             //: Try to keep the translation as short as possible.
             ss << QObject::tr("Finish previous track in TOP-6 to unlock!").toStdWString();
@@ -432,10 +442,10 @@ void TrackSelectionMenu::selectCurrentItem()
 {
     Menu::selectCurrentItem();
     auto && selectedTrack = std::static_pointer_cast<TrackItem>(currentItem())->track();
-    if (!selectedTrack->trackData().isLocked())
+    // A track that cannot be loaded anymore stays in the menu, but cannot be selected
+    if (!selectedTrack->isLocked() && m_scene.setActiveTrack(selectedTrack))
     {
         m_selectedTrack = selectedTrack;
-        m_scene.setActiveTrack(m_selectedTrack);
         setIsDone(true);
     }
 }
@@ -17,6 +17,7 @@
 
 #include "game.hpp"
 #include "graphicsfactory.hpp"
+#include "map.hpp"
 #include "race.hpp"
 #include "renderer.hpp"
 #include "scene.hpp"
@@ -25,8 +26,6 @@
 #include <MCSurface>
 #include <MCSurfaceView>
 
-#include "../common/mapbase.hpp"
-
 #include <memory>
 
 Minimap::Minimap()
@@ -36,12 +35,12 @@ Minimap::Minimap()
     m_markerSurface->material()->setAlphaBlend(true);
 }
 
-Minimap::Minimap(Car & carToFollow, const MapBase & trackMap, int x, int y, size_t size)
+Minimap::Minimap(Car & carToFollow, const Map & trackMap, int x, int y, size_t size)
 {
     initialize(carToFollow, trackMap, x, y, size);
 }
 
-void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int y, size_t size)
+void Minimap::initialize(Car & carToFollow, const Map & trackMap, int x, int y, size_t size)
 {
     m_carToFollow = &carToFollow;
 
@@ -84,9 +83,9 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
         tileX = initX;
         for (size_t i = 0; i < trackMap.cols(); i++)
         {
-            const auto tile = std::static_pointer_cast<TrackTile>(trackMap.getTile(i, j));
-            const auto surface = tile->previewSurface();
-            if (surface && !tile->excludeFromMinimap())
+            auto && tile = trackMap.tile(i, j);
+            auto && surface = trackMap.surface(tile.previewSurfaceIndex());
+            if (surface && !tile.excludeFromMinimap())
             {
                 surface->setShaderProgram(Renderer::instance().program("menu"));
                 surface->setColor({ 1.0, 1.0, 1.0 });
@@ -94,7 +93,7 @@ void Minimap::initialize(Car & carToFollow, const MapBase & trackMap, int x, int
 
                 MinimapTile minimapTile;
                 minimapTile.pos = MCVector3dF(tileX + m_tileW / 2, tileY + m_tileH / 2);
-                minimapTile.rotation = tile->rotation();
+                minimapTile.rotation = tile.rotation();
 
                 m_map[surface].push_back(minimapTile);
             }
@@ -24,7 +24,7 @@
 
 #include <MCVector3d>
 
-class MapBase;
+class Map;
 class MCSurface;
 class Race;
 class TrackTile;
@@ -34,9 +34,9 @@ class Minimap
 public:
     Minimap();
 
-    Minimap(Car & carToFollow, const MapBase & trackMap, int x, int y, size_t size);
+    Minimap(Car & carToFollow, const Map & trackMap, int x, int y, size_t size);
 
-    void initialize(Car & carToFollow, const MapBase & trackMap, int x, int y, size_t size);
+    void initialize(Car & carToFollow, const Map & trackMap, int x, int y, size_t size);
 
     using CarVector = std::vector<CarS>;
     void render(const CarVector & cars, const Race & race);
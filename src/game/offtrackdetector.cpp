@@ -37,11 +37,11 @@ void OffTrackDetector::update()
 {
     {
         const auto leftFrontTirePos(m_car.leftFrontTireLocation());
-        const auto tile = m_track->trackTileAtLocation(leftFrontTirePos.i(), leftFrontTirePos.j());
+        auto && tile = m_track->trackTileAtLocation(leftFrontTirePos.i(), leftFrontTirePos.j());
 
         m_car.setLeftSideOffTrack(false);
 
-        if (isOffTrack(leftFrontTirePos, *tile))
+        if (isOffTrack(leftFrontTirePos, tile))
         {
             m_car.setLeftSideOffTrack(true);
         }
@@ -49,11 +49,11 @@ void OffTrackDetector::update()
 
     {
         const auto rightFrontTirePos(m_car.rightFrontTireLocation());
-        const auto tile = m_track->trackTileAtLocation(rightFrontTirePos.i(), rightFrontTirePos.j());
+        auto && tile = m_track->trackTileAtLocation(rightFrontTirePos.i(), rightFrontTirePos.j());
 
         m_car.setRightSideOffTrack(false);
 
-        if (isOffTrack(rightFrontTirePos, *tile))
+        if (isOffTrack(rightFrontTirePos, tile))
         {
             m_car.setRightSideOffTrack(true);
         }
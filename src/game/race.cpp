@@ -149,6 +149,7 @@ void placeCar(Car & car, float x, float y, int angle)
 {
     car.translate({ x, y });
     car.rotate(static_cast<float>(angle));
+    car.resetRenderState();
 
     juzzlin::L().debug() << "Car " << car.index() << " location: " << car.location();
     juzzlin::L().debug() << "Car " << car.index() << " rotation: " << car.angle();
@@ -207,7 +208,7 @@ void Race::translateCarsToStartPositions()
             {
                 const float y = startTileY + (i % 2) * tileHeight / 3 - tileHeight / 6;
                 float x = startTileX + (static_cast<float>(i / 2) * spacing) + (i % 2) * oddOffset + moveDueToBridge;
-                while (m_track->trackTileAtLocation(x, y)->tileTypeEnum() == TrackTile::TileType::Bridge)
+                while (m_track->trackTileAtLocation(x, y).tileTypeEnum() == TrackTile::TileType::Bridge)
                 {
                     moveDueToBridge += tileWidth;
                     x += moveDueToBridge;
@@ -226,7 +227,7 @@ void Race::translateCarsToStartPositions()
             {
                 const float y = startTileY + (i % 2) * tileHeight / 3 - tileHeight / 6;
                 float x = startTileX - static_cast<float>(i / 2) * spacing + (i % 2) * oddOffset - moveDueToBridge;
-                while (m_track->trackTileAtLocation(x, y)->tileTypeEnum() == TrackTile::TileType::Bridge)
+                while (m_track->trackTileAtLocation(x, y).tileTypeEnum() == TrackTile::TileType::Bridge)
                 {
                     moveDueToBridge += tileWidth;
                     x -= moveDueToBridge;
@@ -243,7 +244,7 @@ void Race::translateCarsToStartPositions()
             {
                 const float x = startTileX + (i % 2) * tileWidth / 3 - tileWidth / 6;
                 float y = startTileY - static_cast<float>(i / 2) * spacing + (i % 2) * oddOffset - moveDueToBridge;
-                while (m_track->trackTileAtLocation(x, y)->tileTypeEnum() == TrackTile::TileType::Bridge)
+                while (m_track->trackTileAtLocation(x, y).tileTypeEnum() == TrackTile::TileType::Bridge)
                 {
                     moveDueToBridge += tileHeight;
                     y -= moveDueToBridge;
@@ -261,7 +262,7 @@ void Race::translateCarsToStartPositions()
             {
                 const float x = startTileX + (i % 2) * tileWidth / 3 - tileWidth / 6;
                 float y = startTileY + static_cast<float>(i / 2) * spacing + (i % 2) * oddOffset + moveDueToBridge;
-                while (m_track->trackTileAtLocation(x, y)->tileTypeEnum() == TrackTile::TileType::Bridge)
+                while (m_track->trackTileAtLocation(x, y).tileTypeEnum() == TrackTile::TileType::Bridge)
                 {
                     moveDueToBridge += tileHeight;
                     y += moveDueToBridge;
@@ -275,7 +276,7 @@ void Race::translateCarsToStartPositions()
     }
     else
     {
-        juzzlin::L().error() << "Finish line tile not found in track '" << m_track->trackData().name().toStdString() << "'";
+        juzzlin::L().error() << "Finish line tile not found in track '" << m_track->name().toStdString() << "'";
     }
 }
 
@@ -567,11 +568,11 @@ void Race::checkForNewBestPosition(const Car & car)
             }
 
             auto && next = m_track->next().lock();
-            if (next && next->trackData().isLocked())
+            if (next && next->isLocked())
             {
                 if (position <= m_unlockLimit)
                 {
-                    next->trackData().setIsLocked(false);
+                    next->setIsLocked(false);
                     Database::instance().saveTrackUnlockStatus(*next, static_cast<int>(m_lapCount), m_game.difficultyProfile().difficulty());
                     emit messageRequested(QObject::tr("A new track unlocked!"));
                 }
@@ -590,7 +591,7 @@ void Race::checkIfCarIsStuck(Car & car)
     {
         static const int STUCK_LIMIT = 60 * 5; // 5 secs.
 
-        const auto currentTile = m_track->trackTileAtLocation(car.location().i(), car.location().j());
+        const auto currentTile = &m_track->trackTileAtLocation(car.location().i(), car.location().j());
         auto && counter = m_stuckHash[car.index()];
         if (counter.first == nullptr || counter.first != currentTile)
         {
@@ -647,6 +648,7 @@ void Race::moveCarOntoPreviousCheckPoint(Car & car)
     const float x = static_cast<float>(targetNode->location().x() + dist(engine));
     const float y = static_cast<float>(targetNode->location().y() + dist(engine));
     car.translate({ x, y });
+    car.resetRenderState();
     car.physicsComponent().reset();
     juzzlin::L().debug() << "Moved stuck car " << car.index() << " to (" << x << ", " << y << ")";
 }
@@ -712,6 +714,7 @@ void Race::setTrack(TrackS track, size_t lapCount)
 {
     m_lapCount = lapCount;
 
+    assert(track->isLoaded());
     m_track = track;
 
     const auto bestPos = Database::instance().loadBestPos(*m_track, static_cast<int>(m_lapCount), m_game.difficultyProfile().difficulty());
@@ -137,7 +137,7 @@ private:
 
     // Data structure to determine if a car is stuck.
     // In that case we move the car onto the previous check point.
-    using StuckTileCounter = std::pair<TrackTileS, int>; // Tile pointer and counter.
+    using StuckTileCounter = std::pair<const TrackTile *, int>; // Tile pointer and counter.
     using StuckHash = std::unordered_map<size_t, StuckTileCounter>; // Car index to StuckTileCounter.
     StuckHash m_stuckHash;
 
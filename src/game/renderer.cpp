@@ -73,6 +73,11 @@ Renderer & Renderer::instance()
     return *Renderer::m_instance;
 }
 
+bool Renderer::hasInstance()
+{
+    return Renderer::m_instance;
+}
+
 void Renderer::resizeWindow()
 {
     // Set window size & disable resize
@@ -236,6 +241,9 @@ void Renderer::initializeFrameBufferObjects()
         m_shadowFbo = std::make_unique<QOpenGLFramebufferObject>(m_hRes, m_vRes);
         m_shadowFbo->setAttachment(QOpenGLFramebufferObject::Depth);
     }
+
+    // Creating the FBOs binds textures behind MiniCore's back, so start each frame from a clean state
+    MCGLShaderProgram::resetTextureBindings();
 }
 
 void Renderer::initializeMaterial()
@@ -389,13 +397,9 @@ void Renderer::renderNow()
         initialize();
     }
 
-    m_frameCounter++;
-    if (Game::instance().fps() == Game::Fps::Fps60 || (Game::instance().fps() == Game::Fps::Fps30 && m_frameCounter & 0x01))
-    {
-        render();
+    render();
 
-        m_context->swapBuffers(this);
-    }
+    m_context->swapBuffers(this);
 }
 
 void Renderer::resizeEvent(QResizeEvent * event)
@@ -47,6 +47,9 @@ public:
     //! \return the single instance.
     static Renderer & instance();
 
+    //! \return true if the renderer exists. It doesn't when running headless.
+    static bool hasInstance();
+
     void initialize();
 
     //! Set game scene to be rendered.
@@ -143,7 +146,6 @@ private:
     int m_fullHRes;
     int m_fullVRes;
 
-    int m_frameCounter = 0;
     bool m_fullScreen;
     bool m_updatePending = false;
 
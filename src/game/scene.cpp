@@ -17,7 +17,6 @@
 
 #include "ai.hpp"
 #include "audioworker.hpp"
-#include "bridge.hpp"
 #include "car.hpp"
 #include "carfactory.hpp"
 #include "carsoundeffectmanager.hpp"
@@ -29,7 +28,6 @@
 #include "mainmenu.hpp"
 #include "messageoverlay.hpp"
 #include "particlefactory.hpp"
-#include "pit.hpp"
 #include "race.hpp"
 #include "renderer.hpp"
 #include "settings.hpp"
@@ -39,8 +37,7 @@
 #include "timingoverlay.hpp"
 #include "track.hpp"
 #include "trackdata.hpp"
-#include "trackobject.hpp"
-#include "tracktile.hpp"
+#include "trackworld.hpp"
 
 #include "../common/config.hpp"
 
@@ -71,14 +68,10 @@
 #include <cassert>
 #include <memory>
 
-using std::dynamic_pointer_cast;
-
 // Default visible scene size.
 int Scene::m_width = 1024;
 int Scene::m_height = 768;
 
-static const float METERS_PER_UNIT = 0.05f;
-
 Scene::Scene(Game & game, StateMachine & stateMachine, Renderer & renderer, MCWorld & world)
   : m_game { game }
   , m_stateMachine { stateMachine }
@@ -135,7 +128,7 @@ void Scene::initializeComponents()
     m_startlightsOverlay->setDimensions(width(), height());
     m_messageOverlay->setDimensions(width(), height());
 
-    m_world.setMetersPerUnit(METERS_PER_UNIT);
+    m_world.setMetersPerUnit(TrackWorld::METERS_PER_UNIT);
 
     MCAssetManager::textureFontManager().font(m_game.fontName()).setShaderProgram(m_renderer.program("text"));
     MCAssetManager::textureFontManager().font(m_game.fontName()).setShadowShaderProgram(m_renderer.program("textShadow"));
@@ -267,7 +260,27 @@ void Scene::updateFrame(InputHandler & handler, std::chrono::milliseconds timeSt
 
             updateWorld(timeStep);
             updateRace(timeStep);
+        }
+    }
+    break;
+    case StateMachine::State::Menu:
+        m_menuManager->stepTime(timeStep);
+        break;
+    default:
+        break;
+    }
+}
 
+void Scene::updateView()
+{
+    switch (m_stateMachine.state())
+    {
+    case StateMachine::State::GameTransitionIn:
+    case StateMachine::State::GameTransitionOut:
+    case StateMachine::State::DoStartlights:
+    case StateMachine::State::Play:
+        if (m_activeTrack)
+        {
             if (m_game.hasTwoHumanPlayers())
             {
                 for (size_t i = 0; i < 2; i++)
@@ -280,10 +293,6 @@ void Scene::updateFrame(InputHandler & handler, std::chrono::milliseconds timeSt
                 updateCameraLocation(m_camera.at(0), m_cameraOffset.at(0), *m_cars.at(0));
             }
         }
-    }
-    break;
-    case StateMachine::State::Menu:
-        m_menuManager->stepTime(timeStep);
         break;
     default:
         break;
@@ -329,7 +338,8 @@ void Scene::updateCameraLocation(MCCamera & camera, float & offset, MCObject & o
     // in the speed won't look bad.
     offset += (object.physicsComponent().velocity().lengthFast() - offset) * 0.2f;
     const float offsetAmplification = m_game.hasTwoHumanPlayers() ? 9.6f : 13.8f;
-    const auto loc = MCVector2dF { object.location() } + object.direction() * offset * offsetAmplification;
+    // Follow the interpolated location that is actually rendered
+    const auto loc = MCVector2dF { object.shape()->renderLocation() } + object.direction() * offset * offsetAmplification;
     camera.setPos(loc.i(), loc.j());
 }
 
@@ -438,8 +448,13 @@ void Scene::setupAI(std::shared_ptr<Track> activeTrack)
     }
 }
 
-void Scene::setActiveTrack(std::shared_ptr<Track> activeTrack)
+bool Scene::setActiveTrack(std::shared_ptr<Track> activeTrack)
 {
+    if (!activeTrack->load())
+    {
+        return false;
+    }
+
     m_activeTrack = activeTrack;
 
     m_world.clear();
@@ -458,6 +473,8 @@ void Scene::setActiveTrack(std::shared_ptr<Track> activeTrack)
 
     setupAI(activeTrack);
     setupMinimaps();
+
+    return true;
 }
 
 void Scene::setWorldDimensions()
@@ -466,14 +483,7 @@ void Scene::setWorldDimensions()
 
     // Update world dimensions according to the
     // active track.
-    const size_t minX = 0;
-    const size_t maxX = m_activeTrack->width();
-    const size_t minY = 0;
-    const size_t maxY = m_activeTrack->height();
-    const size_t minZ = 0;
-    const size_t maxZ = 1000;
-
-    m_world.setDimensions(minX, static_cast<float>(maxX), minY, static_cast<float>(maxY), minZ, maxZ, METERS_PER_UNIT);
+    TrackWorld::setDimensions(m_world, *m_activeTrack);
 }
 
 void Scene::addCarsToWorld()
@@ -485,69 +495,10 @@ void Scene::addCarsToWorld()
 }
 
 void Scene::addTrackObjectsToWorld()
-{
-    createNormalObjects();
-    createBridgeObjects();
-}
-
-void Scene::createNormalObjects()
-{
-    assert(m_activeTrack);
-
-    for (size_t i = 0; i < m_activeTrack->trackData().objects().count(); i++)
-    {
-        const auto trackObject = dynamic_pointer_cast<TrackObject>(m_activeTrack->trackData().objects().object(i));
-        assert(trackObject);
-
-        auto && object = trackObject->object();
-        object.addToWorld();
-
-        // Set the base Z of mesh objects at ground level instead of at the object center
-        float baseZ = 0;
-        if (object.shape() && object.shape()->view() && object.shape()->view()->object())
-        {
-            if (dynamic_cast<MCMesh *>(object.shape()->view()->object()))
-            {
-                baseZ = -object.shape()->view()->object()->minZ();
-            }
-        }
-
-        object.translate(object.initialLocation() + MCVector3dF { 0, 0, baseZ });
-        object.rotate(static_cast<float>(object.initialAngle()));
-
-        if (const auto pit = dynamic_cast<Pit *>(&object); pit)
-        {
-            pit->reset();
-            connect(pit, &Pit::pitStop, m_race.get(), &Race::pitStop);
-        }
-    }
-}
-
-void Scene::createBridgeObjects()
 {
     assert(m_activeTrack);
 
-    auto && map = m_activeTrack->trackData().map();
-    for (size_t j = 0; j <= map.rows(); j++)
-    {
-        for (size_t i = 0; i <= map.cols(); i++)
-        {
-            const auto tile = dynamic_pointer_cast<TrackTile>(map.getTile(i, j));
-            if (tile && tile->tileTypeEnum() == TrackTile::TileType::Bridge)
-            {
-                const auto bridge = std::make_shared<Bridge>();
-                bridge->translate(MCVector3dF {
-                  static_cast<float>(i * TrackTile::width() + TrackTile::width() / 2),
-                  static_cast<float>(j * TrackTile::height() + TrackTile::height() / 2),
-                  0 });
-                bridge->rotate(static_cast<float>(tile->rotation()));
-                bridge->addToWorld();
-                m_bridges.push_back(bridge);
-            }
-        }
-    }
-
-    Bridge::reset();
+    TrackWorld::addTrackObjects(*m_activeTrack, *m_race, m_bridges);
 }
 
 void Scene::resizeOverlays()
@@ -743,8 +694,7 @@ void Scene::renderWorld(MCRenderGroup renderGroup, bool prepareRendering)
 
             if (prepareRendering)
             {
-                m_world.prepareRendering(&m_camera.at(1));
-                m_world.prepareRendering(&m_camera.at(0));
+                m_world.prepareRendering({ &m_camera.at(1), &m_camera.at(0) });
             }
 
             auto && glScene = MCWorld::instance().renderer().glScene();
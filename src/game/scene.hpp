@@ -70,9 +70,15 @@ public:
 
     //! Update physics and objects by the given time step in ms.
     void updateFrame(InputHandler & handler, std::chrono::milliseconds timeStep);
+
+    //! Update cameras and fading once per rendered frame.
+    void updateView();
+
     void updateOverlays();
 
-    void setActiveTrack(std::shared_ptr<Track> activeTrack);
+    //! Set up the race on the given track.
+    //! \return false if the track data cannot be loaded.
+    bool setActiveTrack(std::shared_ptr<Track> activeTrack);
     std::shared_ptr<Track> activeTrack() const;
 
     //! Return track selection menu.
@@ -94,10 +100,8 @@ private:
 
     void connectComponents();
 
-    void createBridgeObjects();
     void createCars();
     void createMenus();
-    void createNormalObjects();
 
     void initializeComponents();
     void initializeRace();
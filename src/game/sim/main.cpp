@@ -0,0 +1,187 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include <QDir>
+#include <QGuiApplication>
+
+#include "../../common/config.hpp"
+
+#include "game.hpp"
+#include "simulation.hpp"
+#include "track.hpp"
+#include "trackdata.hpp"
+#include "trackloader.hpp"
+
+#include <MCGLObjectBase>
+
+#include "argengine.hpp"
+#include "simple_logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+using juzzlin::L;
+
+// Count all heap allocations made by the process
+static std::atomic<size_t> allocationCount { 0 };
+
+void * operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void * p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static void printStage(const char * name, std::chrono::nanoseconds time, size_t steps)
+{
+    const double ms = std::chrono::duration<double, std::milli>(time).count();
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << ms << " ms" << std::setw(12) << (steps ? ms * 1000.0 / steps : 0.0) << " us/step" << std::endl;
+}
+
+static void printResult(const Simulation::Result & result, size_t allocations)
+{
+    using std::chrono::duration;
+
+    const double simulatedSeconds = duration<double>(result.simulatedTime).count();
+    const double wallSeconds = duration<double>(result.wallTime).count();
+
+    std::cout << "Steps:           " << result.steps << (result.raceFinished ? " (race finished)" : "") << std::endl;
+    std::cout << "Simulated time:  " << std::fixed << std::setprecision(3) << simulatedSeconds << " s" << std::endl;
+    std::cout << "Wall time:       " << wallSeconds << " s" << std::endl;
+    std::cout << "Sim s / wall s:  " << (wallSeconds > 0 ? simulatedSeconds / wallSeconds : 0.0) << std::endl;
+    std::cout << "Allocations:     " << allocations << " (" << (result.steps ? static_cast<double>(allocations) / result.steps : 0.0) << " / step)" << std::endl;
+    std::cout << "Grid mutations:  " << result.world.broadPhaseMutations << " (" << (result.steps ? static_cast<double>(result.world.broadPhaseMutations) / result.steps : 0.0) << " / step)" << std::endl;
+    std::cout << std::endl;
+
+    printStage("Force registry", result.world.forces, result.steps);
+    printStage("Integration", result.world.integration, result.steps);
+    printStage("Broad phase", result.world.broadPhase, result.steps);
+    printStage("Narrow phase", result.world.narrowPhase, result.steps);
+    printStage("Resolver", result.world.resolver, result.steps);
+    printStage("AI", result.ai, result.steps);
+    printStage("Race::update", result.race, result.steps);
+}
+
+int main(int argc, char ** argv)
+{
+    // No display is needed
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication::setOrganizationName(Config::General::QT_ORGANIZATION_NAME);
+    QGuiApplication::setApplicationName(Config::Game::QT_APPLICATION_NAME);
+
+    L::setLoggingLevel(L::Level::Warning);
+    L::enableEchoMode(true);
+
+    MCGLObjectBase::setHeadless(true);
+
+    try
+    {
+        Game game(argc, argv, true);
+
+        QString trackPath = QString(Config::General::dataPath) + QDir::separator() + "levels" + QDir::separator() + "curvastone.trk";
+        size_t carCount = 12;
+        size_t lapCount = 5;
+        int seconds = 300;
+
+        juzzlin::Argengine ae(argc, argv);
+        ae.addOption(
+          { "--track" }, [&](std::string value) {
+              trackPath = value.c_str();
+          },
+          false, "Path to the .trk file to race on.", "PATH");
+
+        ae.addOption(
+          { "--cars" }, [&](std::string value) {
+              carCount = static_cast<size_t>(std::max(std::stoi(value), 1));
+          },
+          false, "Number of AI cars. The default is 12.");
+
+        ae.addOption(
+          { "--laps" }, [&](std::string value) {
+              lapCount = static_cast<size_t>(std::max(std::stoi(value), 1));
+          },
+          false, "Number of laps. The default is 5.");
+
+        ae.addOption(
+          { "--seconds" }, [&](std::string value) {
+              seconds = std::max(std::stoi(value), 1);
+          },
+          false, "Maximum simulated time in seconds if the race doesn't finish earlier. The default is 300.");
+
+        ae.addOption(
+          { "--debug" }, [=]() {
+              L::setLoggingLevel(L::Level::Debug);
+          },
+          false, "Set log level to debug.");
+
+        ae.setHelpText("\nRuns a race without a display and reports the simulation throughput.\n\nUsage: " + std::string(argv[0]) + " [OPTIONS]");
+
+        ae.parse();
+
+        auto && trackLoader = TrackLoader::instance();
+        trackLoader.loadAssets();
+
+        auto trackData = trackLoader.loadTrack(trackPath);
+        if (!trackData)
+        {
+            std::cerr << "Cannot load track '" << trackPath.toStdString() << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const auto track = std::make_shared<Track>(std::move(trackData));
+
+        std::cout << "Track:           " << track->name().toStdString() << std::endl;
+        std::cout << "Cars:            " << carCount << std::endl;
+        std::cout << "Laps:            " << lapCount << std::endl;
+
+        Simulation simulation(game, MCWorld::instance(), track, carCount, lapCount);
+
+        const size_t allocationsBefore = allocationCount.load();
+        const auto result = simulation.run(std::chrono::seconds { seconds }, std::chrono::milliseconds { 1000 / 60 });
+        printResult(result, allocationCount.load() - allocationsBefore);
+
+        return EXIT_SUCCESS;
+    } //
+    catch (std::exception & e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
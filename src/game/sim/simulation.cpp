@@ -0,0 +1,141 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "simulation.hpp"
+
+#include "ai.hpp"
+#include "car.hpp"
+#include "carfactory.hpp"
+#include "carsoundeffectmanager.hpp"
+#include "game.hpp"
+#include "particlefactory.hpp"
+#include "race.hpp"
+#include "timing.hpp"
+#include "track.hpp"
+#include "trackworld.hpp"
+
+#include <MCObject>
+
+#include <cassert>
+#include <string>
+
+Simulation::Simulation(Game & game, MCWorld & world, std::shared_ptr<Track> track, size_t carCount, size_t lapCount)
+  : m_game { game }
+  , m_world { world }
+  , m_track { track }
+  , m_race { std::make_shared<Race>(game, carCount) }
+  , m_particleFactory { std::make_unique<ParticleFactory>() }
+{
+    assert(m_track);
+
+    QObject::connect(m_race.get(), &Race::finished, [this]() {
+        m_raceFinished = true;
+    });
+
+    m_world.setMetersPerUnit(TrackWorld::METERS_PER_UNIT);
+    m_world.clear();
+
+    TrackWorld::setDimensions(m_world, *m_track);
+
+    createCars(carCount);
+
+    for (auto && car : m_cars)
+    {
+        car->addToWorld();
+    }
+
+    TrackWorld::addTrackObjects(*m_track, *m_race, m_bridges);
+
+    m_race->initialize(m_track, lapCount);
+
+    for (auto && ai : m_ai)
+    {
+        ai->setTrack(m_track);
+    }
+}
+
+void Simulation::createCars(size_t carCount)
+{
+    for (size_t i = 0; i < carCount; i++)
+    {
+        if (std::shared_ptr<Car> car { CarFactory::buildCar(i, carCount, m_game) }; car)
+        {
+            // Also the player's car is driven by the AI
+            m_ai.push_back(std::make_shared<AI>(*car, m_race));
+
+            // The sound effects are not connected to anything, but cars expect to have them
+            const auto indexStr = std::to_string(i);
+            CarSoundEffectManager::MultiSoundHandles handles;
+            handles.engineSoundHandle = ("carEngine" + indexStr).c_str();
+            handles.hitSoundHandle = ("carHit" + indexStr).c_str();
+            handles.skidSoundHandle = ("skid" + indexStr).c_str();
+            car->setSoundEffectManager(std::make_shared<CarSoundEffectManager>(*car, handles));
+
+            m_cars.push_back(car);
+            m_race->addCar(*car);
+        }
+    }
+}
+
+Simulation::Result Simulation::run(std::chrono::milliseconds duration, std::chrono::milliseconds stepLength)
+{
+    using std::chrono::steady_clock;
+
+    Result result;
+
+    m_world.resetProfile();
+    m_world.setProfilingEnabled(true);
+
+    m_race->start();
+
+    const auto timing = m_race->timing().lock();
+    const auto start = steady_clock::now();
+    while (result.simulatedTime < duration && !m_raceFinished)
+    {
+        auto stageStart = steady_clock::now();
+        for (auto && ai : m_ai)
+        {
+            ai->update(timing->raceCompleted(ai->car().index()));
+        }
+
+        auto now = steady_clock::now();
+        result.ai += now - stageStart;
+
+        m_world.stepTime(stepLength);
+
+        stageStart = steady_clock::now();
+        m_race->update(stepLength);
+
+        now = steady_clock::now();
+        result.race += now - stageStart;
+
+        result.simulatedTime += stepLength;
+        result.steps++;
+    }
+
+    result.wallTime = steady_clock::now() - start;
+    result.world = m_world.profile();
+    result.raceFinished = m_raceFinished;
+
+    m_world.setProfilingEnabled(false);
+
+    return result;
+}
+
+Simulation::~Simulation()
+{
+    // Remove the objects before the cars and the track get deleted
+    m_world.clear();
+}
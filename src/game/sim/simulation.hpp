@@ -0,0 +1,85 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <MCObject>
+#include <MCWorld>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+class AI;
+class Car;
+class Game;
+class ParticleFactory;
+class Race;
+class Track;
+
+/*! Runs a race without rendering, audio or user input, e.g. for benchmarking.
+ *  The race is set up like in Scene, but all cars are driven by the AI. */
+class Simulation
+{
+public:
+    struct Result
+    {
+        std::chrono::milliseconds simulatedTime = {};
+
+        std::chrono::nanoseconds wallTime = {};
+
+        std::chrono::nanoseconds ai = {};
+
+        std::chrono::nanoseconds race = {};
+
+        MCWorld::Profile world;
+
+        size_t steps = 0;
+
+        bool raceFinished = false;
+    };
+
+    Simulation(Game & game, MCWorld & world, std::shared_ptr<Track> track, size_t carCount, size_t lapCount);
+
+    ~Simulation();
+
+    /*! Step the race in fixed steps until the race is finished or the given time is simulated.
+     *  \param stepLength Length of a simulation step as in the game. */
+    Result run(std::chrono::milliseconds duration, std::chrono::milliseconds stepLength);
+
+private:
+    void createCars(size_t carCount);
+
+    Game & m_game;
+
+    MCWorld & m_world;
+
+    std::shared_ptr<Track> m_track;
+
+    std::shared_ptr<Race> m_race;
+
+    std::unique_ptr<ParticleFactory> m_particleFactory;
+
+    std::vector<std::shared_ptr<Car>> m_cars;
+
+    std::vector<std::shared_ptr<AI>> m_ai;
+
+    std::vector<MCObjectPtr> m_bridges;
+
+    bool m_raceFinished = false;
+};
+
+#endif // SIMULATION_HPP
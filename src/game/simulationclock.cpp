@@ -0,0 +1,73 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "simulationclock.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+SimulationClock::SimulationClock(std::chrono::milliseconds stepLength, size_t maxStepsPerFrame)
+  : m_stepLength(stepLength)
+  , m_maxStepsPerFrame(maxStepsPerFrame)
+{
+    assert(stepLength.count() > 0);
+    assert(maxStepsPerFrame > 0);
+}
+
+std::chrono::milliseconds SimulationClock::stepLength() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(m_stepLength);
+}
+
+size_t SimulationClock::advance(std::chrono::milliseconds elapsed)
+{
+    m_accumulator += std::chrono::microseconds { static_cast<std::chrono::microseconds::rep>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() * static_cast<double>(m_timeScale)) };
+
+    size_t steps = static_cast<size_t>(std::max<std::chrono::microseconds::rep>(m_accumulator / m_stepLength, 0));
+    m_accumulator -= m_stepLength * static_cast<std::chrono::microseconds::rep>(steps);
+
+    const size_t maxSteps = static_cast<size_t>(std::ceil(m_maxStepsPerFrame * std::max(m_timeScale, 1.0f)));
+    if (steps > maxSteps)
+    {
+        // Too far behind, e.g. after a hiccup: don't try to catch up all at once
+        steps = maxSteps;
+        m_accumulator = std::chrono::microseconds { 0 };
+    }
+
+    return steps;
+}
+
+float SimulationClock::interpolation() const
+{
+    return static_cast<float>(m_accumulator.count()) / m_stepLength.count();
+}
+
+void SimulationClock::reset()
+{
+    m_accumulator = std::chrono::microseconds { 0 };
+}
+
+void SimulationClock::setTimeScale(float timeScale)
+{
+    assert(timeScale > 0);
+    m_timeScale = timeScale;
+}
+
+float SimulationClock::timeScale() const
+{
+    return m_timeScale;
+}
@@ -0,0 +1,58 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SIMULATIONCLOCK_HPP
+#define SIMULATIONCLOCK_HPP
+
+#include <chrono>
+#include <cstddef>
+
+//! Accumulates elapsed real time and turns it into whole simulation steps of fixed length,
+//! so that the simulation doesn't depend on the frame rate or on timer jitter.
+class SimulationClock
+{
+public:
+    //! \param maxStepsPerFrame Max steps run to catch up per frame. The rest of the backlog is dropped.
+    SimulationClock(std::chrono::milliseconds stepLength, size_t maxStepsPerFrame);
+
+    std::chrono::milliseconds stepLength() const;
+
+    //! Add elapsed real time. \return number of steps to run now.
+    size_t advance(std::chrono::milliseconds elapsed);
+
+    //! \return the fraction of a step left in the accumulator [0.0, 1.0).
+    //! Used to interpolate rendering between the two latest steps.
+    float interpolation() const;
+
+    //! Drop the accumulated time e.g. when continuing from pause.
+    void reset();
+
+    //! Run the simulation faster (> 1.0) or slower (< 1.0) than real time.
+    //! The catch-up limit is scaled accordingly.
+    void setTimeScale(float timeScale);
+
+    float timeScale() const;
+
+private:
+    std::chrono::microseconds m_stepLength;
+
+    size_t m_maxStepsPerFrame;
+
+    std::chrono::microseconds m_accumulator { 0 };
+
+    float m_timeScale = 1.0f;
+};
+
+#endif // SIMULATIONCLOCK_HPP
@@ -19,17 +19,68 @@
 #include "renderer.hpp"
 #include "scene.hpp"
 #include "trackdata.hpp"
+#include "trackloader.hpp"
+#include "trackmesh.hpp"
 #include "tracktile.hpp"
 
+#include "../common/trackfilereader.hpp"
+
+#include <MCAssetCache>
 #include <MCAssetManager>
 #include <MCCamera>
 #include <MCGLShaderProgram>
 #include <MCSurface>
 
+#include "simple_logger.hpp"
+
+#include <QBuffer>
+#include <QFile>
+
 #include <cassert>
 #include <memory>
 
-using std::static_pointer_cast;
+namespace {
+
+//! Read the given track file, if it's still the one with the given hash.
+//! \return The reader or nullptr if the file has been changed, removed or cannot be parsed.
+std::unique_ptr<TrackFileReader> readTrackFile(QString fileName, uint64_t hash)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+
+    const auto data = file.readAll();
+    if (MCAssetCache::hash(data.constData(), static_cast<size_t>(data.size())) != hash)
+    {
+        return nullptr;
+    }
+
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    auto reader = std::make_unique<TrackFileReader>();
+    if (!reader->read(buffer))
+    {
+        return nullptr;
+    }
+
+    return reader;
+}
+
+} // namespace
+
+Track::Track(const Info & info, std::unique_ptr<Thumbnail> thumbnail)
+  : m_info(info)
+  , m_thumbnail(std::move(thumbnail))
+  , m_rows(info.rows)
+  , m_cols(info.cols)
+  , m_width(m_cols * TrackTile::width())
+  , m_height(m_rows * TrackTile::height())
+  , m_asphalt(MCAssetManager::surfaceManager().surface("asphalt"))
+{
+}
 
 Track::Track(std::unique_ptr<TrackData> trackData)
   : m_trackData(std::move(trackData))
@@ -40,191 +91,195 @@ Track::Track(std::unique_ptr<TrackData> trackData)
   , m_asphalt(MCAssetManager::surfaceManager().surface("asphalt"))
 {
     assert(m_trackData);
+
+    m_info.fileName = m_trackData->fileName();
+    m_info.name = m_trackData->name();
+    m_info.index = m_trackData->index();
+    m_info.isUserTrack = m_trackData->isUserTrack();
+    m_info.cols = m_cols;
+    m_info.rows = m_rows;
 }
 
-size_t Track::width() const
+const Track::Info & Track::info() const
 {
-    return m_width;
+    return m_info;
 }
 
-size_t Track::height() const
+QString Track::name() const
 {
-    return m_height;
+    return m_info.name;
 }
 
-TrackData & Track::trackData() const
+unsigned int Track::index() const
 {
-    return *m_trackData;
+    return m_info.index;
 }
 
-TrackTileS Track::trackTileAtLocation(float x, float y) const
+bool Track::isUserTrack() const
 {
-    // X index
-    x = x < 0 ? 0 : x;
-    size_t i = static_cast<size_t>(x * m_cols / m_width);
-    i = i >= m_cols ? m_cols - 1 : i;
-
-    // Y index
-    y = y < 0 ? 0 : y;
-    size_t j = static_cast<size_t>(y * m_rows / m_height);
-    j = j >= m_rows ? m_rows - 1 : j;
-
-    return static_pointer_cast<TrackTile>(m_trackData->map().getTile(i, j));
+    return m_info.isUserTrack;
 }
 
-TrackTileS Track::finishLine() const
+bool Track::isLocked() const
 {
-    auto && map = m_trackData->map();
-    for (size_t j = 0; j < map.rows(); j++)
-    {
-        for (size_t i = 0; i < map.cols(); i++)
-        {
-            const auto tile = static_pointer_cast<TrackTile>(map.getTile(i, j));
-            if (tile->tileTypeEnum() == TrackTile::TileType::Finish)
-            {
-                return tile;
-            }
-        }
-    }
-
-    return nullptr;
+    return m_isLocked;
 }
 
-void Track::calculateVisibleIndices(const MCBBox<int> & r, size_t & i0, size_t & i2, size_t & j0, size_t & j2)
+void Track::setIsLocked(bool locked)
+{
+    m_isLocked = locked;
+}
 
+bool Track::isLoaded() const
 {
-    // Calculate which tiles are visible in the Camera window:
-    // columns from i0 to i2 and rows from j0 to j2.
+    return m_trackData != nullptr;
+}
 
-    // X low index
-    i0 = r.x1() * m_cols / m_width;
-    i0 = i0 >= m_cols ? 0 : i0;
+bool Track::load() const
+{
+    if (m_trackData)
+    {
+        return true;
+    }
 
-    // X high index
-    i2 = r.x2() * m_cols / m_width;
-    i2 = i2 >= m_cols ? m_cols - 1 : i2;
+    if (m_isBroken)
+    {
+        return false;
+    }
 
-    // Y low index
-    j0 = r.y1() * m_rows / m_height;
-    j0 = j0 >= m_rows ? 0 : j0;
+    // The file may have been changed or removed after the tracks were listed
+    auto reader = m_prefetch.valid() ? m_prefetch.get() : readTrackFile(m_info.fileName, m_info.hash);
+    if (!reader)
+    {
+        juzzlin::L().error() << "Cannot load track '" << m_info.fileName.toStdString() << "'";
+        m_isBroken = true;
+        return false;
+    }
 
-    // Y high index
-    j2 = r.y2() * m_rows / m_height;
-    j2 = j2 >= m_rows ? m_rows - 1 : j2;
+    m_trackData = TrackLoader::instance().createTrackData(*reader, m_info.fileName);
+    return true;
 }
 
-void Track::render(MCCamera & camera)
+bool Track::isBroken() const
 {
-    // Calculate which tiles are visible
-    size_t i2, j2, i0, j0;
-    calculateVisibleIndices(camera.bbox(), i0, i2, j0, j2);
-
-    MCGLShaderProgramPtr prog2d = Renderer::instance().program("tile2d");
-    prog2d->bind();
-    renderAsphalt(camera, prog2d, i0, i2, j0, j2);
-    prog2d->release();
-
-    MCGLShaderProgramPtr prog3d = Renderer::instance().program("tile3d");
-    prog3d->bind();
-    renderTiles(camera, prog3d, i0, i2, j0, j2);
-    prog3d->release();
+    return m_isBroken;
 }
 
-void Track::renderAsphalt(MCCamera & camera, MCGLShaderProgramPtr prog, size_t i0, size_t i2, size_t j0, size_t j2)
+void Track::prefetch()
 {
-    float x1, y1; // Coordinates mapped to camera
-
-    // Bind common geometry and textures for all asphalt tiles.
-    m_asphalt->setShaderProgram(prog);
-    m_asphalt->bind();
-
-    const MapBase & map = m_trackData->map();
+    if (!m_trackData && !m_isBroken && !m_prefetch.valid())
+    {
+        // Only the file is parsed in the background: the objects must be created on the main thread
+        m_prefetch = std::async(std::launch::async, readTrackFile, m_info.fileName, m_info.hash);
+    }
+}
 
-    // Loop through the visible tile matrix and draw the tiles
-    size_t x;
-    size_t y = j0 * TrackTile::height();
-    const size_t initX = i0 * TrackTile::width();
-    for (size_t j = j0; j <= j2; j++)
+const Track::Thumbnail & Track::thumbnail() const
+{
+    if (!m_thumbnail)
     {
-        x = initX;
-        for (size_t i = i0; i <= i2; i++)
+        auto thumbnail = std::make_unique<Thumbnail>();
+        if (!load())
+        {
+            m_thumbnail = std::move(thumbnail);
+            return *m_thumbnail;
+        }
+
+        auto && map = trackData().map();
+        for (size_t j = 0; j < map.rows(); j++)
         {
-            const auto tile = static_pointer_cast<TrackTile>(map.getTile(i, j));
-            if (tile->hasAsphalt())
+            for (size_t i = 0; i < map.cols(); i++)
             {
-                x1 = x;
-                y1 = y;
-                camera.mapToCamera(x1, y1);
-                prog->setTransform(0, MCVector3dF(x1 + TrackTile::width() / 2, y1 + TrackTile::height() / 2, 0));
-                m_asphalt->render();
+                auto && tile = map.tile(i, j);
+                auto && surface = map.surface(tile.previewSurfaceIndex());
+                if (surface && !tile.excludeFromMinimap())
+                {
+                    Thumbnail::Tile thumbnailTile;
+                    thumbnailTile.surface = surface;
+                    thumbnailTile.i = static_cast<uint16_t>(i);
+                    thumbnailTile.j = static_cast<uint16_t>(j);
+                    thumbnailTile.rotation = static_cast<int16_t>(tile.rotation());
+                    thumbnail->tiles.push_back(thumbnailTile);
+                }
             }
-
-            x += TrackTile::width();
         }
 
-        y += TrackTile::height();
+        thumbnail->routeLength = trackData().route().geometricLength();
+
+        TrackLoader::instance().storeThumbnail(m_info, *thumbnail);
+        m_thumbnail = std::move(thumbnail);
     }
+
+    return *m_thumbnail;
 }
 
-void Track::renderTiles(MCCamera & camera, MCGLShaderProgramPtr prog, size_t i0, size_t i2, size_t j0, size_t j2)
+size_t Track::width() const
 {
-    float x1, y1; // Coordinates mapped to camera
+    return m_width;
+}
 
-    struct SortedTile
-    {
-        TrackTile * tile;
-        float x1, y1;
-    };
+size_t Track::height() const
+{
+    return m_height;
+}
+
+TrackData & Track::trackData() const
+{
+    assert(m_trackData);
+
+    return *m_trackData;
+}
+
+const TrackTile & Track::trackTileAtLocation(float x, float y) const
+{
+    // X index
+    x = x < 0 ? 0 : x;
+    size_t i = static_cast<size_t>(x * m_cols / m_width);
+    i = i >= m_cols ? m_cols - 1 : i;
 
-    // The tiles are sorted with respect to their surface in order
-    // to minimize GPU context switches.
-    std::map<MCSurfacePtr, std::vector<SortedTile>> sortedTiles;
+    // Y index
+    y = y < 0 ? 0 : y;
+    size_t j = static_cast<size_t>(y * m_rows / m_height);
+    j = j >= m_rows ? m_rows - 1 : j;
 
-    auto && map = m_trackData->map();
+    return trackData().map().tile(i, j);
+}
 
-    // Loop through the visible tile matrix and sort the tiles.
-    size_t initX = i0 * TrackTile::width();
-    size_t x;
-    size_t y = j0 * TrackTile::height();
-    for (size_t j = j0; j <= j2; j++)
+const TrackTile * Track::finishLine() const
+{
+    auto && map = trackData().map();
+    for (size_t j = 0; j < map.rows(); j++)
     {
-        x = initX;
-        for (size_t i = i0; i <= i2; i++)
+        for (size_t i = 0; i < map.cols(); i++)
         {
-            const auto tile = static_pointer_cast<TrackTile>(map.getTile(i, j));
-            if (auto surface = tile->surface())
+            auto && tile = map.tile(i, j);
+            if (tile.tileTypeEnum() == TrackTile::TileType::Finish)
             {
-                x1 = x;
-                y1 = y;
-                camera.mapToCamera(x1, y1);
-
-                sortedTiles[surface].push_back({ tile.get(), x1, y1 });
+                return &tile;
             }
-
-            x += TrackTile::width();
         }
-
-        y += TrackTile::height();
     }
 
-    // Render the tiles.
-    for (auto && iter : sortedTiles)
+    return nullptr;
+}
+
+void Track::render(MCCamera & camera)
+{
+    // The mesh is baked on the first render, so that tracks that are never rendered don't need it
+    if (!m_mesh)
     {
-        const auto surface = iter.first;
-        surface->setShaderProgram(prog);
-        surface->bind();
+        m_mesh = std::make_unique<TrackMesh>(trackData().map(), m_asphalt);
+    }
 
-        for (size_t i = 0; i < iter.second.size(); i++)
-        {
-            x1 = iter.second[i].x1;
-            y1 = iter.second[i].y1;
+    MCGLShaderProgramPtr prog2d = Renderer::instance().program("tile2d");
+    prog2d->bind();
+    m_mesh->renderAsphalt(camera, prog2d);
+    prog2d->release();
 
-            const auto tile = iter.second[i].tile;
-            prog->setTransform(tile->rotation(), MCVector3dF(x1 + TrackTile::width() / 2, y1 + TrackTile::height() / 2, 0));
-            prog->setScale(TrackTile::width() / surface->width(), TrackTile::height() / surface->height(), 1.0f);
-            surface->render();
-        }
-    }
+    MCGLShaderProgramPtr prog3d = Renderer::instance().program("tile3d");
+    prog3d->bind();
+    m_mesh->renderTiles(camera, prog3d);
+    prog3d->release();
 }
 
 void Track::setNext(std::weak_ptr<Track> next)
@@ -246,3 +301,5 @@ std::weak_ptr<Track> Track::prev() const
 {
     return m_prev;
 }
+
+Track::~Track() = default;
@@ -19,24 +19,107 @@
 #include "tracktile.hpp"
 #include "updateableif.hpp"
 
-#include <MCBBox>
 #include <MCGLShaderProgram>
 
+#include <QString>
+
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <vector>
 
 class TrackData;
+class TrackFileReader;
+class TrackMesh;
 class MCCamera;
 class MCSurface;
 
 //! A renderable race track object constructed from
-//! the given track data.
+//! the given track data. The data can be loaded on demand, so that
+//! the tracks can be listed by only scanning the headers of the files.
 class Track
 {
 public:
+    //! What is known about a track without loading it.
+    struct Info
+    {
+        QString fileName;
+
+        QString name;
+
+        unsigned int index = 999;
+
+        bool isUserTrack = false;
+
+        size_t cols = 0;
+
+        size_t rows = 0;
+
+        //! Hash of the file contents.
+        uint64_t hash = 0;
+    };
+
+    //! Tiles of the preview shown in the track selection menu.
+    struct Thumbnail
+    {
+        struct Tile
+        {
+            std::shared_ptr<MCSurface> surface;
+
+            uint16_t i = 0;
+
+            uint16_t j = 0;
+
+            int16_t rotation = 0;
+        };
+
+        std::vector<Tile> tiles;
+
+        float routeLength = 0;
+    };
+
+    /*! Constructor.
+     * \param info Catalogue entry of the track. The data is loaded when first needed.
+     * \param thumbnail Cached thumbnail or nullptr. */
+    Track(const Info & info, std::unique_ptr<Thumbnail> thumbnail);
+
     /*! Constructor.
      * \param trackData The data that represents the track. */
     explicit Track(std::unique_ptr<TrackData> trackData);
 
+    ~Track();
+
+    const Info & info() const;
+
+    QString name() const;
+
+    unsigned int index() const;
+
+    bool isUserTrack() const;
+
+    //! Return true if the track is locked.
+    bool isLocked() const;
+
+    //! Set the locked state.
+    void setIsLocked(bool locked);
+
+    //! Return true if the track data has been loaded.
+    bool isLoaded() const;
+
+    /*! Load the track data if not loaded yet. The file must be the same that was listed.
+     *  \return false if the data cannot be loaded. The track is then marked as broken. */
+    bool load() const;
+
+    //! Return true if the track file couldn't be loaded anymore.
+    bool isBroken() const;
+
+    //! Start parsing the track file in the background, so that loading the data is fast later.
+    void prefetch();
+
+    //! Return the thumbnail. Loads the track data if there's no cached thumbnail.
+    //! The thumbnail of a broken track is empty.
+    const Thumbnail & thumbnail() const;
+
     //! Render as seen through the given camera window.
     void render(MCCamera & camera);
 
@@ -46,15 +129,15 @@ public:
     //! Return height in length units.
     size_t height() const;
 
-    //! Return the track data.
+    //! Return the track data. The data must have been loaded with load().
     TrackData & trackData() const;
 
-    //! Return pointer to the tile at the given location.
-    //! It is assumed that x >= 0 and y >= 0.
-    TrackTileS trackTileAtLocation(float x, float y) const;
+    //! Return the tile at the given location. Locations outside of the track
+    //! are clamped to the nearest tile.
+    const TrackTile & trackTileAtLocation(float x, float y) const;
 
-    //! Return pointer to the finish line tile.
-    TrackTileS finishLine() const;
+    //! Return pointer to the finish line tile or nullptr if not found.
+    const TrackTile * finishLine() const;
 
     //! Set the next track.
     void setNext(std::weak_ptr<Track> next);
@@ -69,18 +152,24 @@ public:
     std::weak_ptr<Track> prev() const;
 
 private:
-    void calculateVisibleIndices(const MCBBox<int> & r, size_t & i0, size_t & i2, size_t & j0, size_t & j2);
+    Info m_info;
 
-    void renderAsphalt(MCCamera & camera, MCGLShaderProgramPtr prog, size_t i0, size_t i2, size_t j0, size_t j2);
+    bool m_isLocked = false;
 
-    void renderTiles(MCCamera & camera, MCGLShaderProgramPtr prog, size_t i0, size_t i2, size_t j0, size_t j2);
+    mutable bool m_isBroken = false;
 
-    std::unique_ptr<TrackData> m_trackData;
+    mutable std::unique_ptr<TrackData> m_trackData;
+
+    mutable std::future<std::unique_ptr<TrackFileReader>> m_prefetch;
+
+    mutable std::unique_ptr<Thumbnail> m_thumbnail;
 
     size_t m_rows, m_cols, m_width, m_height;
 
     std::shared_ptr<MCSurface> m_asphalt;
 
+    std::unique_ptr<TrackMesh> m_mesh;
+
     std::weak_ptr<Track> m_next;
 
     std::weak_ptr<Track> m_prev;
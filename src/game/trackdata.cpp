@@ -20,7 +20,6 @@ TrackData::TrackData(QString name, bool isUserTrack, unsigned int cols, unsigned
   : TrackDataBase(name, isUserTrack)
   , m_map(cols, rows)
   , m_route()
-  , m_isLocked(false)
 {
 }
 
@@ -44,12 +43,12 @@ const Route & TrackData::route() const
     return m_route;
 }
 
-MapBase & TrackData::map()
+Map & TrackData::map()
 {
     return m_map;
 }
 
-const MapBase & TrackData::map() const
+const Map & TrackData::map() const
 {
     return m_map;
 }
@@ -64,14 +63,4 @@ const Objects & TrackData::objects() const
     return m_objects;
 }
 
-bool TrackData::isLocked() const
-{
-    return m_isLocked;
-}
-
-void TrackData::setIsLocked(bool locked)
-{
-    m_isLocked = locked;
-}
-
 TrackData::~TrackData() = default;
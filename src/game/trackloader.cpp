@@ -13,15 +13,14 @@
 // You should have received a copy of the GNU General Public License
 // along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
 
+#include <QBuffer>
 #include <QDir>
-#include <QDomDocument>
-#include <QDomElement>
 #include <QFile>
+#include <QStandardPaths>
 #include <QStringList>
 #include <QTextStream>
 
 #include "../common/config.hpp"
-#include "../common/datakeywords.hpp"
 
 #include "database.hpp"
 #include "layers.hpp"
@@ -33,6 +32,7 @@
 #include "trackobject.hpp"
 #include "tracktile.hpp"
 
+#include <MCAssetCache>
 #include <MCAssetManager>
 #include <MCObjectFactory>
 #include <MCShapeView>
@@ -41,12 +41,46 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <memory>
 
-using std::dynamic_pointer_cast;
-
 static const int UNLOCK_LIMIT = 6; // Position required to unlock a new track
 
+namespace {
+
+//! Header of a cached thumbnail. It's followed by the tiles and the surface handles.
+struct ThumbnailHeader
+{
+    uint32_t tileCount;
+
+    uint32_t surfaceCount;
+
+    float routeLength;
+
+    uint32_t reserved;
+};
+
+struct ThumbnailTile
+{
+    uint16_t i;
+
+    uint16_t j;
+
+    int16_t rotation;
+
+    uint16_t surfaceIndex;
+};
+
+uint64_t thumbnailKey(const Track::Info & info)
+{
+    // Thumbnails share the key space of the application data in the cache
+    static const char prefix[] = "thumbnail";
+    return MCAssetCache::hash(prefix, sizeof(prefix), info.hash);
+}
+
+} // namespace
+
 TrackLoader * TrackLoader::m_instance = nullptr;
 
 TrackLoader::TrackLoader()
@@ -75,11 +109,28 @@ void TrackLoader::addTrackSearchPath(QString path)
 
 void TrackLoader::loadAssets()
 {
+    // Processed textures and meshes are cached so that the next start doesn't need to decode them
+    const auto cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cachePath.isEmpty())
+    {
+        m_assetManager.setCachePath((cachePath + QDir::separator() + "assets").toStdString());
+        m_trackCache = std::make_unique<MCAssetCache>((cachePath + QDir::separator() + "tracks").toStdString());
+    }
+
+    m_assetManager.setProgressCallback([](const std::string & type, size_t loaded, size_t total) {
+        juzzlin::L().debug() << "Loaded " << loaded << "/" << total << " " << type;
+    });
+
+    const auto start = std::chrono::steady_clock::now();
     m_assetManager.load();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    juzzlin::L().info() << "Loading assets took " << elapsed.count() << " ms";
 }
 
 int TrackLoader::loadTracks(int lapCount, DifficultyProfile::Difficulty difficulty)
 {
+    const auto start = std::chrono::steady_clock::now();
+
     int numLoaded = 0;
     for (auto && path : m_paths)
     {
@@ -88,10 +139,10 @@ int TrackLoader::loadTracks(int lapCount, DifficultyProfile::Difficulty difficul
         for (auto && trackPath : trackPaths)
         {
             trackPath = path + QDir::separator() + trackPath;
-            if (auto trackData = loadTrack(trackPath))
+            if (auto track = scanTrack(trackPath))
             {
-                juzzlin::L().info() << "  Found '" << trackPath.toStdString() << "', index=" << trackData->index();
-                m_tracks.push_back(std::make_shared<Track>(std::move(trackData)));
+                juzzlin::L().info() << "  Found '" << trackPath.toStdString() << "', index=" << track->index();
+                m_tracks.push_back(track);
                 numLoaded++;
             }
             else
@@ -111,9 +162,172 @@ int TrackLoader::loadTracks(int lapCount, DifficultyProfile::Difficulty difficul
         updateLockedTracks(lapCount, difficulty);
     }
 
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    juzzlin::L().info() << "Listing race tracks took " << elapsed.count() << " ms";
+
     return numLoaded;
 }
 
+std::shared_ptr<Track> TrackLoader::scanTrack(QString path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return nullptr;
+    }
+
+    // The whole file is hashed for the thumbnail cache
+    const auto data = file.readAll();
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    if (!m_trackFileReader.readHeader(buffer))
+    {
+        return nullptr;
+    }
+
+    const auto & header = m_trackFileReader.header();
+    Track::Info info;
+    info.fileName = path;
+    info.name = header.name;
+    info.index = header.index;
+    info.isUserTrack = header.isUserTrack;
+    info.cols = header.cols;
+    info.rows = header.rows;
+    info.hash = MCAssetCache::hash(data.constData(), static_cast<size_t>(data.size()));
+
+    // A thumbnail is cached only after the same file has been loaded, otherwise check the whole file
+    auto thumbnail = loadThumbnail(info);
+    if (!thumbnail)
+    {
+        buffer.seek(0);
+        if (!m_trackFileReader.read(buffer))
+        {
+            return nullptr;
+        }
+    }
+
+    return std::make_shared<Track>(info, std::move(thumbnail));
+}
+
+std::unique_ptr<Track::Thumbnail> TrackLoader::loadThumbnail(const Track::Info & info) const
+{
+    if (!m_trackCache)
+    {
+        return nullptr;
+    }
+
+    const auto entry = m_trackCache->load(MCAssetCache::Type::Data, thumbnailKey(info));
+    if (!entry || entry->size() < sizeof(ThumbnailHeader))
+    {
+        return nullptr;
+    }
+
+    ThumbnailHeader header;
+    std::memcpy(&header, entry->data(), sizeof(header));
+
+    const size_t tilesSize = header.tileCount * sizeof(ThumbnailTile);
+    if (entry->size() < sizeof(header) + tilesSize)
+    {
+        return nullptr;
+    }
+
+    // Surface handles as length-prefixed strings
+    std::vector<MCSurfacePtr> surfaces;
+    size_t offset = sizeof(header) + tilesSize;
+    for (uint32_t index = 0; index < header.surfaceCount; index++)
+    {
+        uint32_t length = 0;
+        if (entry->size() < offset + sizeof(length))
+        {
+            return nullptr;
+        }
+
+        std::memcpy(&length, entry->data() + offset, sizeof(length));
+        offset += sizeof(length);
+        if (entry->size() < offset + length)
+        {
+            return nullptr;
+        }
+
+        const std::string handle(reinterpret_cast<const char *>(entry->data() + offset), length);
+        offset += length;
+
+        try
+        {
+            surfaces.push_back(MCAssetManager::surfaceManager().surface(handle));
+        } catch (...)
+        {
+            // The surfaces have changed since the thumbnail was stored
+            return nullptr;
+        }
+    }
+
+    auto thumbnail = std::make_unique<Track::Thumbnail>();
+    thumbnail->routeLength = header.routeLength;
+    thumbnail->tiles.reserve(header.tileCount);
+    for (uint32_t index = 0; index < header.tileCount; index++)
+    {
+        ThumbnailTile tile;
+        std::memcpy(&tile, entry->data() + sizeof(header) + index * sizeof(tile), sizeof(tile));
+        if (tile.surfaceIndex >= surfaces.size() || tile.i >= info.cols || tile.j >= info.rows)
+        {
+            return nullptr;
+        }
+
+        Track::Thumbnail::Tile thumbnailTile;
+        thumbnailTile.surface = surfaces.at(tile.surfaceIndex);
+        thumbnailTile.i = tile.i;
+        thumbnailTile.j = tile.j;
+        thumbnailTile.rotation = tile.rotation;
+        thumbnail->tiles.push_back(thumbnailTile);
+    }
+
+    return thumbnail;
+}
+
+void TrackLoader::storeThumbnail(const Track::Info & info, const Track::Thumbnail & thumbnail) const
+{
+    // Tracks not found by the catalogue, e.g. the one given to the headless simulation, have no hash
+    if (!m_trackCache || !info.hash)
+    {
+        return;
+    }
+
+    std::vector<MCSurfacePtr> surfaces;
+    std::vector<ThumbnailTile> tiles;
+    tiles.reserve(thumbnail.tiles.size());
+    for (auto && thumbnailTile : thumbnail.tiles)
+    {
+        const auto surface = std::find(surfaces.begin(), surfaces.end(), thumbnailTile.surface);
+        const auto surfaceIndex = static_cast<uint16_t>(surface - surfaces.begin());
+        if (surface == surfaces.end())
+        {
+            surfaces.push_back(thumbnailTile.surface);
+        }
+
+        tiles.push_back({ thumbnailTile.i, thumbnailTile.j, thumbnailTile.rotation, surfaceIndex });
+    }
+
+    std::string handles;
+    for (auto && surface : surfaces)
+    {
+        const auto handle = surface->handle();
+        const auto length = static_cast<uint32_t>(handle.size());
+        handles.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        handles.append(handle);
+    }
+
+    const ThumbnailHeader header = { static_cast<uint32_t>(tiles.size()), static_cast<uint32_t>(surfaces.size()), thumbnail.routeLength, 0 };
+    if (!m_trackCache->store(MCAssetCache::Type::Data, thumbnailKey(info),
+                             { { &header, sizeof(header) },
+                               { tiles.data(), tiles.size() * sizeof(ThumbnailTile) },
+                               { handles.data(), handles.size() } }))
+    {
+        juzzlin::L().warning() << "Couldn't cache the thumbnail of '" << info.fileName.toStdString() << "'";
+    }
+}
+
 void TrackLoader::updateLockedTracks(int lapCount, DifficultyProfile::Difficulty difficulty)
 {
     sortTracks();
@@ -123,17 +337,17 @@ void TrackLoader::updateLockedTracks(int lapCount, DifficultyProfile::Difficulty
     // Check if the tracks are locked/unlocked.
     for (auto && track : m_tracks)
     {
-        if (!track->trackData().isUserTrack() && !Database::instance().loadTrackUnlockStatus(*track, lapCount, difficulty))
+        if (!track->isUserTrack() && !Database::instance().loadTrackUnlockStatus(*track, lapCount, difficulty))
         {
 #ifndef UNLOCK_ALL_TRACKS
-            track->trackData().setIsLocked(true);
+            track->setIsLocked(true);
 #else
-            track->trackData().setIsLocked(false);
+            track->setIsLocked(false);
 #endif
         }
         else
         {
-            track->trackData().setIsLocked(false);
+            track->setIsLocked(false);
 
             // This is needed in the case new tracks are added to the game afterwards.
             const auto bestPos = Database::instance().loadBestPos(*track, lapCount, difficulty);
@@ -142,16 +356,16 @@ void TrackLoader::updateLockedTracks(int lapCount, DifficultyProfile::Difficulty
                 auto && next = track->next().lock();
                 if (next)
                 {
-                    next->trackData().setIsLocked(false);
+                    next->setIsLocked(false);
                     Database::instance().saveTrackUnlockStatus(*next, lapCount, difficulty);
                 }
             }
         }
 
         // Always unlock the first official track
-        if (!track->trackData().isUserTrack() && !firstOfficialTrackUnlocked)
+        if (!track->isUserTrack() && !firstOfficialTrackUnlocked)
         {
-            track->trackData().setIsLocked(false);
+            track->setIsLocked(false);
             firstOfficialTrackUnlocked = true;
         }
     }
@@ -163,8 +377,8 @@ void TrackLoader::sortTracks()
     // beginning of the track array.
     std::stable_sort(m_tracks.begin(), m_tracks.end(),
                      [](auto lhs, auto rhs) -> bool {
-                         const int left = lhs->trackData().isUserTrack() ? -1 : static_cast<int>(lhs->trackData().index());
-                         return left < static_cast<int>(rhs->trackData().index());
+                         const int left = lhs->isUserTrack() ? -1 : static_cast<int>(lhs->index());
+                         return left < static_cast<int>(rhs->index());
                      });
 
     // Cross-link the tracks
@@ -177,109 +391,94 @@ void TrackLoader::sortTracks()
 
 std::unique_ptr<TrackData> TrackLoader::loadTrack(QString path)
 {
-    QDomDocument doc;
-
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly))
+    if (!m_trackFileReader.read(path))
     {
         return nullptr;
     }
 
-    if (!doc.setContent(&file))
+    return createTrackData(m_trackFileReader, path);
+}
+
+std::unique_ptr<TrackData> TrackLoader::createTrackData(const TrackFileReader & reader, QString path)
+{
+    const auto & header = reader.header();
+    auto newData = std::make_unique<TrackData>(header.name, header.isUserTrack, header.cols, header.rows);
+    newData->setFileName(path);
+    newData->setIndex(header.index);
+
+    // Each tile type is resolved only once
+    std::vector<const TileTypeData *> tileTypes(reader.tileTypes().size(), nullptr);
+    for (auto && tile : reader.tiles())
     {
-        file.close();
-        return nullptr;
-    }
+        auto && typeData = tileTypes.at(tile.typeIndex);
+        if (!typeData)
+        {
+            typeData = &tileTypeData(reader.tileTypes().at(tile.typeIndex));
+        }
 
-    file.close();
+        readTile(tile, *typeData, *newData);
+    }
 
-    std::unique_ptr<TrackData> newData;
-    const auto root = doc.documentElement();
-    if (root.nodeName() == "track")
+    for (auto && object : reader.objects())
     {
-        const auto cols = root.attribute(DataKeywords::Header::cols, "0").toUInt();
-        const auto rows = root.attribute(DataKeywords::Header::rows, "0").toUInt();
+        readObject(object, *newData);
+    }
 
-        if (cols > 0 && rows > 0)
-        {
-            const auto name = root.attribute(DataKeywords::Header::name, "undefined");
-            const bool isUserTrack = root.attribute(DataKeywords::Header::user, "0").toUInt();
+    // A temporary route vector.
+    std::vector<TargetNodeBasePtr> route;
+    route.reserve(reader.nodes().size());
+    for (auto && node : reader.nodes())
+    {
+        readTargetNode(node, *newData, route);
+    }
 
-            newData = std::make_unique<TrackData>(name, isUserTrack, cols, rows);
-            newData->setFileName(path);
-            newData->setIndex(root.attribute(DataKeywords::Header::index, "999").toUInt());
+    newData->route().buildFromVector(route);
 
-            // A temporary route vector.
-            std::vector<TargetNodeBasePtr> route;
+    return newData;
+}
 
-            auto node = root.firstChild();
-            while (!node.isNull())
-            {
-                auto element = node.toElement();
-                if (!element.isNull())
-                {
-                    // Read a tile element
-                    if (element.nodeName() == DataKeywords::Track::tile)
-                    {
-                        readTile(element, *newData);
-                    }
-                    // Read an object element
-                    else if (element.nodeName() == DataKeywords::Track::object)
-                    {
-                        readObject(element, *newData);
-                    }
-                    // Read a target node element
-                    else if (element.nodeName() == DataKeywords::Track::node)
-                    {
-                        readTargetNode(element, *newData, route);
-                    }
-                }
+const TrackLoader::TileTypeData & TrackLoader::tileTypeData(const QString & type)
+{
+    // The surfaces are kept over tracks, so each type is resolved only once
+    auto && data = m_tileTypeData[type];
+    if (!data.surface)
+    {
+        const auto handle = type.toStdString();
 
-                node = node.nextSibling();
-            }
+        // surface() throws if fails. Handled of higher level.
+        data.surface = MCAssetManager::surfaceManager().surface(handle);
+        data.typeEnum = tileTypeEnumFromString(handle);
 
-            newData->route().buildFromVector(route);
+        // Set preview surface, if found.
+        try
+        {
+            data.previewSurface = MCAssetManager::surfaceManager().surface(handle + "Preview");
+        } catch (...)
+        {
+            // Don't care
         }
     }
 
-    return newData;
+    return data;
 }
 
-void TrackLoader::readTile(QDomElement & element, TrackData & newData)
+void TrackLoader::readTile(const TrackFileReader::Tile & tileData, const TileTypeData & typeData, TrackData & newData)
 {
-    // X-coordinate in the tile matrix
-    const auto i = element.attribute(DataKeywords::Tile::i, "0").toUInt();
-
     // Mirror the y-index, because game has the y-axis pointing up.
-    const auto j = newData.map().rows() - 1 - element.attribute(DataKeywords::Tile::j, "0").toUInt();
-
-    const auto tile = dynamic_pointer_cast<TrackTile>(newData.map().getTile(i, j));
-    assert(tile);
+    auto && map = newData.map();
+    auto && tile = map.tile(tileData.i, map.rows() - 1 - tileData.j);
 
-    const auto type = element.attribute(DataKeywords::Tile::type, "clear").toStdString();
-    tile->setTileType(type.c_str());
-    tile->setTileTypeEnum(tileTypeEnumFromString(type.c_str()));
+    tile.setTileTypeEnum(typeData.typeEnum);
 
     // Mirror the angle, because game has the y-axis pointing up.
-    const int o = -element.attribute("o", "0").toInt();
-    tile->setRotation(o);
-    tile->setComputerHint(
-      static_cast<TrackTileBase::ComputerHint>(element.attribute(DataKeywords::Tile::computerHint, "0").toUInt()));
-    tile->setExcludeFromMinimap(element.attribute(DataKeywords::Tile::excludeFromMinimap, "0").toInt());
+    tile.setRotation(-tileData.orientation);
+    tile.setComputerHint(static_cast<TrackTile::ComputerHint>(tileData.computerHint));
+    tile.setExcludeFromMinimap(tileData.excludeFromMinimap);
 
     // Associate with a surface object corresponging
     // to the tile type.
-    // surface() throws if fails. Handled of higher level.
-    tile->setSurface(MCAssetManager::surfaceManager().surface(type));
-
-    // Set preview surface, if found.
-    try
-    {
-        tile->setPreviewSurface(MCAssetManager::surfaceManager().surface(type + "Preview"));
-    } catch (...)
-    {
-        // Don't care
-    }
+    map.setSurface(tile, typeData.surface);
+    map.setPreviewSurface(tile, typeData.previewSurface);
 }
 
 TrackTile::TileType TrackLoader::tileTypeEnumFromString(std::string str)
@@ -310,55 +509,38 @@ TrackTile::TileType TrackLoader::tileTypeEnumFromString(std::string str)
     return mappings[str];
 }
 
-void TrackLoader::readObject(QDomElement & element, TrackData & newData)
+void TrackLoader::readObject(const TrackFileReader::Object & objectData, TrackData & newData)
 {
-    // X-coordinate in the world
-    const int x = element.attribute(DataKeywords::Object::x, "0").toInt();
-
-    // Y-coordinate in the world
-    const int y = element.attribute(DataKeywords::Object::y, "0").toInt();
-
     // Height of the map.
     const int h = static_cast<int>(newData.map().rows() * TrackTile::height());
 
     // The y-coordinates needs to be mirrored, because the y-axis is pointing
     // down in the editor's coordinate system.
-    const MCVector2dF location(x, h - y);
+    const MCVector2dF location(objectData.x, h - objectData.y);
 
     // Mirror the angle, because the y-axis is pointing
     // down in the editor's coordinate system.
-    const int angle = -element.attribute(DataKeywords::Object::orientation, "0").toInt();
+    const int angle = -objectData.orientation;
 
-    const auto category = element.attribute(DataKeywords::Object::category, "");
-    const auto role = element.attribute(DataKeywords::Object::role, "");
-    const bool forceStationary = element.attribute(DataKeywords::Object::forceStationary, "0").toUInt();
-
-    if (const auto object = m_trackObjectFactory.build(category, role, location, angle, forceStationary))
+    if (const auto object = m_trackObjectFactory.build(objectData.category, objectData.role, location, angle, objectData.forceStationary))
     {
         newData.objects().add(std::shared_ptr<TrackObject>(object));
     }
 }
 
-void TrackLoader::readTargetNode(QDomElement & element, TrackData & newData, std::vector<TargetNodeBasePtr> & route)
+void TrackLoader::readTargetNode(const TrackFileReader::Node & nodeData, TrackData & newData, std::vector<TargetNodeBasePtr> & route)
 {
     // Height of the map. The y-coordinates needs to be mirrored, because
     // the coordinate system is y-wise mirrored in the editor.
     const int mapHeight = static_cast<int>(newData.map().rows() * TrackTile::height());
 
     const auto targetNode = std::make_shared<TargetNodeBase>();
-    targetNode->setIndex(element.attribute(DataKeywords::Node::index, "0").toInt());
-
-    const int x = element.attribute(DataKeywords::Node::x, "0").toInt();
-    const int y = element.attribute(DataKeywords::Node::y, "0").toInt();
-
-    targetNode->setLocation(QPointF(x, mapHeight - y));
-
-    const int w = element.attribute(DataKeywords::Node::width, "0").toInt();
-    const int h = element.attribute(DataKeywords::Node::height, "0").toInt();
+    targetNode->setIndex(nodeData.index);
+    targetNode->setLocation(QPointF(nodeData.x, mapHeight - nodeData.y));
 
-    if (w > 0 && h > 0)
+    if (nodeData.width > 0 && nodeData.height > 0)
     {
-        targetNode->setSize(QSizeF(w, h));
+        targetNode->setSize(QSizeF(nodeData.width, nodeData.height));
     }
 
     route.push_back(targetNode);
@@ -17,26 +17,27 @@
 #define TRACKLOADER_HPP
 
 #include <QString>
+#include <map>
 #include <vector>
 
+#include <MCAssetCache>
 #include <MCAssetManager>
 #include <MCObjectFactory>
 
 #include "difficultyprofile.hpp"
+#include "track.hpp"
 #include "trackobjectfactory.hpp"
 #include "tracktile.hpp"
 
 #include "../common/targetnodebase.hpp"
+#include "../common/trackfilereader.hpp"
 
 class TargetNodeBase;
-class Track;
 class TrackData;
 class TrackTileBase;
-class QDomElement;
 
 //! A singleton class that handles track loading.
-//! TODO: This can be shared with the editor or inherit from
-//! a shared loader.
+//! The track files are parsed with TrackFileReader shared with the editor.
 class TrackLoader
 {
 public:
@@ -48,8 +49,8 @@ public:
 
     void loadAssets();
 
-    /*! Load all tracks found in the added paths.
-     *  Lock/unlock tracks according to the given lap count.
+    /*! List all tracks found in the added paths. Only the headers are read for the tracks with
+     *  a cached thumbnail: the track data is loaded on demand. Lock/unlock tracks according to the given lap count.
      *  \return Number of track loaded. */
     int loadTracks(int lapCount, DifficultyProfile::Difficulty difficulty);
 
@@ -64,21 +65,47 @@ public:
 
     static TrackLoader & instance();
 
-private:
     //! Load the given track.
     //! \return Valid data pointer or nullptr if fails.
     std::unique_ptr<TrackData> loadTrack(QString path);
 
+    //! Create the track data from a track file read by the given reader.
+    std::unique_ptr<TrackData> createTrackData(const TrackFileReader & reader, QString path);
+
+    //! Store the thumbnail of the given track in the cache.
+    void storeThumbnail(const Track::Info & info, const Track::Thumbnail & thumbnail) const;
+
+private:
     void sortTracks();
 
-    //! Read a tile element.
-    void readTile(QDomElement & element, TrackData & newData);
+    //! Scan the header of the given track file. The whole file is parsed if there's no cached thumbnail.
+    //! \return A track to be loaded on demand or nullptr if not a valid track file.
+    std::shared_ptr<Track> scanTrack(QString path);
+
+    //! \return The cached thumbnail of the given track or nullptr if not found.
+    std::unique_ptr<Track::Thumbnail> loadThumbnail(const Track::Info & info) const;
+
+    //! Surfaces and type enum resolved for a tile type.
+    struct TileTypeData
+    {
+        MCSurfacePtr surface;
+
+        MCSurfacePtr previewSurface;
 
-    //! Read an object element.
-    void readObject(QDomElement & element, TrackData & newData);
+        TrackTile::TileType typeEnum = TrackTile::TileType::None;
+    };
 
-    //! Read a target node element and push to the given vector.
-    void readTargetNode(QDomElement & element, TrackData & newData, std::vector<TargetNodeBasePtr> & route);
+    //! Get the data for the given tile type.
+    const TileTypeData & tileTypeData(const QString & type);
+
+    //! Set up a tile from the read tile data.
+    void readTile(const TrackFileReader::Tile & tileData, const TileTypeData & typeData, TrackData & newData);
+
+    //! Create an object from the read object data.
+    void readObject(const TrackFileReader::Object & objectData, TrackData & newData);
+
+    //! Create a target node from the read node data and push to the given vector.
+    void readTargetNode(const TrackFileReader::Node & nodeData, TrackData & newData, std::vector<TargetNodeBasePtr> & route);
 
     //! Convert tile type string to a type enum.
     TrackTile::TileType tileTypeEnumFromString(std::string str);
@@ -89,6 +116,12 @@ private:
 
     TrackObjectFactory m_trackObjectFactory;
 
+    TrackFileReader m_trackFileReader;
+
+    std::map<QString, TileTypeData> m_tileTypeData;
+
+    std::unique_ptr<MCAssetCache> m_trackCache;
+
     std::vector<QString> m_paths;
 
     std::vector<std::shared_ptr<Track>> m_tracks;
@@ -0,0 +1,217 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trackmesh.hpp"
+
+#include "map.hpp"
+#include "tracktile.hpp"
+
+#include <MCCamera>
+#include <MCGLObjectBase>
+#include <MCMathUtil>
+#include <MCSurface>
+
+#include <map>
+
+//! Vertex buffer combining copies of surfaces.
+class TrackMesh::Chunk : public MCGLObjectBase
+{
+public:
+    explicit Chunk(MCGLMaterialPtr material)
+      : MCGLObjectBase("trackMeshChunk")
+    {
+        setMaterial(material);
+    }
+
+    /*! Add the vertices of the given surface. The vertices are transformed like
+     *  the model matrix and scale would do when rendering the surface.
+     *  The normals are not rotated, because the tile shaders don't rotate them either. */
+    void add(const MCSurface & surface, float x, float y, float angle, float scaleX, float scaleY)
+    {
+        for (size_t i = 0; i < surface.vertexCount(); i++)
+        {
+            const auto & vertex = surface.vertex(i);
+            const float vertexX = vertex.x() * scaleX;
+            const float vertexY = vertex.y() * scaleY;
+            addVertex({ x + MCMathUtil::rotatedX(vertexX, vertexY, angle), y + MCMathUtil::rotatedY(vertexX, vertexY, angle), vertex.z() });
+            addNormal(surface.normal(i));
+            addTexCoord(surface.texCoord(i));
+            addColor(surface.color(i));
+        }
+    }
+
+    void build()
+    {
+        const auto vertexDataSize = sizeof(MCGLVertex) * vertexCount();
+        const auto normalDataSize = sizeof(MCGLVertex) * vertexCount();
+        const auto texCoordDataSize = sizeof(MCGLTexCoord) * vertexCount();
+        const auto colorDataSize = sizeof(MCGLColor) * vertexCount();
+
+        initBufferData(vertexDataSize + normalDataSize + texCoordDataSize + colorDataSize, GL_STATIC_DRAW);
+
+        addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::Vertex, vertexDataSize, verticesAsGlArray());
+        addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::Normal, normalDataSize, normalsAsGlArray());
+        addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::TexCoords, texCoordDataSize, texCoordsAsGlArray());
+        addBufferSubData(MCGLShaderProgram::VertexAttributeLocation::Color, colorDataSize, colorsAsGlArray());
+
+        finishBufferData();
+    }
+
+    void render(MCGLShaderProgramPtr program)
+    {
+        setShaderProgram(program);
+        bind();
+        MCGLObjectBase::render();
+        release();
+    }
+};
+
+TrackMesh::TrackMesh(const Map & map, std::shared_ptr<MCSurface> asphalt, size_t sectorSize)
+  : m_sectorSize(sectorSize)
+  , m_sectorCols((map.cols() + sectorSize - 1) / sectorSize)
+  , m_sectorRows((map.rows() + sectorSize - 1) / sectorSize)
+  , m_sectors(m_sectorCols * m_sectorRows)
+{
+    bake(map, asphalt);
+}
+
+void TrackMesh::bake(const Map & map, std::shared_ptr<MCSurface> asphalt)
+{
+    const float tileW = static_cast<float>(TrackTile::width());
+    const float tileH = static_cast<float>(TrackTile::height());
+
+    for (size_t sj = 0; sj < m_sectorRows; sj++)
+    {
+        for (size_t si = 0; si < m_sectorCols; si++)
+        {
+            auto && sector = m_sectors[sj * m_sectorCols + si];
+            std::map<MCSurface *, Chunk *> tileChunks;
+
+            const size_t j2 = std::min((sj + 1) * m_sectorSize, map.rows());
+            const size_t i2 = std::min((si + 1) * m_sectorSize, map.cols());
+            for (size_t j = sj * m_sectorSize; j < j2; j++)
+            {
+                for (size_t i = si * m_sectorSize; i < i2; i++)
+                {
+                    auto && tile = map.tile(i, j);
+                    const float x = i * tileW + tileW / 2;
+                    const float y = j * tileH + tileH / 2;
+
+                    if (tile.hasAsphalt() && asphalt)
+                    {
+                        if (!sector.asphalt)
+                        {
+                            sector.asphalt = std::make_unique<Chunk>(asphalt->material());
+                        }
+
+                        sector.asphalt->add(*asphalt, x, y, 0, 1, 1);
+                    }
+
+                    if (auto && surface = map.surface(tile.surfaceIndex()))
+                    {
+                        auto && chunk = tileChunks[surface.get()];
+                        if (!chunk)
+                        {
+                            sector.tiles.push_back(std::make_unique<Chunk>(surface->material()));
+                            chunk = sector.tiles.back().get();
+                        }
+
+                        chunk->add(*surface, x, y, static_cast<float>(tile.rotation()), tileW / surface->width(), tileH / surface->height());
+                    }
+                }
+            }
+
+            if (sector.asphalt)
+            {
+                sector.asphalt->build();
+            }
+
+            for (auto && chunk : sector.tiles)
+            {
+                chunk->build();
+            }
+        }
+    }
+}
+
+void TrackMesh::calculateVisibleSectors(const MCBBox<int> & bbox, size_t & i0, size_t & i2, size_t & j0, size_t & j2) const
+{
+    const auto sectorW = static_cast<int>(m_sectorSize * TrackTile::width());
+    const auto sectorH = static_cast<int>(m_sectorSize * TrackTile::height());
+
+    i0 = static_cast<size_t>(std::max(bbox.x1(), 0) / sectorW);
+    i2 = std::min(static_cast<size_t>(std::max(bbox.x2(), 0) / sectorW), m_sectorCols - 1);
+    j0 = static_cast<size_t>(std::max(bbox.y1(), 0) / sectorH);
+    j2 = std::min(static_cast<size_t>(std::max(bbox.y2(), 0) / sectorH), m_sectorRows - 1);
+}
+
+void TrackMesh::setCameraTransform(MCCamera & camera, MCGLShaderProgramPtr program) const
+{
+    // The vertices are in world coordinates, so just map the origin to the camera
+    float x = 0;
+    float y = 0;
+    camera.mapToCamera(x, y);
+
+    program->setTransform(0, MCVector3dF(x, y, 0));
+    program->setScale(1.0f, 1.0f, 1.0f);
+}
+
+void TrackMesh::renderAsphalt(MCCamera & camera, MCGLShaderProgramPtr program)
+{
+    if (m_sectors.empty())
+    {
+        return;
+    }
+
+    setCameraTransform(camera, program);
+
+    size_t i0, i2, j0, j2;
+    calculateVisibleSectors(camera.bbox(), i0, i2, j0, j2);
+    for (size_t j = j0; j <= j2; j++)
+    {
+        for (size_t i = i0; i <= i2; i++)
+        {
+            if (auto && chunk = m_sectors[j * m_sectorCols + i].asphalt)
+            {
+                chunk->render(program);
+            }
+        }
+    }
+}
+
+void TrackMesh::renderTiles(MCCamera & camera, MCGLShaderProgramPtr program)
+{
+    if (m_sectors.empty())
+    {
+        return;
+    }
+
+    setCameraTransform(camera, program);
+
+    size_t i0, i2, j0, j2;
+    calculateVisibleSectors(camera.bbox(), i0, i2, j0, j2);
+    for (size_t j = j0; j <= j2; j++)
+    {
+        for (size_t i = i0; i <= i2; i++)
+        {
+            for (auto && chunk : m_sectors[j * m_sectorCols + i].tiles)
+            {
+                chunk->render(program);
+            }
+        }
+    }
+}
+
+TrackMesh::~TrackMesh() = default;
@@ -0,0 +1,71 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TRACKMESH_HPP
+#define TRACKMESH_HPP
+
+#include <MCBBox>
+#include <MCGLShaderProgram>
+
+#include <memory>
+#include <vector>
+
+class Map;
+class MCCamera;
+class MCSurface;
+
+/*! Static geometry of the track tiles baked into vertex buffers.
+ *  The track is divided into sectors of sectorSize x sectorSize tiles. A sector has one buffer
+ *  for the asphalt and one buffer for each tile surface in it, so a visible sector takes
+ *  a few draw calls instead of one per tile. Tiles never move, so the buffers are built only once. */
+class TrackMesh
+{
+public:
+    TrackMesh(const Map & map, std::shared_ptr<MCSurface> asphalt, size_t sectorSize = 8);
+
+    ~TrackMesh();
+
+    //! Render the asphalt of the sectors visible in the camera window.
+    void renderAsphalt(MCCamera & camera, MCGLShaderProgramPtr program);
+
+    //! Render the tile surfaces of the sectors visible in the camera window.
+    void renderTiles(MCCamera & camera, MCGLShaderProgramPtr program);
+
+private:
+    class Chunk;
+
+    struct Sector
+    {
+        std::unique_ptr<Chunk> asphalt;
+
+        std::vector<std::unique_ptr<Chunk>> tiles;
+    };
+
+    void bake(const Map & map, std::shared_ptr<MCSurface> asphalt);
+
+    void calculateVisibleSectors(const MCBBox<int> & bbox, size_t & i0, size_t & i2, size_t & j0, size_t & j2) const;
+
+    void setCameraTransform(MCCamera & camera, MCGLShaderProgramPtr program) const;
+
+    size_t m_sectorSize;
+
+    size_t m_sectorCols;
+
+    size_t m_sectorRows;
+
+    std::vector<Sector> m_sectors;
+};
+
+#endif // TRACKMESH_HPP
@@ -34,7 +34,13 @@
 
 namespace {
 static const float DEFAULT_DIFFUSE_COEFF = 1.5f;
+
+MCGLShaderProgramPtr specularShader()
+{
+    // There are no shaders when running headless
+    return Renderer::hasInstance() ? Renderer::instance().program("defaultSpecular") : nullptr;
 }
+} // namespace
 
 TrackObjectFactory::TrackObjectFactory(MCObjectFactory & objectFactory)
   : m_objectFactory(objectFactory)
@@ -57,7 +63,7 @@ TrackObject * TrackObjectFactory::build(
         data.setSurfaceId(role.toStdString());
 
         object = m_objectFactory.build(data);
-        object->shape()->view()->setShaderProgram(Renderer::instance().program("defaultSpecular"));
+        object->shape()->view()->setShaderProgram(specularShader());
         object->shape()->view()->object()->material()->setDiffuseCoeff(DEFAULT_DIFFUSE_COEFF);
     }
     else if (role == "bushArea")
@@ -97,7 +103,7 @@ TrackObject * TrackObjectFactory::build(
         data.setSurfaceId(role.toStdString());
 
         object = m_objectFactory.build(data);
-        object->shape()->view()->setShaderProgram(Renderer::instance().program("defaultSpecular"));
+        object->shape()->view()->setShaderProgram(specularShader());
         object->shape()->view()->object()->material()->setDiffuseCoeff(DEFAULT_DIFFUSE_COEFF);
     }
     else if (role == "grandstand")
@@ -173,7 +179,7 @@ TrackObject * TrackObjectFactory::build(
         data.setXYFriction(0.25);
 
         object = m_objectFactory.build(data);
-        object->shape()->view()->setShaderProgram(Renderer::instance().program("defaultSpecular"));
+        object->shape()->view()->setShaderProgram(specularShader());
     }
     else if (role == "tree")
     {
@@ -197,7 +203,7 @@ TrackObject * TrackObjectFactory::build(
         data.setInitialLocation(MCVector3dF(location.i(), location.j(), 8));
 
         object = m_objectFactory.build(data);
-        object->shape()->view()->setShaderProgram(Renderer::instance().program("defaultSpecular"));
+        object->shape()->view()->setShaderProgram(specularShader());
     }
 
     if (!object)
@@ -15,46 +15,35 @@
 
 #include "tracktile.hpp"
 
-TrackTile::TrackTile(
-  QPointF location,
-  QPoint matrixLocation,
-  const QString & type,
-  TrackTile::TileType typeEnum)
-  : TrackTileBase(location, matrixLocation, type)
-  , m_rotation(0)
-  , m_typeEnum(typeEnum)
-  , m_hasAsphalt(false)
+TrackTile::TrackTile(size_t i, size_t j)
+  : m_i(static_cast<uint16_t>(i))
+  , m_j(static_cast<uint16_t>(j))
 {
 }
 
-void TrackTile::setRotation(int rotation)
-{
-    m_rotation = rotation;
-}
-
-int TrackTile::rotation() const
+QPointF TrackTile::location() const
 {
-    return m_rotation;
+    return { static_cast<qreal>(width() / 2 + m_i * width()), static_cast<qreal>(height() / 2 + m_j * height()) };
 }
 
-void TrackTile::setSurface(MCSurfacePtr surface)
+size_t TrackTile::i() const
 {
-    m_surface = surface;
+    return m_i;
 }
 
-MCSurfacePtr TrackTile::surface() const
+size_t TrackTile::j() const
 {
-    return m_surface;
+    return m_j;
 }
 
-void TrackTile::setPreviewSurface(MCSurfacePtr surface)
+void TrackTile::setRotation(int rotation)
 {
-    m_previewSurface = surface;
+    m_rotation = static_cast<int16_t>(rotation);
 }
 
-MCSurfacePtr TrackTile::previewSurface() const
+int TrackTile::rotation() const
 {
-    return m_previewSurface;
+    return m_rotation;
 }
 
 TrackTile::TileType TrackTile::tileTypeEnum() const
@@ -76,17 +65,72 @@ void TrackTile::setTileTypeEnum(TrackTile::TileType type)
     case TileType::Straight45Male:
     case TileType::Straight45Female:
     case TileType::Finish:
-        m_hasAsphalt = true;
+        m_flags |= HasAsphalt;
         break;
     default:
-        m_hasAsphalt = false;
+        m_flags &= ~HasAsphalt;
         break;
     }
 }
 
 bool TrackTile::hasAsphalt() const
 {
-    return m_hasAsphalt;
+    return m_flags & HasAsphalt;
+}
+
+void TrackTile::setComputerHint(ComputerHint hint)
+{
+    m_computerHint = static_cast<uint8_t>(hint);
+}
+
+TrackTile::ComputerHint TrackTile::computerHint() const
+{
+    return static_cast<ComputerHint>(m_computerHint);
+}
+
+void TrackTile::setExcludeFromMinimap(bool exclude)
+{
+    if (exclude)
+    {
+        m_flags |= ExcludeFromMinimap;
+    }
+    else
+    {
+        m_flags &= ~ExcludeFromMinimap;
+    }
+}
+
+bool TrackTile::excludeFromMinimap() const
+{
+    return m_flags & ExcludeFromMinimap;
 }
 
-TrackTile::~TrackTile() = default;
+void TrackTile::setSurfaceIndex(uint16_t index)
+{
+    m_surfaceIndex = index;
+}
+
+uint16_t TrackTile::surfaceIndex() const
+{
+    return m_surfaceIndex;
+}
+
+void TrackTile::setPreviewSurfaceIndex(uint16_t index)
+{
+    m_previewSurfaceIndex = index;
+}
+
+uint16_t TrackTile::previewSurfaceIndex() const
+{
+    return m_previewSurfaceIndex;
+}
+
+size_t TrackTile::width()
+{
+    return TrackTileBase::width();
+}
+
+size_t TrackTile::height()
+{
+    return TrackTileBase::height();
+}
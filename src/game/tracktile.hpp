@@ -17,14 +17,20 @@
 #define TRACKTILE_HPP
 
 #include "../common/tracktilebase.hpp"
-#include <MCSurface>
 
-//! The track tile used in the game.
-class TrackTile : public TrackTileBase
+#include <QPointF>
+
+#include <cstdint>
+
+/*! The track tile used in the game. Unlike in the editor, tiles are plain records
+ *  stored by value in Map, so that the hot paths (AI, off-track detection and rendering)
+ *  can access them without touching reference counts. Surfaces are referred by their
+ *  index in the map. */
+class TrackTile
 {
 public:
     //! All possible types.
-    enum class TileType
+    enum class TileType : uint8_t
     {
         None = 0,
         Bridge,
@@ -42,56 +48,93 @@ public:
         Finish
     };
 
-    /*! Constructor.
-     *  \see TrackTileBase. */
-    TrackTile(QPointF location, QPoint matrixLocation, const QString & type = "", TileType typeEnum = TileType::None);
+    using ComputerHint = TrackTileBase::ComputerHint;
 
-    //! Destructor
-    virtual ~TrackTile() override;
+    //! Surface index of tiles without a surface.
+    static const uint16_t NO_SURFACE = 0xffff;
 
-    //! Set the orientation in XY-plane in degrees when loading
-    //! a track.
-    void setRotation(int rotation);
+    //! Constructor.
+    TrackTile() = default;
+
+    /*! Constructor.
+     *  \param i Column in the tile matrix.
+     *  \param j Row in the tile matrix. */
+    TrackTile(size_t i, size_t j);
 
-    //! Set the renderable surface object corresponding to the track tile.
-    void setSurface(MCSurfacePtr surface);
+    //! Get location (center) in the world.
+    QPointF location() const;
 
-    //! Get the corresponding surface.
-    MCSurfacePtr surface() const;
+    //! Get column in the tile matrix.
+    size_t i() const;
 
-    //! Set the renderable surface object corresponding to the preview of track tile.
-    void setPreviewSurface(MCSurfacePtr surface);
+    //! Get row in the tile matrix.
+    size_t j() const;
 
-    //! Get the corresponding preview surface.
-    MCSurfacePtr previewSurface() const;
+    //! Set the orientation in XY-plane in degrees when loading
+    //! a track.
+    void setRotation(int rotation);
 
     //! Get the orientation in XY-plane in degrees.
     int rotation() const;
 
-    //! Get the type as an enum (performance optimization).
+    //! Get the type as an enum.
     TileType tileTypeEnum() const;
 
-    //! Set the type as an enum (performance optimization).
+    //! Set the type as an enum.
     void setTileTypeEnum(TileType type);
 
     //! Returns true if the tile needs a separate asphalt background.
     bool hasAsphalt() const;
 
+    //! Set computer hint
+    void setComputerHint(ComputerHint hint);
+
+    //! Get computer hint
+    ComputerHint computerHint() const;
+
+    //! Don't show the tile in minimap / preview even if an asphalt tile.
+    void setExcludeFromMinimap(bool exclude);
+
+    bool excludeFromMinimap() const;
+
+    //! Set index of the surface in the map. \see Map::surface().
+    void setSurfaceIndex(uint16_t index);
+
+    uint16_t surfaceIndex() const;
+
+    //! Set index of the preview surface in the map. \see Map::surface().
+    void setPreviewSurfaceIndex(uint16_t index);
+
+    uint16_t previewSurfaceIndex() const;
+
+    //! \return Tile width in pixels
+    static size_t width();
+
+    //! \return Tile height in pixels
+    static size_t height();
+
 private:
-    //! Disable the string-based type getter. Use tileTypeEnum() instead.
-    const QString & tileType() const;
+    enum Flags : uint8_t
+    {
+        HasAsphalt = 1,
+        ExcludeFromMinimap = 2
+    };
 
-    int m_rotation;
+    uint16_t m_i = 0;
 
-    MCSurfacePtr m_surface;
+    uint16_t m_j = 0;
 
-    MCSurfacePtr m_previewSurface;
+    int16_t m_rotation = 0;
 
-    TileType m_typeEnum;
+    uint16_t m_surfaceIndex = NO_SURFACE;
 
-    bool m_hasAsphalt;
-};
+    uint16_t m_previewSurfaceIndex = NO_SURFACE;
 
-using TrackTileS = std::shared_ptr<TrackTile>;
+    TileType m_typeEnum = TileType::None;
+
+    uint8_t m_computerHint = 0;
+
+    uint8_t m_flags = 0;
+};
 
 #endif // TRACKTILE_HPP
@@ -0,0 +1,110 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trackworld.hpp"
+#include "bridge.hpp"
+#include "pit.hpp"
+#include "race.hpp"
+#include "track.hpp"
+#include "trackdata.hpp"
+#include "trackobject.hpp"
+#include "tracktile.hpp"
+
+#include <MCMesh>
+#include <MCShape>
+#include <MCShapeView>
+#include <MCWorld>
+
+#include <cassert>
+
+using std::dynamic_pointer_cast;
+
+namespace TrackWorld {
+
+static void addNormalObjects(const Track & track, Race & race)
+{
+    for (size_t i = 0; i < track.trackData().objects().count(); i++)
+    {
+        const auto trackObject = dynamic_pointer_cast<TrackObject>(track.trackData().objects().object(i));
+        assert(trackObject);
+
+        auto && object = trackObject->object();
+        object.addToWorld();
+
+        // Set the base Z of mesh objects at ground level instead of at the object center
+        float baseZ = 0;
+        if (object.shape() && object.shape()->view() && object.shape()->view()->object())
+        {
+            if (dynamic_cast<MCMesh *>(object.shape()->view()->object()))
+            {
+                baseZ = -object.shape()->view()->object()->minZ();
+            }
+        }
+
+        object.translate(object.initialLocation() + MCVector3dF { 0, 0, baseZ });
+        object.rotate(static_cast<float>(object.initialAngle()));
+
+        if (const auto pit = dynamic_cast<Pit *>(&object); pit)
+        {
+            pit->reset();
+            QObject::connect(pit, &Pit::pitStop, &race, &Race::pitStop);
+        }
+    }
+}
+
+static void addBridgeObjects(const Track & track, std::vector<MCObjectPtr> & bridges)
+{
+    auto && map = track.trackData().map();
+    for (size_t j = 0; j < map.rows(); j++)
+    {
+        for (size_t i = 0; i < map.cols(); i++)
+        {
+            auto && tile = map.tile(i, j);
+            if (tile.tileTypeEnum() == TrackTile::TileType::Bridge)
+            {
+                const auto bridge = std::make_shared<Bridge>();
+                bridge->translate(MCVector3dF {
+                  static_cast<float>(i * TrackTile::width() + TrackTile::width() / 2),
+                  static_cast<float>(j * TrackTile::height() + TrackTile::height() / 2),
+                  0 });
+                bridge->rotate(static_cast<float>(tile.rotation()));
+                bridge->addToWorld();
+                bridges.push_back(bridge);
+            }
+        }
+    }
+
+    Bridge::reset();
+}
+
+void setDimensions(MCWorld & world, const Track & track)
+{
+    const size_t minX = 0;
+    const size_t maxX = track.width();
+    const size_t minY = 0;
+    const size_t maxY = track.height();
+    const size_t minZ = 0;
+    const size_t maxZ = 1000;
+
+    world.setDimensions(minX, static_cast<float>(maxX), minY, static_cast<float>(maxY), minZ, maxZ, METERS_PER_UNIT, true, 128, MCBroadPhase::Type::SweepAndPrune);
+}
+
+void addTrackObjects(const Track & track, Race & race, std::vector<MCObjectPtr> & bridges)
+{
+    addNormalObjects(track, race);
+    addBridgeObjects(track, bridges);
+}
+
+} // namespace TrackWorld
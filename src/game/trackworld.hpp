@@ -0,0 +1,41 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef TRACKWORLD_HPP
+#define TRACKWORLD_HPP
+
+#include <MCObject>
+
+#include <vector>
+
+class MCWorld;
+class Race;
+class Track;
+
+//! Sets up the physics world for a race on a track. Shared by Scene and Simulation.
+namespace TrackWorld {
+
+const float METERS_PER_UNIT = 0.05f;
+
+//! Set the dimensions of the world according to the given track.
+void setDimensions(MCWorld & world, const Track & track);
+
+/*! Add the objects of the given track to the world and connect the pits to the race.
+ *  The bridges built on the bridge tiles are appended to the given vector. */
+void addTrackObjects(const Track & track, Race & race, std::vector<MCObjectPtr> & bridges);
+
+} // namespace TrackWorld
+
+#endif // TRACKWORLD_HPP
@@ -0,0 +1,302 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "audiocommandqueuetest.hpp"
+
+#include "audiocommandqueue.hpp"
+#include "audiosourcebank.hpp"
+
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class NullDevice : public STFH::Device
+{
+public:
+    virtual void initialize() override
+    {
+    }
+
+    virtual void shutDown() override
+    {
+    }
+};
+
+class RecordingSource : public STFH::Source
+{
+public:
+    virtual void play(bool loop) override
+    {
+        m_playing = true;
+        m_looping = loop;
+        m_playCount++;
+    }
+
+    virtual void stop() override
+    {
+        m_playing = false;
+        m_stopCount++;
+    }
+
+    //! \reimp
+    virtual void setPitch(float pitch) override
+    {
+        STFH::Source::setPitch(pitch);
+        m_updateCount++;
+    }
+
+    //! \reimp
+    virtual void setLocation(const STFH::Location & location) override
+    {
+        STFH::Source::setLocation(location);
+        m_updateCount++;
+    }
+
+    bool m_playing = false;
+    bool m_looping = false;
+    int m_playCount = 0;
+    int m_stopCount = 0;
+    int m_updateCount = 0;
+};
+
+const size_t SOURCE_COUNT = 8;
+
+std::vector<std::shared_ptr<RecordingSource>> addSources(AudioSourceBank & bank)
+{
+    std::vector<std::shared_ptr<RecordingSource>> sources;
+    for (size_t i = 0; i < SOURCE_COUNT; i++)
+    {
+        sources.push_back(std::make_shared<RecordingSource>());
+        bank.setSource(i, sources.back());
+    }
+
+    return sources;
+}
+
+//! Record a stream similar to what CarSoundEffectManager sends: engine updates every frame and occasional hits and skids.
+std::vector<AudioCommand> recordCommands(size_t frames)
+{
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<float> value(0, 1000);
+    std::uniform_int_distribution<int> event(0, 20);
+
+    std::vector<AudioCommand> commands;
+    for (uint16_t car = 0; car < SOURCE_COUNT / 2; car++)
+    {
+        commands.push_back({ AudioCommand::Type::PlayLooped, car, {} });
+    }
+
+    for (size_t frame = 0; frame < frames; frame++)
+    {
+        for (uint16_t car = 0; car < SOURCE_COUNT / 2; car++)
+        {
+            const float x = value(engine);
+            const float y = value(engine);
+            commands.push_back({ AudioCommand::Type::SetPitch, car, { 1.0f + value(engine) / 1000, 0 } });
+            commands.push_back({ AudioCommand::Type::SetLocation, car, { x, y } });
+
+            const uint16_t effect = static_cast<uint16_t>(car + SOURCE_COUNT / 2);
+            switch (event(engine))
+            {
+            case 0:
+                commands.push_back({ AudioCommand::Type::SetLocation, effect, { x, y } });
+                commands.push_back({ AudioCommand::Type::Play, effect, {} });
+                break;
+            case 1:
+                commands.push_back({ AudioCommand::Type::Stop, effect, {} });
+                break;
+            case 2:
+                commands.push_back({ AudioCommand::Type::SetVolume, effect, { value(engine) / 1000, 0 } });
+                break;
+            case 3:
+                commands.push_back({ AudioCommand::Type::SetPitch, AudioCommand::NO_SOURCE, { 1, 0 } });
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    return commands;
+}
+
+bool sameState(const RecordingSource & a, const RecordingSource & b)
+{
+    return a.m_playing == b.m_playing && a.m_looping == b.m_looping && a.m_playCount == b.m_playCount && a.m_stopCount == b.m_stopCount && a.pitch() == b.pitch() && a.volume() == b.volume() && a.location().x() == b.location().x() && a.location().y() == b.location().y();
+}
+
+} // namespace
+
+AudioCommandQueueTest::AudioCommandQueueTest()
+{
+}
+
+void AudioCommandQueueTest::testPushAndPop()
+{
+    AudioCommandQueue queue(5);
+    QCOMPARE(queue.capacity(), size_t(8));
+
+    std::vector<AudioCommand> batch;
+    QCOMPARE(queue.pop(batch), size_t(0));
+
+    // Wrap around the ring a few times
+    for (uint16_t round = 0; round < 5; round++)
+    {
+        for (uint16_t i = 0; i < 6; i++)
+        {
+            QVERIFY(queue.push({ AudioCommand::Type::Play, static_cast<uint16_t>(round + i), {} }));
+        }
+
+        QCOMPARE(queue.pop(batch), size_t(6));
+        for (uint16_t i = 0; i < 6; i++)
+        {
+            QCOMPARE(batch[i].source, static_cast<uint16_t>(round + i));
+        }
+    }
+}
+
+void AudioCommandQueueTest::testFull()
+{
+    AudioCommandQueue queue(4);
+    for (uint16_t i = 0; i < 4; i++)
+    {
+        QVERIFY(queue.push({ AudioCommand::Type::Play, i, {} }));
+    }
+
+    QVERIFY(!queue.push({ AudioCommand::Type::Play, 4, {} }));
+
+    std::vector<AudioCommand> batch;
+    QCOMPARE(queue.pop(batch), size_t(4));
+    QCOMPARE(batch.back().source, uint16_t(3));
+
+    QVERIFY(queue.push({ AudioCommand::Type::Play, 4, {} }));
+}
+
+void AudioCommandQueueTest::testCoalesce()
+{
+    AudioCommandQueue queue;
+    std::vector<AudioCommand> batch = {
+        { AudioCommand::Type::SetPitch, 0, { 1, 0 } },
+        { AudioCommand::Type::SetLocation, 0, { 1, 1 } },
+        { AudioCommand::Type::SetPitch, 1, { 5, 0 } },
+        { AudioCommand::Type::SetPitch, 0, { 2, 0 } },
+        { AudioCommand::Type::SetLocation, 0, { 2, 2 } },
+        { AudioCommand::Type::Play, 0, {} },
+        { AudioCommand::Type::SetLocation, 0, { 3, 3 } },
+        { AudioCommand::Type::SetPitch, AudioCommand::NO_SOURCE, { 1, 0 } },
+        { AudioCommand::Type::SetLocation, 0, { 4, 4 } }
+    };
+
+    queue.coalesce(batch);
+
+    // The updates before playing are kept, because the sound must start at the right place
+    QCOMPARE(batch.size(), size_t(5));
+    QVERIFY(batch[0].type == AudioCommand::Type::SetPitch);
+    QCOMPARE(batch[0].args[0], 2.0f);
+    QVERIFY(batch[1].type == AudioCommand::Type::SetLocation);
+    QCOMPARE(batch[1].args[0], 2.0f);
+    QCOMPARE(batch[2].source, uint16_t(1));
+    QVERIFY(batch[3].type == AudioCommand::Type::Play);
+    QVERIFY(batch[4].type == AudioCommand::Type::SetLocation);
+    QCOMPARE(batch[4].args[0], 4.0f);
+}
+
+void AudioCommandQueueTest::testReplay()
+{
+    const auto commands = recordCommands(1000);
+
+    AudioSourceBank directBank(std::make_shared<NullDevice>());
+    const auto directSources = addSources(directBank);
+    for (auto && command : commands)
+    {
+        directBank.execute(command);
+    }
+
+    // Drain every few frames like the audio thread would
+    AudioSourceBank queuedBank(std::make_shared<NullDevice>());
+    const auto queuedSources = addSources(queuedBank);
+    AudioCommandQueue queue;
+    std::vector<AudioCommand> batch;
+    size_t executed = 0;
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        QVERIFY(queue.push(commands[i]));
+        if (i % 50 == 0 || i + 1 == commands.size())
+        {
+            executed += queue.pop(batch);
+            for (auto && command : batch)
+            {
+                queuedBank.execute(command);
+            }
+        }
+    }
+
+    QVERIFY(executed < commands.size() / 2);
+
+    int directUpdates = 0;
+    int queuedUpdates = 0;
+    for (size_t i = 0; i < SOURCE_COUNT; i++)
+    {
+        QVERIFY(sameState(*directSources[i], *queuedSources[i]));
+        directUpdates += directSources[i]->m_updateCount;
+        queuedUpdates += queuedSources[i]->m_updateCount;
+    }
+
+    QVERIFY(queuedUpdates < directUpdates);
+}
+
+void AudioCommandQueueTest::testConcurrentProducer()
+{
+    const uint16_t commandCount = 50000;
+
+    AudioCommandQueue queue(64);
+    std::thread producer([&] {
+        for (uint16_t i = 0; i < commandCount;)
+        {
+            // Play requests are never coalesced
+            if (queue.push({ AudioCommand::Type::Play, static_cast<uint16_t>(i % 2), { static_cast<float>(i), 0 } }))
+            {
+                i++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<AudioCommand> batch;
+    uint16_t expected = 0;
+    bool ordered = true;
+    while (expected < commandCount)
+    {
+        queue.pop(batch);
+        for (auto && command : batch)
+        {
+            ordered = ordered && command.args[0] == static_cast<float>(expected);
+            expected++;
+        }
+    }
+
+    producer.join();
+
+    QVERIFY(ordered);
+    QCOMPARE(expected, commandCount);
+}
+
+QTEST_GUILESS_MAIN(AudioCommandQueueTest)
@@ -0,0 +1,112 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "simulationclocktest.hpp"
+#include "simulationclock.hpp"
+
+#include <vector>
+
+using std::chrono::milliseconds;
+
+SimulationClockTest::SimulationClockTest()
+{
+}
+
+void SimulationClockTest::testWholeSteps()
+{
+    SimulationClock clock(milliseconds { 10 }, 5);
+
+    QCOMPARE(clock.advance(milliseconds { 5 }), size_t(0));
+    QCOMPARE(clock.advance(milliseconds { 5 }), size_t(1));
+    QCOMPARE(clock.advance(milliseconds { 25 }), size_t(2));
+    QCOMPARE(clock.advance(milliseconds { 5 }), size_t(1));
+    QCOMPARE(clock.stepLength(), milliseconds { 10 });
+}
+
+void SimulationClockTest::testInterpolation()
+{
+    SimulationClock clock(milliseconds { 10 }, 5);
+
+    QCOMPARE(clock.interpolation(), 0.0f);
+
+    clock.advance(milliseconds { 14 });
+    QCOMPARE(clock.interpolation(), 0.4f);
+
+    clock.advance(milliseconds { 6 });
+    QCOMPARE(clock.interpolation(), 0.0f);
+
+    clock.advance(milliseconds { 5 });
+    clock.reset();
+    QCOMPARE(clock.interpolation(), 0.0f);
+}
+
+void SimulationClockTest::testCatchUpLimit()
+{
+    SimulationClock clock(milliseconds { 10 }, 5);
+
+    QCOMPARE(clock.advance(milliseconds { 1000 }), size_t(5));
+
+    // The backlog is dropped
+    QCOMPARE(clock.interpolation(), 0.0f);
+    QCOMPARE(clock.advance(milliseconds { 10 }), size_t(1));
+}
+
+void SimulationClockTest::testFrameRateIndependence()
+{
+    // Run a second with jittery 30 fps and 60 fps frame times: the number of steps must match
+    const std::vector<int> frames30 = { 33, 34, 33, 30, 36, 34 };
+    const std::vector<int> frames60 = { 16, 17, 17, 15, 18, 17 };
+
+    SimulationClock clock30(milliseconds { 16 }, 5);
+    SimulationClock clock60(milliseconds { 16 }, 5);
+
+    size_t steps30 = 0;
+    size_t steps60 = 0;
+    int elapsed = 0;
+    for (size_t i = 0; elapsed < 1000; i++)
+    {
+        const int frame = frames30.at(i % frames30.size());
+        steps30 += clock30.advance(milliseconds { frame });
+        elapsed += frame;
+    }
+
+    const int elapsed30 = elapsed;
+    elapsed = 0;
+    for (size_t i = 0; elapsed < elapsed30; i++)
+    {
+        const int frame = std::min(frames60.at(i % frames60.size()), elapsed30 - elapsed);
+        steps60 += clock60.advance(milliseconds { frame });
+        elapsed += frame;
+    }
+
+    QCOMPARE(steps30, steps60);
+    QCOMPARE(steps30, static_cast<size_t>(elapsed30 / 16));
+}
+
+void SimulationClockTest::testTimeScale()
+{
+    SimulationClock clock(milliseconds { 10 }, 5);
+    clock.setTimeScale(4.0f);
+
+    // The catch-up limit is scaled, too
+    QCOMPARE(clock.advance(milliseconds { 100 }), size_t(20));
+    QCOMPARE(clock.timeScale(), 4.0f);
+
+    clock.setTimeScale(0.5f);
+    QCOMPARE(clock.advance(milliseconds { 10 }), size_t(0));
+    QCOMPARE(clock.advance(milliseconds { 10 }), size_t(1));
+}
+
+QTEST_GUILESS_MAIN(SimulationClockTest)
@@ -0,0 +1,309 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "streamqueuetest.hpp"
+
+#include "oggstreamdata.hpp"
+
+#include <StreamQueue>
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::string SOUND_FILE = std::string(SOUNDS_PATH) + "/bell.ogg";
+
+//! Reads the raw bytes of a file as stereo PCM in small and uneven chunks like a decoder would.
+class FileStreamData : public STFH::StreamData
+{
+public:
+    FileStreamData(const std::string & path, size_t maxRead)
+      : m_file(path, std::ios::binary)
+      , m_maxRead(maxRead)
+    {
+        Data::load(path);
+    }
+
+    virtual size_t read(char * buffer, size_t size) override
+    {
+        m_file.read(buffer, static_cast<std::streamsize>(std::min(size, m_maxRead)));
+        return static_cast<size_t>(m_file.gcount());
+    }
+
+    virtual void rewind() override
+    {
+        m_file.clear();
+        m_file.seekg(0);
+    }
+
+    virtual int channels() const override
+    {
+        return 2;
+    }
+
+    virtual int sampleRate() const override
+    {
+        return 44100;
+    }
+
+private:
+    std::ifstream m_file;
+
+    size_t m_maxRead;
+};
+
+//! Plays the queued buffers into a byte vector instead of a device.
+class FakeStreamQueue : public STFH::StreamQueue
+{
+public:
+    FakeStreamQueue(STFH::StreamDataPtr data, size_t bufferCount, size_t bufferSize)
+      : StreamQueue(data, bufferCount, bufferSize)
+      , m_buffers(bufferCount)
+    {
+    }
+
+    virtual ~FakeStreamQueue() override
+    {
+        stopPlayback();
+    }
+
+    //! Play the given number of the queued buffers. The device stops if it runs out of buffers.
+    void playBuffers(size_t count)
+    {
+        for (size_t i = 0; i < count && m_deviceQueue.size() > m_processed; i++)
+        {
+            auto && buffer = m_buffers[m_deviceQueue[m_processed++]];
+            m_output.insert(m_output.end(), buffer.begin(), buffer.end());
+        }
+
+        m_devicePlaying = m_devicePlaying && m_deviceQueue.size() > m_processed;
+    }
+
+    size_t queuedCount() const
+    {
+        return m_deviceQueue.size();
+    }
+
+    std::vector<char> m_output;
+
+    std::vector<size_t> m_bufferSizes;
+
+    bool m_devicePlaying = false;
+
+    int m_restartCount = 0;
+
+protected:
+    virtual size_t unqueueProcessedBuffers() override
+    {
+        const size_t processed = m_processed;
+        m_deviceQueue.erase(m_deviceQueue.begin(), m_deviceQueue.begin() + static_cast<std::ptrdiff_t>(processed));
+        m_processed = 0;
+        return processed;
+    }
+
+    virtual void queueBuffer(size_t index, const char * data, size_t size) override
+    {
+        // A buffer may not be reused before it has been played
+        if (std::find(m_deviceQueue.begin(), m_deviceQueue.end(), index) != m_deviceQueue.end())
+        {
+            throw std::logic_error("Buffer is still queued");
+        }
+
+        m_buffers[index].assign(data, data + size);
+        m_bufferSizes.push_back(size);
+        m_deviceQueue.push_back(index);
+    }
+
+    virtual void startPlayback() override
+    {
+        if (!m_devicePlaying)
+        {
+            m_devicePlaying = true;
+            m_restartCount++;
+        }
+    }
+
+    virtual void stopPlayback() override
+    {
+        m_devicePlaying = false;
+        m_deviceQueue.clear();
+        m_processed = 0;
+    }
+
+private:
+    std::vector<std::vector<char>> m_buffers;
+
+    std::deque<size_t> m_deviceQueue;
+
+    size_t m_processed = 0;
+};
+
+std::vector<char> readFile(const std::string & path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+std::vector<char> readAll(STFH::StreamData & data)
+{
+    std::vector<char> pcm(1024 * 1024);
+    size_t size = 0;
+    while (const size_t bytes = data.read(pcm.data() + size, pcm.size() - size))
+    {
+        size += bytes;
+        if (size == pcm.size())
+        {
+            pcm.resize(pcm.size() * 2);
+        }
+    }
+
+    pcm.resize(size);
+    return pcm;
+}
+
+//! Play the stream to the end updating between randomly sized bursts of played buffers.
+void playToEnd(FakeStreamQueue & queue, size_t bufferCount)
+{
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<size_t> burst(0, bufferCount - 1);
+    while (queue.update())
+    {
+        queue.playBuffers(burst(engine));
+    }
+}
+
+} // namespace
+
+StreamQueueTest::StreamQueueTest()
+{
+}
+
+void StreamQueueTest::testContinuity()
+{
+    const auto reference = readFile(SOUND_FILE);
+    QVERIFY(!reference.empty());
+
+    // The buffer size is not a multiple of the frame size and the reads are uneven on purpose
+    const size_t bufferCount = 3;
+    const size_t bufferSize = 1002;
+    FakeStreamQueue queue(std::make_shared<FileStreamData>(SOUND_FILE, 333), bufferCount, bufferSize);
+    queue.play(false);
+    QVERIFY(queue.isPlaying());
+    QCOMPARE(queue.queuedCount(), bufferCount);
+
+    playToEnd(queue, bufferCount);
+
+    QVERIFY(!queue.isPlaying());
+    QVERIFY(queue.m_output == reference);
+
+    // All but the last buffer are full and contain whole frames
+    for (size_t i = 0; i + 1 < queue.m_bufferSizes.size(); i++)
+    {
+        QCOMPARE(queue.m_bufferSizes[i], size_t(1000));
+    }
+}
+
+void StreamQueueTest::testLoop()
+{
+    const auto reference = readFile(SOUND_FILE);
+
+    const size_t bufferCount = 4;
+    FakeStreamQueue queue(std::make_shared<FileStreamData>(SOUND_FILE, 4096), bufferCount, 8192);
+    queue.play(true);
+    while (queue.m_output.size() < reference.size() * 5 / 2)
+    {
+        QVERIFY(queue.update());
+        QCOMPARE(queue.queuedCount(), bufferCount);
+        queue.playBuffers(2);
+    }
+
+    // The stream wraps around without gaps, also within a buffer
+    for (size_t i = 0; i < queue.m_output.size(); i++)
+    {
+        QCOMPARE(queue.m_output[i], reference[i % reference.size()]);
+    }
+}
+
+void StreamQueueTest::testUnderrun()
+{
+    const auto reference = readFile(SOUND_FILE);
+
+    const size_t bufferCount = 2;
+    FakeStreamQueue queue(std::make_shared<FileStreamData>(SOUND_FILE, 4096), bufferCount, 4096);
+    queue.play(false);
+    QCOMPARE(queue.m_restartCount, 1);
+
+    // Late updates let the device run out of buffers every time
+    while (queue.update())
+    {
+        QVERIFY(queue.m_devicePlaying);
+        queue.playBuffers(bufferCount);
+        QVERIFY(!queue.m_devicePlaying);
+    }
+
+    QVERIFY(queue.m_restartCount > 2);
+    QVERIFY(queue.m_output == reference);
+}
+
+void StreamQueueTest::testStop()
+{
+    const auto reference = readFile(SOUND_FILE);
+
+    const size_t bufferCount = 3;
+    FakeStreamQueue queue(std::make_shared<FileStreamData>(SOUND_FILE, 4096), bufferCount, 4096);
+    queue.play(true);
+    queue.playBuffers(2);
+    queue.update();
+
+    queue.stop();
+    QVERIFY(!queue.isPlaying());
+    QVERIFY(!queue.update());
+    QCOMPARE(queue.queuedCount(), size_t(0));
+
+    // Playing again starts from the beginning
+    queue.m_output.clear();
+    queue.play(false);
+    playToEnd(queue, bufferCount);
+    QVERIFY(queue.m_output == reference);
+}
+
+void StreamQueueTest::testOggStream()
+{
+    OggStreamData decoder(SOUND_FILE);
+    QVERIFY(decoder.channels() > 0);
+    QVERIFY(decoder.sampleRate() > 0);
+
+    const auto reference = readAll(decoder);
+    QVERIFY(!reference.empty());
+
+    decoder.rewind();
+    QVERIFY(readAll(decoder) == reference);
+
+    const size_t bufferCount = 4;
+    FakeStreamQueue queue(std::make_shared<OggStreamData>(SOUND_FILE), bufferCount, 32768);
+    queue.play(false);
+    playToEnd(queue, bufferCount);
+    QVERIFY(queue.m_output == reference);
+}
+
+QTEST_GUILESS_MAIN(StreamQueueTest)
@@ -0,0 +1,236 @@
+// This file is part of Dust Racing 2D.
+// Copyright (C) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// Dust Racing 2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// Dust Racing 2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Dust Racing 2D. If not, see <http://www.gnu.org/licenses/>.
+
+#include "trackfilereadertest.hpp"
+
+#include "../common/datakeywords.hpp"
+#include "../common/trackfilereader.hpp"
+
+#include <QBuffer>
+#include <QDir>
+#include <QDomDocument>
+#include <QDomElement>
+#include <QFile>
+
+namespace {
+
+bool readFromString(TrackFileReader & reader, const QByteArray & data, bool headerOnly = false)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return headerOnly ? reader.readHeader(buffer) : reader.read(buffer);
+}
+
+QDomElement loadDomDocument(QString path)
+{
+    QDomDocument doc;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || !doc.setContent(&file))
+    {
+        return {};
+    }
+
+    return doc.documentElement();
+}
+
+} // namespace
+
+TrackFileReaderTest::TrackFileReaderTest()
+{
+    const QDir levels(LEVELS_PATH);
+    for (auto && fileName : levels.entryList(QStringList("*.trk")))
+    {
+        m_trackPaths << levels.filePath(fileName);
+    }
+}
+
+void TrackFileReaderTest::testBundledTracksMatchDomDocument()
+{
+    QVERIFY(!m_trackPaths.isEmpty());
+
+    TrackFileReader reader;
+    for (auto && path : m_trackPaths)
+    {
+        QVERIFY(reader.read(path));
+
+        // Compare against the way the tracks were loaded with QDomDocument
+        const auto root = loadDomDocument(path);
+        QVERIFY(!root.isNull());
+
+        const auto & header = reader.header();
+        QCOMPARE(header.name, root.attribute(DataKeywords::Header::name, "undefined"));
+        QCOMPARE(header.cols, root.attribute(DataKeywords::Header::cols, "0").toUInt());
+        QCOMPARE(header.rows, root.attribute(DataKeywords::Header::rows, "0").toUInt());
+        QCOMPARE(header.index, root.attribute(DataKeywords::Header::index, "999").toUInt());
+        QCOMPARE(header.isUserTrack, root.attribute(DataKeywords::Header::user, "0").toUInt() > 0);
+
+        size_t tileIndex = 0;
+        size_t objectIndex = 0;
+        size_t nodeIndex = 0;
+        for (auto element = root.firstChildElement(); !element.isNull(); element = element.nextSiblingElement())
+        {
+            if (element.nodeName() == DataKeywords::Track::tile)
+            {
+                QVERIFY(tileIndex < reader.tiles().size());
+                const auto & tile = reader.tiles().at(tileIndex++);
+                QCOMPARE(static_cast<unsigned int>(tile.i), element.attribute(DataKeywords::Tile::i, "0").toUInt());
+                QCOMPARE(static_cast<unsigned int>(tile.j), element.attribute(DataKeywords::Tile::j, "0").toUInt());
+                QCOMPARE(reader.tileTypes().at(tile.typeIndex), element.attribute(DataKeywords::Tile::type, "clear"));
+                QCOMPARE(static_cast<int>(tile.orientation), element.attribute(DataKeywords::Tile::orientation, "0").toInt());
+                QCOMPARE(static_cast<unsigned int>(tile.computerHint), element.attribute(DataKeywords::Tile::computerHint, "0").toUInt());
+                QCOMPARE(tile.excludeFromMinimap, element.attribute(DataKeywords::Tile::excludeFromMinimap, "0").toUInt() > 0);
+            }
+            else if (element.nodeName() == DataKeywords::Track::object)
+            {
+                QVERIFY(objectIndex < reader.objects().size());
+                const auto & object = reader.objects().at(objectIndex++);
+                QCOMPARE(object.category, element.attribute(DataKeywords::Object::category, ""));
+                QCOMPARE(object.role, element.attribute(DataKeywords::Object::role, ""));
+                QCOMPARE(object.x, element.attribute(DataKeywords::Object::x, "0").toInt());
+                QCOMPARE(object.y, element.attribute(DataKeywords::Object::y, "0").toInt());
+                QCOMPARE(object.orientation, element.attribute(DataKeywords::Object::orientation, "0").toInt());
+                QCOMPARE(object.forceStationary, element.attribute(DataKeywords::Object::forceStationary, "0").toUInt() > 0);
+            }
+            else if (element.nodeName() == DataKeywords::Track::node)
+            {
+                QVERIFY(nodeIndex < reader.nodes().size());
+                const auto & node = reader.nodes().at(nodeIndex++);
+                QCOMPARE(node.index, element.attribute(DataKeywords::Node::index, "0").toInt());
+                QCOMPARE(node.x, element.attribute(DataKeywords::Node::x, "0").toInt());
+                QCOMPARE(node.y, element.attribute(DataKeywords::Node::y, "0").toInt());
+                QCOMPARE(node.width, element.attribute(DataKeywords::Node::width, "0").toInt());
+                QCOMPARE(node.height, element.attribute(DataKeywords::Node::height, "0").toInt());
+            }
+        }
+
+        QCOMPARE(tileIndex, reader.tiles().size());
+        QCOMPARE(objectIndex, reader.objects().size());
+        QCOMPARE(nodeIndex, reader.nodes().size());
+    }
+}
+
+void TrackFileReaderTest::testDefaults()
+{
+    TrackFileReader reader;
+    QVERIFY(readFromString(reader, "<track cols=\"2\" rows=\"3\"><t i=\"1\" j=\"2\"/><o r=\"tree\"/><n/></track>"));
+
+    QCOMPARE(reader.header().name, QString("undefined"));
+    QCOMPARE(reader.header().cols, 2u);
+    QCOMPARE(reader.header().rows, 3u);
+    QCOMPARE(reader.header().index, 999u);
+    QCOMPARE(reader.header().isUserTrack, false);
+
+    QCOMPARE(reader.tiles().size(), size_t(1));
+    QCOMPARE(reader.tiles().at(0).i, uint16_t(1));
+    QCOMPARE(reader.tiles().at(0).j, uint16_t(2));
+    QCOMPARE(reader.tileTypes().at(reader.tiles().at(0).typeIndex), QString("clear"));
+    QCOMPARE(reader.tiles().at(0).orientation, int16_t(0));
+
+    QCOMPARE(reader.objects().size(), size_t(1));
+    QCOMPARE(reader.objects().at(0).role, QString("tree"));
+    QVERIFY(reader.objects().at(0).category.isEmpty());
+
+    QCOMPARE(reader.nodes().size(), size_t(1));
+    QCOMPARE(reader.nodes().at(0).width, 0);
+}
+
+void TrackFileReaderTest::testInvalidFiles()
+{
+    TrackFileReader reader;
+    QVERIFY(!reader.read(QString("does-not-exist.trk")));
+    QVERIFY(!readFromString(reader, ""));
+    QVERIFY(!readFromString(reader, "<level cols=\"2\" rows=\"2\"/>"));
+    QVERIFY(!readFromString(reader, "<track cols=\"0\" rows=\"2\"/>"));
+    QVERIFY(!readFromString(reader, "<track cols=\"2\" rows=\"2\"><t i=\"0\" j=\"0\"></track>"));
+
+    // Tiles outside of the map are dropped
+    QVERIFY(readFromString(reader, "<track cols=\"2\" rows=\"2\"><t i=\"2\" j=\"0\"/><t i=\"0\" j=\"1\"/></track>"));
+    QCOMPARE(reader.tiles().size(), size_t(1));
+}
+
+void TrackFileReaderTest::testReadHeader()
+{
+    TrackFileReader reader;
+    QVERIFY(readFromString(reader, "<track cols=\"2\" rows=\"1\"><t i=\"0\" t=\"grass\"/><n/></track>"));
+    QCOMPARE(reader.tiles().size(), size_t(1));
+
+    // The rest of the file is not even checked
+    QVERIFY(readFromString(reader, "<track name=\"Test\" cols=\"3\" rows=\"4\" index=\"5\" isUserTrack=\"1\"><t i=\"0\"", true));
+    QCOMPARE(reader.header().name, QString("Test"));
+    QCOMPARE(reader.header().cols, 3u);
+    QCOMPARE(reader.header().rows, 4u);
+    QCOMPARE(reader.header().index, 5u);
+    QCOMPARE(reader.header().isUserTrack, true);
+    QVERIFY(reader.tiles().empty());
+    QVERIFY(reader.nodes().empty());
+
+    QVERIFY(!readFromString(reader, "<track cols=\"3\"/>", true));
+}
+
+void TrackFileReaderTest::testTileTypesAreInterned()
+{
+    TrackFileReader reader;
+    QVERIFY(readFromString(reader, "<track cols=\"3\" rows=\"1\"><t i=\"0\" t=\"grass\"/><t i=\"1\" t=\"sand\"/><t i=\"2\" t=\"grass\"/></track>"));
+    QCOMPARE(reader.tileTypes().size(), size_t(3));
+    QCOMPARE(reader.tiles().at(0).typeIndex, reader.tiles().at(2).typeIndex);
+
+    // The indices stay valid for the next track
+    const auto sandIndex = reader.tiles().at(1).typeIndex;
+    QVERIFY(readFromString(reader, "<track cols=\"1\" rows=\"1\"><t i=\"0\" t=\"sand\"/></track>"));
+    QCOMPARE(reader.tileTypes().size(), size_t(3));
+    QCOMPARE(reader.tiles().at(0).typeIndex, sandIndex);
+}
+
+void TrackFileReaderTest::benchmarkTrackFileReader()
+{
+    TrackFileReader reader;
+    QBENCHMARK
+    {
+        for (auto && path : m_trackPaths)
+        {
+            reader.read(path);
+        }
+    }
+}
+
+void TrackFileReaderTest::benchmarkDomDocument()
+{
+    // The reference: what loading the tracks with QDomDocument costs before reading any attributes
+    QBENCHMARK
+    {
+        for (auto && path : m_trackPaths)
+        {
+            loadDomDocument(path);
+        }
+    }
+}
+
+void TrackFileReaderTest::benchmarkReadHeader()
+{
+    // What listing the tracks costs
+    TrackFileReader reader;
+    QBENCHMARK
+    {
+        for (auto && path : m_trackPaths)
+        {
+            QFile file(path);
+            file.open(QIODevice::ReadOnly);
+            reader.readHeader(file);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TrackFileReaderTest)